@@ -17,6 +17,18 @@
  *     * The application name identifier.
  *     * The relative path to the UI definition file.
  *     * The filename of the SQLite database used for storing records.
+ *     * The number of invoices/statements fetched per page by the lists.
+ *     * The number of invoices committed per transaction by a bulk save.
+ *     * The memory budget of the process-wide model cache.
+ *     * The number of business names the search bar suggests.
+ *     * The file a tracing build writes its Chrome trace-event JSON to.
+ *     * The file, in the user's cache directory, the runtime metrics are
+ *       written to on exit.
+ *     * The directory, in the user's documents directory, the export button
+ *       writes the CSV files to, and the number of workers a split export
+ *       uses.
+ *     * The number of rows a bulk import commits per transaction, and the
+ *       number of rejected rows after which it gives up.
  *
  *   These constants eliminate magic strings within the codebase and provide
  *   a single authoritative source for configuring core behaviours.
@@ -33,10 +45,19 @@
 #ifndef _CONFIG_H_
 #define _CONFIG_H_
 #include <string>
+#include <cstddef>
 namespace app {
 namespace config {
 	constexpr int password_number{0};
 	constexpr const char *password_manager_schema_name{"org.app.mint-bill.password"};
+	constexpr long long page_size{50};
+	constexpr std::size_t model_cache_budget{32 * 1024 * 1024};
+	constexpr std::size_t search_suggestions{8};
+	constexpr const char *trace_file{"mint-bill-trace.json"};
+	constexpr const char *metrics_file{"mint-bill-metrics.json"};
+	constexpr const char *export_directory{"mint-bill-export"};
+	constexpr std::size_t export_workers{4};
+	constexpr std::size_t import_error_limit{1000};
 }
 }
 #endif
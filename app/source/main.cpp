@@ -14,7 +14,7 @@
  *     - Initializing the main application windows and common GUI components:
  *       * Page stack and stack-driven navigation.
  *       * Global search bar.
- *       * Print, email, and save buttons.
+ *       * Print, email, save and export buttons.
  *     - Constructing and initializing the feature pages:
  *       * Admin page (business details and configuration).
  *       * Client registration page.
@@ -27,6 +27,51 @@
  *     - Loading persisted admin data from the database and updating the UI
  *       (for example, the organization label) when valid data exists.
  *
+ *   Startup is staged so the slow parts overlap:
+ *
+ *     - The keyring lookup, the SQLCipher open (key derivation) and the admin
+ *       load run on a worker thread started first thing in activate(), while
+ *       the main thread parses the UI file and builds the windows.
+ *     - The admin load also warms the model cache under the business name,
+ *       so the first admin_page search does not open the database again.
+ *     - Once the pages have the password, a task of its own opens the
+ *       full-text search model (creating its index on first run), so the
+ *       first page does not wait for it; once available, the search bar
+ *       suggests up to `app::config::search_suggestions` business names as
+ *       the user types.
+ *     - Pages are created lazily on their first stack switch; only the
+ *       visible page is built during activate().
+ *     - Every phase, and the total from activate() to the first interactive
+ *       page, is timed and reported through syslog at LOG_INFO.
+ *     - On exit the runtime metrics (database, PDF, email and search
+ *       timings) are written as JSON to `app::config::metrics_file` in the
+ *       user's cache directory.
+ *     - Builds with TRACE_ENABLED (Debug) write the recorded trace spans to
+ *       `app::config::trace_file` in Chrome trace-event JSON on exit.
+ *
+ *   The export button writes the invoices, labor lines and statements of
+ *   every client as CSV to `app::config::export_directory` in the user's
+ *   documents directory, on a worker thread. The same export runs headless,
+ *   without GTK, when the first argument is --export:
+ *
+ *     mint-bill --export [--kind invoices|labor|statements]
+ *                        [--format csv|jsonl] [--from YYYY-MM-DD]
+ *                        [--to YYYY-MM-DD] [--client NAME]...
+ *                        [--output FILE | --split DIRECTORY [--workers N]]
+ *
+ *   It reads the database password from the keyring, writes to standard
+ *   output unless --output or --split is given, and exits non-zero when the
+ *   export fails.
+ *
+ *   Historical invoices are loaded headless with --import:
+ *
+ *     mint-bill --import --invoices FILE --labor FILE [--format csv|jsonl]
+ *                        [--defer-indexes]
+ *
+ *   It prints every rejected row as "file:line: reason" and the throughput
+ *   to standard error, and exits non-zero when the import failed or
+ *   rejected a row. A failed import is rolled back as a whole.
+ *
  *   Error conditions and unexpected states are reported via syslog with
  *   critical severity, including file name and line number to aid in
  *   diagnostics. The class is intentionally non-copyable and non-movable to
@@ -35,12 +80,24 @@
  *
  *****************************************************************************/
 #include <gui.h>
+#include <chrono>
 #include <thread>
 #include <future>
+#include <unordered_set>
 #include <stack.h>
 #include <syslog.h>
+#include <trace.h>
+#include <metrics.h>
 #include <config.h>
 #include <gui_parts.h>
+#include <model_cache.h>
+#include <resource_loader.h>
+#include <fstream>
+#include <filesystem>
+#include <iostream>
+#include <search_model.h>
+#include <export_model.h>
+#include <import_model.h>
 #include <invoice_page.h>
 #include <admin_page.h>
 #include <statement_page.h>
@@ -48,6 +105,47 @@
 #include <client_register_page.h>
 
 
+class phase_timer {
+public:
+	phase_timer() = delete;
+	explicit phase_timer(const std::string& _phase): phase{_phase} {}
+	phase_timer(const phase_timer&) = delete;
+	phase_timer(phase_timer&&) = delete;
+	phase_timer& operator= (const phase_timer&) = delete;
+	phase_timer& operator= (phase_timer&&) = delete;
+	~phase_timer()
+	{
+		long long elapsed{std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - this->started).count()};
+		syslog(LOG_INFO, "MINT_BILL: startup phase %s took %lld us", this->phase.c_str(), elapsed);
+	}
+
+private:
+	std::string phase{""};
+	std::chrono::steady_clock::time_point started{std::chrono::steady_clock::now()};
+};
+
+struct export_command {
+	model::export_kind kind{model::export_kind::invoices};
+	model::export_format format{model::export_format::csv};
+	model::export_filter filter{};
+	std::string output{""};
+	std::string split{""};
+	std::size_t workers{app::config::export_workers};
+};
+
+struct import_command {
+	std::string invoices{""};
+	std::string labor{""};
+	model::export_format format{model::export_format::csv};
+	model::import_options options{};
+};
+
+struct warm_start {
+	std::string password{""};
+	data::admin admin_data{};
+};
+
 class mint_bill {
 public:
 	mint_bill();
@@ -69,21 +167,34 @@ protected:
 	[[nodiscard]] bool database_password_components_setup(const Glib::RefPtr<Gtk::Builder>&);
 	void database_password_save_button_on_clicked();
 	void database_password_exist();
+	void search_exist();
+	[[nodiscard]] static warm_start open_database(const std::string&);
+	[[nodiscard]] bool page_setup(const std::string&);
 	[[nodiscard]] bool stack_setup(const Glib::RefPtr<Gtk::Builder>&);
 	[[nodiscard]] bool search_bar_setup(const Glib::RefPtr<Gtk::Builder>&);
 	[[nodiscard]] bool print_button_setup(const Glib::RefPtr<Gtk::Builder>&);
 	[[nodiscard]] bool email_button_setup(const Glib::RefPtr<Gtk::Builder>&);
 	[[nodiscard]] bool save_button_setup(const Glib::RefPtr<Gtk::Builder>&);
+	[[nodiscard]] bool export_button_setup(const Glib::RefPtr<Gtk::Builder>&);
 
 private:
 	Glib::Dispatcher database_password_dispatcher{};
-	std::future<std::string> database_password_future{};
+	std::future<warm_start> database_password_future{};
+	Glib::Dispatcher search_dispatcher{};
+	std::future<std::shared_ptr<model::search>> search_future{};
+	std::future<bool> export_future{};
+	std::string database_password{""};
+	std::chrono::steady_clock::time_point activated{};
+	bool interactive_reported{false};
+	Glib::RefPtr<Gtk::Builder> ui_builder{nullptr};
+	std::unordered_set<std::string> created_pages{};
 	std::shared_ptr<Gtk::Application> app{nullptr};
 	std::shared_ptr<Gtk::Window> mint_bill_window{nullptr};
 	std::unique_ptr<Gtk::Window> database_password_window{nullptr};
 	std::unique_ptr<Gtk::Entry> database_password_entry{nullptr};
 	std::unique_ptr<Gtk::Button> database_password_button{nullptr};
 	std::unique_ptr<Gtk::Label> organization_label{nullptr};
+	std::shared_ptr<model::search> search{nullptr};
 	gui::admin_page admin_page{};
 	gui::client_register_page client_register_page{};
 	gui::invoice_page invoice_page{};
@@ -93,14 +204,212 @@ private:
 	gui::part::sub_button print_button{"print-button"};
 	gui::part::sub_button email_button{"email-button"};
 	gui::part::sub_button save_button{"save-button"};
+	gui::part::sub_button export_button{"export-button"};
 };
 
 
+static bool parse_export_options(int argc, char** argv, export_command& _options)
+{
+	for (int index{2}; index < argc; ++index)
+	{
+		const std::string option{argv[index]};
+		if (index + 1 >= argc)
+		{
+			return false;
+		}
+
+		const std::string value{argv[++index]};
+		if (option == "--kind" && value == "invoices")
+		{
+			_options.kind = model::export_kind::invoices;
+		}
+		else if (option == "--kind" && value == "labor")
+		{
+			_options.kind = model::export_kind::labor;
+		}
+		else if (option == "--kind" && value == "statements")
+		{
+			_options.kind = model::export_kind::statements;
+		}
+		else if (option == "--format" && value == "csv")
+		{
+			_options.format = model::export_format::csv;
+		}
+		else if (option == "--format" && value == "jsonl")
+		{
+			_options.format = model::export_format::jsonl;
+		}
+		else if (option == "--from")
+		{
+			_options.filter.from = value;
+		}
+		else if (option == "--to")
+		{
+			_options.filter.to = value;
+		}
+		else if (option == "--client")
+		{
+			_options.filter.clients.push_back(value);
+		}
+		else if (option == "--output")
+		{
+			_options.output = value;
+		}
+		else if (option == "--split")
+		{
+			_options.split = value;
+		}
+		else if (option == "--workers" && value.find_first_not_of("0123456789") == std::string::npos &&
+			 value.size() < 4 && std::stoul(value) > 0)
+		{
+			_options.workers = std::stoul(value);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return (_options.output.empty() || _options.split.empty());
+}
+
+static int export_main(int argc, char** argv)
+{
+	export_command options{};
+	if (parse_export_options(argc, argv, options) == false)
+	{
+		std::cerr << "usage: " << argv[0] << " --export [--kind invoices|labor|statements] [--format csv|jsonl]\n"
+			  << "       [--from YYYY-MM-DD] [--to YYYY-MM-DD] [--client NAME]...\n"
+			  << "       [--output FILE | --split DIRECTORY [--workers N]]\n";
+		return EXIT_FAILURE;
+	}
+
+	feature::password_manager password_manager{app::config::password_manager_schema_name};
+	model::exporter exporter{MINTBILL_DB_PATH, password_manager.lookup_password(app::config::password_number)};
+	if (exporter.is_available() == false)
+	{
+		std::cerr << "failed to open the database\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success{false};
+	std::size_t rows{0};
+	if (options.split.empty() == false)
+	{
+		success = exporter.write_split(options.split, options.kind, options.format, options.filter, options.workers, rows);
+	}
+	else if (options.output.empty() == false)
+	{
+		std::ofstream file{options.output, std::ios::binary | std::ios::trunc};
+		success = (file.is_open() && exporter.write(file, options.kind, options.format, options.filter, rows));
+	}
+	else
+	{
+		std::ios::sync_with_stdio(false);
+		success = exporter.write(std::cout, options.kind, options.format, options.filter, rows);
+	}
+
+	std::cerr << rows << " rows exported" << (success ? "\n" : ", the export failed\n");
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+static bool parse_import_options(int argc, char** argv, import_command& _options)
+{
+	for (int index{2}; index < argc; ++index)
+	{
+		const std::string option{argv[index]};
+		if (option == "--defer-indexes")
+		{
+			_options.options.defer_indexes = true;
+			continue;
+		}
+		else if (index + 1 >= argc)
+		{
+			return false;
+		}
+
+		const std::string value{argv[++index]};
+		if (option == "--invoices")
+		{
+			_options.invoices = value;
+		}
+		else if (option == "--labor")
+		{
+			_options.labor = value;
+		}
+		else if (option == "--format" && value == "csv")
+		{
+			_options.format = model::export_format::csv;
+		}
+		else if (option == "--format" && value == "jsonl")
+		{
+			_options.format = model::export_format::jsonl;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return (_options.invoices.empty() == false && _options.labor.empty() == false);
+}
+
+static int import_main(int argc, char** argv)
+{
+	import_command options{};
+	if (parse_import_options(argc, argv, options) == false)
+	{
+		std::cerr << "usage: " << argv[0] << " --import --invoices FILE --labor FILE [--format csv|jsonl]\n"
+			  << "       [--defer-indexes]\n";
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream invoices{options.invoices, std::ios::binary};
+	std::ifstream labor{options.labor, std::ios::binary};
+	if (invoices.is_open() == false || labor.is_open() == false)
+	{
+		std::cerr << "failed to open the invoice or labor file\n";
+		return EXIT_FAILURE;
+	}
+
+	feature::password_manager password_manager{app::config::password_manager_schema_name};
+	model::importer importer{MINTBILL_DB_PATH, password_manager.lookup_password(app::config::password_number)};
+	if (importer.is_available() == false)
+	{
+		std::cerr << "failed to open the database\n";
+		return EXIT_FAILURE;
+	}
+
+	model::import_report report{};
+	const bool success{importer.import(invoices, labor, options.format, options.options, report)};
+	for (const model::import_error& error : report.errors)
+	{
+		std::cerr << ((error.file == "invoices") ? options.invoices : options.labor) << ":" << error.line
+			  << ": " << error.message << "\n";
+	}
+
+	const double rate{(report.seconds > 0.0) ? static_cast<double> (report.labor) / report.seconds : 0.0};
+	std::cerr << report.invoices << " invoices and " << report.labor << " labor lines in " << report.seconds
+		  << " s (" << static_cast<long long> (rate) << " labor lines/s), " << report.errors.size()
+		  << " rejected" << (success ? "\n" : ", the import failed\n");
+	return (success && report.errors.empty()) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int main(int argc, char** argv)
 {
 	int return_code{0};
 	try
 	{
+		if (argc > 1 && std::string{argv[1]} == "--export")
+		{
+			return export_main(argc, argv);
+		}
+		else if (argc > 1 && std::string{argv[1]} == "--import")
+		{
+			return import_main(argc, argv);
+		}
+
 		mint_bill mint_bill;
 		if (mint_bill.create() == false)
 		{
@@ -110,6 +419,18 @@ int main(int argc, char** argv)
 		else
 		{
 			return_code = mint_bill.launch(argc, argv);
+			if (utility::metrics::write(Glib::build_filename(Glib::get_user_cache_dir(), app::config::metrics_file)) == false)
+			{
+				syslog(LOG_CRIT, "MINT_BILL: failed to write the metrics file - "
+						 "filename %s, line number %d", __FILE__, __LINE__);
+			}
+#if defined(TRACE_ENABLED)
+			if (utility::trace::write_chrome_json(app::config::trace_file) == false)
+			{
+				syslog(LOG_CRIT, "MINT_BILL: failed to write the trace file - "
+						 "filename %s, line number %d", __FILE__, __LINE__);
+			}
+#endif
 		}
 	}
 	catch (...)
@@ -124,6 +445,7 @@ int main(int argc, char** argv)
 mint_bill::mint_bill()
 {
 	this->database_password_dispatcher.connect(sigc::mem_fun(*this, &mint_bill::database_password_exist));
+	this->search_dispatcher.connect(sigc::mem_fun(*this, &mint_bill::search_exist));
 }
 
 bool mint_bill::create()
@@ -150,8 +472,21 @@ int mint_bill::launch(int argc, char** argv)
 
 void mint_bill::activate()
 {
-        Glib::RefPtr<Gtk::Builder> ui_builder{Gtk::Builder::create()};
-	if (ui_builder == nullptr)
+	this->activated = std::chrono::steady_clock::now();
+	this->database_password_future = std::async(std::launch::async, [this] () {
+		std::string password{""};
+		{
+			phase_timer timer{"keyring"};
+			feature::password_manager password_manager{app::config::password_manager_schema_name};
+			password = password_manager.lookup_password(app::config::password_number);
+		}
+		warm_start warm{open_database(password)};
+		this->database_password_dispatcher.emit();
+		return warm;
+	});
+
+        this->ui_builder = Gtk::Builder::create();
+	if (this->ui_builder == nullptr)
 	{
                 syslog(LOG_CRIT, "MINT_BILL: ui_builder is not valid - "
                                  "filename %s, line number %d", __FILE__, __LINE__);
@@ -159,14 +494,17 @@ void mint_bill::activate()
 	}
 	else
 	{
-
-		if (this->load_ui_file(ui_builder) == false)
 		{
-			syslog(LOG_CRIT, "MINT_BILL: failed to load the UI file - "
-					 "filename %s, line number %d", __FILE__, __LINE__);
-			return;
+			phase_timer timer{"ui file"};
+			if (this->load_ui_file(this->ui_builder) == false)
+			{
+				syslog(LOG_CRIT, "MINT_BILL: failed to load the UI file - "
+						 "filename %s, line number %d", __FILE__, __LINE__);
+				return;
+			}
 		}
 
+		phase_timer timer{"windows and controls"};
 		if (this->settings_setup() == false)
 		{
 			syslog(LOG_CRIT, "MINT_BILL: failed to set application settings - "
@@ -181,98 +519,128 @@ void mint_bill::activate()
 			return;
 		}
 
-		if (this->window_setup(ui_builder) == false)
+		if (this->window_setup(this->ui_builder) == false)
 		{
 			syslog(LOG_CRIT, "MINT_BILL: failed to setup the application windows - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
 
-		if (this->database_password_components_setup(ui_builder) == false)
+		if (this->database_password_components_setup(this->ui_builder) == false)
 		{
 			syslog(LOG_CRIT, "MINT_BILL: failed to setup the application windows - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
 
-		if (this->admin_page.create(ui_builder) == false)
+		if (this->print_button_setup(this->ui_builder) == false)
 		{
-			syslog(LOG_CRIT, "Failed to create the business page - "
+			syslog(LOG_CRIT, "Failed to setup the print button - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
 
-		if (this->client_register_page.create(ui_builder) == false)
+		if (this->email_button_setup(this->ui_builder) == false)
 		{
-			syslog(LOG_CRIT, "Failed to create the client registration page - "
+			syslog(LOG_CRIT, "Failed to setup the email button - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
 
-		if (this->invoice_page.create(ui_builder, this->mint_bill_window) == false)
+		if (this->save_button_setup(this->ui_builder) == false)
 		{
-			syslog(LOG_CRIT, "Failed to create the invoice page - "
+			syslog(LOG_CRIT, "Failed to setup the save button - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
 
-		if (this->statement_page.create(ui_builder, this->mint_bill_window) == false)
+		if (this->export_button_setup(this->ui_builder) == false)
 		{
-			syslog(LOG_CRIT, "Failed to create the statement page - "
+			syslog(LOG_CRIT, "Failed to setup the export button - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
 
-		if (this->print_button_setup(ui_builder) == false)
+		if (this->search_bar_setup(this->ui_builder) == false)
 		{
-			syslog(LOG_CRIT, "Failed to setup the print button - "
+			syslog(LOG_CRIT, "Failed to setup the search bar - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
 
-		if (this->email_button_setup(ui_builder) == false)
+		if (this->stack_setup(this->ui_builder) == false)
 		{
-			syslog(LOG_CRIT, "Failed to setup the email button - "
+			syslog(LOG_CRIT, "Failed to setup the stack - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
 
-		if (this->save_button_setup(ui_builder) == false)
+		if (this->page_setup(this->stack.current_page()) == false)
 		{
-			syslog(LOG_CRIT, "Failed to setup the save button - "
+			syslog(LOG_CRIT, "Failed to create the visible page - "
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			return;
 		}
+	}
+}
 
-		if (this->search_bar_setup(ui_builder) == false)
-		{
-			syslog(LOG_CRIT, "Failed to setup the search bar - "
-					 "filename %s, line number %d", __FILE__, __LINE__);
-			return;
-		}
+bool mint_bill::page_setup(const std::string& _stack_page_name)
+{
+	if (this->created_pages.contains(_stack_page_name) == true)
+	{
+		return true;
+	}
 
-		if (this->stack_setup(ui_builder) == false)
-		{
-			syslog(LOG_CRIT, "Failed to setup the stack - "
-					 "filename %s, line number %d", __FILE__, __LINE__);
-			return;
-		}
+	bool success{false};
+	phase_timer timer{_stack_page_name};
+	if (_stack_page_name == "admin-page")
+	{
+		success = this->admin_page.create(this->ui_builder);
+	}
+	else if (_stack_page_name == "register-page")
+	{
+		success = this->client_register_page.create(this->ui_builder);
 	}
+	else if (_stack_page_name == "invoice-page")
+	{
+		success = this->invoice_page.create(this->ui_builder, this->mint_bill_window);
+	}
+	else if (_stack_page_name == "statement-page")
+	{
+		success = this->statement_page.create(this->ui_builder, this->mint_bill_window);
+	}
+	else
+	{
+		syslog(LOG_CRIT, "MINT_BILL: the stack page is not known: %s", _stack_page_name.c_str());
+	}
+
+	if (success == false)
+	{
+		syslog(LOG_CRIT, "MINT_BILL: failed to create the page %s - "
+				 "filename %s, line number %d", _stack_page_name.c_str(), __FILE__, __LINE__);
+	}
+	else
+	{
+		this->created_pages.insert(_stack_page_name);
+	}
+
+	return success;
 }
 
 bool mint_bill::load_ui_file(const Glib::RefPtr<Gtk::Builder>& ui_builder)
 {
         bool verified{false};
-        try
+        const utility::resource ui_file{utility::resource_loader::instance().load(MINTBILL_UI_PATH)};
+        if (ui_file.is_valid() == false)
         {
-                verified = true;
-                ui_builder->add_from_file(MINTBILL_UI_PATH);
+                syslog(LOG_CRIT, "MINT_BILL: ui file loading - %s could not be loaded", MINTBILL_UI_PATH);
+                return verified;
         }
-        catch(const Glib::FileError& ex)
+
+        try
         {
-                std::string error_string{ex.what()};
-                syslog(LOG_CRIT, "MINT_BILL: ui file loading - %s", error_string.c_str());
-                return verified;
+                verified = true;
+                ui_builder->add_from_string(ui_file.view().data(), static_cast<gssize>(ui_file.view().size()));
         }
         catch(const Glib::MarkupError& ex)
         {
@@ -301,6 +669,11 @@ bool mint_bill::stack_setup(const Glib::RefPtr<Gtk::Builder>& _ui_builder)
 	else
 	{
 		success = this->stack.subscribe("search_bar", [this] (const std::string& _stack_page_name) {
+			if (this->page_setup(_stack_page_name) == false)
+			{
+				return false;
+			}
+
 			if (this->search_bar.update(_stack_page_name) == false)
 			{
 				syslog(LOG_CRIT, "MINT_BILL: failed to update the search_bar - "
@@ -584,6 +957,76 @@ bool mint_bill::save_button_setup(const Glib::RefPtr<Gtk::Builder>& _ui_builder)
 	return success;
 }
 
+bool mint_bill::export_button_setup(const Glib::RefPtr<Gtk::Builder>& _ui_builder)
+{
+	bool success{false};
+	if (this->export_button.create(_ui_builder) == false)
+	{
+		syslog(LOG_CRIT, "MINT_BILL: failed to create the export_button - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		if (this->export_button.enable() == false)
+		{
+			syslog(LOG_CRIT, "MINT_BILL: failed to enable the export_button - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+		else
+		{
+			success = this->export_button.subscribe([this] () {
+				if (this->database_password.empty() == true)
+				{
+					syslog(LOG_CRIT, "MINT_BILL: no database password to export with - "
+							 "filename %s, line number %d", __FILE__, __LINE__);
+					return false;
+				}
+				else if (this->export_future.valid() == true &&
+					 this->export_future.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+				{
+					syslog(LOG_INFO, "MINT_BILL: an export is already running");
+					return false;
+				}
+
+				const std::string directory{Glib::build_filename(
+					Glib::get_user_special_dir(Glib::UserDirectory::DOCUMENTS), app::config::export_directory)};
+				this->export_future = std::async(std::launch::async, [directory, password = this->database_password] () {
+					std::error_code error{};
+					std::filesystem::create_directories(directory, error);
+					model::exporter exporter{MINTBILL_DB_PATH, password};
+					bool success{exporter.is_available() == true && error.value() == 0};
+					std::size_t rows{0};
+					for (const model::export_kind kind : {model::export_kind::invoices, model::export_kind::labor,
+									      model::export_kind::statements})
+					{
+						std::ofstream file{std::filesystem::path{directory} /
+								   model::exporter::file_name("mint-bill", kind, model::export_format::csv),
+								   std::ios::binary | std::ios::trunc};
+						success = (success && file.is_open() &&
+							   exporter.write(file, kind, model::export_format::csv, model::export_filter{}, rows));
+					}
+
+					if (success == false)
+					{
+						syslog(LOG_CRIT, "MINT_BILL: failed to export the book - "
+								 "filename %s, line number %d", __FILE__, __LINE__);
+					}
+					else
+					{
+						syslog(LOG_INFO, "MINT_BILL: exported %zu rows to %s", rows, directory.c_str());
+					}
+
+					return success;
+				});
+
+				return true;
+			});
+		}
+	}
+
+	return success;
+}
+
 bool mint_bill::settings_setup()
 {
 	bool success{false};
@@ -615,8 +1058,14 @@ bool mint_bill::css_setup()
 	}
 	else
 	{
-		success = true;
-		css_provider->load_from_path(MINTBILL_CSS_PATH);
+		const utility::resource css_file{utility::resource_loader::instance().load(MINTBILL_CSS_PATH)};
+		success = css_file.is_valid();
+		if (success == false)
+		{
+			syslog(LOG_CRIT, "MINT_BILL: the css file %s could not be loaded - "
+					 "filename %s, line number %d", MINTBILL_CSS_PATH, __FILE__, __LINE__);
+		}
+		css_provider->load_from_string(std::string{css_file.view()});
 		Gtk::StyleContext::add_provider_for_display(
 			display,
 			css_provider,
@@ -644,12 +1093,6 @@ bool mint_bill::window_setup(const Glib::RefPtr<Gtk::Builder>& _ui_builder)
         else
         {
                 success = true;
-		this->database_password_future = std::move(std::async(std::launch::async, [this] () {
-			feature::password_manager password_manager{app::config::password_manager_schema_name};
-			std::string password{password_manager.lookup_password(app::config::password_number)};
-			this->database_password_dispatcher.emit();
-			return password;
-		}));
                 this->mint_bill_window->set_visible(true);
                 this->app->add_window(*this->mint_bill_window);
         }
@@ -683,23 +1126,58 @@ bool mint_bill::database_password_components_setup(const Glib::RefPtr<Gtk::Build
 void mint_bill::database_password_save_button_on_clicked()
 {
 	std::string password{this->database_password_entry->get_text()};
-	this->database_password_future = std::move(std::async(std::launch::async, [password, this] () {
+	this->database_password_future = std::async(std::launch::async, [password, this] () {
 		feature::password_manager password_manager{app::config::password_manager_schema_name};
 		std::string secret{""};
 		if (password_manager.store_password(password, app::config::password_number) == true)
 		{
 			secret = password_manager.lookup_password(app::config::password_number);
 		}
+		warm_start warm{open_database(secret)};
 		this->database_password_dispatcher.emit();
 
-		return secret;
-	}));
+		return warm;
+	});
+}
+
+warm_start mint_bill::open_database(const std::string& _password)
+{
+	warm_start warm{.password = _password};
+	if (_password.empty() == false)
+	{
+		phase_timer timer{"database"};
+		try
+		{
+			model::admin admin_model{MINTBILL_DB_PATH, _password};
+			warm.admin_data = std::any_cast<data::admin> (admin_model.load());
+			if (warm.admin_data.is_valid() == true)
+			{
+				model::cache::instance().store(MINTBILL_DB_PATH, model::entity::admin,
+							       warm.admin_data.get_name(), "",
+							       std::make_shared<const data::admin>(warm.admin_data),
+							       model::footprint(warm.admin_data));
+			}
+		}
+		catch (...)
+		{
+			syslog(LOG_CRIT, "MINT_BILL: failed to open the database - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+	}
+
+	return warm;
 }
 
 void mint_bill::database_password_exist()
 {
-	std::string password{this->database_password_future.get()};
-	if (password.empty() == true)
+	warm_start warm{this->database_password_future.get()};
+	const std::string& password{warm.password};
+	if (this->mint_bill_window == nullptr || this->database_password_window == nullptr)
+	{
+		syslog(LOG_CRIT, "MINT_BILL: the windows are not valid - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (password.empty() == true)
 	{
 		syslog(LOG_CRIT, "MINT_BILL: no database password exist - "
 				"filename %s, line number %d", __FILE__, __LINE__);
@@ -714,9 +1192,7 @@ void mint_bill::database_password_exist()
 	}
 	else
 	{
-		model::admin admin_model{MINTBILL_DB_PATH, password};
-		std::any data{admin_model.load()};
-		data::admin admin_data{std::any_cast<data::admin> (data)};
+		const data::admin& admin_data{warm.admin_data};
 		if (admin_data.is_valid() == false)
 		{
 			syslog(LOG_CRIT, "MINT_BILL: the admin data is not valid - "
@@ -761,6 +1237,52 @@ void mint_bill::database_password_exist()
 					"filename %s, line number %d", __FILE__, __LINE__);
 		}
 
+		this->database_password = password;
+		if (this->search_future.valid() == false)
+		{
+			this->search_future = std::async(std::launch::async, [password, this] () {
+				std::shared_ptr<model::search> search_model{nullptr};
+				try
+				{
+					phase_timer timer{"search"};
+					search_model = std::make_shared<model::search>(MINTBILL_DB_PATH, password);
+				}
+				catch (...)
+				{
+					syslog(LOG_CRIT, "MINT_BILL: failed to open the search index - "
+							 "filename %s, line number %d", __FILE__, __LINE__);
+				}
+				this->search_dispatcher.emit();
+
+				return search_model;
+			});
+		}
+
 		this->database_password_window->close();
 	}
+
+	if (this->interactive_reported == false)
+	{
+		this->interactive_reported = true;
+		long long elapsed{std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - this->activated).count()};
+		syslog(LOG_INFO, "MINT_BILL: interactive %lld us after activate", elapsed);
+	}
+}
+
+void mint_bill::search_exist()
+{
+	this->search = this->search_future.get();
+	if (this->search == nullptr || this->search->is_available() == false)
+	{
+		syslog(LOG_CRIT, "MINT_BILL: the search index is not available - "
+				"filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (this->search_bar.set_suggestion_source([this] (const std::string& _keyword) {
+			return this->search->suggest(_keyword, app::config::search_suggestions);
+		}) == false)
+	{
+		syslog(LOG_CRIT, "MINT_BILL: failed to set the search suggestion source - "
+				"filename %s, line number %d", __FILE__, __LINE__);
+	}
 }
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+################################################################################
+# File: compare.py
+# Description:
+#   Compares two JSON reports written by mint-bill-suite and fails when a
+#   tracked benchmark got slower than the allowed threshold.
+#
+# Usage:
+#   ./compare.py <baseline.json> <current.json> [--threshold PERCENT]
+#                [--metric median_ns|min_ns|max_ns] [--track REGEX ...]
+#
+#   --threshold  allowed slowdown in percent (default: 10)
+#   --metric     field compared per benchmark (default: median_ns)
+#   --track      only benchmarks whose name matches one of the regular
+#                expressions are tracked (default: every benchmark)
+#
+# Exit status:
+#   0  no tracked benchmark regressed
+#   1  a tracked benchmark regressed or is missing from the current report
+#   2  invalid arguments or unreadable reports
+################################################################################
+import argparse
+import json
+import re
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as report:
+        return {entry["name"]: entry for entry in json.load(report)["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two mint-bill-suite reports.")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0)
+    parser.add_argument("--metric", default="median_ns", choices=["median_ns", "min_ns", "max_ns"])
+    parser.add_argument("--track", action="append", default=[])
+    arguments = parser.parse_args()
+
+    try:
+        baseline = load(arguments.baseline)
+        current = load(arguments.current)
+    except (OSError, ValueError, KeyError) as error:
+        print(f"compare.py: {error}", file=sys.stderr)
+        return 2
+
+    tracked = [re.compile(pattern) for pattern in arguments.track]
+    failed = False
+    print(f"{'benchmark':<48} {'baseline':>14} {'current':>14} {'change':>9}")
+    for name, entry in sorted(baseline.items()):
+        if tracked and not any(pattern.search(name) for pattern in tracked):
+            continue
+
+        if name not in current:
+            print(f"{name:<48} {entry[arguments.metric]:>14.1f} {'missing':>14} {'':>9}  FAIL")
+            failed = True
+            continue
+
+        before = entry[arguments.metric]
+        after = current[name][arguments.metric]
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        verdict = ""
+        if change > arguments.threshold:
+            verdict = "  FAIL"
+            failed = True
+        print(f"{name:<48} {before:>14.1f} {after:>14.1f} {change:>+8.1f}%{verdict}")
+
+    for name in sorted(set(current) - set(baseline)):
+        print(f"{name:<48} {'new':>14} {current[name][arguments.metric]:>14.1f}")
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
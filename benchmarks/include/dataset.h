@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * @file dataset.h
+ *
+ * @brief Deterministic synthetic datasets for load-testing the database.
+ *
+ * @details
+ * Builds an encrypted SQLCipher database from `mint-bill-schema.sql` and
+ * fills it with generated records of a chosen shape:
+ *
+ *   • one admin business,
+ *   • `clients` client businesses,
+ *   • `statements_per_client` monthly statements per client, newest first
+ *     counting back from December 2025,
+ *   • `invoices_per_statement` invoices inside each statement period,
+ *   • `labor_per_invoice` labor lines per invoice, alternating description
+ *     and material lines.
+ *
+ * Every value (quantities, amounts, descriptions, paid status, days) comes
+ * from a splitmix64 stream seeded with `seed`, so the same shape and seed
+ * always produce the same rows on every platform. The defaults give 1,000
+ * clients and 1,008,000 labor lines.
+ *
+ * Client business names come from `client_name()`, so benchmarks and tests
+ * can address generated clients without reading the database first.
+ *******************************************************************************/
+#ifndef _DATASET_H_
+#define _DATASET_H_
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace bench {
+namespace dataset {
+struct shape {
+	std::size_t clients{1000};
+	std::size_t statements_per_client{12};
+	std::size_t invoices_per_statement{7};
+	std::size_t labor_per_invoice{12};
+	std::uint64_t seed{1};
+};
+
+struct totals {
+	std::size_t businesses{0};
+	std::size_t clients{0};
+	std::size_t statements{0};
+	std::size_t invoices{0};
+	std::size_t labor{0};
+};
+
+[[nodiscard]] std::string client_name(const std::size_t&);
+[[nodiscard]] bool generate(const std::string&, const std::string&, const std::string&,
+			    const shape&, totals&);
+}
+}
+#endif
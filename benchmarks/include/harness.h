@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * @file harness.h
+ *
+ * @brief Minimal timing harness for the micro-benchmark suite.
+ *
+ * @details
+ * `bench::harness::run()` measures one operation:
+ *
+ *   • The operation is repeated, doubling the count, until one sample takes
+ *     at least `min_sample_time`; that count is used for every sample.
+ *   • `samples` samples are taken; the median, minimum and maximum time per
+ *     operation are recorded.
+ *   • The operation returns a checksum that is accumulated so the compiler
+ *     cannot discard the work.
+ *
+ * Benchmarks whose name does not contain `filter` are skipped. `json()`
+ * renders every measurement in the format read by `benchmarks/compare.py`.
+ *******************************************************************************/
+#ifndef _HARNESS_H_
+#define _HARNESS_H_
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+namespace bench {
+struct options {
+	std::chrono::nanoseconds min_sample_time{std::chrono::milliseconds{20}};
+	std::size_t samples{7};
+	std::string filter{""};
+};
+
+struct measurement {
+	std::string name{""};
+	std::size_t iterations{0};
+	std::size_t samples{0};
+	double median_ns{0.0};
+	double min_ns{0.0};
+	double max_ns{0.0};
+};
+
+class harness {
+public:
+	harness() = delete;
+	explicit harness(const options&);
+	harness(const harness&) = delete;
+	harness(harness&&) = delete;
+	harness& operator= (const harness&) = delete;
+	harness& operator= (harness&&) = delete;
+	virtual ~harness() = default;
+
+	[[nodiscard]] virtual bool selected(const std::string&) const;
+	virtual void run(const std::string&, const std::function<std::size_t()>&);
+	[[nodiscard]] virtual std::string json() const;
+
+private:
+	[[nodiscard]] double sample(const std::function<std::size_t()>&, const std::size_t&);
+
+private:
+	options settings{};
+	std::vector<measurement> measurements{};
+	std::size_t checksum{0};
+};
+}
+#endif
@@ -0,0 +1,370 @@
+/*******************************************************************************
+ * @file dataset.cpp
+ *
+ * @brief Implementation of the deterministic synthetic dataset generator.
+ *
+ * @details
+ * The database file is created and keyed directly through SQLCipher, the
+ * schema script is executed as-is, and the connection is closed. The rows
+ * are then written through storage::database::sqlite, the same wrapper the
+ * models use, one transaction per client so a run of a million labor lines
+ * keeps its journal small.
+ *
+ * The full-text search triggers are dropped before the load and the search
+ * tables are filled in one pass afterwards, the way a bulk loader should;
+ * paying the triggers per row would make the load an order of magnitude
+ * slower.
+ *
+ * Identifiers are assigned explicitly in generation order (the admin
+ * business is business 1, client n is business n + 2), which keeps the
+ * output independent of SQLite's rowid allocation.
+ *******************************************************************************/
+#include <span>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <syslog.h>
+#include <filesystem>
+#include <file.h>
+#include <sqlite.h>
+#include <dataset.h>
+#include <search_model.h>
+
+namespace bench {
+namespace dataset {
+namespace {
+constexpr const char* business_insert{R"sql(
+	INSERT INTO business_details (business_id, business_name, email_address,
+				      contact_number, street, area_code, town_name)
+	VALUES (?, ?, ?, ?, ?, ?, ?);
+)sql"};
+
+constexpr const char* admin_insert{R"sql(
+	INSERT INTO admin (business_id, bank_name, branch_code, account_number,
+			   app_password, client_message)
+	VALUES (?, ?, ?, ?, ?, ?);
+)sql"};
+
+constexpr const char* client_insert{R"sql(
+	INSERT INTO client (client_id, business_id, vat_number, statement_schedule)
+	VALUES (?, ?, ?, ?);
+)sql"};
+
+constexpr const char* statement_insert{R"sql(
+	INSERT INTO statement (statement_id, business_id, period_start, period_end,
+			       statement_date, paid_status)
+	VALUES (?, ?, ?, ?, ?, ?);
+)sql"};
+
+constexpr const char* invoice_insert{R"sql(
+	INSERT INTO invoice (invoice_id, business_id, statement_id, order_number,
+			     job_card_number, date_created, paid_status,
+			     material_total, description_total, grand_total)
+	VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);
+)sql"};
+
+constexpr const char* labor_insert{R"sql(
+	INSERT INTO labor (labor_id, invoice_id, line_number, quantity, description,
+			   amount, is_description)
+	VALUES (?, ?, ?, ?, ?, ?, ?);
+)sql"};
+
+constexpr std::array<const char*, 12> words{
+	"Machining", "steel", "shaft", "to", "drawing", "revision",
+	"welding", "bracket", "replace", "bearing", "hydraulic", "pump"
+};
+
+class splitmix64 {
+public:
+	explicit splitmix64(const std::uint64_t& _seed) : state{_seed} {}
+
+	std::uint64_t next()
+	{
+		std::uint64_t value{this->state += 0x9e3779b97f4a7c15ULL};
+		value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+		return value ^ (value >> 31);
+	}
+
+	std::uint64_t between(const std::uint64_t& _low, const std::uint64_t& _high)
+	{
+		return _low + next() % (_high - _low + 1);
+	}
+
+private:
+	std::uint64_t state{0};
+};
+
+std::string date(const std::chrono::year_month_day& _date)
+{
+	std::ostringstream text{};
+	text << static_cast<unsigned>(_date.month()) << "-"
+	     << static_cast<unsigned>(_date.day()) << "-"
+	     << static_cast<int>(_date.year());
+	return text.str();
+}
+
+std::string money(const double& _amount)
+{
+	std::ostringstream text{};
+	text << std::fixed << std::setprecision(2) << _amount;
+	return text.str();
+}
+
+std::string description(splitmix64& _random)
+{
+	std::string text{};
+	const std::uint64_t length{_random.between(3, 8)};
+	for (std::uint64_t word{0}; word < length; ++word)
+	{
+		text += (word == 0 ? "" : " ");
+		text += words[_random.next() % words.size()];
+	}
+
+	return text;
+}
+
+sqlite3_int64 integer(const std::size_t& _value)
+{
+	return static_cast<sqlite3_int64> (_value);
+}
+
+bool create(const std::string& _path, const std::string& _password, const std::string& _schema)
+{
+	bool success{false};
+	sqlite3* database{nullptr};
+	if (sqlite3_open_v2(_path.c_str(), &database, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK)
+	{
+		syslog(LOG_CRIT, "DATASET: failed to create the database - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (sqlite3_key(database, _password.data(), static_cast<int> (_password.size())) != SQLITE_OK)
+	{
+		syslog(LOG_CRIT, "DATASET: failed to key the database - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (sqlite3_exec(database, _schema.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK)
+	{
+		syslog(LOG_CRIT, "DATASET: failed to apply the schema - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		success = true;
+	}
+	sqlite3_close_v2(database);
+
+	return success;
+}
+
+bool run(storage::database::sqlite& _database, std::span<const char* const> _statements)
+{
+	return std::ranges::all_of(_statements, [&_database] (const char* _statement) {
+		return _database.transaction(_statement);
+	});
+}
+
+bool fill_search(storage::database::sqlite& _database)
+{
+	bool success{_database.transaction("BEGIN IMMEDIATE;") &&
+		     run(_database, sql::query::search_index_create) &&
+		     run(_database, sql::query::search_index_clear) &&
+		     run(_database, sql::query::search_index_fill) &&
+		     _database.transaction("COMMIT;")};
+	if (success == false)
+	{
+		syslog(LOG_CRIT, "DATASET: failed to fill the search index - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		(void)_database.transaction("ROLLBACK;");
+	}
+
+	return success;
+}
+
+bool business(storage::database::sqlite& _database, const std::size_t& _id, const std::string& _name)
+{
+	return _database.usert(business_insert, {
+		integer(_id),
+		_name,
+		"business" + std::to_string(_id) + "@example.com",
+		"08" + std::to_string(10000000 + _id),
+		std::to_string(_id) + " Geelsterd",
+		std::to_string(6500 + _id % 100),
+		"George"
+	});
+}
+
+bool client(storage::database::sqlite& _database, const shape& _shape, const std::size_t& _index,
+	    splitmix64& _random, totals& _totals)
+{
+	const std::size_t business_id{_index + 2};
+	if (business(_database, business_id, client_name(_index)) == false ||
+	    _database.usert(client_insert, {
+		    integer(_index + 1),
+		    integer(business_id),
+		    "4" + std::to_string(100000000 + _index),
+		    std::to_string(_random.between(1, 4)) + "," + std::to_string(_random.between(1, 7))
+	    }) == false)
+	{
+		return false;
+	}
+	++_totals.businesses;
+	++_totals.clients;
+
+	const std::chrono::year_month newest{std::chrono::year{2025} / std::chrono::December};
+	for (std::size_t statement{0}; statement < _shape.statements_per_client; ++statement)
+	{
+		const std::chrono::year_month period{newest - std::chrono::months{static_cast<int> (statement)}};
+		const std::chrono::year_month_day last{period / std::chrono::last};
+		const std::size_t statement_id{_totals.statements + 1};
+		if (_database.usert(statement_insert, {
+				integer(statement_id),
+				integer(business_id),
+				date(period / std::chrono::day{1}),
+				date(last),
+				date(last),
+				_random.next() % 4 == 0 ? "Not Paid" : "Paid"
+			}) == false)
+		{
+			return false;
+		}
+		++_totals.statements;
+
+		for (std::size_t invoice{0}; invoice < _shape.invoices_per_statement; ++invoice)
+		{
+			const std::size_t invoice_id{_totals.invoices + 1};
+			double description_total{0.0};
+			double material_total{0.0};
+			std::vector<storage::database::sql_parameters> lines{};
+			lines.reserve(_shape.labor_per_invoice);
+			for (std::size_t line{0}; line < _shape.labor_per_invoice; ++line)
+			{
+				const bool is_description{line % 2 == 0};
+				const std::uint64_t quantity{_random.between(1, 9)};
+				const double amount{static_cast<double> (_random.between(100, 500000)) / 100.0};
+				(is_description ? description_total : material_total) += static_cast<double> (quantity) * amount;
+				lines.push_back({
+					integer(_totals.labor + line + 1),
+					integer(invoice_id),
+					integer(line / 2),
+					static_cast<sqlite3_int64> (quantity),
+					description(_random),
+					amount,
+					static_cast<sqlite3_int64> (is_description)
+				});
+			}
+
+			const std::chrono::year_month_day created{period / std::chrono::day{
+				static_cast<unsigned> (_random.between(1, 28))}};
+			if (_database.usert(invoice_insert, {
+					integer(invoice_id),
+					integer(business_id),
+					integer(statement_id),
+					"ORD-" + std::to_string(invoice_id),
+					"JC-" + std::to_string(invoice_id),
+					date(created),
+					_random.next() % 4 == 0 ? "Not Paid" : "Paid",
+					money(material_total),
+					money(description_total),
+					money(material_total + description_total)
+				}) == false)
+			{
+				return false;
+			}
+			++_totals.invoices;
+
+			for (const storage::database::sql_parameters& line : lines)
+			{
+				if (_database.usert(labor_insert, line) == false)
+				{
+					return false;
+				}
+				++_totals.labor;
+			}
+		}
+	}
+
+	return true;
+}
+}
+}
+}
+
+std::string bench::dataset::client_name(const std::size_t& _index)
+{
+	char name[32]{};
+	std::snprintf(name, sizeof(name), "Client %06zu", _index);
+	return name;
+}
+
+bool bench::dataset::generate(const std::string& _path, const std::string& _password, const std::string& _schema_path,
+			      const shape& _shape, totals& _totals)
+{
+	bool success{false};
+	_totals = totals{};
+	if (_path.empty() == true || _password.empty() == true || std::filesystem::exists(_path) == true)
+	{
+		syslog(LOG_CRIT, "DATASET: invalid arguments or the output already exists - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return success;
+	}
+
+	std::string schema{};
+	try
+	{
+		utility::file schema_file{_schema_path};
+		schema = schema_file.read();
+	}
+	catch (...)
+	{
+		syslog(LOG_CRIT, "DATASET: failed to read the schema - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return success;
+	}
+
+	if (create(_path, _password, schema) == false)
+	{
+		return success;
+	}
+
+	storage::database::sqlite database{_path, _password};
+	splitmix64 random{_shape.seed};
+	success = run(database, sql::query::search_triggers_drop) &&
+		  database.transaction("BEGIN IMMEDIATE;") &&
+		  business(database, 1, "Admin Business") &&
+		  database.usert(admin_insert, {
+			  integer(1),
+			  "Standard Bank",
+			  "043232",
+			  "0932443824",
+			  "bxwx eaku ndjj ltda",
+			  "Thank you for your support"
+		  }) &&
+		  database.transaction("COMMIT;");
+	if (success == true)
+	{
+		++_totals.businesses;
+	}
+
+	for (std::size_t index{0}; success == true && index < _shape.clients; ++index)
+	{
+		success = database.transaction("BEGIN IMMEDIATE;") &&
+			  client(database, _shape, index, random, _totals);
+		if (success == false)
+		{
+			syslog(LOG_CRIT, "DATASET: failed to write a client - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			(void)database.transaction("ROLLBACK;");
+		}
+		else
+		{
+			success = database.transaction("COMMIT;");
+		}
+	}
+
+	return success && fill_search(database);
+}
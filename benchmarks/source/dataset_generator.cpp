@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * @file dataset_generator.cpp
+ *
+ * @brief Command-line front end of the synthetic dataset generator.
+ *
+ * @details
+ * Usage:
+ *
+ *   mint-bill-dataset <output.db> <password> [options]
+ *
+ *     --schema <path>       schema script (default: mint-bill-schema.sql)
+ *     --clients <n>         client businesses (default: 1000)
+ *     --statements <n>      statements per client (default: 12)
+ *     --invoices <n>        invoices per statement (default: 7)
+ *     --labor <n>           labor lines per invoice (default: 12)
+ *     --seed <n>            generator seed (default: 1)
+ *
+ * The output file must not exist. On success the row counts and the time
+ * taken are printed and the exit code is EXIT_SUCCESS.
+ *******************************************************************************/
+#include <chrono>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <dataset.h>
+
+namespace bench {
+static bool parse(const int _argc, char** _argv, bench::dataset::shape& _shape, std::string& _schema)
+{
+	for (int index{3}; index + 1 < _argc; index += 2)
+	{
+		const std::string option{_argv[index]};
+		const std::string value{_argv[index + 1]};
+		try
+		{
+			if (option == "--schema")
+				_schema = value;
+			else if (option == "--clients")
+				_shape.clients = std::stoul(value);
+			else if (option == "--statements")
+				_shape.statements_per_client = std::stoul(value);
+			else if (option == "--invoices")
+				_shape.invoices_per_statement = std::stoul(value);
+			else if (option == "--labor")
+				_shape.labor_per_invoice = std::stoul(value);
+			else if (option == "--seed")
+				_shape.seed = std::stoull(value);
+			else
+				return false;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	return (_argc >= 3 && _argc % 2 == 1);
+}
+}
+
+int main(int argc, char** argv)
+{
+	bench::dataset::shape shape{};
+	std::string schema{"mint-bill-schema.sql"};
+	if (bench::parse(argc, argv, shape, schema) == false)
+	{
+		std::fprintf(stderr, "usage: %s <output.db> <password> [--schema path] [--clients n] "
+				     "[--statements n] [--invoices n] [--labor n] [--seed n]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	bench::dataset::totals totals{};
+	const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+	if (bench::dataset::generate(argv[1], argv[2], schema, shape, totals) == false)
+	{
+		std::fprintf(stderr, "failed to generate %s (it must not exist already)\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+
+	std::printf("%s: %zu businesses, %zu clients, %zu statements, %zu invoices, %zu labor lines "
+		    "(seed %llu) in %.1f s\n",
+		    argv[1], totals.businesses, totals.clients, totals.statements, totals.invoices,
+		    totals.labor, static_cast<unsigned long long> (shape.seed), elapsed.count());
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * @file harness.cpp
+ *
+ * @brief Implementation of the micro-benchmark timing harness.
+ *
+ * @details
+ * Samples are timed on the steady clock. Progress is printed to stderr as
+ * each benchmark finishes so stdout can carry the JSON report.
+ *******************************************************************************/
+#include <cstdio>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <harness.h>
+
+bench::harness::harness(const options& _settings)
+	: settings{_settings}
+{
+	if (this->settings.samples == 0)
+	{
+		this->settings.samples = 1;
+	}
+}
+
+bool bench::harness::selected(const std::string& _name) const
+{
+	return _name.find(this->settings.filter) != std::string::npos;
+}
+
+void bench::harness::run(const std::string& _name, const std::function<std::size_t()>& _operation)
+{
+	if (selected(_name) == false)
+	{
+		return;
+	}
+
+	std::size_t iterations{1};
+	const double min_sample_ns{static_cast<double> (this->settings.min_sample_time.count())};
+	while (sample(_operation, iterations) * static_cast<double> (iterations) < min_sample_ns)
+	{
+		iterations *= 2;
+	}
+
+	std::vector<double> per_operation{};
+	for (std::size_t index{0}; index < this->settings.samples; ++index)
+	{
+		per_operation.push_back(sample(_operation, iterations));
+	}
+	std::sort(per_operation.begin(), per_operation.end());
+
+	measurement result{
+		.name = _name,
+		.iterations = iterations,
+		.samples = per_operation.size(),
+		.median_ns = per_operation[per_operation.size() / 2],
+		.min_ns = per_operation.front(),
+		.max_ns = per_operation.back()
+	};
+	std::fprintf(stderr, "%-48s %14.1f ns/op  (%zu x %zu)\n",
+			result.name.c_str(), result.median_ns, result.samples, result.iterations);
+	this->measurements.push_back(std::move(result));
+}
+
+std::string bench::harness::json() const
+{
+	std::ostringstream out{};
+	out << std::fixed << std::setprecision(1);
+	out << "{\n\"checksum\": " << this->checksum << ",\n\"benchmarks\": [";
+	bool first{true};
+	for (const measurement& result : this->measurements)
+	{
+		out << (first ? "\n" : ",\n")
+		    << "  {\"name\": \"" << result.name << "\""
+		    << ", \"iterations\": " << result.iterations
+		    << ", \"samples\": " << result.samples
+		    << ", \"median_ns\": " << result.median_ns
+		    << ", \"min_ns\": " << result.min_ns
+		    << ", \"max_ns\": " << result.max_ns << "}";
+		first = false;
+	}
+	out << "\n]\n}\n";
+
+	return out.str();
+}
+
+double bench::harness::sample(const std::function<std::size_t()>& _operation, const std::size_t& _iterations)
+{
+	const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+	for (std::size_t index{0}; index < _iterations; ++index)
+	{
+		this->checksum += _operation();
+	}
+	const std::chrono::nanoseconds elapsed{std::chrono::steady_clock::now() - start};
+
+	return static_cast<double> (elapsed.count()) / static_cast<double> (_iterations);
+}
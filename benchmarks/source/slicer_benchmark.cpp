@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * @file slicer_benchmark.cpp
+ *
+ * @brief Micro-benchmark of the text slicers' heap allocations.
+ *
+ * @details
+ * Wraps a labor description with utility::boundary_slicer and splits a
+ * recipient list with utility::word_slicer three ways:
+ *
+ *   • legacy_path
+ *       - Reproduces the former slicers: a std::istringstream over a copy of
+ *         the text, a std::string per word, a mutex around every update of
+ *         the member buffer and a std::vector<std::string> returned by value.
+ *
+ *   • string_path
+ *       - The current slice(const std::string&), which still returns owned
+ *         strings for the callers that keep them.
+ *
+ *   • view_path
+ *       - The stateless next() / slice(std::string_view, std::span) form
+ *         writing std::string_view pieces into a stack buffer.
+ *
+ * Global operator new is replaced with a counting one, so each path reports
+ * the heap allocations it makes per call next to its mean wall time. The
+ * view path is expected to report zero.
+ *******************************************************************************/
+#include <new>
+#include <span>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string_view>
+#include <word_slicer.h>
+#include <boundary_slicer.h>
+
+namespace {
+	std::atomic<std::size_t> allocations{0};
+}
+
+void* operator new(std::size_t _size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer{std::malloc(_size == 0 ? 1 : _size)}; pointer != nullptr)
+	{
+		return pointer;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	std::free(_pointer);
+}
+
+void operator delete(void* _pointer, std::size_t) noexcept
+{
+	std::free(_pointer);
+}
+
+namespace bench {
+constexpr int iterations{100000};
+constexpr std::size_t width{40};
+
+const std::string description{"Machining a steel shaft to drawing revision 12, "
+			      "including the keyway, two circlip grooves and a "
+			      "hardened bearing seat, checked against the client's "
+			      "gauge before delivery to site"};
+const std::string recipients{"accounts@example.com orders@example.com "
+			     "workshop@example.com manager@example.com"};
+
+class legacy_boundary_slicer {
+public:
+	std::vector<std::string> slice(const std::string& _data)
+	{
+		this->sliced_data.clear();
+		this->current_line.clear();
+		std::string word{};
+		std::istringstream stream{_data};
+		while (stream >> word)
+		{
+			std::lock_guard<std::mutex> guard(this->data_mutex);
+			if (this->current_line.size() + word.size() + (this->current_line.empty() ? 0 : 1) <= width)
+			{
+				this->current_line += (this->current_line.empty() ? "" : " ") + word;
+			}
+			else
+			{
+				this->sliced_data.push_back(this->current_line);
+				this->current_line = word;
+			}
+		}
+		this->sliced_data.push_back(this->current_line);
+
+		return this->sliced_data;
+	}
+
+private:
+	std::mutex data_mutex{};
+	std::string current_line{""};
+	std::vector<std::string> sliced_data{};
+};
+
+class legacy_word_slicer {
+public:
+	std::vector<std::string> slice(const std::string& _data)
+	{
+		this->sliced_data.clear();
+		std::string word{""};
+		std::istringstream stream{_data};
+		while (stream >> word)
+		{
+			std::lock_guard<std::mutex> guard(this->data_mutex);
+			this->sliced_data.push_back(word);
+		}
+
+		return this->sliced_data;
+	}
+
+private:
+	std::mutex data_mutex{};
+	std::vector<std::string> sliced_data{""};
+};
+
+static std::size_t legacy_path()
+{
+	static legacy_boundary_slicer boundary{};
+	static legacy_word_slicer words{};
+	return boundary.slice(description).size() + words.slice(recipients).size();
+}
+
+static std::size_t string_path()
+{
+	static utility::boundary_slicer boundary{width};
+	static utility::word_slicer words{};
+	return boundary.slice(description).size() + words.slice(recipients).size();
+}
+
+static std::size_t view_path()
+{
+	static const utility::boundary_slicer boundary{width};
+	std::array<std::string_view, 16> lines{};
+	std::size_t pieces{boundary.slice(description, lines)};
+
+	std::string_view rest{recipients};
+	std::string_view word{};
+	while (utility::word_slicer::next(rest, word) == true)
+	{
+		++pieces;
+	}
+
+	return pieces;
+}
+
+template <typename path_type>
+static void run(const char* _name, path_type _path)
+{
+	std::size_t checksum{0};
+	const std::size_t before{allocations.load()};
+	auto start{std::chrono::steady_clock::now()};
+	for (int i = 0; i < iterations; ++i)
+	{
+		checksum += _path();
+	}
+	const std::chrono::nanoseconds elapsed{std::chrono::steady_clock::now() - start};
+	const std::size_t allocated{allocations.load() - before};
+
+	std::printf("%-12s allocs/op %8.2f  mean %10.1f ns  (checksum %zu)\n",
+			_name,
+			static_cast<double> (allocated) / iterations,
+			static_cast<double> (elapsed.count()) / iterations,
+			checksum);
+}
+}
+
+int main()
+{
+	std::printf("%zu byte description at width %zu, %zu byte recipient list, %d iterations\n",
+			bench::description.size(),
+			bench::width,
+			bench::recipients.size(),
+			bench::iterations);
+
+	bench::run("legacy_path", bench::legacy_path);
+	bench::run("string_path", bench::string_path);
+	bench::run("view_path", bench::view_path);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,470 @@
+/*******************************************************************************
+ * @file suite.cpp
+ *
+ * @brief Micro-benchmark suite over storage, serializers, models, PDFs and
+ *        utilities.
+ *
+ * @details
+ * Usage:
+ *
+ *   mint-bill-suite [--schema path] [--json path] [--filter text]
+ *                   [--samples n] [--min-time-ms n] [--work-dir path]
+ *
+ * The suite generates its own encrypted databases with bench::dataset into
+ * a scratch directory, one per model data size, and deletes them on exit:
+ *
+ *   • 12 statements × {1, 5, 25} invoices × 12 labor lines per client,
+ *     i.e. 12, 60 and 300 invoices per model load.
+ *
+ * Benchmarks (name → what one operation is):
+ *
+ *   storage.select.business          one parameterised SELECT round trip
+ *   storage.usert.business           one upsert round trip
+ *   serialize.<type>.extract_data    converting pre-fetched rows for business,
+ *                                    admin, client, invoice, labor, statement
+ *   model.invoice.load.cold/<n>      model::invoice::load with an empty cache
+ *   model.invoice.load.cached/<n>    model::invoice::load served by the cache
+ *   model.statement.load.cold/<n>    model::statement::load with an empty cache
+ *   model.statement.load.cached/<n>  model::statement::load served by the cache
+ *   report.<name>.cold               one aggregate report with an empty cache:
+ *                                    aged, revenue (a year), unpaid, top_clients
+ *   totals.verify                    model::totals::verify over every statement
+ *   search.find.business             model::search::find of a business name prefix
+ *   search.find.labor                model::search::find of labor description prefixes
+ *   pdf.invoice.generate             invoice_pdf::generate of one invoice
+ *   pdf.statement.generate           statement_pdf::generate of one statement
+ *   utility.boundary_slicer.slice    wrapping a long labor description
+ *   utility.word_slicer.slice        splitting a recipient list
+ *   utility.boundary_slicer.next     the same wrap into a stack span of views
+ *   utility.word_slicer.next         the same split as views, one at a time
+ *   utility.line_breaker.wrap.cold   wrapping the description on Courier advances
+ *   utility.line_breaker.wrap.cached the same wrap served from the memo table
+ *   utility.date_manager.compute_period_bounds
+ *   utility.calendar.compute_period_bounds.batch
+ *                                    the bounds of 5000 parsed client
+ *                                    schedules in one calendar call
+ *
+ * Human-readable progress goes to stderr; the JSON report goes to stdout or
+ * to the --json file and is what `benchmarks/compare.py` reads.
+ *******************************************************************************/
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdlib>
+#include <unistd.h>
+#include <filesystem>
+#include <string_view>
+#include <sqlite.h>
+#include <harness.h>
+#include <dataset.h>
+#include <word_slicer.h>
+#include <model_cache.h>
+#include <calendar.h>
+#include <date_manager.h>
+#include <line_breaker.h>
+#include <pdf_sink.h>
+#include <bundle_pdf.h>
+#include <invoice_pdf.h>
+#include <statement_pdf.h>
+#include <admin_serialize.h>
+#include <report_model.h>
+#include <search_model.h>
+#include <totals_model.h>
+#include <invoice_model.h>
+#include <client_serialize.h>
+#include <statement_model.h>
+#include <boundary_slicer.h>
+#include <invoice_serialize.h>
+#include <business_serialize.h>
+#include <statement_serialize.h>
+
+namespace bench {
+constexpr const char* password{"benchmark"};
+constexpr std::size_t statements_per_client{12};
+constexpr std::size_t labor_per_invoice{12};
+constexpr std::size_t invoice_sizes[]{1, 5, 25};
+
+struct settings {
+	options timing{};
+	std::string schema{"mint-bill-schema.sql"};
+	std::string json{""};
+	std::filesystem::path work_dir{std::filesystem::temp_directory_path() /
+				       ("mint-bill-bench-" + std::to_string(getpid()))};
+};
+
+struct fixture {
+	std::string path{""};
+	std::size_t invoices{0};
+};
+
+static bool parse(const int _argc, char** _argv, settings& _settings)
+{
+	for (int index{1}; index + 1 < _argc; index += 2)
+	{
+		const std::string option{_argv[index]};
+		const std::string value{_argv[index + 1]};
+		try
+		{
+			if (option == "--schema")
+				_settings.schema = value;
+			else if (option == "--json")
+				_settings.json = value;
+			else if (option == "--filter")
+				_settings.timing.filter = value;
+			else if (option == "--samples")
+				_settings.timing.samples = std::stoul(value);
+			else if (option == "--min-time-ms")
+				_settings.timing.min_sample_time = std::chrono::milliseconds{std::stoul(value)};
+			else if (option == "--work-dir")
+				_settings.work_dir = value;
+			else
+				return false;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	return (_argc % 2 == 1);
+}
+
+static bool prepare(const settings& _settings, std::vector<fixture>& _fixtures)
+{
+	std::error_code error{};
+	std::filesystem::create_directories(_settings.work_dir, error);
+	for (const std::size_t invoices : invoice_sizes)
+	{
+		dataset::shape shape{
+			.clients = 2,
+			.statements_per_client = statements_per_client,
+			.invoices_per_statement = invoices,
+			.labor_per_invoice = labor_per_invoice,
+			.seed = 1
+		};
+		dataset::totals totals{};
+		fixture current{
+			.path = (_settings.work_dir / ("bench-" + std::to_string(invoices) + ".db")).string(),
+			.invoices = statements_per_client * invoices
+		};
+		if (dataset::generate(current.path, password, _settings.schema, shape, totals) == false)
+		{
+			return false;
+		}
+		_fixtures.push_back(current);
+	}
+
+	return true;
+}
+
+static void cleanup(const settings& _settings, const std::vector<fixture>& _fixtures)
+{
+	std::error_code error{};
+	for (const fixture& current : _fixtures)
+	{
+		for (const char* suffix : {"", "-wal", "-shm"})
+		{
+			std::filesystem::remove(current.path + suffix, error);
+		}
+	}
+	std::filesystem::remove(_settings.work_dir, error);
+}
+
+static void storage_benchmarks(harness& _harness, const fixture& _fixture)
+{
+	storage::database::sqlite database{_fixture.path, password};
+	const storage::database::sql_parameters by_name{dataset::client_name(0)};
+	_harness.run("storage.select.business", [&] {
+		return database.select(sql::query::business_details_select, by_name).size();
+	});
+
+	const storage::database::part::rows business{database.select(sql::query::business_details_select, by_name)};
+	const storage::database::sql_parameters upsert(business.front().begin(), business.front().end());
+	_harness.run("storage.usert.business", [&] {
+		return static_cast<std::size_t> (database.usert(sql::query::business_details_usert, upsert));
+	});
+}
+
+static void serialize_benchmarks(harness& _harness, const fixture& _fixture)
+{
+	storage::database::sqlite database{_fixture.path, password};
+	const storage::database::sql_parameters by_name{dataset::client_name(0)};
+	const storage::database::part::rows business{database.select(sql::query::business_details_select, by_name)};
+	const storage::database::part::rows admin{database.select(sql::query::admin_no_name_select)};
+	const storage::database::part::rows client{database.select(sql::query::client_select, by_name)};
+	const storage::database::part::rows invoices{database.select(sql::query::invoice_select, by_name)};
+	const storage::database::part::rows statements{database.select(sql::query::statement_select, by_name)};
+	const storage::database::part::rows labor{database.select(sql::query::description_labor_select,
+								  {invoices.front()[1]})};
+
+	_harness.run("serialize.business.extract_data", [&] {
+		serialize::business serializer{};
+		return serializer.extract_data(business).has_value() ? std::size_t{1} : std::size_t{0};
+	});
+	_harness.run("serialize.admin.extract_data", [&] {
+		serialize::admin serializer{};
+		return serializer.extract_data(admin).has_value() ? std::size_t{1} : std::size_t{0};
+	});
+	_harness.run("serialize.client.extract_data", [&] {
+		serialize::client serializer{};
+		return serializer.extract_data(client).has_value() ? std::size_t{1} : std::size_t{0};
+	});
+	_harness.run("serialize.invoice.extract_data", [&] {
+		serialize::invoice serializer{};
+		return serializer.extract_data(invoices).size();
+	});
+	_harness.run("serialize.labor.extract_data", [&] {
+		serialize::labor serializer{};
+		return serializer.extract_data(labor).size();
+	});
+	_harness.run("serialize.statement.extract_data", [&] {
+		serialize::statement serializer{};
+		return serializer.extract_data(statements).size();
+	});
+}
+
+static void model_benchmarks(harness& _harness, const std::vector<fixture>& _fixtures)
+{
+	const std::string business_name{dataset::client_name(0)};
+	for (const fixture& current : _fixtures)
+	{
+		const std::string size{"/" + std::to_string(current.invoices)};
+		const model::invoice invoices{current.path, password};
+		const model::statement statements{current.path, password};
+		_harness.run("model.invoice.load.cold" + size, [&] {
+			model::cache::instance().clear();
+			return invoices.load(business_name)->size();
+		});
+		_harness.run("model.invoice.load.cached" + size, [&] {
+			return invoices.load(business_name)->size();
+		});
+		_harness.run("model.statement.load.cold" + size, [&] {
+			model::cache::instance().clear();
+			return statements.load(business_name)->size();
+		});
+		_harness.run("model.statement.load.cached" + size, [&] {
+			return statements.load(business_name)->size();
+		});
+	}
+	model::cache::instance().clear();
+}
+
+static void report_benchmarks(harness& _harness, const fixture& _fixture)
+{
+	if (_harness.selected("report.") == false)
+	{
+		return;
+	}
+
+	const model::report report{_fixture.path, password};
+	_harness.run("report.aged.cold", [&] {
+		model::cache::instance().clear();
+		return static_cast<std::size_t> (report.aged("2025-12-31").days_0_30_cents > 0);
+	});
+	_harness.run("report.revenue.cold", [&] {
+		model::cache::instance().clear();
+		return report.revenue("2025-01-01", "2025-12-31").size();
+	});
+	_harness.run("report.unpaid.cold", [&] {
+		model::cache::instance().clear();
+		return report.unpaid().size();
+	});
+	_harness.run("report.top_clients.cold", [&] {
+		model::cache::instance().clear();
+		return report.top_clients("2025-01-01", "2025-12-31", 10).size();
+	});
+	model::cache::instance().clear();
+}
+
+static void totals_benchmarks(harness& _harness, const fixture& _fixture)
+{
+	if (_harness.selected("totals.") == false)
+	{
+		return;
+	}
+
+	const model::totals totals{_fixture.path, password};
+	_harness.run("totals.verify", [&] {
+		return totals.verify().size();
+	});
+}
+
+static void search_benchmarks(harness& _harness, const fixture& _fixture)
+{
+	if (_harness.selected("search.") == false)
+	{
+		return;
+	}
+
+	const model::search search{_fixture.path, password};
+	_harness.run("search.find.business", [&] {
+		return search.find("cli", 10).size();
+	});
+	_harness.run("search.find.labor", [&] {
+		return search.find("weld brack", 10).size();
+	});
+}
+
+static void pdf_benchmarks(harness& _harness, const fixture& _fixture)
+{
+	if (_harness.selected("pdf.") == false)
+	{
+		return;
+	}
+
+	const std::string business_name{dataset::client_name(0)};
+	const model::documents<data::pdf_invoice> loaded_invoices{model::invoice{_fixture.path, password}.load(business_name)};
+	const model::documents<data::pdf_statement> loaded_statements{model::statement{_fixture.path, password}.load(business_name)};
+	const std::vector<data::pdf_invoice>& invoices{*loaded_invoices};
+	const std::vector<data::pdf_statement>& statements{*loaded_statements};
+	model::cache::instance().clear();
+
+	_harness.run("pdf.invoice.generate", [&] {
+		feature::invoice_pdf generator{};
+		return generator.generate(invoices.front()).size();
+	});
+	_harness.run("pdf.statement.generate", [&] {
+		feature::statement_pdf generator{};
+		return generator.generate(statements.front()).size();
+	});
+	_harness.run("pdf.invoice.generate.native", [&] {
+		feature::invoice_pdf generator{feature::pdf_backend::native};
+		return generator.generate(invoices.front()).size();
+	});
+	_harness.run("pdf.statement.generate.native", [&] {
+		feature::statement_pdf generator{feature::pdf_backend::native};
+		return generator.generate(statements.front()).size();
+	});
+	_harness.run("pdf.statement.generate.file", [&] {
+		feature::statement_pdf generator{};
+		feature::file_sink sink{"/dev/null"};
+		return generator.generate(statements.front(), sink) == true ? sink.written() : 0;
+	});
+	_harness.run("pdf.statement.email.separate", [&] {
+		feature::statement_pdf statement_generator{};
+		feature::invoice_pdf invoice_generator{};
+		std::size_t bytes{statement_generator.generate(statements.front()).size()};
+		for (const data::pdf_invoice& pdf_invoice : statements.front().get_pdf_invoices())
+		{
+			bytes += invoice_generator.generate(pdf_invoice).size();
+		}
+		return bytes;
+	});
+	_harness.run("pdf.statement.email.bundle", [&] {
+		feature::bundle_pdf generator{};
+		return generator.generate(statements.front()).size();
+	});
+	_harness.run("pdf.invoice.load.print", [&] {
+		const model::invoice invoice_model{_fixture.path, password};
+		const model::documents<data::pdf_invoice> loaded{invoice_model.load(business_name)};
+		return invoice_model.prepare_for_print(*loaded).size();
+	});
+	model::cache::instance().clear();
+}
+
+static void utility_benchmarks(harness& _harness)
+{
+	const std::string description{
+		"Machining steel shaft to drawing revision four, replace both bearings on the hydraulic pump, "
+		"weld the mounting bracket and re-align the drive coupling before the pressure test"};
+	const std::string recipients{
+		"accounts@example.com admin@example.com workshop@example.com "
+		"foreman@example.com director@example.com"};
+
+	_harness.run("utility.boundary_slicer.slice", [&] {
+		utility::boundary_slicer slicer{40};
+		return slicer.slice(description).size();
+	});
+	_harness.run("utility.word_slicer.slice", [&] {
+		utility::word_slicer slicer{};
+		return slicer.slice(recipients).size();
+	});
+	_harness.run("utility.boundary_slicer.next", [&] {
+		const utility::boundary_slicer slicer{40};
+		std::array<std::string_view, 16> lines{};
+		return slicer.slice(description, lines);
+	});
+	_harness.run("utility.word_slicer.next", [&] {
+		std::string_view rest{recipients};
+		std::string_view email{};
+		std::size_t count{0};
+		while (utility::word_slicer::next(rest, email) == true)
+		{
+			++count;
+		}
+		return count;
+	});
+	_harness.run("utility.line_breaker.wrap.cold", [&] {
+		utility::line_breaker breaker{};
+		feature::courier_metrics metrics{};
+		return breaker.wrap(description, 290.0, 12.0, metrics, utility::hyphenation::on).size();
+	});
+	utility::line_breaker cached{};
+	feature::courier_metrics cached_metrics{};
+	_harness.run("utility.line_breaker.wrap.cached", [&] {
+		return cached.wrap(description, 290.0, 12.0, cached_metrics, utility::hyphenation::on).size();
+	});
+	_harness.run("utility.date_manager.compute_period_bounds", [&] {
+		utility::date_manager date_manager{};
+		return date_manager.compute_period_bounds("4,5").period_start.size();
+	});
+	std::vector<utility::schedule> schedules{};
+	for (std::size_t client = 0; client < 5000; ++client)
+	{
+		schedules.push_back(utility::schedule{static_cast<std::uint8_t>(client % 4 + 1),
+						      static_cast<std::uint8_t>(client % 7 + 1)});
+	}
+	_harness.run("utility.calendar.compute_period_bounds.batch", [&] {
+		return utility::calendar::instance().compute_period_bounds(schedules).size();
+	});
+}
+}
+
+int main(int argc, char** argv)
+{
+	bench::settings settings{};
+	if (bench::parse(argc, argv, settings) == false)
+	{
+		std::fprintf(stderr, "usage: %s [--schema path] [--json path] [--filter text] "
+				     "[--samples n] [--min-time-ms n] [--work-dir path]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::vector<bench::fixture> fixtures{};
+	if (bench::prepare(settings, fixtures) == false)
+	{
+		std::fprintf(stderr, "failed to generate the benchmark databases from %s\n", settings.schema.c_str());
+		bench::cleanup(settings, fixtures);
+		return EXIT_FAILURE;
+	}
+
+	bench::harness harness{settings.timing};
+	bench::storage_benchmarks(harness, fixtures.back());
+	bench::serialize_benchmarks(harness, fixtures.back());
+	bench::model_benchmarks(harness, fixtures);
+	bench::report_benchmarks(harness, fixtures.back());
+	bench::totals_benchmarks(harness, fixtures.back());
+	bench::search_benchmarks(harness, fixtures.back());
+	bench::pdf_benchmarks(harness, fixtures[1]);
+	bench::utility_benchmarks(harness);
+	bench::cleanup(settings, fixtures);
+
+	if (settings.json.empty() == true)
+	{
+		std::fputs(harness.json().c_str(), stdout);
+	}
+	else
+	{
+		std::ofstream output{settings.json, std::ios::out | std::ios::trunc};
+		output << harness.json();
+		if (output.good() == false)
+		{
+			std::fprintf(stderr, "failed to write %s\n", settings.json.c_str());
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
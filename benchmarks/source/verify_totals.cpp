@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * @file verify_totals.cpp
+ *
+ * @brief Command-line check of the maintained statement totals.
+ *
+ * @details
+ * Usage:
+ *
+ *   mint-bill-verify <database.db> <password> [--repair]
+ *
+ * Recomputes every statement's invoice count, total and unpaid total from
+ * its invoices and prints the statements whose stored values differ, one
+ * line each. With --repair every statement is then recomputed and stored,
+ * and the check is run again.
+ *
+ * The exit code is EXIT_SUCCESS when no statement differs (after a repair,
+ * when one was asked for) and EXIT_FAILURE otherwise.
+ *******************************************************************************/
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <totals_model.h>
+
+namespace bench {
+static void print(const model::statement_total& _total)
+{
+	std::printf("%lld invoices, %lld cents, %lld unpaid", _total.invoices, _total.total_cents, _total.unpaid_cents);
+}
+
+static std::size_t report(const std::vector<model::total_drift>& _drifts)
+{
+	for (const model::total_drift& drift : _drifts)
+	{
+		std::printf("statement %lld: stored ", drift.statement_id);
+		print(drift.stored);
+		std::printf("; actual ");
+		print(drift.actual);
+		std::printf("\n");
+	}
+
+	return _drifts.size();
+}
+}
+
+int main(int argc, char** argv)
+{
+	const bool repair{argc == 4 && std::string{argv[3]} == "--repair"};
+	if (argc != 3 && repair == false)
+	{
+		std::fprintf(stderr, "usage: %s <database.db> <password> [--repair]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	model::totals totals{argv[1], argv[2]};
+	if (totals.is_available() == false)
+	{
+		std::fprintf(stderr, "failed to open %s or to prepare its statement totals\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	std::size_t drifted{bench::report(totals.verify())};
+	std::printf("%s: %zu statement(s) differ from their invoices\n", argv[1], drifted);
+	if (repair == true && drifted > 0)
+	{
+		if (totals.repair() == false)
+		{
+			std::fprintf(stderr, "failed to repair the statement totals\n");
+			return EXIT_FAILURE;
+		}
+
+		drifted = bench::report(totals.verify());
+		std::printf("%s: repaired, %zu statement(s) differ\n", argv[1], drifted);
+	}
+
+	return (drifted == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -55,7 +55,7 @@ public:
 	virtual void set_quantity(const unsigned int&);
 	[[nodiscard]] virtual unsigned int get_quantity() const;
 	virtual void set_description(const std::string&);
-	[[nodiscard]] virtual std::string get_description() const;
+	[[nodiscard]] virtual const std::string& get_description() const;
 	virtual void set_amount(const double&);
 	[[nodiscard]] virtual double get_amount() const;
 	virtual void set_row_number(const long long&);
@@ -70,9 +70,9 @@ public:
 	virtual void set_grand_total(const std::string&);
 	[[nodiscard]] std::string get_grand_total() const;
 	virtual void set_description_column(const std::vector<data::column>&);
-	[[nodiscard]] std::vector<data::column> get_description_column() const;
+	[[nodiscard]] const std::vector<data::column>& get_description_column() const;
 	virtual void set_material_column(const std::vector<data::column>&);
-	[[nodiscard]] std::vector<data::column> get_material_column() const;
+	[[nodiscard]] const std::vector<data::column>& get_material_column() const;
 
 private:
 	void set_flag(const int&);
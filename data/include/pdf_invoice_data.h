@@ -51,7 +51,7 @@ public:
 	virtual void set_client(const data::client&);
 	[[nodiscard]] virtual data::client get_client() const;
 	virtual void set_invoice(const data::invoice&);
-	[[nodiscard]] virtual data::invoice get_invoice() const;
+	[[nodiscard]] virtual const data::invoice& get_invoice() const;
 	virtual void set_business(const data::admin&);
 	[[nodiscard]] virtual data::admin get_business() const;
 
@@ -55,7 +55,7 @@ public:
 	virtual void set_statement(const data::statement&);
 	[[nodiscard]] virtual data::statement get_statement() const;
 	virtual void set_pdf_invoices(const std::vector<data::pdf_invoice>&);
-	[[nodiscard]] virtual std::vector<data::pdf_invoice> get_pdf_invoices() const;
+	[[nodiscard]] virtual const std::vector<data::pdf_invoice>& get_pdf_invoices() const;
 
 private:
 	void set_flag(const int&);
@@ -123,7 +123,7 @@ void data::column::set_description(const std::string& _description)
         }
 }
 
-std::string data::column::get_description() const
+const std::string& data::column::get_description() const
 {
         return this->description;
 }
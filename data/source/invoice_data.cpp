@@ -203,7 +203,7 @@ void data::invoice::set_description_column(const std::vector<data::column>& _col
         }
 }
 
-std::vector<data::column> data::invoice::get_description_column() const
+const std::vector<data::column>& data::invoice::get_description_column() const
 {
         return this->description_column;
 }
@@ -222,7 +222,7 @@ void data::invoice::set_material_column(const std::vector<data::column>& _column
         }
 }
 
-std::vector<data::column> data::invoice::get_material_column() const
+const std::vector<data::column>& data::invoice::get_material_column() const
 {
         return this->material_column;
 }
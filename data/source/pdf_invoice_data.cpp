@@ -106,7 +106,7 @@ void data::pdf_invoice::set_invoice(const data::invoice& _invoice)
         }
 }
 
-data::invoice data::pdf_invoice::get_invoice() const
+const data::invoice& data::pdf_invoice::get_invoice() const
 {
         return this->invoice;
 }
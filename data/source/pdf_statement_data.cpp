@@ -177,7 +177,7 @@ void data::pdf_statement::set_pdf_invoices(const std::vector<data::pdf_invoice>&
 	}
 }
 
-std::vector<data::pdf_invoice> data::pdf_statement::get_pdf_invoices() const
+const std::vector<data::pdf_invoice>& data::pdf_statement::get_pdf_invoices() const
 {
 	return this->pdf_invoices;
 }
@@ -6,11 +6,11 @@
  *   specifically the abstract `pdf` interface for generating PDF documents.
  *
  * @details
- *   This header defines `interface::pdf`, an abstract base class intended to
- *   standardize PDF generation functionality throughout the system.
- *   Implementations of this interface accept strongly typed data wrapped in
- *   `std::any`, allowing the caller to provide a wide range of structured
- *   inputs without tightly coupling this interface to any specific data type.
+ *   This header defines `interface::pdf<document_type>`, an abstract class
+ *   template intended to standardize PDF generation functionality throughout
+ *   the system. Implementations of this interface receive the document they
+ *   render by const reference, so the model → PDF hand-off never copies the
+ *   document graph.
  *
  *   Key characteristics of the design:
  *
@@ -18,14 +18,21 @@
  *       Allows multiple PDF generators (invoices, statements, summaries, etc.)
  *       to share a common API so they can be used interchangeably.
  *
- *     - **Type-Agnostic Input via `std::any`:**
- *       Supports flexible input structures while letting implementation classes
- *       perform strict type-checking internally.
+ *     - **Strongly Typed Input:**
+ *       Each generator is bound to its document type at compile time
+ *       (e.g. `interface::pdf<data::pdf_invoice>`), so a mismatched document
+ *       is a compile error rather than a `std::bad_any_cast` at runtime.
  *
  *     - **Ownership and Lifetime Safety:**
  *       Uses a virtual destructor to guarantee proper cleanup through
  *       base-class pointers.
  *
+ *     - **Streaming Output:**
+ *       `generate(document, sink)` writes the PDF into an `interface::pdf_sink`
+ *       as it is produced, so a batch can stream each document to a file,
+ *       memfd or pipe (see pdf_sink.h) without holding it in memory. The
+ *       string overload collects the same bytes in a buffer.
+ *
  *   This abstraction is part of the `features` layer, which encapsulates
  *   optional or pluggable functionality used by the GUI controllers and
  *   underlying data models.
@@ -33,26 +40,46 @@
  * @class interface::pdf
  *   @brief Abstract interface for PDF generation.
  *
- * @fn generate(const std::any&)
+ * @class interface::pdf_sink
+ *   @brief Destination of the PDF bytes; `write()` returns false when they
+ *          could not all be written, and `written()` counts the bytes it
+ *          has taken.
+ *
+ * @fn generate(const document_type&)
  *   @brief Produces a PDF based on the provided structured data.
  *   @return A `std::string` representing a file path, file name, or raw PDF
  *           content, depending on the implementation.
  *
+ * @fn generate(const document_type&, interface::pdf_sink&)
+ *   @brief Streams the PDF into the sink.
+ *   @return false when the document is not valid or the sink failed; the
+ *           sink may then hold part of a document.
+ *
  *****************************************************************************/
 #ifndef _FEATURES_H_
 #define _FEATURES_H_
-#include <any>
 #include <memory>
 #include <string>
+#include <cstddef>
 #include <vector>
 #include <email_data.h>
 
 namespace interface {
+class pdf_sink {
+public:
+	virtual ~pdf_sink() = default;
+
+	[[nodiscard]] virtual bool write(const char*, const std::size_t&) = 0;
+	[[nodiscard]] virtual std::size_t written() const = 0;
+};
+
+template <typename document_type>
 class pdf {
 public:
 	virtual ~pdf() = default;
 
-	[[nodiscard]] virtual std::string generate(const std::any&) = 0;
+	[[nodiscard]] virtual std::string generate(const document_type&) = 0;
+	[[nodiscard]] virtual bool generate(const document_type&, interface::pdf_sink&) = 0;
 };
 }
 #endif
@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * @file    bundle_pdf.h
+ *
+ * @brief
+ *   Declaration of the statement bundle generator.
+ *
+ * @details
+ *   `feature::bundle_pdf` renders a client's statements together with every
+ *   invoice they reference into a single PDF. Each statement section is
+ *   followed by a section per invoice:
+ *
+ *       statement 1, invoice 1.1, invoice 1.2, ..., statement 2, ...
+ *
+ *   The sections are laid out by `feature::statement_pdf::layout()` and
+ *   `feature::invoice_pdf::layout()`, so they paginate exactly like the
+ *   documents rendered on their own, and their pages are then drawn in one
+ *   pass: one surface, one font embedding and one set of stamp templates
+ *   for the whole bundle, instead of one per document. The email sent for
+ *   a statement then carries one attachment instead of one per document.
+ *
+ *   Like the other generators, the bundle can be streamed into an
+ *   `interface::pdf_sink` (see pdf_sink.h) instead of returned as a string.
+ *
+ *   The backend is selected as for the other generators (see pdf_writer.h);
+ *   with `feature::pdf_backend::native` a bundle holding text the writer
+ *   cannot encode is drawn through Cairo.
+ *
+ *   Error handling:
+ *     - Invalid statements are logged with syslog and left out of the
+ *       bundle. `generate()` returns an empty string when no section is
+ *       left, or when the surface reports an error; the sink overloads
+ *       return false.
+ *
+ *****************************************************************************/
+#ifndef _BUNDLE_PDF_H_
+#define _BUNDLE_PDF_H_
+#include <span>
+#include <string>
+#include <vector>
+#include <app_features.h>
+#include <pdf_layout.h>
+#include <pdf_emitter.h>
+#include <pdf_writer.h>
+#include <pdf_sink.h>
+#include <invoice_pdf.h>
+#include <statement_pdf.h>
+#include <pdf_statement_data.h>
+
+namespace feature {
+class bundle_pdf : public interface::pdf<data::pdf_statement> {
+public:
+	bundle_pdf();
+	explicit bundle_pdf(const feature::pdf_backend&);
+	bundle_pdf(const bundle_pdf&) = delete;
+	bundle_pdf(bundle_pdf&&) = delete;
+	bundle_pdf& operator = (const bundle_pdf&) = delete;
+	bundle_pdf& operator = (bundle_pdf&&) = delete;
+	virtual ~bundle_pdf() override;
+
+	[[nodiscard]] virtual std::string generate(const data::pdf_statement&) override;
+	[[nodiscard]] virtual std::string generate(std::span<const data::pdf_statement>);
+	[[nodiscard]] virtual bool generate(const data::pdf_statement&, interface::pdf_sink&) override;
+	[[nodiscard]] virtual bool generate(std::span<const data::pdf_statement>, interface::pdf_sink&);
+	[[nodiscard]] virtual std::vector<feature::page_layout> layout(std::span<const data::pdf_statement>,
+								       interface::text_metrics&);
+
+private:
+	feature::statement_pdf statement{};
+	feature::invoice_pdf invoice{};
+	feature::pdf_backend backend{feature::pdf_backend::cairo};
+	feature::pdf_emitter emitter{};
+	feature::pdf_writer writer{};
+	std::size_t last_size{0};
+};
+}
+#endif
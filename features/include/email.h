@@ -53,7 +53,7 @@
 #ifndef _EMAIL_H_
 #define _EMAIL_H_
 #include <string>
-#include <file.h>
+#include <resource_loader.h>
 #include <memory>
 #include <errors.h>
 #include <curl/curl.h>
@@ -117,7 +117,6 @@ namespace smtp {
 
                 private:
                         std::shared_ptr<CURL> curl;
-                        utility::word_slicer slicer{};
                         std::unique_ptr<struct curl_slist, decltype(&curl_slist_free_all)> headers{
                                 nullptr, curl_slist_free_all
                         };
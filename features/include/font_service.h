@@ -0,0 +1,95 @@
+/*****************************************************************************
+ * @file    font_service.h
+ *
+ * @brief
+ *   Process-wide font face and glyph metrics for the PDF generators.
+ *
+ * @details
+ *   The invoice and statement PDFs are set in the "monospace" toy face.
+ *   `feature::font_service` resolves that face once per process (the
+ *   fontconfig lookup `select_font_face()` used to repeat on every
+ *   generate() call) and hands it to the emitter with `face()`.
+ *
+ *   It is also the `interface::text_metrics` the layout pass measures with.
+ *   For each font size it keeps a Cairo scaled font and a table of glyph
+ *   metrics (ink bearing, ink width and advance). The printable ASCII glyphs
+ *   are measured when a size is first used, any other code point the first
+ *   time it is seen. A string is then measured by walking its glyphs through
+ *   the table, without a Cairo call, and the result matches
+ *   `get_text_extents()` on a PDF surface, which does not hint metrics.
+ *   `advance()` sums the glyph advances from the same table, which is what
+ *   `utility::line_breaker` wraps descriptions with.
+ *
+ *   Thread Safety:
+ *     - One mutex guards the tables; the generators may measure from several
+ *       threads at once.
+ *
+ *   Error Handling:
+ *     - A size whose scaled font cannot be created measures as empty extents
+ *       and is logged to syslog.
+ *
+ *****************************************************************************/
+#ifndef _FONT_SERVICE_H_
+#define _FONT_SERVICE_H_
+#include <map>
+#include <array>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <pdf_layout.h>
+#include <cairo/cairo.h>
+#include <cairomm/cairomm.h>
+
+namespace feature {
+struct glyph_metrics {
+	double x_bearing{0.0};
+	double width{0.0};
+	double x_advance{0.0};
+};
+
+struct font_statistics {
+	std::size_t sizes{0};
+	std::size_t glyphs{0};
+	std::uint64_t queries{0};
+};
+
+class font_service : public interface::text_metrics {
+public:
+	font_service(const font_service&) = delete;
+	font_service(font_service&&) = delete;
+	font_service& operator= (const font_service&) = delete;
+	font_service& operator= (font_service&&) = delete;
+	virtual ~font_service() override;
+
+	[[nodiscard]] static font_service& instance();
+
+	[[nodiscard]] virtual feature::text_extent measure(const std::string&, const double&) override;
+	[[nodiscard]] virtual double advance(std::string_view, const double&) override;
+	[[nodiscard]] virtual std::string font() const override;
+	[[nodiscard]] virtual Cairo::RefPtr<Cairo::FontFace> face() const;
+	[[nodiscard]] virtual font_statistics statistics() const;
+
+private:
+	font_service();
+
+	struct sized_font {
+		Cairo::RefPtr<Cairo::ScaledFont> font{};
+		std::array<feature::glyph_metrics, 128> ascii{};
+		std::unordered_map<char32_t, feature::glyph_metrics> others{};
+	};
+
+	[[nodiscard]] sized_font* font_at(const double&);
+	[[nodiscard]] feature::glyph_metrics glyph(sized_font&, const char32_t&);
+	[[nodiscard]] feature::glyph_metrics query(sized_font&, const char32_t&);
+
+private:
+	mutable std::mutex guard{};
+	Cairo::RefPtr<Cairo::ToyFontFace> font_face{};
+	Cairo::FontOptions options{};
+	std::map<double, sized_font> fonts{};
+	std::uint64_t queries{0};
+};
+}
+#endif
@@ -11,42 +11,46 @@
  *
  *   Responsibilities:
  *     - Accept a `data::pdf_invoice` aggregate (business, client, invoice).
- *     - Lay out invoice content using Cairo / cairomm on a PDF surface:
+ *     - Lay out invoice content into pages and draw them with Cairo / cairomm:
  *         * Document header (title and top-of-page layout).
  *         * Business and client information sections.
  *         * Invoice metadata (number, date, order number, job card).
  *         * Labor and material tables with quantities, descriptions, amounts.
  *         * Totals (labor, materials, and grand total).
  *         * Payment method and optional client message.
- *     - Expose a single `generate()` API that returns the final PDF as an
- *       in-memory string buffer suitable for email attachments or file I/O.
+ *     - Expose a `generate()` API that returns the final PDF as an in-memory
+ *       string buffer suitable for email attachments, and one that streams
+ *       it into an `interface::pdf_sink` (a file, memfd or pipe, see
+ *       pdf_sink.h) as it is drawn.
  *
  *   Layout and rendering details:
  *     - Uses fixed page dimensions (A4 in points: 595 x 842).
- *     - Provides helper methods for:
- *         * Text placement: left-aligned, centered, and right-aligned.
- *         * Section spacing, line drawing, and page-break handling.
- *         * Column layout for quantity / description / amount fields.
- *     - Uses `utility::boundary_slicer` to wrap long item descriptions over
- *       multiple lines without exceeding column boundaries.
+ *     - `layout()` lays the invoice out with `feature::pdf_layout` (see
+ *       pdf_layout.h) into positioned text runs and rules per page; it only
+ *       measures text, so pagination is known before anything is drawn and
+ *       the result can be cached, compared and tested on its own.
+ *     - `generate()` lays the invoice out with `feature::font_service` and hands
+ *       the pages to `feature::pdf_emitter`, which draws them.
+ *     - Constructed with `feature::pdf_backend::native`, `generate()` lays
+ *       the invoice out with `feature::courier_metrics` and writes it with
+ *       `feature::pdf_writer` (see pdf_writer.h) instead; text the writer
+ *       cannot encode sends the invoice through Cairo.
+ *     - Wraps long item descriptions over multiple lines with
+ *       `pdf_layout::wrap()`, which measures them with the same metrics the
+ *       layout places them with, so they stay inside the column at any size.
  *
  *   Concurrency and safety:
- *     - Maintains internal drawing state (`current_width`, `current_height`)
- *       protected by a `std::mutex` to guard against accidental concurrent
- *       access during rendering.
- *     - All drawing goes through `context_ok()` to verify the Cairo context
- *       remains in a valid state.
+ *     - The pen position lives in the `feature::pdf_layout` of each call,
+ *       not in the generator, so no drawing state is shared between calls.
  *
  *   Error handling:
- *     - `generate()` returns an empty string if any step fails (e.g., Cairo
- *       surface/context creation or rendering failure).
- *     - Helper methods return `bool` to allow early bail-out when layout or
- *       drawing operations fail.
+ *     - `generate()` returns an empty string (or false) if the invoice is
+ *       invalid, the Cairo surface reports an error while the pages are
+ *       drawn or the sink fails.
  *
  *****************************************************************************/
 #ifndef _INVOICE_PDF_H_
 #define _INVOICE_PDF_H_
-#include <mutex>
 #include <string>
 #include <vector>
 #include <ostream>
@@ -54,64 +58,48 @@
 #include <errors.h>
 #include <algorithm>
 #include <app_features.h>
-#include <cairo/cairo.h>
 #include <client_data.h>
 #include <invoice_data.h>
 #include <admin_data.h>
-#include <cairomm/cairomm.h>
-#include <boundary_slicer.h>
+#include <pdf_layout.h>
+#include <pdf_emitter.h>
+#include <pdf_writer.h>
+#include <pdf_sink.h>
+#include <font_service.h>
 #include <pdf_invoice_data.h>
 #include <poppler/cpp/poppler-document.h>
 
 namespace feature {
-class invoice_pdf : public interface::pdf {
+class invoice_pdf : public interface::pdf<data::pdf_invoice> {
 public:
 	invoice_pdf();
+	explicit invoice_pdf(const feature::pdf_backend&);
 	invoice_pdf(const invoice_pdf&) = delete;
 	invoice_pdf(invoice_pdf&&) = delete;
 	invoice_pdf& operator = (const invoice_pdf&) = delete;
 	invoice_pdf& operator = (invoice_pdf&&) = delete;
 	virtual ~invoice_pdf() override;
 
-	[[nodiscard]] virtual std::string generate(const std::any&) override;
+	[[nodiscard]] virtual std::string generate(const data::pdf_invoice&) override;
+	[[nodiscard]] virtual bool generate(const data::pdf_invoice&, interface::pdf_sink&) override;
+	[[nodiscard]] virtual std::vector<feature::page_layout> layout(const data::pdf_invoice&, interface::text_metrics&);
 
 private:
-	[[nodiscard]] bool add_header(const std::string&);
-	[[nodiscard]] bool add_information(const data::pdf_invoice&);
-	[[nodiscard]] bool add_invoice(const data::invoice&);
-	[[nodiscard]] bool add_labor(const data::invoice&);
-	[[nodiscard]] bool add_material(const data::invoice&);
-	[[nodiscard]] bool add_items(const std::vector<data::column>&);
-	[[nodiscard]] bool add_item_description(const data::column&);
-	[[nodiscard]] bool add_grand_total(const data::invoice&);
-	[[nodiscard]] bool add_payment_method(const data::admin&);
-	[[nodiscard]] bool write_to_pdf(const std::string&, const double&);
-	[[nodiscard]] bool write_to_pdf_in_center(const std::string&, const double&);
-	[[nodiscard]] bool write_to_pdf_from_right(const std::string&, const double&);
-	[[nodiscard]] bool write_to_pdf_from_right_information(const std::string&, const double&);
-	[[nodiscard]] bool draw_line();
-	[[nodiscard]] bool context_ok();
-	void add_new_line();
-	void add_new_section();
-	void align_to_left_border();
-	void align_to_right_border();
-	void align_information_section();
-	void align_to_top_border();
-	void align_to_right(const Cairo::TextExtents&);
-	void align_to_right_information(const Cairo::TextExtents&);
-	void align_to_center(const Cairo::TextExtents&);
-	void adjust_height();
-	void adjust_payment_height();
+	void add_header(feature::pdf_layout&, const std::string&);
+	void add_information(feature::pdf_layout&, const data::pdf_invoice&);
+	void add_invoice(feature::pdf_layout&, const data::invoice&);
+	void add_labor(feature::pdf_layout&, const data::invoice&);
+	void add_material(feature::pdf_layout&, const data::invoice&);
+	void add_items(feature::pdf_layout&, const std::vector<data::column>&);
+	void add_item_description(feature::pdf_layout&, const data::column&);
+	void add_grand_total(feature::pdf_layout&, const data::invoice&);
+	void add_payment_method(feature::pdf_layout&, const data::admin&);
 
 private:
-	const double width{595.0};
-	const double height{842.0};
-	double current_width{0.0};
-	double current_height{0.0};
-	Cairo::RefPtr<Cairo::PdfSurface> surface{};
-	Cairo::RefPtr<Cairo::Context> context{};
-	utility::boundary_slicer slicer{};
-	std::mutex pdf_mutex{};
+	feature::pdf_backend backend{feature::pdf_backend::cairo};
+	feature::pdf_emitter emitter{};
+	feature::pdf_writer writer{};
+	std::size_t last_size{0};
 };
 }
 #endif
@@ -0,0 +1,85 @@
+/*****************************************************************************
+ * @file    page_templates.h
+ *
+ * @brief
+ *   Per-thread cache of recorded page templates.
+ *
+ * @details
+ *   The parts of an invoice or statement that only depend on the business
+ *   and the layout (the title, the business address block, section titles,
+ *   the payment method footer) are laid out as stamps (see pdf_layout.h).
+ *   `feature::page_templates` draws each stamp once onto a Cairo recording
+ *   surface and keeps it under the stamp's key. The emitter then paints the
+ *   recording as a single pattern instead of drawing the strings one by one,
+ *   so a batch of documents for one business records them once.
+ *
+ *   A hit is only served when the stored runs equal the stamp's, so a key
+ *   that misses a field can cost a recording but never shows stale text.
+ *   The cache holds at most `capacity` templates and starts over when full.
+ *
+ *   Thread Safety:
+ *     - `instance()` returns the cache of the calling thread. Painting a
+ *       recording attaches snapshots to it, so a Cairo surface must not be
+ *       painted from two threads at once; with one cache per thread, the
+ *       documents the models generate in parallel each paint their own
+ *       recordings. `clear()` and `statistics()` apply to the calling
+ *       thread's cache only; the "pdf.template_hits" and
+ *       "pdf.template_misses" metrics count the lookups of every thread.
+ *       The models render a batch on a few workers (see the models'
+ *       render_batch.h), so each worker's cache serves many documents.
+ *
+ *   Error Handling:
+ *     - `find()` returns nullptr when the recording fails; the emitter then
+ *       draws the stamp's runs directly.
+ *
+ *****************************************************************************/
+#ifndef _PAGE_TEMPLATES_H_
+#define _PAGE_TEMPLATES_H_
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <pdf_layout.h>
+#include <cairo/cairo.h>
+#include <cairomm/cairomm.h>
+
+namespace feature {
+struct template_statistics {
+	std::uint64_t hits{0};
+	std::uint64_t misses{0};
+	std::size_t entries{0};
+};
+
+class page_templates {
+public:
+	page_templates(const page_templates&) = delete;
+	page_templates(page_templates&&) = delete;
+	page_templates& operator= (const page_templates&) = delete;
+	page_templates& operator= (page_templates&&) = delete;
+	virtual ~page_templates();
+
+	[[nodiscard]] static page_templates& instance();
+
+	[[nodiscard]] virtual Cairo::RefPtr<Cairo::RecordingSurface> find(const feature::stamp&);
+	virtual void clear();
+	[[nodiscard]] virtual template_statistics statistics() const;
+
+	static constexpr std::size_t capacity{256};
+
+private:
+	page_templates();
+
+	[[nodiscard]] Cairo::RefPtr<Cairo::RecordingSurface> record(const feature::stamp&);
+
+	struct entry {
+		std::vector<feature::text_run> runs{};
+		Cairo::RefPtr<Cairo::RecordingSurface> surface{};
+	};
+
+private:
+	std::unordered_map<std::string, entry> entries{};
+	std::uint64_t hits{0};
+	std::uint64_t misses{0};
+};
+}
+#endif
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * @file    pdf_emitter.h
+ *
+ * @brief
+ *   Cairo side of the two-pass PDF generation.
+ *
+ * @details
+ *   Declares `feature::pdf_emitter`, which draws the pages laid out by
+ *   `feature::pdf_layout` (see pdf_layout.h) onto a Cairo PDF surface whose
+ *   output goes straight into an `interface::pdf_sink` (see pdf_sink.h).
+ *   The string overload streams into a `feature::buffer_sink` reserved to
+ *   the size of the last document and moves its bytes out. The text is set
+ *   in the face resolved by `feature::font_service` (see font_service.h),
+ *   the same one the layout measured with.
+ *
+ *   Stamps are painted from the templates recorded by
+ *   `feature::page_templates` (see page_templates.h), translated to where
+ *   the page put them.
+ *
+ *   The emitter only draws what the layout placed; it takes any run of
+ *   pages, so a document can be emitted in parts.
+ *
+ *   Error handling:
+ *     - `emit()` returns an empty string, or false, when there is nothing to
+ *       draw, the surface reports an error or the sink fails.
+ *
+ *****************************************************************************/
+#ifndef _PDF_EMITTER_H_
+#define _PDF_EMITTER_H_
+#include <span>
+#include <string>
+#include <vector>
+#include <pdf_layout.h>
+#include <app_features.h>
+#include <cairo/cairo.h>
+#include <cairomm/cairomm.h>
+
+namespace feature {
+class pdf_emitter {
+public:
+	pdf_emitter();
+	pdf_emitter(const pdf_emitter&) = delete;
+	pdf_emitter(pdf_emitter&&) = delete;
+	pdf_emitter& operator= (const pdf_emitter&) = delete;
+	pdf_emitter& operator= (pdf_emitter&&) = delete;
+	virtual ~pdf_emitter();
+
+	[[nodiscard]] virtual std::string emit(std::span<const feature::page_layout>);
+	[[nodiscard]] virtual bool emit(std::span<const feature::page_layout>, interface::pdf_sink&);
+
+private:
+	void draw(const Cairo::RefPtr<Cairo::Context>&, const std::vector<feature::text_run>&, const double&);
+
+private:
+	std::size_t last_size{0};
+};
+}
+#endif
@@ -0,0 +1,178 @@
+/*****************************************************************************
+ * @file    pdf_layout.h
+ *
+ * @brief
+ *   Page layout shared by the invoice and statement PDF generators.
+ *
+ * @details
+ *   The PDF generators work in two passes. The layout pass, declared here,
+ *   turns a document into a flat list of pages, each holding the text runs
+ *   and rules it shows at their final positions. It only measures text, so
+ *   it is plain computation: the result can be compared, cached and tested
+ *   without a Cairo surface. The emit pass (see pdf_emitter.h) then draws
+ *   those pages.
+ *
+ *   Types:
+ *     - `feature::text_run`    : one string, its font size and its baseline
+ *                                origin.
+ *     - `feature::rule`        : one horizontal line and its width.
+ *     - `feature::stamp`       : runs that are the same on every document
+ *                                with the same key (business details,
+ *                                section titles), placed relative to an
+ *                                origin so the emitter can draw them from
+ *                                a recorded template (see page_templates.h).
+ *     - `feature::page_layout` : the runs, rules and stamps of one page.
+ *     - `interface::text_metrics` : measures a string at a font size; the
+ *       layout needs the ink extents to center and right-align text. It is
+ *       also the `interface::glyph_advances` (see line_breaker.h) the layout
+ *       wraps text with.
+ *
+ *   `feature::pdf_layout` is the cursor the generators lay a document out
+ *   with. It keeps the pen position, starts a new page when a line would run
+ *   into the bottom margin, and records every run and rule on the current
+ *   page:
+ *     - `write()`     : places a string on the current line; the placement
+ *                       sets the pen's x (left at the pen, centered,
+ *                       right-aligned, or in a statement column).
+ *     - `write_at()`  : places a string at a fixed point (the page title).
+ *     - `wrap()`      : breaks a string into lines no wider than a column,
+ *                       measured with the layout's metrics; the breaks are
+ *                       memoized by `utility::line_breaker::instance()`.
+ *     - `begin_stamp()`, `end_stamp()` : open and close a stamp; the
+ *                       key must name everything its runs are made of.
+ *     - `write_fixed()`, `write_fixed_at()` : as `write()` and `write_at()`,
+ *                       but into the open stamp. A page break inside a stamp
+ *                       turns what it holds into plain runs.
+ *     - `new_line()`, `new_section()`, `rule()` : advance the pen.
+ *     - `keep()`      : starts a new page unless the given height still fits.
+ *     - `finish()`    : hands the pages over and starts an empty document.
+ *
+ *   The page geometry is A4 in points (595 x 842) with a 60 point top and
+ *   bottom margin, the measures the generators have always used.
+ *
+ *****************************************************************************/
+#ifndef _PDF_LAYOUT_H_
+#define _PDF_LAYOUT_H_
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+#include <initializer_list>
+#include <line_breaker.h>
+
+namespace feature {
+enum class placement {
+	pen = 0,
+	center,
+	right,
+	right_information,
+	first_quarter,
+	second_quarter
+};
+
+struct text_extent {
+	double x_bearing{0.0};
+	double width{0.0};
+};
+
+struct text_run {
+	double x{0.0};
+	double y{0.0};
+	double size{0.0};
+	std::string text{""};
+
+	bool operator==(const text_run&) const = default;
+};
+
+struct rule {
+	double x_start{0.0};
+	double x_end{0.0};
+	double y{0.0};
+	double width{0.0};
+
+	bool operator==(const rule&) const = default;
+};
+
+struct stamp {
+	std::string key{""};
+	double y{0.0};
+	std::vector<feature::text_run> runs{};
+
+	bool operator==(const stamp&) const = default;
+};
+
+struct page_layout {
+	std::vector<feature::text_run> runs{};
+	std::vector<feature::rule> rules{};
+	std::vector<feature::stamp> stamps{};
+
+	bool operator==(const page_layout&) const = default;
+};
+}
+
+namespace interface {
+class text_metrics : public interface::glyph_advances {
+public:
+	virtual ~text_metrics() override = default;
+
+	[[nodiscard]] virtual feature::text_extent measure(const std::string&, const double&) = 0;
+};
+}
+
+namespace feature {
+namespace page {
+	constexpr double width{595.0};
+	constexpr double height{842.0};
+	constexpr double top_border{60.0};
+	constexpr double bottom_border{height - top_border};
+	constexpr double left_border{20.0};
+	constexpr double right_border{575.0};
+	constexpr double information_left{40.0};
+	constexpr double information_right{width - 40.0};
+	constexpr double text_offset{17.0};
+	constexpr double line_offset{10.0};
+	constexpr double space_offset{20.0};
+	constexpr double line_width{1.5};
+}
+
+class pdf_layout {
+public:
+	pdf_layout() = delete;
+	explicit pdf_layout(interface::text_metrics&);
+	pdf_layout(const pdf_layout&) = delete;
+	pdf_layout(pdf_layout&&) = delete;
+	pdf_layout& operator= (const pdf_layout&) = delete;
+	pdf_layout& operator= (pdf_layout&&) = delete;
+	virtual ~pdf_layout();
+
+	virtual void write(const std::string&, const double&, const feature::placement&);
+	virtual void write_at(const std::string&, const double&, const double&, const double&);
+	[[nodiscard]] virtual std::vector<std::string> wrap(const std::string&, const double&, const double&,
+							    const utility::hyphenation&);
+	virtual void begin_stamp(std::initializer_list<std::string_view>);
+	virtual void write_fixed(const std::string&, const double&, const feature::placement&);
+	virtual void write_fixed_at(const std::string&, const double&, const double&, const double&);
+	virtual void end_stamp();
+	virtual void new_line();
+	virtual void new_section();
+	virtual void rule();
+	virtual void keep(const double&);
+	virtual void align(const double&);
+	virtual void align_to_top();
+	[[nodiscard]] virtual double pen_x() const;
+	[[nodiscard]] virtual double pen_y() const;
+	[[nodiscard]] virtual std::vector<feature::page_layout> finish();
+
+private:
+	void place(const std::string&, const double&, const feature::placement&);
+	void new_page();
+
+private:
+	interface::text_metrics& metrics;
+	double x{page::left_border};
+	double y{page::top_border};
+	std::vector<feature::page_layout> document{1};
+	std::optional<feature::stamp> open_stamp{};
+};
+}
+#endif
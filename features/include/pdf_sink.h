@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * @file    pdf_sink.h
+ *
+ * @brief
+ *   Destinations the PDF generators stream their output into.
+ *
+ * @details
+ *   Implementations of `interface::pdf_sink` (see app_features.h):
+ *
+ *     - `feature::buffer_sink` : a growable buffer, reserved up front to the
+ *       expected document size. `take()` moves the bytes out without a copy.
+ *     - `feature::fd_sink`     : an open file descriptor the sink does not
+ *       own, e.g. a pipe, a socket or a `memfd_create()` descriptor. Short
+ *       writes and EINTR are retried until every byte is written.
+ *     - `feature::file_sink`   : a file the sink creates (or truncates) and
+ *       writes through an fd_sink. `close()` closes it and tells whether
+ *       that succeeded; a sink destroyed while still open closes the file
+ *       then. The file is created readable by the owner only, as it holds
+ *       client data.
+ *
+ *   A generator writes each chunk the moment Cairo or the native writer
+ *   produces it, so a document streamed into an fd_sink or file_sink is
+ *   never held in memory as a whole.
+ *
+ *   Error handling:
+ *     - `write()` returns false, and logs with syslog, when the descriptor
+ *       is not open or the write fails; the sink keeps what was written
+ *       before.
+ *     - `close()` returns false, and logs with syslog, when the file was
+ *       not open or closing it fails, e.g. when the file system reports a
+ *       delayed write error only then. A file that did not close cleanly
+ *       must be treated as not written. Writes after `close()` fail.
+ *
+ *****************************************************************************/
+#ifndef _PDF_SINK_H_
+#define _PDF_SINK_H_
+#include <string>
+#include <cstddef>
+#include <filesystem>
+#include <app_features.h>
+
+namespace feature {
+class buffer_sink : public interface::pdf_sink {
+public:
+	buffer_sink() = default;
+	explicit buffer_sink(const std::size_t&);
+	buffer_sink(const buffer_sink&) = delete;
+	buffer_sink(buffer_sink&&) = delete;
+	buffer_sink& operator= (const buffer_sink&) = delete;
+	buffer_sink& operator= (buffer_sink&&) = delete;
+	virtual ~buffer_sink() override;
+
+	[[nodiscard]] virtual bool write(const char*, const std::size_t&) override;
+	[[nodiscard]] virtual std::size_t written() const override;
+	[[nodiscard]] virtual std::string take();
+
+private:
+	std::string buffer{""};
+};
+
+class fd_sink : public interface::pdf_sink {
+public:
+	fd_sink() = delete;
+	explicit fd_sink(const int&);
+	fd_sink(const fd_sink&) = delete;
+	fd_sink(fd_sink&&) = delete;
+	fd_sink& operator= (const fd_sink&) = delete;
+	fd_sink& operator= (fd_sink&&) = delete;
+	virtual ~fd_sink() override;
+
+	[[nodiscard]] virtual bool write(const char*, const std::size_t&) override;
+	[[nodiscard]] virtual std::size_t written() const override;
+
+protected:
+	int descriptor{-1};
+	std::size_t count{0};
+};
+
+class file_sink : public fd_sink {
+public:
+	file_sink() = delete;
+	explicit file_sink(const std::filesystem::path&);
+	file_sink(const file_sink&) = delete;
+	file_sink(file_sink&&) = delete;
+	file_sink& operator= (const file_sink&) = delete;
+	file_sink& operator= (file_sink&&) = delete;
+	virtual ~file_sink() override;
+
+	[[nodiscard]] virtual bool is_open() const;
+	[[nodiscard]] virtual bool close();
+};
+}
+#endif
@@ -0,0 +1,107 @@
+/*****************************************************************************
+ * @file    pdf_writer.h
+ *
+ * @brief
+ *   Native PDF backend for the text-only invoice and statement documents.
+ *
+ * @details
+ *   The documents are monospace text and horizontal rules, so they do not
+ *   need a Cairo surface. `feature::pdf_writer` writes the PDF objects of
+ *   laid out pages (see pdf_layout.h) directly:
+ *
+ *     - One font resource, the standard Courier face in WinAnsiEncoding,
+ *       shared by every page. Viewers provide the standard fonts, so nothing
+ *       is embedded or subset per document.
+ *     - One shared resource dictionary; each distinct stamp becomes a form
+ *       XObject written once and drawn wherever a page places it.
+ *     - Content streams built in a buffer the writer keeps between
+ *       documents, and an xref table written in the same pass as the
+ *       objects.
+ *     - Output streamed into an `interface::pdf_sink` (see pdf_sink.h) one
+ *       page's objects at a time.
+ *
+ *   `feature::courier_metrics` measures text for the layout pass with the
+ *   fixed Courier advance of 600 units per em, so text is centered and
+ *   right-aligned for the face the writer draws with, and descriptions are
+ *   wrapped for it.
+ *
+ *   The generators select a backend with `feature::pdf_backend` when they
+ *   are constructed (see invoice_pdf.h and statement_pdf.h). The models
+ *   construct them with `configured_pdf_backend()`, which reads the
+ *   `MINTBILL_PDF_BACKEND` environment variable: "native" selects this
+ *   backend, and anything else, or no value, selects Cairo.
+ *
+ *   Error handling:
+ *     - `encodable()` tells whether all text of the pages has a WinAnsi
+ *       code. `write()` returns an empty string (or false) otherwise, or
+ *       when there are no pages; the generators then use the Cairo backend.
+ *       It also returns false when the sink fails.
+ *
+ *****************************************************************************/
+#ifndef _PDF_WRITER_H_
+#define _PDF_WRITER_H_
+#include <span>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <pdf_layout.h>
+#include <app_features.h>
+
+namespace feature {
+enum class pdf_backend {
+	cairo = 0,
+	native
+};
+
+constexpr const char *pdf_backend_variable{"MINTBILL_PDF_BACKEND"};
+
+[[nodiscard]] feature::pdf_backend parse_pdf_backend(std::string_view);
+[[nodiscard]] feature::pdf_backend configured_pdf_backend();
+
+class courier_metrics : public interface::text_metrics {
+public:
+	courier_metrics() = default;
+	courier_metrics(const courier_metrics&) = delete;
+	courier_metrics(courier_metrics&&) = delete;
+	courier_metrics& operator= (const courier_metrics&) = delete;
+	courier_metrics& operator= (courier_metrics&&) = delete;
+	virtual ~courier_metrics() override = default;
+
+	[[nodiscard]] virtual feature::text_extent measure(const std::string&, const double&) override;
+	[[nodiscard]] virtual double advance(std::string_view, const double&) override;
+	[[nodiscard]] virtual std::string font() const override;
+
+	static constexpr double em_advance{0.6};
+};
+
+class pdf_writer {
+public:
+	pdf_writer();
+	pdf_writer(const pdf_writer&) = delete;
+	pdf_writer(pdf_writer&&) = delete;
+	pdf_writer& operator= (const pdf_writer&) = delete;
+	pdf_writer& operator= (pdf_writer&&) = delete;
+	virtual ~pdf_writer();
+
+	[[nodiscard]] virtual bool encodable(std::span<const feature::page_layout>) const;
+	[[nodiscard]] virtual std::string write(std::span<const feature::page_layout>);
+	[[nodiscard]] virtual bool write(std::span<const feature::page_layout>, interface::pdf_sink&);
+
+private:
+	void begin_object(const std::size_t&);
+	void write_stream(const std::size_t&, const std::string&, const std::string&);
+	[[nodiscard]] bool flush(interface::pdf_sink&);
+	void add_runs(const std::vector<feature::text_run>&, const double&);
+	void add_rules(const std::vector<feature::rule>&);
+	void add_number(std::string&, const double&);
+
+private:
+	std::string chunk{""};
+	std::string content{""};
+	std::string encoded{""};
+	std::vector<std::size_t> offsets{};
+	std::size_t flushed{0};
+	std::size_t last_size{0};
+};
+}
+#endif
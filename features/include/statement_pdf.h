@@ -16,106 +16,93 @@
  *  - Integrate with application data models (client, admin, pdf_statement).
  *
  * Overview of Responsibilities:
- *  - Render PDF headers, metadata blocks, invoice tables, and totals.
+ *  - Lay out PDF headers, metadata blocks, invoice tables, and totals into
+ *    pages of positioned text runs and rules (see pdf_layout.h).
  *  - Format all textual sections using configurable font sizes and alignment
- *    routines (left, center, right, first/second quarter).
- *  - Create table-like structures using Cairo drawing primitives.
+ *    placements (left, center, right, first/second quarter).
  *  - Manage pagination and spatial constraints to avoid visual overflow.
  *
  * Thread Safety:
- *  - A mutex ensures synchronized updates to PDF cursor positions during write
- *    operations, preventing inconsistent layout in multi-threaded contexts.
+ *  - The pen position lives in the `feature::pdf_layout` of each call, so no
+ *    drawing state is shared between calls.
  *
  * Public API:
- *  - std::string generate(const std::any&)
+ *  - std::string generate(const data::pdf_statement&)
  *      Converts a data::pdf_statement into a fully rendered PDF stored in memory
- *      and returned as a binary string. Handles validation, surface creation,
- *      context setup, and full layout execution.
+ *      and returned as a binary string: validates it, lays it out with
+ *      feature::font_service and draws the pages with `feature::pdf_emitter`.
+ *      With the feature::pdf_backend::native backend it uses
+ *      feature::courier_metrics and feature::pdf_writer instead, unless the
+ *      statement holds text the writer cannot encode. The buffer is reserved
+ *      to the size of the previous statement.
+ *
+ *  - bool generate(const data::pdf_statement&, interface::pdf_sink&)
+ *      Streams the same PDF into a sink (see pdf_sink.h) as it is drawn, so
+ *      a batch can write statements to disk without holding them in memory.
+ *
+ *  - std::vector<feature::page_layout> layout(const data::pdf_statement&,
+ *                                             interface::text_metrics&)
+ *      The layout pass on its own. It only measures text, so the pages of a
+ *      statement are known before any is drawn, and can be cached, compared
+ *      and emitted in parts.
  *
  * Internal Helpers:
  *  - add_header(), add_information(), add_statement_information(),
  *    add_statements(), add_items(), add_grand_total(), add_payment_method()
- *      These methods draw specific document sections.
- *
- *  - write_to_pdf(), write_to_pdf_in_first_quarter(), write_to_pdf_in_center(),
- *    write_to_pdf_in_second_quarter(), write_to_pdf_from_right(), etc.
- *      Handle positioning, text rendering, and formatting for each section.
- *
- *  - align_to_*(...) and adjust_height()/adjust_payment_height()
- *      Manage layout flow and prevent clipping across PDF pages.
+ *      These methods lay out specific document sections.
  *
  * Error Handling:
  *  - Invalid data triggers syslog messages and aborts PDF generation.
- *  - Failures at any rendering stage cause early termination with an empty PDF.
+ *  - A surface error while the pages are drawn, or a failed sink, yields an
+ *    empty PDF (or false).
  *
  ******************************************************************************/
 #ifndef _STATEMENT_PDF_H_
 #define _STATEMENT_PDF_H_
-#include <mutex>
 #include <string>
 #include <vector>
 #include <syslog.h>
 #include <app_features.h>
-#include <cairo/cairo.h>
 #include <client_data.h>
 #include <invoice_data.h>
 #include <admin_data.h>
-#include <cairomm/cairomm.h>
-#include <boundary_slicer.h>
+#include <pdf_layout.h>
+#include <pdf_emitter.h>
+#include <pdf_writer.h>
+#include <pdf_sink.h>
+#include <font_service.h>
 #include <pdf_statement_data.h>
 #include <poppler/cpp/poppler-document.h>
 
 namespace feature {
-class statement_pdf : public interface::pdf {
+class statement_pdf : public interface::pdf<data::pdf_statement> {
 public:
 	statement_pdf();
+	explicit statement_pdf(const feature::pdf_backend&);
 	statement_pdf(const statement_pdf&) = delete;
 	statement_pdf(statement_pdf&&) = delete;
 	statement_pdf& operator = (const statement_pdf&) = delete;
 	statement_pdf& operator = (statement_pdf&&) = delete;
 	virtual ~statement_pdf() override;
 
-	[[nodiscard]] std::string generate(const std::any&) override;
+	[[nodiscard]] std::string generate(const data::pdf_statement&) override;
+	[[nodiscard]] bool generate(const data::pdf_statement&, interface::pdf_sink&) override;
+	[[nodiscard]] virtual std::vector<feature::page_layout> layout(const data::pdf_statement&, interface::text_metrics&);
 
 private:
-	[[nodiscard]] bool add_header(const std::string&);
-	[[nodiscard]] bool add_information(const data::client&, const data::admin&);
-	[[nodiscard]] bool add_statement_information(const data::pdf_statement&);
-	[[nodiscard]] bool add_statements(const data::pdf_statement&);
-	[[nodiscard]] bool add_items(const std::vector<data::pdf_invoice>&);
-	[[nodiscard]] bool add_grand_total(const data::pdf_statement&);
-	[[nodiscard]] bool add_payment_method(const data::admin&);
-	[[nodiscard]] bool write_to_pdf(const std::string&, const double&);
-	[[nodiscard]] bool write_to_pdf_in_first_quarter(const std::string&, const double&);
-	[[nodiscard]] bool write_to_pdf_in_center(const std::string&, const double&);
-	[[nodiscard]] bool write_to_pdf_in_second_quarter(const std::string&, const double&);
-	[[nodiscard]] bool write_to_pdf_from_right(const std::string&, const double&);
-	[[nodiscard]] bool write_to_pdf_from_right_information(const std::string&, const double&);
-	[[nodiscard]] bool draw_line();
-	[[nodiscard]] bool context_ok();
-	void add_new_line();
-	void add_new_section();
-	void align_to_left_border();
-	void align_to_right_border();
-	void align_information_section();
-	void align_to_top_border();
-	void align_to_right(const Cairo::TextExtents&);
-	void align_to_right_information(const Cairo::TextExtents&);
-	void align_to_first_quarter(const Cairo::TextExtents&);
-	void align_to_center(const Cairo::TextExtents&);
-	void align_to_second_quarter(const Cairo::TextExtents&);
-	void adjust_height();
-	void adjust_payment_height();
+	void add_header(feature::pdf_layout&, const std::string&);
+	void add_information(feature::pdf_layout&, const data::client&, const data::admin&);
+	void add_statement_information(feature::pdf_layout&, const data::pdf_statement&);
+	void add_statements(feature::pdf_layout&, const data::pdf_statement&);
+	void add_items(feature::pdf_layout&, const std::vector<data::pdf_invoice>&);
+	void add_grand_total(feature::pdf_layout&, const data::pdf_statement&);
+	void add_payment_method(feature::pdf_layout&, const data::admin&);
 
 private:
-	const double width{595.0};
-	const double height{842.0};
-	double current_width{0.0};
-	double current_height{0.0};
-	Cairo::RefPtr<Cairo::PdfSurface> surface{};
-	Cairo::RefPtr<Cairo::Context> context{};
-	utility::boundary_slicer slicer{15};
-	std::mutex pdf_mutex{};
+	feature::pdf_backend backend{feature::pdf_backend::cairo};
+	feature::pdf_emitter emitter{};
+	feature::pdf_writer writer{};
+	std::size_t last_size{0};
 };
 }
 #endif
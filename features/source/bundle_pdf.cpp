@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * @file    bundle_pdf.cpp
+ *
+ * @brief
+ *   Implementation of the statement bundle generator.
+ *
+ * @details
+ *   `layout()` appends the pages of every section in order; the sections
+ *   keep their own pagination, so each starts on a fresh page. `generate()`
+ *   hands all the pages to one `feature::pdf_emitter::emit()` call (or one
+ *   `feature::pdf_writer::write()` call), which is where the per-document
+ *   surface, font embedding and template lookups are saved.
+ *
+ *****************************************************************************/
+#include <bundle_pdf.h>
+#include <iterator>
+#include <syslog.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::counter& rendered{utility::metrics::counter_named("pdf.bundles_rendered")};
+	utility::metrics::counter& rendered_bytes{utility::metrics::counter_named("pdf.bytes")};
+	utility::metrics::histogram& render_time{utility::metrics::histogram_named("pdf.render_ns")};
+}
+
+
+feature::bundle_pdf::bundle_pdf() {}
+
+feature::bundle_pdf::bundle_pdf(const feature::pdf_backend& _backend) : backend{_backend} {}
+
+feature::bundle_pdf::~bundle_pdf() {}
+
+std::string feature::bundle_pdf::generate(const data::pdf_statement& _data)
+{
+	return generate(std::span<const data::pdf_statement>{&_data, 1});
+}
+
+std::string feature::bundle_pdf::generate(std::span<const data::pdf_statement> _data)
+{
+	feature::buffer_sink sink{this->last_size};
+	if (generate(_data, sink) == false)
+	{
+		return "";
+	}
+	this->last_size = sink.written();
+
+	return sink.take();
+}
+
+bool feature::bundle_pdf::generate(const data::pdf_statement& _data, interface::pdf_sink& _sink)
+{
+	return generate(std::span<const data::pdf_statement>{&_data, 1}, _sink);
+}
+
+bool feature::bundle_pdf::generate(std::span<const data::pdf_statement> _data, interface::pdf_sink& _sink)
+{
+	TRACE_SPAN("feature", "bundle_pdf::generate");
+	utility::metrics::timer render_timer{render_time};
+	const std::size_t start{_sink.written()};
+	bool success{false};
+	std::vector<feature::page_layout> pages{};
+	if (this->backend == feature::pdf_backend::native)
+	{
+		feature::courier_metrics metrics{};
+		pages = layout(_data, metrics);
+	}
+
+	if (pages.empty() == false && this->writer.encodable(pages) == true)
+	{
+		success = this->writer.write(pages, _sink);
+	}
+	else
+	{
+		success = this->emitter.emit(layout(_data, feature::font_service::instance()), _sink);
+	}
+
+	if (success == true)
+	{
+		rendered.add();
+		rendered_bytes.add(_sink.written() - start);
+	}
+
+	return success;
+}
+
+std::vector<feature::page_layout> feature::bundle_pdf::layout(std::span<const data::pdf_statement> _data,
+							       interface::text_metrics& _metrics)
+{
+	TRACE_SPAN("feature", "bundle_pdf::layout");
+	std::vector<feature::page_layout> pages{};
+	auto append{[&pages] (std::vector<feature::page_layout>&& _section) {
+		pages.insert(pages.end(), std::make_move_iterator(_section.begin()), std::make_move_iterator(_section.end()));
+	}};
+
+	for (const data::pdf_statement& pdf_statement : _data)
+	{
+		if (pdf_statement.is_valid() == false)
+		{
+			syslog(LOG_CRIT, "BUNDLE_PDF: the statement is not valid and is left out - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			continue;
+		}
+
+		append(this->statement.layout(pdf_statement, _metrics));
+		for (const data::pdf_invoice& pdf_invoice : pdf_statement.get_pdf_invoices())
+		{
+			if (pdf_invoice.is_valid() == false)
+			{
+				syslog(LOG_CRIT, "BUNDLE_PDF: the invoice is not valid and is left out - "
+						 "filename %s, line number %d", __FILE__, __LINE__);
+				continue;
+			}
+
+			append(this->invoice.layout(pdf_invoice, _metrics));
+		}
+	}
+
+	return pages;
+}
@@ -40,6 +40,8 @@
  *       * Builds a multipart MIME message using `curl_mime`:
  *           - Plain–text body from "email.txt" with placeholder replacement.
  *           - HTML body from "email.html" with the same placeholder scheme.
+ *             Both templates come from `utility::resource_loader`, which
+ *             reads them once and again only after they change.
  *           - A multipart/alternative wrapper for the two bodies.
  *           - One or more PDF attachments, base64 encoded, named using the
  *             `data::email` subject (e.g., "<subject>.pdf").
@@ -54,6 +56,20 @@
  *
  *****************************************************************************/
 #include <email.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::counter& sent{utility::metrics::counter_named("email.sent")};
+	utility::metrics::counter& failed{utility::metrics::counter_named("email.failures")};
+	utility::metrics::histogram& send_time{utility::metrics::histogram_named("email.send_ns")};
+
+	struct send_outcome {
+		bool succeeded{false};
+		~send_outcome() { (succeeded ? sent : failed).add(); }
+	};
+}
 
 feature::email::email() {}
 
@@ -61,6 +77,9 @@ feature::email::~email() {}
 
 bool feature::email::send(const data::email& _data)
 {
+	TRACE_SPAN("feature", "email::send");
+	utility::metrics::timer send_timer{send_time};
+	send_outcome outcome{};
         if (_data.is_valid())
         {
 		smtp::client client{this->curl};
@@ -92,6 +111,7 @@ bool feature::email::send(const data::email& _data)
 			return false;
 		}
 
+		outcome.succeeded = true;
 		return true;
         }
 
@@ -193,11 +213,12 @@ bool smtp::header::add(const data::email& _data)
 
 std::string smtp::header::to_mail(const std::string& _emails)
 {
-        std::vector<std::string> sliced_emails{this->slicer.slice(_emails)};
+        std::string_view rest{_emails};
+        std::string_view email{};
         std::string to{""};
-        if (!sliced_emails.empty())
+        if (utility::word_slicer::next(rest, email) == true)
         {
-                to = std::move(sliced_emails.front());
+                to = email;
         }
 
         return to;
@@ -205,13 +226,14 @@ std::string smtp::header::to_mail(const std::string& _emails)
 
 std::string smtp::header::cc_mail(const std::string& _emails)
 {
-        std::vector<std::string> sliced_emails{this->slicer.slice(_emails)};
+        std::string_view rest{_emails};
+        std::string_view email{};
         std::string cc{""};
-        if (!sliced_emails.empty())
+        if (utility::word_slicer::next(rest, email) == true)
         {
-                for (const auto& email : std::ranges::subrange(sliced_emails.begin() + 1, sliced_emails.end()))
+                while (utility::word_slicer::next(rest, email) == true)
                 {
-                        cc += (email + " ");
+                        cc.append(email).append(" ");
                 }
         }
 
@@ -236,11 +258,12 @@ bool smtp::recipients::add(const data::client& _data)
         bool added{false};
         if (_data.is_valid())
         {
-                utility::word_slicer slicer{};
-                std::vector<std::string> sliced_emails{slicer.slice(_data.get_email())};
-                for (const auto& _email : sliced_emails)
+                const std::string emails{_data.get_email()};
+                std::string_view rest{emails};
+                std::string_view email{};
+                while (utility::word_slicer::next(rest, email) == true)
                 {
-                        this->receivers.reset(curl_slist_append(this->receivers.release(), _email.c_str()));
+                        this->receivers.reset(curl_slist_append(this->receivers.release(), std::string{email}.c_str()));
                 }
 
                 added = !static_cast<bool> (curl_easy_setopt(this->curl.get(), CURLOPT_MAIL_RCPT, this->receivers.get()));
@@ -300,8 +323,13 @@ bool smtp::parts::text_body(const data::email& _data)
         part = curl_mime_addpart(alt.get());
         if (part)
         {
-                utility::file text_file{"email.txt"};
-                std::string text{text_file.read()};
+                const utility::resource text_file{utility::resource_loader::instance().load("email.txt")};
+                if (text_file.is_valid() == false)
+                {
+                        return success;
+                }
+
+                std::string text{text_file.view()};
 
                 data::client client{_data.get_client()};
                 data::admin admin{_data.get_business()};
@@ -326,8 +354,13 @@ bool smtp::parts::html_body(const data::email& _data)
         part = curl_mime_addpart(alt.get());
         if (part)
         {
-                utility::file html_file{"email.html"};
-                std::string html{html_file.read()};
+                const utility::resource html_file{utility::resource_loader::instance().load("email.html")};
+                if (html_file.is_valid() == false)
+                {
+                        return success;
+                }
+
+                std::string html{html_file.view()};
 
                 data::client client{_data.get_client()};
                 data::admin admin{_data.get_business()};
@@ -0,0 +1,249 @@
+/*****************************************************************************
+ * @file    font_service.cpp
+ *
+ * @brief
+ *   Implementation of the process-wide font service.
+ *
+ * @details
+ *   The toy face and the font options (no metric hinting, no hint style,
+ *   as on a Cairo PDF surface) are set up once in the constructor. A scaled
+ *   font is created the first time a size is measured, and the glyphs of
+ *   printable ASCII are queried from it right away.
+ *
+ *   measure() decodes the string as UTF-8 and lays its glyphs out along
+ *   their advances. Like Cairo, it takes the union of the inked glyph boxes
+ *   as the string's ink extents, so blanks only move the pen. A byte that is
+ *   not valid UTF-8 is measured as U+FFFD.
+ *
+ *****************************************************************************/
+#include <font_service.h>
+#include <limits>
+#include <algorithm>
+#include <syslog.h>
+#include <trace.h>
+
+namespace {
+constexpr char32_t replacement_character{0xFFFD};
+
+char32_t next_code_point(std::string_view _text, std::size_t& _index)
+{
+	const unsigned char lead{static_cast<unsigned char>(_text[_index++])};
+	if (lead < 0x80)
+	{
+		return lead;
+	}
+
+	std::size_t length{0};
+	char32_t code_point{0};
+	if ((lead & 0xE0) == 0xC0)
+	{
+		length = 1;
+		code_point = lead & 0x1F;
+	}
+	else if ((lead & 0xF0) == 0xE0)
+	{
+		length = 2;
+		code_point = lead & 0x0F;
+	}
+	else if ((lead & 0xF8) == 0xF0)
+	{
+		length = 3;
+		code_point = lead & 0x07;
+	}
+	else
+	{
+		return replacement_character;
+	}
+
+	for (std::size_t count{0}; count < length; ++count)
+	{
+		if (_index >= _text.size() || (static_cast<unsigned char>(_text[_index]) & 0xC0) != 0x80)
+		{
+			return replacement_character;
+		}
+		code_point = (code_point << 6) | (static_cast<unsigned char>(_text[_index++]) & 0x3F);
+	}
+
+	return code_point;
+}
+
+std::string encode(const char32_t& _code_point)
+{
+	std::string text{};
+	if (_code_point < 0x80)
+	{
+		text += static_cast<char>(_code_point);
+	}
+	else if (_code_point < 0x800)
+	{
+		text += static_cast<char>(0xC0 | (_code_point >> 6));
+		text += static_cast<char>(0x80 | (_code_point & 0x3F));
+	}
+	else if (_code_point < 0x10000)
+	{
+		text += static_cast<char>(0xE0 | (_code_point >> 12));
+		text += static_cast<char>(0x80 | ((_code_point >> 6) & 0x3F));
+		text += static_cast<char>(0x80 | (_code_point & 0x3F));
+	}
+	else
+	{
+		text += static_cast<char>(0xF0 | (_code_point >> 18));
+		text += static_cast<char>(0x80 | ((_code_point >> 12) & 0x3F));
+		text += static_cast<char>(0x80 | ((_code_point >> 6) & 0x3F));
+		text += static_cast<char>(0x80 | (_code_point & 0x3F));
+	}
+
+	return text;
+}
+}
+
+
+feature::font_service::font_service()
+{
+	this->font_face = Cairo::ToyFontFace::create("monospace", Cairo::ToyFontFace::Slant::NORMAL,
+						     Cairo::ToyFontFace::Weight::NORMAL);
+	this->options.set_hint_metrics(Cairo::FontOptions::HintMetrics::OFF);
+	this->options.set_hint_style(Cairo::FontOptions::HintStyle::NONE);
+	if (this->font_face == nullptr)
+	{
+		syslog(LOG_CRIT, "FONT_SERVICE: failed to resolve the monospace face - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+}
+
+feature::font_service::~font_service() {}
+
+feature::font_service& feature::font_service::instance()
+{
+	static font_service shared{};
+	return shared;
+}
+
+feature::text_extent feature::font_service::measure(const std::string& _text, const double& _size)
+{
+	TRACE_SPAN("feature", "font_service::measure");
+	std::lock_guard<std::mutex> lock{this->guard};
+	sized_font* font{font_at(_size)};
+	if (font == nullptr)
+	{
+		return feature::text_extent{};
+	}
+
+	double pen{0.0};
+	double left{std::numeric_limits<double>::max()};
+	double right{std::numeric_limits<double>::lowest()};
+	for (std::size_t index{0}; index < _text.size();)
+	{
+		const feature::glyph_metrics metrics{glyph(*font, next_code_point(_text, index))};
+		if (metrics.width > 0.0)
+		{
+			left = std::min(left, pen + metrics.x_bearing);
+			right = std::max(right, pen + metrics.x_bearing + metrics.width);
+		}
+		pen += metrics.x_advance;
+	}
+
+	if (left > right)
+	{
+		return feature::text_extent{};
+	}
+
+	return feature::text_extent{left, right - left};
+}
+
+double feature::font_service::advance(std::string_view _text, const double& _size)
+{
+	std::lock_guard<std::mutex> lock{this->guard};
+	sized_font* font{font_at(_size)};
+	if (font == nullptr)
+	{
+		return 0.0;
+	}
+
+	double pen{0.0};
+	for (std::size_t index{0}; index < _text.size();)
+	{
+		pen += glyph(*font, next_code_point(_text, index)).x_advance;
+	}
+
+	return pen;
+}
+
+std::string feature::font_service::font() const
+{
+	return "monospace";
+}
+
+Cairo::RefPtr<Cairo::FontFace> feature::font_service::face() const
+{
+	return this->font_face;
+}
+
+feature::font_statistics feature::font_service::statistics() const
+{
+	std::lock_guard<std::mutex> lock{this->guard};
+	feature::font_statistics current{};
+	current.sizes = this->fonts.size();
+	current.queries = this->queries;
+	for (const auto& [size, font] : this->fonts)
+	{
+		current.glyphs += font.others.size() + (font.font == nullptr ? 0 : font.ascii.size());
+	}
+
+	return current;
+}
+
+feature::font_service::sized_font* feature::font_service::font_at(const double& _size)
+{
+	auto found{this->fonts.find(_size)};
+	if (found != this->fonts.end())
+	{
+		return found->second.font == nullptr ? nullptr : &found->second;
+	}
+
+	sized_font& font{this->fonts[_size]};
+	if (this->font_face != nullptr)
+	{
+		font.font = Cairo::ScaledFont::create(this->font_face, Cairo::scaling_matrix(_size, _size),
+						      Cairo::identity_matrix(), this->options);
+	}
+
+	if (font.font == nullptr)
+	{
+		syslog(LOG_CRIT, "FONT_SERVICE: failed to create the scaled font - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return nullptr;
+	}
+
+	for (char32_t code_point{0x20}; code_point < 0x7F; ++code_point)
+	{
+		font.ascii[code_point] = query(font, code_point);
+	}
+
+	return &font;
+}
+
+feature::glyph_metrics feature::font_service::glyph(sized_font& _font, const char32_t& _code_point)
+{
+	if (_code_point < _font.ascii.size())
+	{
+		return _font.ascii[_code_point];
+	}
+
+	auto found{_font.others.find(_code_point)};
+	if (found != _font.others.end())
+	{
+		return found->second;
+	}
+
+	return _font.others.emplace(_code_point, query(_font, _code_point)).first->second;
+}
+
+feature::glyph_metrics feature::font_service::query(sized_font& _font, const char32_t& _code_point)
+{
+	++this->queries;
+	Cairo::TextExtents extents;
+	_font.font->get_text_extents(encode(_code_point), extents);
+
+	return feature::glyph_metrics{extents.x_bearing, extents.width, extents.x_advance};
+}
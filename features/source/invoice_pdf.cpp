@@ -10,69 +10,61 @@
  *   Cairo / cairomm.
  *
  *   High-level flow (`generate()`):
- *     1. Accept a `std::any` that is expected to contain `data::pdf_invoice`.
+ *     1. Accept the `data::pdf_invoice` by const reference (no copy).
  *     2. Validate the aggregate (`data::pdf_invoice::is_valid()`).
- *     3. Create a `Cairo::PdfSurface` backed by an in-memory stream and a
- *        `Cairo::Context` bound to that surface.
- *     4. Configure a monospace font and fixed page dimensions.
- *     5. Render, in sequence:
- *          - Document header (e.g., "Invoice").
- *          - Business / client information block.
- *          - Invoice metadata (ID, date, order number, job card).
- *          - Labor section (table, rows, and subtotal).
- *          - Material section (table, rows, and subtotal).
- *          - Grand total summary.
- *          - Payment method details and client message.
- *     6. Finalize the page with `show_page()` and `finish()` and return the
- *        accumulated PDF bytes as a `std::string`.
+ *     3. Lay the invoice out (`layout()`), measuring with the cached glyph
+ *        metrics of `feature::font_service`.
+ *     4. Hand the pages to `feature::pdf_emitter`, which draws them on a
+ *        `Cairo::PdfSurface` writing into the caller's sink. The string
+ *        overload passes a `feature::buffer_sink` reserved to the size of
+ *        the previous invoice and moves the PDF bytes out of it.
+ *
+ *   Layout (`layout()`), in sequence:
+ *     - Document header (e.g., "Invoice").
+ *     - Business / client information block.
+ *     - Invoice metadata (ID, date, order number, job card).
+ *     - Labor section (table, rows, and subtotal).
+ *     - Material section (table, rows, and subtotal).
+ *     - Grand total summary.
+ *     - Payment method details and client message.
  *
  *   Layout helpers:
  *     - `add_header`, `add_information`, `add_invoice`,
  *       `add_labor`, `add_material`, `add_grand_total`,
  *       `add_payment_method`:
- *         * Compose domain-level sections using the underlying drawing
- *           primitives (`write_to_pdf*`, `draw_line`, alignment helpers).
+ *         * Compose domain-level sections from the `feature::pdf_layout`
+ *           primitives (`write`, `new_line`, `new_section`, `rule`, `keep`).
  *
  *     - `add_items` / `add_item_description`:
- *         * Iterate over `data::column` vectors to render tabular rows.
- *         * Use `utility::boundary_slicer` to wrap long descriptions into
- *           multiple lines while preserving column alignment.
- *
- *     - `write_to_pdf`, `write_to_pdf_in_center`,
- *       `write_to_pdf_from_right`, `write_to_pdf_from_right_information`:
- *         * Configure font size, compute `Cairo::TextExtents`, update the
- *           current cursor position, and render the given string.
- *
- *   Page and cursor management:
- *     - `add_new_line`:
- *         * Advances the vertical cursor and triggers a new page if the
- *           next line would exceed the bottom margin.
- *
- *     - `add_new_section`:
- *         * Adds vertical spacing between logical sections.
+ *         * Iterate over `data::column` vectors to lay out tabular rows.
+ *         * Use `pdf_layout::wrap()` to wrap long descriptions into lines
+ *           no wider than the description column, measured in points, so
+ *           they fit at any font size; over-long words are hyphenated.
  *
- *     - `align_to_left_border`, `align_to_right_border`,
- *       `align_information_section`, `align_to_top_border`:
- *         * Update horizontal/vertical cursors to fixed margin anchors.
+ *   Page management:
+ *     - `pdf_layout::new_line()` starts a new page when the next line would
+ *       pass the bottom margin; `keep()` does so before a section that
+ *       would not fit, e.g. the payment block, which needs five section
+ *       gaps and two text lines.
  *
- *     - `align_to_right`, `align_to_right_information`,
- *       `align_to_center`:
- *         * Compute x-coordinates based on text extents so that text
- *           is right-aligned or centered within the configured widths.
- *
- *     - `adjust_height` and `adjust_payment_height`:
- *         * Predict future vertical usage and insert a page break when
- *           remaining space is insufficient to render the upcoming section.
- *
- *   Robustness:
- *     - `context_ok()` inspects the Cairo target status to detect write or
- *       surface errors after drawing operations.
- *     - All layout helpers return `bool` and are checked by callers so that
- *       `generate()` can abort gracefully and return an empty result if any
- *       drawing step fails.
+ *   Static regions:
+ *     - The title, the business block, the table titles and the payment
+ *       method are written as stamps keyed by `version::layout` and the
+ *       business fields they show. The emitter paints them from templates
+ *       recorded once per process (see page_templates.h). Bump the version
+ *       when their layout changes.
  *
  *****************************************************************************/
 #include <invoice_pdf.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::counter& rendered{utility::metrics::counter_named("pdf.invoices_rendered")};
+	utility::metrics::counter& rendered_bytes{utility::metrics::counter_named("pdf.bytes")};
+	utility::metrics::histogram& render_time{utility::metrics::histogram_named("pdf.render_ns")};
+}
 
 
 namespace font_size {
@@ -83,527 +75,252 @@ namespace font_size {
 }
 
 namespace width {
-        constexpr double page_width{595.0};
-        constexpr double left_border{20.0};
-        constexpr double right_border{575.0};
         constexpr double header{350.0};
-        constexpr double information_left{40.0};
-        constexpr double information_right{page_width - 40.0};
-        constexpr double max_quantity{10.0};
-        constexpr double max_amount{10.0};
-        constexpr double left_item_description{left_border + max_quantity};
-        constexpr double right_item_description{right_border - max_amount};
+        constexpr double description{290.0};
+}
+
+namespace version {
+        constexpr std::string_view layout{"invoice.1"};
 }
 
 namespace height {
-        constexpr double page_height{842.0};
-        constexpr double top_border{60.0};
-        constexpr double header{top_border + 30.0};
-        constexpr double text_offset{17.0};
-        constexpr double line_offset{10.0};
-        constexpr double space_offset{20.0};
+        constexpr double header{feature::page::top_border + 30.0};
+        constexpr double payment{(feature::page::space_offset * 5) + (feature::page::text_offset * 2)};
 }
 
 
 feature::invoice_pdf::invoice_pdf() {}
 
+feature::invoice_pdf::invoice_pdf(const feature::pdf_backend& _backend) : backend{_backend} {}
+
 feature::invoice_pdf::~invoice_pdf() {}
 
-std::string feature::invoice_pdf::generate(const std::any& _data)
+std::string feature::invoice_pdf::generate(const data::pdf_invoice& _data)
 {
-	std::ostringstream final_pdf{};
-	data::pdf_invoice data{std::any_cast<data::pdf_invoice> (_data)};
-	if (data.is_valid())
+	feature::buffer_sink sink{this->last_size};
+	if (generate(_data, sink) == false)
 	{
-		this->surface = Cairo::PdfSurface::create_for_stream(
-				[&, this](const unsigned char* _data, unsigned int _length) -> cairo_status_t {
-				final_pdf.write(reinterpret_cast<const char*>(_data), _length);
-				return final_pdf.fail() ? CAIRO_STATUS_WRITE_ERROR : CAIRO_STATUS_SUCCESS;
-				},
-				this->width, this->height
-				);
+		return "";
+	}
+	this->last_size = sink.written();
 
+	return sink.take();
+}
 
-		if (this->surface == nullptr)
-		{
-			return "";
-		}
-		else
+bool feature::invoice_pdf::generate(const data::pdf_invoice& _data, interface::pdf_sink& _sink)
+{
+	TRACE_SPAN("feature", "invoice_pdf::generate");
+	utility::metrics::timer render_timer{render_time};
+	const std::size_t start{_sink.written()};
+	bool success{false};
+	if (_data.is_valid())
+	{
+		std::vector<feature::page_layout> pages{};
+		if (this->backend == feature::pdf_backend::native)
 		{
-			this->context = Cairo::Context::create(this->surface);
+			feature::courier_metrics metrics{};
+			pages = layout(_data, metrics);
 		}
 
-		if (this->context == nullptr)
+		if (pages.empty() == false && this->writer.encodable(pages) == true)
 		{
-			this->surface->finish();
-			return "";
+			success = this->writer.write(pages, _sink);
 		}
 		else
 		{
-			this->context->select_font_face("monospace", Cairo::ToyFontFace::Slant::NORMAL, Cairo::ToyFontFace::Weight::NORMAL);
-		}
-
-		if (add_header("Invoice") == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (add_information(data) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (add_invoice(data.get_invoice()) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (draw_line() == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (add_labor(data.get_invoice()) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (draw_line() == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (add_material(data.get_invoice()) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (draw_line() == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (add_grand_total(data.get_invoice()) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		if (add_payment_method(data.get_business()) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
+			success = this->emitter.emit(layout(_data, feature::font_service::instance()), _sink);
 		}
+	}
 
-		this->context->show_page();
-		this->surface->finish();
+	if (success == true)
+	{
+		rendered.add();
+		rendered_bytes.add(_sink.written() - start);
 	}
 
-	return final_pdf.str();
+	return success;
+}
+
+std::vector<feature::page_layout> feature::invoice_pdf::layout(const data::pdf_invoice& _data,
+								interface::text_metrics& _metrics)
+{
+	TRACE_SPAN("feature", "invoice_pdf::layout");
+	feature::pdf_layout layout{_metrics};
+	add_header(layout, "Invoice");
+	add_information(layout, _data);
+	add_invoice(layout, _data.get_invoice());
+	layout.rule();
+	add_labor(layout, _data.get_invoice());
+	layout.rule();
+	add_material(layout, _data.get_invoice());
+	layout.rule();
+	add_grand_total(layout, _data.get_invoice());
+	add_payment_method(layout, _data.get_business());
+
+	return layout.finish();
 }
 
-bool feature::invoice_pdf::add_header(const std::string& _data)
+void feature::invoice_pdf::add_header(feature::pdf_layout& _layout, const std::string& _data)
 {
-        align_to_top_border();
-        align_to_left_border();
-        add_new_line();
-        this->context->set_font_size(font_size::header);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        this->context->move_to(width::header, height::header);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
+        _layout.align_to_top();
+        _layout.align(feature::page::left_border);
+        _layout.new_line();
+        _layout.begin_stamp({version::layout, "header", _data});
+        _layout.write_fixed_at(_data, font_size::header, width::header, height::header);
+        _layout.end_stamp();
 }
 
-bool feature::invoice_pdf::add_information(const data::pdf_invoice& _data)
+void feature::invoice_pdf::add_information(feature::pdf_layout& _layout, const data::pdf_invoice& _data)
 {
-        data::admin admin{_data.get_business()};
-        data::client client{_data.get_client()};
-        align_information_section();
-        add_new_section();
-        std::string client_business_name{client.get_name()};
-        if (write_to_pdf(client_business_name, font_size::information) == false)
-                return false;
-
-        std::string name{admin.get_name()};
-        if (write_to_pdf_from_right_information(name, font_size::information) == false)
-                return false;
-
-        align_information_section();
-        add_new_line();
-        std::string client_business_address{client.get_address()};
-        if (write_to_pdf(client_business_address, font_size::information) == false)
-                return false;
-
-        std::string address{admin.get_address()};
-        if (write_to_pdf_from_right_information(address, font_size::information) == false)
-                return false;
-
-        align_information_section();
-        add_new_line();
-        std::string client_business_town{client.get_town() + ", " + client.get_area_code()};
-        if (write_to_pdf(client_business_town, font_size::information) == false)
-                return false;
-
-        std::string town{admin.get_town() + ", " + admin.get_area_code()};
-        if (write_to_pdf_from_right_information(town, font_size::information) == false)
-                return false;
-
-        align_information_section();
-        add_new_line();
-        std::string vat_number{"VAT #: " + client.get_vat_number()};
-        if (write_to_pdf(vat_number, font_size::information) == false)
-                return false;
-
-        std::string cellphone{admin.get_cellphone()};
-        if (write_to_pdf_from_right_information(cellphone, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string email{admin.get_email()};
-        if (write_to_pdf_from_right_information(email, font_size::information) == false)
-                return false;
-
-        return true;
+        const data::admin& admin{_data.get_business()};
+        const data::client& client{_data.get_client()};
+        _layout.align(feature::page::information_left);
+        _layout.new_section();
+        _layout.begin_stamp({version::layout, "business", admin.get_name(), admin.get_address(), admin.get_town(),
+                             admin.get_area_code(), admin.get_cellphone(), admin.get_email()});
+        _layout.write(client.get_name(), font_size::information, feature::placement::pen);
+        _layout.write_fixed(admin.get_name(), font_size::information, feature::placement::right_information);
+
+        _layout.align(feature::page::information_left);
+        _layout.new_line();
+        _layout.write(client.get_address(), font_size::information, feature::placement::pen);
+        _layout.write_fixed(admin.get_address(), font_size::information, feature::placement::right_information);
+
+        _layout.align(feature::page::information_left);
+        _layout.new_line();
+        _layout.write(client.get_town() + ", " + client.get_area_code(), font_size::information, feature::placement::pen);
+        _layout.write_fixed(admin.get_town() + ", " + admin.get_area_code(), font_size::information,
+                      feature::placement::right_information);
+
+        _layout.align(feature::page::information_left);
+        _layout.new_line();
+        _layout.write("VAT #: " + client.get_vat_number(), font_size::information, feature::placement::pen);
+        _layout.write_fixed(admin.get_cellphone(), font_size::information, feature::placement::right_information);
+
+        _layout.new_line();
+        _layout.write_fixed(admin.get_email(), font_size::information, feature::placement::right_information);
+        _layout.end_stamp();
 }
 
-bool feature::invoice_pdf::add_invoice(const data::invoice& _data)
+void feature::invoice_pdf::add_invoice(feature::pdf_layout& _layout, const data::invoice& _data)
 {
-        align_to_left_border();
-        add_new_section();
-
-        add_new_line();
-        std::string number{"Invoice #:... " + _data.get_id()};
-        if (write_to_pdf(number, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string date{"Date:........ " + _data.get_date()};
-        if (write_to_pdf(date, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string order{"Order #:..... " + _data.get_order_number()};
-        if (write_to_pdf(order, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string job_card{"Job Card:.... " + _data.get_job_card_number()};
-        if (write_to_pdf(job_card, font_size::information) == false)
-                return false;
-
-        return true;
+        _layout.align(feature::page::left_border);
+        _layout.new_section();
+
+        _layout.new_line();
+        _layout.write("Invoice #:... " + _data.get_id(), font_size::information, feature::placement::pen);
+
+        _layout.new_line();
+        _layout.write("Date:........ " + _data.get_date(), font_size::information, feature::placement::pen);
+
+        _layout.new_line();
+        _layout.write("Order #:..... " + _data.get_order_number(), font_size::information, feature::placement::pen);
+
+        _layout.new_line();
+        _layout.write("Job Card:.... " + _data.get_job_card_number(), font_size::information, feature::placement::pen);
 }
 
-bool feature::invoice_pdf::add_labor(const data::invoice& _data)
+void feature::invoice_pdf::add_labor(feature::pdf_layout& _layout, const data::invoice& _data)
 {
-        align_to_left_border();
-        add_new_section();
-        adjust_height();
-        std::string header_quantity{"Quantity"};
-        if (write_to_pdf(header_quantity, font_size::prominent) == false)
-                return false;
-
-        std::string header_description{"Labor Description"};
-        if (write_to_pdf_in_center(header_description, font_size::prominent) == false)
-                return false;
-
-        std::string header_amount{"Amount"};
-        if (write_to_pdf_from_right(header_amount, font_size::prominent) == false)
-                return false;
-
-        if (add_items(_data.get_description_column()) == false)
-                return false;
-
-        add_new_section();
-        adjust_height();
-        std::string total{"Total: R " + _data.get_description_total()};
-        if (write_to_pdf_from_right(total, font_size::prominent) == false)
-                return false;
-
-        return true;
+        _layout.align(feature::page::left_border);
+        _layout.new_section();
+        _layout.keep(0.0);
+        _layout.begin_stamp({version::layout, "labor"});
+        _layout.write_fixed("Quantity", font_size::prominent, feature::placement::pen);
+        _layout.write_fixed("Labor Description", font_size::prominent, feature::placement::center);
+        _layout.write_fixed("Amount", font_size::prominent, feature::placement::right);
+        _layout.end_stamp();
+
+        add_items(_layout, _data.get_description_column());
+
+        _layout.new_section();
+        _layout.keep(0.0);
+        _layout.write("Total: R " + _data.get_description_total(), font_size::prominent, feature::placement::right);
 }
 
-bool feature::invoice_pdf::add_material(const data::invoice& _data)
+void feature::invoice_pdf::add_material(feature::pdf_layout& _layout, const data::invoice& _data)
 {
-        align_to_left_border();
-        add_new_section();
-        adjust_height();
-        std::string header_quantity{"Quantity"};
-        if (write_to_pdf(header_quantity, font_size::prominent) == false)
-                return false;
-
-        std::string header_description{"Material Used"};
-        if (write_to_pdf_in_center(header_description, font_size::prominent) == false)
-                return false;
-
-        std::string header_amount{"Amount"};
-        if (write_to_pdf_from_right(header_amount, font_size::prominent) == false)
-                return false;
-
-        if (add_items(_data.get_material_column()) == false)
-                return false;
-
-        add_new_line();
-        adjust_height();
-        std::string total{"Total: R " + _data.get_material_total()};
-        if (write_to_pdf_from_right(total, font_size::prominent) == false)
-                return false;
-
-        return true;
+        _layout.align(feature::page::left_border);
+        _layout.new_section();
+        _layout.keep(0.0);
+        _layout.begin_stamp({version::layout, "material"});
+        _layout.write_fixed("Quantity", font_size::prominent, feature::placement::pen);
+        _layout.write_fixed("Material Used", font_size::prominent, feature::placement::center);
+        _layout.write_fixed("Amount", font_size::prominent, feature::placement::right);
+        _layout.end_stamp();
+
+        add_items(_layout, _data.get_material_column());
+
+        _layout.new_line();
+        _layout.keep(0.0);
+        _layout.write("Total: R " + _data.get_material_total(), font_size::prominent, feature::placement::right);
 }
 
-bool feature::invoice_pdf::add_items(const std::vector<data::column>& _data)
+void feature::invoice_pdf::add_items(feature::pdf_layout& _layout, const std::vector<data::column>& _data)
 {
-        add_new_line();
+        _layout.new_line();
         for (const auto& column : _data)
         {
-                this->current_width = width::left_border;
-                if (write_to_pdf(std::to_string(column.get_quantity()), font_size::information) == false)
-                        return false;
+                _layout.align(feature::page::left_border);
+                _layout.write(std::to_string(column.get_quantity()), font_size::information, feature::placement::pen);
 
                 std::ostringstream amount{""};
                 amount << std::fixed << std::setprecision(2) << column.get_amount();
-                if (write_to_pdf_from_right("R " + amount.str(), font_size::information) == false)
-                        return false;
+                _layout.write("R " + amount.str(), font_size::information, feature::placement::right);
 
-                if (add_item_description(column) == false)
-                        return false;
+                add_item_description(_layout, column);
 
-                add_new_line();
+                _layout.new_line();
         }
-
-        return true;
 }
 
-bool feature::invoice_pdf::add_item_description(const data::column& _data)
+void feature::invoice_pdf::add_item_description(feature::pdf_layout& _layout, const data::column& _data)
 {
-        std::vector<std::string> sliced_data{this->slicer.slice(_data.get_description())};
-        if (sliced_data.size() >= 2)
+        const std::string description{_data.get_description()};
+        const std::vector<std::string> lines{_layout.wrap(description, font_size::information, width::description,
+                                                          utility::hyphenation::on)};
+        if (lines.size() >= 2)
         {
-                if (std::all_of(sliced_data.cbegin(), sliced_data.cend(), [&] (const std::string& str) {
-                        if (write_to_pdf_in_center(str, font_size::information) == false)
-                                return false;
-
-                        add_new_line();
-                        adjust_height();
-
-                        return true;
-                }) == false)
+                for (const std::string& line : lines)
                 {
-                        return false;
+                        _layout.write(line, font_size::information, feature::placement::center);
+                        _layout.new_line();
+                        _layout.keep(0.0);
                 }
         }
         else
         {
-                if (write_to_pdf_in_center(_data.get_description(), font_size::information) == false)
-                        return false;
-
+                _layout.write(description, font_size::information, feature::placement::center);
         }
-
-        return true;
-}
-
-bool feature::invoice_pdf::add_grand_total(const data::invoice& _data)
-{
-        align_to_right_border();
-        add_new_section();
-        adjust_height();
-        std::string grand_total{"Grand Total: R " + _data.get_grand_total()};
-        if (write_to_pdf_from_right(grand_total, font_size::prominent) == false)
-                return false;
-
-        return true;
-}
-
-bool feature::invoice_pdf::add_payment_method(const data::admin& _data)
-{
-        align_to_left_border();
-        add_new_section();
-        adjust_payment_height();
-        std::string method{"Payment Method"};
-        if (write_to_pdf(method, font_size::prominent) == false)
-                return false;
-
-        add_new_line();
-        std::string bank{"Bank Name:..... " + _data.get_bank()};
-        if (write_to_pdf(bank, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string account{"Account #:..... " + _data.get_account_number()};
-        if (write_to_pdf(account, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string branch{"Branch Code:... " + _data.get_branch_code()};
-        if (write_to_pdf(branch, font_size::information) == false)
-                return false;
-
-        add_new_section();
-        std::string message{_data.get_client_message()};
-        if (write_to_pdf(message, font_size::prominent) == false)
-                return false;
-
-        return true;
-}
-
-bool feature::invoice_pdf::write_to_pdf(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
-}
-
-bool feature::invoice_pdf::write_to_pdf_in_center(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        align_to_center(extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
-}
-
-bool feature::invoice_pdf::write_to_pdf_from_right(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        align_to_right(extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
 }
 
-bool feature::invoice_pdf::write_to_pdf_from_right_information(const std::string& _data, const double& _font_size)
+void feature::invoice_pdf::add_grand_total(feature::pdf_layout& _layout, const data::invoice& _data)
 {
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        align_to_right_information(extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
+        _layout.align(feature::page::right_border);
+        _layout.new_section();
+        _layout.keep(0.0);
+        _layout.write("Grand Total: R " + _data.get_grand_total(), font_size::prominent, feature::placement::right);
 }
 
-bool feature::invoice_pdf::draw_line()
+void feature::invoice_pdf::add_payment_method(feature::pdf_layout& _layout, const data::admin& _data)
 {
-        this->current_height += height::line_offset;
-        this->context->set_line_width(1.5);
-        this->context->move_to(width::left_border, this->current_height);
-        this->context->line_to((this->width - width::left_border), this->current_height);
-        this->context->stroke();
+        _layout.align(feature::page::left_border);
+        _layout.new_section();
+        _layout.keep(height::payment);
+        _layout.begin_stamp({version::layout, "payment", _data.get_bank(), _data.get_account_number(),
+                             _data.get_branch_code(), _data.get_client_message()});
+        _layout.write_fixed("Payment Method", font_size::prominent, feature::placement::pen);
 
-        return this->context_ok();
-}
+        _layout.new_line();
+        _layout.write_fixed("Bank Name:..... " + _data.get_bank(), font_size::information, feature::placement::pen);
 
-bool feature::invoice_pdf::context_ok()
-{
-        return (context->get_target()->get_status() == CAIRO_STATUS_SUCCESS);
-}
+        _layout.new_line();
+        _layout.write_fixed("Account #:..... " + _data.get_account_number(), font_size::information, feature::placement::pen);
 
-void feature::invoice_pdf::add_new_line()
-{
-	double next_line = this->current_height + height::text_offset;
-	if (next_line >= (height::page_height - height::top_border)) {
-		this->context->show_page();
-		align_to_top_border();
-		align_to_left_border();
-	}
-
-	std::lock_guard<std::mutex> guard(this->pdf_mutex);
-	this->current_height += height::text_offset;
-}
-
-void feature::invoice_pdf::add_new_section()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_height += height::space_offset;
-        this->current_height += height::space_offset;
-}
+        _layout.new_line();
+        _layout.write_fixed("Branch Code:... " + _data.get_branch_code(), font_size::information, feature::placement::pen);
 
-void feature::invoice_pdf::align_to_left_border()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_width = width::left_border;
-}
-
-void feature::invoice_pdf::align_to_right_border()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_width = width::right_border;
-}
-
-void feature::invoice_pdf::align_information_section()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_width = width::information_left;
-}
-
-void feature::invoice_pdf::align_to_top_border()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_height = height::top_border;
-}
-
-void feature::invoice_pdf::align_to_right(const Cairo::TextExtents& _extent)
-{
-        this->current_width = (width::right_border - (_extent.width + _extent.x_bearing));
-}
-
-void feature::invoice_pdf::align_to_right_information(const Cairo::TextExtents& _extent)
-{
-        this->current_width = (width::information_right - (_extent.width + _extent.x_bearing));
-}
-
-void feature::invoice_pdf::align_to_center(const cairo_text_extents_t& _extent)
-{
-        this->current_width = ((this->width / 2) - ((_extent.width / 2) + _extent.x_bearing));
-}
-
-void feature::invoice_pdf::adjust_height()
-{
-        if (this->current_height >= (height::page_height - (height::top_border)))
-        {
-                this->context->show_page();
-                align_to_top_border();
-        }
-}
-
-void feature::invoice_pdf::adjust_payment_height()
-{
-        double future_height{this->current_height + (height::space_offset * 5) + (height::text_offset * 2)};
-        if (future_height >= (height::page_height - (height::top_border)))
-        {
-                this->context->show_page();
-                align_to_top_border();
-        }
+        _layout.new_section();
+        _layout.write_fixed(_data.get_client_message(), font_size::prominent, feature::placement::pen);
+        _layout.end_stamp();
 }
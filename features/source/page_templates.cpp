@@ -0,0 +1,110 @@
+/*****************************************************************************
+ * @file    page_templates.cpp
+ *
+ * @brief
+ *   Implementation of the recorded page template cache.
+ *
+ * @details
+ *   A template is an unbounded Cairo recording surface holding the stamp's
+ *   runs at their positions relative to the stamp origin, set in the face of
+ *   the font service. Painting it into a PDF replays those operations, so
+ *   the text stays selectable and searchable in the output.
+ *
+ *   The cache is thread_local, so no lock is taken: a recording is only
+ *   ever replayed on the thread that recorded it. The hits and misses of
+ *   every thread are also added to the "pdf.template_hits" and
+ *   "pdf.template_misses" metrics, so the reuse across a batch rendered on
+ *   several workers can be read from one place.
+ *
+ *****************************************************************************/
+#include <page_templates.h>
+#include <font_service.h>
+#include <syslog.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::counter& template_hits{utility::metrics::counter_named("pdf.template_hits")};
+	utility::metrics::counter& template_misses{utility::metrics::counter_named("pdf.template_misses")};
+}
+
+
+feature::page_templates::page_templates() {}
+
+feature::page_templates::~page_templates() {}
+
+feature::page_templates& feature::page_templates::instance()
+{
+	thread_local page_templates shared{};
+	return shared;
+}
+
+Cairo::RefPtr<Cairo::RecordingSurface> feature::page_templates::find(const feature::stamp& _stamp)
+{
+	TRACE_SPAN("feature", "page_templates::find");
+	auto found{this->entries.find(_stamp.key)};
+	if (found != this->entries.end() && found->second.runs == _stamp.runs)
+	{
+		++this->hits;
+		template_hits.add();
+		return found->second.surface;
+	}
+
+	++this->misses;
+	template_misses.add();
+	Cairo::RefPtr<Cairo::RecordingSurface> surface{record(_stamp)};
+	if (surface == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (found == this->entries.end() && this->entries.size() >= capacity)
+	{
+		this->entries.clear();
+	}
+	this->entries[_stamp.key] = entry{_stamp.runs, surface};
+
+	return surface;
+}
+
+void feature::page_templates::clear()
+{
+	this->entries.clear();
+	this->hits = 0;
+	this->misses = 0;
+}
+
+feature::template_statistics feature::page_templates::statistics() const
+{
+	return feature::template_statistics{this->hits, this->misses, this->entries.size()};
+}
+
+Cairo::RefPtr<Cairo::RecordingSurface> feature::page_templates::record(const feature::stamp& _stamp)
+{
+	Cairo::RefPtr<Cairo::RecordingSurface> surface{Cairo::RecordingSurface::create()};
+	if (surface == nullptr)
+	{
+		syslog(LOG_CRIT, "PAGE_TEMPLATES: failed to create the recording surface - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return nullptr;
+	}
+
+	Cairo::RefPtr<Cairo::Context> context{Cairo::Context::create(surface)};
+	context->set_font_face(feature::font_service::instance().face());
+	for (const feature::text_run& run : _stamp.runs)
+	{
+		context->set_font_size(run.size);
+		context->move_to(run.x, run.y);
+		context->show_text(run.text.c_str());
+	}
+
+	if (surface->get_status() != CAIRO_STATUS_SUCCESS)
+	{
+		syslog(LOG_CRIT, "PAGE_TEMPLATES: failed to record the template - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return nullptr;
+	}
+
+	return surface;
+}
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * @file    pdf_emitter.cpp
+ *
+ * @brief
+ *   Implementation of the PDF emit pass.
+ *
+ * @details
+ *   `pdf_emitter::emit()` creates a PDF surface writing into the sink and,
+ *   for every page, paints the recorded template of each stamp, shows its
+ *   runs, strokes its rules and ends the page with `show_page()`. The surface status is checked after every page
+ *   and once more after `finish()`, which writes the trailer. The face
+ *   comes from the font service, so no fontconfig lookup is made per call.
+ *
+ *****************************************************************************/
+#include <pdf_emitter.h>
+#include <font_service.h>
+#include <page_templates.h>
+#include <pdf_sink.h>
+#include <syslog.h>
+#include <trace.h>
+
+
+feature::pdf_emitter::pdf_emitter() {}
+
+feature::pdf_emitter::~pdf_emitter() {}
+
+std::string feature::pdf_emitter::emit(std::span<const feature::page_layout> _pages)
+{
+	feature::buffer_sink sink{this->last_size};
+	if (emit(_pages, sink) == false)
+	{
+		return "";
+	}
+	this->last_size = sink.written();
+
+	return sink.take();
+}
+
+bool feature::pdf_emitter::emit(std::span<const feature::page_layout> _pages, interface::pdf_sink& _sink)
+{
+	TRACE_SPAN("feature", "pdf_emitter::emit");
+	if (_pages.empty() == true)
+	{
+		return false;
+	}
+
+	Cairo::RefPtr<Cairo::PdfSurface> surface{Cairo::PdfSurface::create_for_stream(
+			[&_sink](const unsigned char* _data, unsigned int _length) -> cairo_status_t {
+				return _sink.write(reinterpret_cast<const char*>(_data), _length) ?
+					CAIRO_STATUS_SUCCESS : CAIRO_STATUS_WRITE_ERROR;
+			},
+			page::width, page::height
+	)};
+
+	if (surface == nullptr)
+	{
+		return false;
+	}
+
+	Cairo::RefPtr<Cairo::Context> context{Cairo::Context::create(surface)};
+	if (context == nullptr)
+	{
+		surface->finish();
+		return false;
+	}
+
+	context->set_font_face(feature::font_service::instance().face());
+	for (const feature::page_layout& page_layout : _pages)
+	{
+		for (const feature::stamp& stamp : page_layout.stamps)
+		{
+			Cairo::RefPtr<Cairo::RecordingSurface> recording{feature::page_templates::instance().find(stamp)};
+			if (recording == nullptr)
+			{
+				draw(context, stamp.runs, stamp.y);
+			}
+			else
+			{
+				context->save();
+				context->translate(0.0, stamp.y);
+				context->set_source(recording, 0.0, 0.0);
+				context->paint();
+				context->restore();
+			}
+		}
+
+		draw(context, page_layout.runs, 0.0);
+
+		for (const feature::rule& rule : page_layout.rules)
+		{
+			context->set_line_width(rule.width);
+			context->move_to(rule.x_start, rule.y);
+			context->line_to(rule.x_end, rule.y);
+			context->stroke();
+		}
+
+		context->show_page();
+		if (context->get_target()->get_status() != CAIRO_STATUS_SUCCESS)
+		{
+			syslog(LOG_CRIT, "PDF_EMITTER: failed to draw the page - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			surface->finish();
+			return false;
+		}
+	}
+	surface->finish();
+	if (surface->get_status() != CAIRO_STATUS_SUCCESS)
+	{
+		syslog(LOG_CRIT, "PDF_EMITTER: failed to finish the document - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	return true;
+}
+
+void feature::pdf_emitter::draw(const Cairo::RefPtr<Cairo::Context>& _context,
+				const std::vector<feature::text_run>& _runs, const double& _y)
+{
+	for (const feature::text_run& run : _runs)
+	{
+		_context->set_font_size(run.size);
+		_context->move_to(run.x, run.y + _y);
+		_context->show_text(run.text.c_str());
+	}
+}
@@ -0,0 +1,192 @@
+/*****************************************************************************
+ * @file    pdf_layout.cpp
+ *
+ * @brief
+ *   Implementation of the PDF layout cursor.
+ *
+ * @details
+ *   `feature::pdf_layout` replays the cursor rules the generators used to
+ *   apply while drawing, and records the result instead:
+ *
+ *     - `new_line()` moves the pen down one text line. When that line would
+ *       reach the bottom margin it first starts a new page and returns the
+ *       pen to the top-left corner.
+ *     - `keep()` starts a new page, keeping the pen's x, when the pen plus
+ *       the given height reaches the bottom margin; `keep(0.0)` breaks only
+ *       when the pen is already past it.
+ *     - `write()` measures the string, moves the pen's x to where the
+ *       placement puts it and records the run there. The pen's x stays
+ *       where the run started, so the next `placement::pen` run follows it.
+ *     - A stamp takes the pen's y as its origin when it is opened. Its runs
+ *       are stored relative to that origin, so the same stamp is equal
+ *       wherever the page puts it. The key joins its parts with a unit
+ *       separator, which does not occur in the document text.
+ *
+ *   Nothing here touches Cairo; the text metrics are the only input besides
+ *   the strings.
+ *
+ *****************************************************************************/
+#include <pdf_layout.h>
+#include <utility>
+
+
+feature::pdf_layout::pdf_layout(interface::text_metrics& _metrics) : metrics{_metrics} {}
+
+feature::pdf_layout::~pdf_layout() {}
+
+void feature::pdf_layout::write(const std::string& _text, const double& _size, const feature::placement& _placement)
+{
+	place(_text, _size, _placement);
+	this->document.back().runs.push_back(feature::text_run{this->x, this->y, _size, _text});
+}
+
+void feature::pdf_layout::write_at(const std::string& _text, const double& _size, const double& _x, const double& _y)
+{
+	this->document.back().runs.push_back(feature::text_run{_x, _y, _size, _text});
+}
+
+std::vector<std::string> feature::pdf_layout::wrap(const std::string& _text, const double& _size, const double& _width,
+						   const utility::hyphenation& _hyphenation)
+{
+	return utility::line_breaker::instance().wrap(_text, _width, _size, this->metrics, _hyphenation);
+}
+
+void feature::pdf_layout::begin_stamp(std::initializer_list<std::string_view> _key)
+{
+	end_stamp();
+	std::string key{""};
+	for (const std::string_view& part : _key)
+	{
+		key.append(part).push_back('\x1f');
+	}
+
+	this->open_stamp = feature::stamp{std::move(key), this->y, {}};
+}
+
+void feature::pdf_layout::write_fixed(const std::string& _text, const double& _size, const feature::placement& _placement)
+{
+	place(_text, _size, _placement);
+	write_fixed_at(_text, _size, this->x, this->y);
+}
+
+void feature::pdf_layout::write_fixed_at(const std::string& _text, const double& _size, const double& _x, const double& _y)
+{
+	if (this->open_stamp.has_value() == false)
+	{
+		write_at(_text, _size, _x, _y);
+	}
+	else
+	{
+		this->open_stamp->runs.push_back(feature::text_run{_x, _y - this->open_stamp->y, _size, _text});
+	}
+}
+
+void feature::pdf_layout::end_stamp()
+{
+	if (this->open_stamp.has_value() == true && this->open_stamp->runs.empty() == false)
+	{
+		this->document.back().stamps.push_back(std::move(this->open_stamp.value()));
+	}
+	this->open_stamp.reset();
+}
+
+void feature::pdf_layout::new_line()
+{
+	if ((this->y + page::text_offset) >= page::bottom_border)
+	{
+		new_page();
+		this->x = page::left_border;
+	}
+
+	this->y += page::text_offset;
+}
+
+void feature::pdf_layout::new_section()
+{
+	this->y += (page::space_offset * 2);
+}
+
+void feature::pdf_layout::rule()
+{
+	this->y += page::line_offset;
+	this->document.back().rules.push_back(
+			feature::rule{page::left_border, page::width - page::left_border, this->y, page::line_width});
+}
+
+void feature::pdf_layout::keep(const double& _height)
+{
+	if ((this->y + _height) >= page::bottom_border)
+	{
+		new_page();
+	}
+}
+
+void feature::pdf_layout::align(const double& _x)
+{
+	this->x = _x;
+}
+
+void feature::pdf_layout::align_to_top()
+{
+	this->y = page::top_border;
+}
+
+double feature::pdf_layout::pen_x() const
+{
+	return this->x;
+}
+
+double feature::pdf_layout::pen_y() const
+{
+	return this->y;
+}
+
+std::vector<feature::page_layout> feature::pdf_layout::finish()
+{
+	end_stamp();
+	std::vector<feature::page_layout> pages(std::exchange(this->document, std::vector<feature::page_layout>(1)));
+	this->x = page::left_border;
+	this->y = page::top_border;
+
+	return pages;
+}
+
+void feature::pdf_layout::place(const std::string& _text, const double& _size, const feature::placement& _placement)
+{
+	const feature::text_extent extent{this->metrics.measure(_text, _size)};
+	switch (_placement)
+	{
+	case feature::placement::center:
+		this->x = (page::width / 2) - ((extent.width / 2) + extent.x_bearing);
+		break;
+	case feature::placement::right:
+		this->x = page::right_border - (extent.width + extent.x_bearing);
+		break;
+	case feature::placement::right_information:
+		this->x = page::information_right - (extent.width + extent.x_bearing);
+		break;
+	case feature::placement::first_quarter:
+		this->x = (page::width / 4) - ((extent.width / 4) + (extent.x_bearing - 10));
+		break;
+	case feature::placement::second_quarter:
+		this->x = (page::width / 4) - ((extent.width / 4) + (extent.x_bearing - 250));
+		break;
+	case feature::placement::pen:
+	default:
+		break;
+	}
+}
+
+void feature::pdf_layout::new_page()
+{
+	if (this->open_stamp.has_value() == true)
+	{
+		for (const feature::text_run& run : this->open_stamp->runs)
+		{
+			write_at(run.text, run.size, run.x, run.y + this->open_stamp->y);
+		}
+		this->open_stamp.reset();
+	}
+	this->document.emplace_back();
+	this->y = page::top_border;
+}
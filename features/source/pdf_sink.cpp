@@ -0,0 +1,123 @@
+/*****************************************************************************
+ * @file    pdf_sink.cpp
+ *
+ * @brief
+ *   Implementation of the PDF output sinks.
+ *
+ *****************************************************************************/
+#include <pdf_sink.h>
+#include <cerrno>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <syslog.h>
+
+
+feature::buffer_sink::buffer_sink(const std::size_t& _reserve)
+{
+	this->buffer.reserve(_reserve);
+}
+
+feature::buffer_sink::~buffer_sink() {}
+
+bool feature::buffer_sink::write(const char* _data, const std::size_t& _length)
+{
+	this->buffer.append(_data, _length);
+	return true;
+}
+
+std::size_t feature::buffer_sink::written() const
+{
+	return this->buffer.size();
+}
+
+std::string feature::buffer_sink::take()
+{
+	return std::move(this->buffer);
+}
+
+
+feature::fd_sink::fd_sink(const int& _descriptor) : descriptor{_descriptor} {}
+
+feature::fd_sink::~fd_sink() {}
+
+bool feature::fd_sink::write(const char* _data, const std::size_t& _length)
+{
+	if (this->descriptor < 0)
+	{
+		syslog(LOG_CRIT, "PDF_SINK: the file descriptor is not open - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	std::size_t offset{0};
+	while (offset < _length)
+	{
+		const ssize_t result{::write(this->descriptor, _data + offset, _length - offset)};
+		if (result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		else if (result <= 0)
+		{
+			syslog(LOG_CRIT, "PDF_SINK: failed to write to the file descriptor - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			return false;
+		}
+
+		offset += static_cast<std::size_t>(result);
+		this->count += static_cast<std::size_t>(result);
+	}
+
+	return true;
+}
+
+std::size_t feature::fd_sink::written() const
+{
+	return this->count;
+}
+
+
+feature::file_sink::file_sink(const std::filesystem::path& _path)
+	: fd_sink{::open(_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600)}
+{
+	if (this->descriptor < 0)
+	{
+		syslog(LOG_CRIT, "PDF_SINK: failed to open %s - "
+				 "filename %s, line number %d", _path.c_str(), __FILE__, __LINE__);
+	}
+}
+
+feature::file_sink::~file_sink()
+{
+	if (this->descriptor >= 0)
+	{
+		(void)close();
+	}
+}
+
+bool feature::file_sink::is_open() const
+{
+	return this->descriptor >= 0;
+}
+
+bool feature::file_sink::close()
+{
+	if (this->descriptor < 0)
+	{
+		syslog(LOG_CRIT, "PDF_SINK: the file is not open - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	const int result{::close(this->descriptor)};
+	this->descriptor = -1;
+	if (result != 0)
+	{
+		syslog(LOG_CRIT, "PDF_SINK: failed to close the file - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,442 @@
+/*****************************************************************************
+ * @file    pdf_writer.cpp
+ *
+ * @brief
+ *   Implementation of the native PDF backend.
+ *
+ * @details
+ *   Object numbers are fixed before anything is written: the catalog (1),
+ *   the page tree (2), the Courier font (3), the shared resources (4), one
+ *   form XObject per distinct stamp, then a page object and its content
+ *   stream for every page. The page tree can therefore name its kids up
+ *   front, and the byte offset of each object is noted as it is appended,
+ *   so the xref table follows the last object without a second pass.
+ *
+ *   The objects are appended to a chunk buffer that is handed to the sink
+ *   after the shared objects, after every page and after the trailer, so
+ *   only one page's objects are held at a time. The offsets count the
+ *   bytes already handed over.
+ *
+ *   Layout positions are top-down from the top-left corner; PDF user space
+ *   is bottom-up, so every y is written as the page height minus y. A form
+ *   XObject holds its stamp's runs below its own origin and is drawn with a
+ *   translation to where the page put the stamp.
+ *
+ *   Text is written as WinAnsi bytes in literal strings, with the string
+ *   delimiters and the backslash escaped. Control characters are written as
+ *   blanks. Streams are not compressed.
+ *
+ *****************************************************************************/
+#include <pdf_writer.h>
+#include <pdf_sink.h>
+#include <array>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <charconv>
+#include <syslog.h>
+#include <trace.h>
+
+namespace {
+constexpr char32_t not_encodable{0xFFFFFFFF};
+
+constexpr std::array<char32_t, 32> win_ansi_specials{
+	0x20AC, not_encodable, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+	0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, not_encodable, 0x017D, not_encodable,
+	not_encodable, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+	0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, not_encodable, 0x017E, 0x0178
+};
+
+char32_t next_code_point(std::string_view _text, std::size_t& _index)
+{
+	const unsigned char lead{static_cast<unsigned char>(_text[_index++])};
+	if (lead < 0x80)
+	{
+		return lead;
+	}
+
+	std::size_t length{0};
+	char32_t code_point{0};
+	if ((lead & 0xE0) == 0xC0)
+	{
+		length = 1;
+		code_point = lead & 0x1F;
+	}
+	else if ((lead & 0xF0) == 0xE0)
+	{
+		length = 2;
+		code_point = lead & 0x0F;
+	}
+	else if ((lead & 0xF8) == 0xF0)
+	{
+		length = 3;
+		code_point = lead & 0x07;
+	}
+	else
+	{
+		return not_encodable;
+	}
+
+	for (std::size_t count{0}; count < length; ++count)
+	{
+		if (_index >= _text.size() || (static_cast<unsigned char>(_text[_index]) & 0xC0) != 0x80)
+		{
+			return not_encodable;
+		}
+		code_point = (code_point << 6) | (static_cast<unsigned char>(_text[_index++]) & 0x3F);
+	}
+
+	return code_point;
+}
+
+bool win_ansi(const char32_t& _code_point, unsigned char& _byte)
+{
+	if (_code_point < 0x20)
+	{
+		_byte = ' ';
+		return true;
+	}
+	else if (_code_point < 0x7F || (_code_point >= 0xA0 && _code_point <= 0xFF))
+	{
+		_byte = static_cast<unsigned char>(_code_point);
+		return true;
+	}
+
+	for (std::size_t index{0}; index < win_ansi_specials.size(); ++index)
+	{
+		if (win_ansi_specials[index] == _code_point)
+		{
+			_byte = static_cast<unsigned char>(0x80 + index);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool encode(const std::string& _text, std::string& _encoded)
+{
+	_encoded.clear();
+	for (std::size_t index{0}; index < _text.size();)
+	{
+		unsigned char byte{0};
+		if (win_ansi(next_code_point(_text, index), byte) == false)
+		{
+			return false;
+		}
+
+		if (byte == '(' || byte == ')' || byte == '\\')
+		{
+			_encoded.push_back('\\');
+		}
+		_encoded.push_back(static_cast<char>(byte));
+	}
+
+	return true;
+}
+}
+
+
+feature::pdf_backend feature::parse_pdf_backend(std::string_view _name)
+{
+	if (_name == "native")
+	{
+		return feature::pdf_backend::native;
+	}
+
+	if (_name.empty() == false && _name != "cairo")
+	{
+		syslog(LOG_CRIT, "PDF_WRITER: unknown PDF backend, using cairo - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+
+	return feature::pdf_backend::cairo;
+}
+
+feature::pdf_backend feature::configured_pdf_backend()
+{
+	const char *name{std::getenv(feature::pdf_backend_variable)};
+	return parse_pdf_backend(name == nullptr ? std::string_view{} : std::string_view{name});
+}
+
+feature::text_extent feature::courier_metrics::measure(const std::string& _text, const double& _size)
+{
+	return feature::text_extent{0.0, advance(_text, _size)};
+}
+
+double feature::courier_metrics::advance(std::string_view _text, const double& _size)
+{
+	std::size_t glyphs{0};
+	for (std::size_t index{0}; index < _text.size();)
+	{
+		(void)next_code_point(_text, index);
+		++glyphs;
+	}
+
+	return static_cast<double>(glyphs) * em_advance * _size;
+}
+
+std::string feature::courier_metrics::font() const
+{
+	return "Courier";
+}
+
+
+feature::pdf_writer::pdf_writer() {}
+
+feature::pdf_writer::~pdf_writer() {}
+
+bool feature::pdf_writer::encodable(std::span<const feature::page_layout> _pages) const
+{
+	std::string scratch{""};
+	for (const feature::page_layout& page_layout : _pages)
+	{
+		for (const feature::text_run& run : page_layout.runs)
+		{
+			if (encode(run.text, scratch) == false)
+			{
+				return false;
+			}
+		}
+
+		for (const feature::stamp& stamp : page_layout.stamps)
+		{
+			for (const feature::text_run& run : stamp.runs)
+			{
+				if (encode(run.text, scratch) == false)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+std::string feature::pdf_writer::write(std::span<const feature::page_layout> _pages)
+{
+	feature::buffer_sink sink{this->last_size};
+	if (write(_pages, sink) == false)
+	{
+		return "";
+	}
+	this->last_size = sink.written();
+
+	return sink.take();
+}
+
+bool feature::pdf_writer::write(std::span<const feature::page_layout> _pages, interface::pdf_sink& _sink)
+{
+	TRACE_SPAN("feature", "pdf_writer::write");
+	if (_pages.empty() == true || encodable(_pages) == false)
+	{
+		syslog(LOG_CRIT, "PDF_WRITER: there is nothing the native writer can write - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	std::vector<const feature::stamp*> forms{};
+	auto form_of{[&forms] (const feature::stamp& _stamp) {
+		return std::find_if(forms.cbegin(), forms.cend(), [&_stamp] (const feature::stamp* _form) {
+			return _form->key == _stamp.key && _form->runs == _stamp.runs;
+		});
+	}};
+	for (const feature::page_layout& page_layout : _pages)
+	{
+		for (const feature::stamp& stamp : page_layout.stamps)
+		{
+			if (form_of(stamp) == forms.cend())
+			{
+				forms.push_back(&stamp);
+			}
+		}
+	}
+
+	const std::size_t first_form{5};
+	const std::size_t first_page{first_form + forms.size()};
+	const std::size_t size{first_page + (_pages.size() * 2)};
+	this->offsets.assign(size, 0);
+	this->chunk.clear();
+	this->flushed = 0;
+
+	this->chunk += "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n";
+
+	begin_object(1);
+	this->chunk += "<< /Type /Catalog /Pages 2 0 R >>\nendobj\n";
+
+	begin_object(2);
+	this->chunk += "<< /Type /Pages /Kids [";
+	for (std::size_t page{0}; page < _pages.size(); ++page)
+	{
+		this->chunk += " " + std::to_string(first_page + (page * 2)) + " 0 R";
+	}
+	this->chunk += " ] /Count " + std::to_string(_pages.size()) + " >>\nendobj\n";
+
+	begin_object(3);
+	this->chunk += "<< /Type /Font /Subtype /Type1 /BaseFont /Courier /Encoding /WinAnsiEncoding >>\nendobj\n";
+
+	begin_object(4);
+	this->chunk += "<< /Font << /F1 3 0 R >>";
+	if (forms.empty() == false)
+	{
+		this->chunk += " /XObject <<";
+		for (std::size_t form{0}; form < forms.size(); ++form)
+		{
+			this->chunk += " /S" + std::to_string(form) + " " + std::to_string(first_form + form) + " 0 R";
+		}
+		this->chunk += " >>";
+	}
+	this->chunk += " >>\nendobj\n";
+
+	for (std::size_t form{0}; form < forms.size(); ++form)
+	{
+		this->content.clear();
+		add_runs(forms[form]->runs, 0.0);
+		write_stream(first_form + form,
+			     "/Type /XObject /Subtype /Form /BBox [0 -842 595 842] /Resources << /Font << /F1 3 0 R >> >> ",
+			     this->content);
+	}
+
+	if (flush(_sink) == false)
+	{
+		return false;
+	}
+
+	for (std::size_t page{0}; page < _pages.size(); ++page)
+	{
+		const std::size_t page_object{first_page + (page * 2)};
+		begin_object(page_object);
+		this->chunk += "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 595 842] /Resources 4 0 R /Contents ";
+		this->chunk += std::to_string(page_object + 1) + " 0 R >>\nendobj\n";
+
+		this->content.clear();
+		for (const feature::stamp& stamp : _pages[page].stamps)
+		{
+			this->content += "q 1 0 0 1 0 ";
+			add_number(this->content, page::height - stamp.y);
+			this->content += " cm /S" + std::to_string(form_of(stamp) - forms.cbegin()) + " Do Q\n";
+		}
+		add_runs(_pages[page].runs, page::height);
+		add_rules(_pages[page].rules);
+		write_stream(page_object + 1, "", this->content);
+
+		if (flush(_sink) == false)
+		{
+			return false;
+		}
+	}
+
+	const std::size_t xref{this->flushed};
+	this->chunk += "xref\n0 " + std::to_string(size) + "\n0000000000 65535 f \n";
+	for (std::size_t object{1}; object < size; ++object)
+	{
+		std::array<char, 24> entry{};
+		const int length{std::snprintf(entry.data(), entry.size(), "%010zu 00000 n \n", this->offsets[object])};
+		this->chunk.append(entry.data(), static_cast<std::size_t>(length));
+	}
+	this->chunk += "trailer\n<< /Size " + std::to_string(size) + " /Root 1 0 R >>\nstartxref\n";
+	this->chunk += std::to_string(xref) + "\n%%EOF\n";
+
+	return flush(_sink);
+}
+
+void feature::pdf_writer::begin_object(const std::size_t& _number)
+{
+	this->offsets[_number] = this->flushed + this->chunk.size();
+	this->chunk += std::to_string(_number) + " 0 obj\n";
+}
+
+void feature::pdf_writer::write_stream(const std::size_t& _number, const std::string& _dictionary,
+				       const std::string& _stream)
+{
+	begin_object(_number);
+	this->chunk += "<< " + _dictionary + "/Length " + std::to_string(_stream.size()) + " >>\nstream\n";
+	this->chunk += _stream;
+	this->chunk += "\nendstream\nendobj\n";
+}
+
+bool feature::pdf_writer::flush(interface::pdf_sink& _sink)
+{
+	if (_sink.write(this->chunk.data(), this->chunk.size()) == false)
+	{
+		syslog(LOG_CRIT, "PDF_WRITER: the sink did not take the document - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+	this->flushed += this->chunk.size();
+	this->chunk.clear();
+
+	return true;
+}
+
+void feature::pdf_writer::add_runs(const std::vector<feature::text_run>& _runs, const double& _top)
+{
+	if (_runs.empty() == true)
+	{
+		return;
+	}
+
+	double size{0.0};
+	this->content += "BT\n";
+	for (const feature::text_run& run : _runs)
+	{
+		if (run.size != size)
+		{
+			size = run.size;
+			this->content += "/F1 ";
+			add_number(this->content, size);
+			this->content += " Tf\n";
+		}
+
+		(void)encode(run.text, this->encoded);
+		this->content += "1 0 0 1 ";
+		add_number(this->content, run.x);
+		this->content += " ";
+		add_number(this->content, _top - run.y);
+		this->content += " Tm (";
+		this->content += this->encoded;
+		this->content += ") Tj\n";
+	}
+	this->content += "ET\n";
+}
+
+void feature::pdf_writer::add_rules(const std::vector<feature::rule>& _rules)
+{
+	for (const feature::rule& rule : _rules)
+	{
+		add_number(this->content, rule.width);
+		this->content += " w ";
+		add_number(this->content, rule.x_start);
+		this->content += " ";
+		add_number(this->content, page::height - rule.y);
+		this->content += " m ";
+		add_number(this->content, rule.x_end);
+		this->content += " ";
+		add_number(this->content, page::height - rule.y);
+		this->content += " l S\n";
+	}
+}
+
+void feature::pdf_writer::add_number(std::string& _buffer, const double& _number)
+{
+	std::array<char, 32> digits{};
+	auto [end, error]{std::to_chars(digits.data(), digits.data() + digits.size(), _number, std::chars_format::fixed, 2)};
+	if (error != std::errc{})
+	{
+		_buffer += "0";
+		return;
+	}
+
+	while (end[-1] == '0')
+	{
+		--end;
+	}
+	if (end[-1] == '.')
+	{
+		--end;
+	}
+
+	const std::string_view number{digits.data(), static_cast<std::size_t>(end - digits.data())};
+	_buffer += (number == "-0") ? "0" : number;
+}
@@ -10,47 +10,57 @@
  * page management.
  *
  * generate():
- *  - Validates the supplied std::any data and extracts a data::pdf_statement.
- *  - Creates a Cairo PDF surface writing into a memory stream.
- *  - Initializes font face and performs sequential rendering of:
+ *  - Validates the supplied data::pdf_statement, taken by const reference.
+ *  - Lays the statement out (layout()) with feature::font_service.
+ *  - Hands the pages to feature::pdf_emitter, which draws them on a Cairo PDF
+ *    surface writing into the caller's sink, or into a feature::buffer_sink
+ *    for the string overload.
+ *
+ * layout():
+ *  - Lays out, in sequence:
  *        * header section
  *        * client + business information block
  *        * statement metadata (statement number, date)
  *        * invoice list and table rows
  *        * grand total
  *        * payment method details
- *  - Ensures proper pagination and finalizes the PDF.
+ *  - Pagination is decided here, before anything is drawn.
  *
- * Section-Rendering Methods:
- *  - add_header(): Draws the page title using large typography.
+ * Section Methods:
+ *  - add_header(): Places the page title using large typography.
  *  - add_information(): Prints client and business identity/address pairs.
- *  - add_statement_information(): Renders the statement number and date.
- *  - add_statements(): Renders table headers and delegates line-item output.
- *  - add_items(): Prints each invoice row (ID, date, order number, totals).
+ *  - add_statement_information(): Places the statement number and date.
+ *  - add_statements(): Places table headers and delegates line-item output.
+ *  - add_items(): Places each invoice row (ID, date, order number, totals).
  *  - add_grand_total(): Displays the sum of all invoices.
  *  - add_payment_method(): Displays business banking details and note text.
  *
  * Layout and Alignment:
- *  - Cursor-based positioning relies on current_width/current_height and a
- *    collection of helper alignment methods:
- *        align_to_left_border(), align_to_right_border()
- *        align_to_top_border(), align_information_section()
- *        align_to_first_quarter(), align_to_center()
- *        align_to_second_quarter(), align_to_right_information()
+ *  - The pen of feature::pdf_layout is aligned to the borders and the
+ *    information column, and the placements put text at the left, first
+ *    quarter, center, second quarter or right of the page.
+ *  - pdf_layout::keep() starts a new page before a block that would not
+ *    fit, so content never exceeds the page limits.
  *
- *  - adjust_height() and adjust_payment_height() ensure content never exceeds
- *    page limits, initiating page breaks when required.
+ * Static Regions:
+ *  - The title, the business block, the table titles and the payment method
+ *    are written as stamps keyed by version::layout and the business fields
+ *    they show, and painted from recorded templates (see page_templates.h).
  *
  * Error Handling:
- *  - All rendering steps validate their success and return false on failure.
- *  - syslog is used for logging validation failures or unexpected states.
- *
- * Rendering Backend:
- *  - Cairo::Context and Cairo::PdfSurface are used with stream-based output.
- *  - Cairo text measurement guides alignment-based cursor positioning.
+ *  - syslog is used for logging validation failures.
  *
  ******************************************************************************/
 #include <statement_pdf.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::counter& rendered{utility::metrics::counter_named("pdf.statements_rendered")};
+	utility::metrics::counter& rendered_bytes{utility::metrics::counter_named("pdf.bytes")};
+	utility::metrics::histogram& render_time{utility::metrics::histogram_named("pdf.render_ns")};
+}
 
 namespace font_size {
         constexpr double header{50.0};
@@ -59,506 +69,231 @@ namespace font_size {
 }
 
 namespace width {
-        constexpr double page_width{595.0};
-        constexpr double left_border{20.0};
-        constexpr double right_border{575.0};
         constexpr double header{290.0};
-        constexpr double information_left{40.0};
-        constexpr double information_right{page_width - 40.0};
+        constexpr double order_number{110.0};
+}
+
+namespace version {
+        constexpr std::string_view layout{"statement.1"};
 }
 
 namespace height {
-        constexpr double page_height{842.0};
-        constexpr double top_border{60.0};
-        constexpr double header{top_border + 30.0};
-        constexpr double text_offset{17.0};
-        constexpr double line_offset{10.0};
-        constexpr double space_offset{20.0};
+        constexpr double header{feature::page::top_border + 30.0};
+        constexpr double payment{(feature::page::space_offset * 5) + (feature::page::text_offset * 2)};
 }
 
 
 feature::statement_pdf::statement_pdf() {}
 
+feature::statement_pdf::statement_pdf(const feature::pdf_backend& _backend) : backend{_backend} {}
+
 feature::statement_pdf::~statement_pdf() {}
 
-std::string feature::statement_pdf::generate(const std::any& _data)
+std::string feature::statement_pdf::generate(const data::pdf_statement& _data)
 {
-        std::ostringstream final_pdf{};
-	data::pdf_statement data{std::any_cast<data::pdf_statement> (_data)};
-        if (data.is_valid() == false)
+	feature::buffer_sink sink{this->last_size};
+	if (generate(_data, sink) == false)
+	{
+		return "";
+	}
+	this->last_size = sink.written();
+
+	return sink.take();
+}
+
+bool feature::statement_pdf::generate(const data::pdf_statement& _data, interface::pdf_sink& _sink)
+{
+	TRACE_SPAN("feature", "statement_pdf::generate");
+	utility::metrics::timer render_timer{render_time};
+	const std::size_t start{_sink.written()};
+        bool success{false};
+        if (_data.is_valid() == false)
 	{
                 syslog(LOG_CRIT, "Data is not valid - "
                                  "filename %s, line number %d", __FILE__, __LINE__);
 	}
 	else
         {
-                this->surface = Cairo::PdfSurface::create_for_stream(
-                        [&, this](const unsigned char* _data, unsigned int _length) -> cairo_status_t {
-                                final_pdf.write(reinterpret_cast<const char*>(_data), _length);
-                                return final_pdf.fail() ? CAIRO_STATUS_WRITE_ERROR : CAIRO_STATUS_SUCCESS;
-                        },
-                        this->width, this->height
-                );
-
-		if (this->surface == nullptr)
-		{
-			return "";
-		}
-		else
-		{
-			this->context = Cairo::Context::create(this->surface);
-		}
-
-                if (this->context == nullptr)
-		{
-			this->surface->finish();
-                        return "";
-		}
-                else
-                        this->context->select_font_face("monospace", Cairo::ToyFontFace::Slant::NORMAL, Cairo::ToyFontFace::Weight::NORMAL);
-
-                if (add_header("Statement") == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-		data::client client{(data.get_pdf_invoices())[0].get_client()};
-		data::admin admin{(data.get_pdf_invoices())[0].get_business()};
-                if (add_information(client, admin) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-                if (add_statement_information(data) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-                if (draw_line() == false)
+		std::vector<feature::page_layout> pages{};
+		if (this->backend == feature::pdf_backend::native)
 		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
+			feature::courier_metrics metrics{};
+			pages = layout(_data, metrics);
 		}
 
-                if (add_statements(data) == false)
+		if (pages.empty() == false && this->writer.encodable(pages) == true)
 		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
+			success = this->writer.write(pages, _sink);
 		}
-
-                if (draw_line() == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-                if (add_grand_total(data) == false)
-		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
-		}
-
-                if (add_payment_method((data.get_pdf_invoices())[0].get_business()) == false)
+		else
 		{
-			this->context->show_page();
-			this->surface->finish();
-			return "";
+			success = this->emitter.emit(layout(_data, feature::font_service::instance()), _sink);
 		}
+        }
 
-                this->context->show_page();
-                this->surface->finish();
+        if (success == true)
+        {
+                rendered.add();
+                rendered_bytes.add(_sink.written() - start);
         }
 
-        return final_pdf.str();
+        return success;
 }
 
-bool feature::statement_pdf::add_header(const std::string& _data)
+std::vector<feature::page_layout> feature::statement_pdf::layout(const data::pdf_statement& _data,
+								  interface::text_metrics& _metrics)
 {
-        align_to_top_border();
-        align_to_left_border();
-        add_new_line();
-        this->context->set_font_size(font_size::header);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        this->context->move_to(width::header, height::header);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
+	TRACE_SPAN("feature", "statement_pdf::layout");
+	feature::pdf_layout layout{_metrics};
+	const std::vector<data::pdf_invoice>& pdf_invoices{_data.get_pdf_invoices()};
+	if (pdf_invoices.empty() == true)
+	{
+		return layout.finish();
+	}
+
+	add_header(layout, "Statement");
+	add_information(layout, pdf_invoices[0].get_client(), pdf_invoices[0].get_business());
+	add_statement_information(layout, _data);
+	layout.rule();
+	add_statements(layout, _data);
+	layout.rule();
+	add_grand_total(layout, _data);
+	add_payment_method(layout, pdf_invoices[0].get_business());
+
+	return layout.finish();
 }
 
-bool feature::statement_pdf::add_information(const data::client& _client, const data::admin& _business)
+void feature::statement_pdf::add_header(feature::pdf_layout& _layout, const std::string& _data)
 {
-        align_information_section();
-        add_new_section();
-        std::string client_business_name{_client.get_name()};
-        if (write_to_pdf(client_business_name, font_size::information) == false)
-                return false;
-
-        std::string name{_business.get_name()};
-        if (write_to_pdf_from_right_information(name, font_size::information) == false)
-                return false;
-
-        align_information_section();
-        add_new_line();
-        std::string client_business_address{_client.get_address()};
-        if (write_to_pdf(client_business_address, font_size::information) == false)
-                return false;
-
-        std::string address{_business.get_address()};
-        if (write_to_pdf_from_right_information(address, font_size::information) == false)
-                return false;
-
-        align_information_section();
-        add_new_line();
-        std::string client_business_town{_client.get_town() + ", " + _client.get_area_code()};
-        if (write_to_pdf(client_business_town, font_size::information) == false)
-                return false;
-
-        std::string town{_business.get_town() + ", " + _business.get_area_code()};
-        if (write_to_pdf_from_right_information(town, font_size::information) == false)
-                return false;
-
-        align_information_section();
-        add_new_line();
-        std::string vat_number{"VAT #: " + _client.get_vat_number()};
-        if (write_to_pdf(vat_number, font_size::information) == false)
-                return false;
-
-        std::string cellphone{_business.get_cellphone()};
-        if (write_to_pdf_from_right_information(cellphone, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string email{_business.get_email()};
-        if (write_to_pdf_from_right_information(email, font_size::information) == false)
-                return false;
-
-        return true;
+        _layout.align_to_top();
+        _layout.align(feature::page::left_border);
+        _layout.new_line();
+        _layout.begin_stamp({version::layout, "header", _data});
+        _layout.write_fixed_at(_data, font_size::header, width::header, height::header);
+        _layout.end_stamp();
 }
 
-bool feature::statement_pdf::add_statement_information(const data::pdf_statement& _data)
+void feature::statement_pdf::add_information(feature::pdf_layout& _layout, const data::client& _client,
+                                             const data::admin& _business)
 {
-        align_to_left_border();
-        add_new_section();
-
-        add_new_line();
-        std::string number{"Statement #:... " + _data.get_number()};
-        if (write_to_pdf(number, font_size::information) == false)
-                return false;
+        _layout.align(feature::page::information_left);
+        _layout.new_section();
+        _layout.begin_stamp({version::layout, "business", _business.get_name(), _business.get_address(),
+                             _business.get_town(), _business.get_area_code(), _business.get_cellphone(),
+                             _business.get_email()});
+        _layout.write(_client.get_name(), font_size::information, feature::placement::pen);
+        _layout.write_fixed(_business.get_name(), font_size::information, feature::placement::right_information);
+
+        _layout.align(feature::page::information_left);
+        _layout.new_line();
+        _layout.write(_client.get_address(), font_size::information, feature::placement::pen);
+        _layout.write_fixed(_business.get_address(), font_size::information, feature::placement::right_information);
+
+        _layout.align(feature::page::information_left);
+        _layout.new_line();
+        _layout.write(_client.get_town() + ", " + _client.get_area_code(), font_size::information, feature::placement::pen);
+        _layout.write_fixed(_business.get_town() + ", " + _business.get_area_code(), font_size::information,
+                      feature::placement::right_information);
+
+        _layout.align(feature::page::information_left);
+        _layout.new_line();
+        _layout.write("VAT #: " + _client.get_vat_number(), font_size::information, feature::placement::pen);
+        _layout.write_fixed(_business.get_cellphone(), font_size::information, feature::placement::right_information);
+
+        _layout.new_line();
+        _layout.write_fixed(_business.get_email(), font_size::information, feature::placement::right_information);
+        _layout.end_stamp();
+}
+
+void feature::statement_pdf::add_statement_information(feature::pdf_layout& _layout, const data::pdf_statement& _data)
+{
+        _layout.align(feature::page::left_border);
+        _layout.new_section();
 
-        add_new_line();
-        std::string date{"Date:.......... " + _data.get_date()};
-        if (write_to_pdf(date, font_size::information) == false)
-                return false;
+        _layout.new_line();
+        _layout.write("Statement #:... " + _data.get_number(), font_size::information, feature::placement::pen);
 
-        return true;
+        _layout.new_line();
+        _layout.write("Date:.......... " + _data.get_date(), font_size::information, feature::placement::pen);
 }
 
-bool feature::statement_pdf::add_statements(const data::pdf_statement& _data)
+void feature::statement_pdf::add_statements(feature::pdf_layout& _layout, const data::pdf_statement& _data)
 {
-        align_to_left_border();
-        add_new_section();
-        adjust_height();
-        std::string header_invoice_number{"Invoice #"};
-        if (write_to_pdf(header_invoice_number, font_size::prominent) == false)
-                return false;
+        _layout.align(feature::page::left_border);
+        _layout.new_section();
+        _layout.keep(0.0);
+        _layout.begin_stamp({version::layout, "statements"});
+        _layout.write_fixed("Invoice #", font_size::prominent, feature::placement::pen);
+        _layout.write_fixed("Date", font_size::prominent, feature::placement::first_quarter);
+        _layout.write_fixed("Order #", font_size::prominent, feature::placement::center);
+        _layout.write_fixed("Paid Status", font_size::prominent, feature::placement::second_quarter);
+        _layout.write_fixed("Price", font_size::prominent, feature::placement::right);
+        _layout.end_stamp();
 
-        std::string header_date{"Date"};
-	if (write_to_pdf_in_first_quarter(header_date, font_size::prominent) == false)
-		return false;
-
-        std::string header_order_number{"Order #"};
-        if (write_to_pdf_in_center(header_order_number, font_size::prominent) == false)
-                return false;
-
-        std::string header_paid_status{"Paid Status"};
-        if (write_to_pdf_in_second_quarter(header_paid_status, font_size::prominent) == false)
-                return false;
-
-        std::string header_price{"Price"};
-        if (write_to_pdf_from_right(header_price, font_size::prominent) == false)
-                return false;
-
-        if (add_items(_data.get_pdf_invoices()) == false)
-                return false;
-
-        return true;
+        add_items(_layout, _data.get_pdf_invoices());
 }
 
-bool feature::statement_pdf::add_items(const std::vector<data::pdf_invoice>& _data)
+void feature::statement_pdf::add_items(feature::pdf_layout& _layout, const std::vector<data::pdf_invoice>& _data)
 {
-        add_new_line();
-        add_new_line();
+        _layout.new_line();
+        _layout.new_line();
         for (const data::pdf_invoice& pdf_invoice : _data)
         {
-		data::invoice invoice{pdf_invoice.get_invoice()};
-                this->current_width = width::left_border;
-                if (write_to_pdf("# " + invoice.get_id(), font_size::information) == false)
-			break;
-
-                if (write_to_pdf_in_first_quarter(invoice.get_date() , font_size::information) == false)
-			break;
-
-                if (write_to_pdf_in_second_quarter(invoice.get_paid_status() , font_size::information) == false)
-			break;
-
-                if (write_to_pdf_from_right("R " + invoice.get_grand_total(), font_size::information) == false)
-                // if (write_to_pdf_from_right("R " + goss.str(), font_size::information) == false)
-			break;
-
-		std::vector<std::string> sliced_data{this->slicer.slice(invoice.get_order_number())};
-		if (sliced_data.size() >= 2)
+		const data::invoice& invoice{pdf_invoice.get_invoice()};
+                _layout.align(feature::page::left_border);
+                _layout.write("# " + invoice.get_id(), font_size::information, feature::placement::pen);
+                _layout.write(invoice.get_date(), font_size::information, feature::placement::first_quarter);
+                _layout.write(invoice.get_paid_status(), font_size::information, feature::placement::second_quarter);
+                _layout.write("R " + invoice.get_grand_total(), font_size::information, feature::placement::right);
+
+		const std::string order_number{invoice.get_order_number()};
+		const std::vector<std::string> lines{_layout.wrap(order_number, font_size::information, width::order_number,
+								  utility::hyphenation::off)};
+		if (lines.size() >= 2)
 		{
-			if (std::all_of(sliced_data.cbegin(), sliced_data.cend(), [&] (const std::string& str) {
-				if (write_to_pdf_in_center(str, font_size::information) == false)
-					return false;
-
-				add_new_line();
-				adjust_height();
-
-				return true;
-			}) == false)
+			for (const std::string& line : lines)
 			{
-				return false;
+				_layout.write(line, font_size::information, feature::placement::center);
+				_layout.new_line();
+				_layout.keep(0.0);
 			}
 		}
 		else
 		{
-			if (write_to_pdf_in_center(invoice.get_order_number() , font_size::information) == false)
-				return false;
+			_layout.write(order_number, font_size::information, feature::placement::center);
 		}
 
-                add_new_line();
+                _layout.new_line();
         }
-
-        return true;
 }
 
-bool feature::statement_pdf::add_grand_total(const data::pdf_statement& _data)
+void feature::statement_pdf::add_grand_total(feature::pdf_layout& _layout, const data::pdf_statement& _data)
 {
-        align_to_right_border();
-        add_new_section();
-        adjust_height();
-        std::string grand_total{"Grand Total: R " + _data.get_total()};
-        if (write_to_pdf_from_right(grand_total, font_size::prominent) == false)
-                return false;
-
-        return true;
+        _layout.align(feature::page::right_border);
+        _layout.new_section();
+        _layout.keep(0.0);
+        _layout.write("Grand Total: R " + _data.get_total(), font_size::prominent, feature::placement::right);
 }
 
-bool feature::statement_pdf::add_payment_method(const data::admin& _data)
+void feature::statement_pdf::add_payment_method(feature::pdf_layout& _layout, const data::admin& _data)
 {
-        align_to_left_border();
-        add_new_section();
-        adjust_payment_height();
-        std::string method{"Payment Method"};
-        if (write_to_pdf(method, font_size::prominent) == false)
-                return false;
-
-        add_new_line();
-        std::string bank{"Bank Name:..... " + _data.get_bank()};
-        if (write_to_pdf(bank, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string account{"Account #:..... " + _data.get_account_number()};
-        if (write_to_pdf(account, font_size::information) == false)
-                return false;
-
-        add_new_line();
-        std::string branch{"Branch Code:... " + _data.get_branch_code()};
-        if (write_to_pdf(branch, font_size::information) == false)
-                return false;
-
-        add_new_section();
-        std::string message{_data.get_client_message()};
-        if (write_to_pdf(message, font_size::prominent) == false)
-                return false;
-
-        return true;
-}
+        _layout.align(feature::page::left_border);
+        _layout.new_section();
+        _layout.keep(height::payment);
+        _layout.begin_stamp({version::layout, "payment", _data.get_bank(), _data.get_account_number(),
+                             _data.get_branch_code(), _data.get_client_message()});
+        _layout.write_fixed("Payment Method", font_size::prominent, feature::placement::pen);
 
-bool feature::statement_pdf::write_to_pdf(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
+        _layout.new_line();
+        _layout.write_fixed("Bank Name:..... " + _data.get_bank(), font_size::information, feature::placement::pen);
 
-        return this->context_ok();
-}
+        _layout.new_line();
+        _layout.write_fixed("Account #:..... " + _data.get_account_number(), font_size::information, feature::placement::pen);
 
-bool feature::statement_pdf::write_to_pdf_in_first_quarter(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        align_to_first_quarter(extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
-}
-
-bool feature::statement_pdf::write_to_pdf_in_center(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        align_to_center(extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
-}
-
-bool feature::statement_pdf::write_to_pdf_in_second_quarter(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        align_to_second_quarter(extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
-}
-
-bool feature::statement_pdf::write_to_pdf_from_right(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        align_to_right(extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
-}
-
-bool feature::statement_pdf::write_to_pdf_from_right_information(const std::string& _data, const double& _font_size)
-{
-        this->context->set_font_size(_font_size);
-        Cairo::TextExtents extent;
-        this->context->get_text_extents(_data.c_str(), extent);
-        align_to_right_information(extent);
-        this->context->move_to(this->current_width, this->current_height);
-        this->context->show_text(_data.c_str());
-
-        return this->context_ok();
-}
-
-bool feature::statement_pdf::draw_line()
-{
-        this->current_height += height::line_offset;
-        this->context->set_line_width(1.5);
-        this->context->move_to(width::left_border, this->current_height);
-        this->context->line_to((this->width - width::left_border), this->current_height);
-        this->context->stroke();
-
-        return this->context_ok();
-}
-
-bool feature::statement_pdf::context_ok()
-{
-        return (context->get_target()->get_status() == CAIRO_STATUS_SUCCESS);
-}
-
-void feature::statement_pdf::add_new_line()
-{
-	double next_line = this->current_height + height::text_offset;
-	if (next_line >= (height::page_height - height::top_border)) {
-		this->context->show_page();
-		align_to_top_border();
-		align_to_left_border();
-	}
-
-	std::lock_guard<std::mutex> guard(this->pdf_mutex);
-	this->current_height += height::text_offset;
-}
-
-void feature::statement_pdf::add_new_section()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_height += height::space_offset;
-        this->current_height += height::space_offset;
-}
+        _layout.new_line();
+        _layout.write_fixed("Branch Code:... " + _data.get_branch_code(), font_size::information, feature::placement::pen);
 
-void feature::statement_pdf::align_to_left_border()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_width = width::left_border;
-}
-
-void feature::statement_pdf::align_to_right_border()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_width = width::right_border;
-}
-
-void feature::statement_pdf::align_information_section()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_width = width::information_left;
-}
-
-void feature::statement_pdf::align_to_top_border()
-{
-        std::lock_guard<std::mutex> guard(this->pdf_mutex);
-        this->current_height = height::top_border;
-}
-
-void feature::statement_pdf::align_to_right(const Cairo::TextExtents& _extent)
-{
-        this->current_width = (width::right_border - (_extent.width + _extent.x_bearing));
-}
-
-void feature::statement_pdf::align_to_right_information(const Cairo::TextExtents& _extent)
-{
-        this->current_width = (width::information_right - (_extent.width + _extent.x_bearing));
-}
-
-void feature::statement_pdf::align_to_first_quarter(const cairo_text_extents_t& _extent)
-{
-        this->current_width = ((this->width / 4) - ((_extent.width / 4) + (_extent.x_bearing - 10)));
-}
-
-void feature::statement_pdf::align_to_center(const cairo_text_extents_t& _extent)
-{
-        this->current_width = ((this->width / 2) - ((_extent.width / 2) + _extent.x_bearing));
-}
-
-void feature::statement_pdf::align_to_second_quarter(const cairo_text_extents_t& _extent)
-{
-        this->current_width = ((this->width / 4) - ((_extent.width / 4) + (_extent.x_bearing - 250)));
-}
-
-void feature::statement_pdf::adjust_height()
-{
-        if (this->current_height >= (height::page_height - (height::top_border)))
-        {
-                this->context->show_page();
-                align_to_top_border();
-        }
-}
-
-void feature::statement_pdf::adjust_payment_height()
-{
-        double future_height{this->current_height + (height::space_offset * 5) + (height::text_offset * 2)};
-        if (future_height >= (height::page_height - (height::top_border)))
-        {
-                this->context->show_page();
-                align_to_top_border();
-        }
+        _layout.new_section();
+        _layout.write_fixed(_data.get_client_message(), font_size::prominent, feature::placement::pen);
+        _layout.end_stamp();
 }
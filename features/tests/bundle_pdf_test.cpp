@@ -0,0 +1,121 @@
+/******************************************************************************
+ * @test_list Statement Bundle Test Suite
+ *
+ * @brief
+ *   This suite verifies the bundle generator that renders statements and
+ *   their invoices into one PDF.
+ *
+ * @details
+ *   The following behaviors are tested:
+ *
+ *   1. **Section order**
+ *      - The pages of a bundle are the statement's pages followed by the
+ *        pages of each of its invoices, as the generators lay them out.
+ *
+ *   2. **One document**
+ *      - The bundle loads in Poppler with every section's pages, and is
+ *        smaller than the statement and invoices rendered one by one.
+ *
+ *   3. **Invalid input**
+ *      - Invalid statements are left out of the bundle, and a bundle with
+ *        nothing left in it is empty.
+ *
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <memory>
+#include <gtkmm.h>
+#include <bundle_pdf.h>
+#include <invoice_pdf.h>
+#include <generate_pdf.h>
+#include <statement_pdf.h>
+#include <pdf_statement_data.h>
+#include <poppler/cpp/poppler-document.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) A bundle is the statement's pages followed by its invoices' pages. (Done)
+ * 2) A bundle loads as one document smaller than its parts. (Done)
+ * 3) Invalid statements are left out of the bundle. (Done)
+ ******************************************************************************/
+TEST_GROUP(bundle_pdf_test)
+{
+	feature::bundle_pdf bundle_pdf{};
+	feature::invoice_pdf invoice_pdf{};
+	feature::statement_pdf statement_pdf{};
+	feature::courier_metrics metrics{};
+	data::pdf_statement pdf_statement{};
+	void setup()
+	{
+		std::vector<data::pdf_invoice> pdf_invoices{};
+		for (int i = 0; i < 3; ++i)
+		{
+			data::pdf_invoice pdf_invoice{};
+			pdf_invoice.set_business(test::generate_business_data());
+			pdf_invoice.set_client(test::generate_client_data());
+			pdf_invoice.set_invoice(test::generate_invoice_data("Machining steel"));
+			pdf_invoices.push_back(pdf_invoice);
+		}
+		pdf_statement.set_number("#1");
+		pdf_statement.set_date("2025-06-14");
+		pdf_statement.set_total("1234567898.00");
+		pdf_statement.set_statement(test::generate_statement_data());
+		pdf_statement.set_pdf_invoices(pdf_invoices);
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(bundle_pdf_test, a_bundle_is_the_statement_pages_followed_by_its_invoices_pages)
+{
+	std::vector<feature::page_layout> expected{statement_pdf.layout(pdf_statement, metrics)};
+	for (const data::pdf_invoice& pdf_invoice : pdf_statement.get_pdf_invoices())
+	{
+		for (const feature::page_layout& page_layout : invoice_pdf.layout(pdf_invoice, metrics))
+		{
+			expected.push_back(page_layout);
+		}
+	}
+
+	std::vector<feature::page_layout> pages{bundle_pdf.layout(std::span<const data::pdf_statement>{&pdf_statement, 1}, metrics)};
+
+	CHECK_EQUAL(expected.size(), pages.size());
+	CHECK((expected == pages));
+}
+
+TEST(bundle_pdf_test, a_bundle_loads_as_one_document_smaller_than_its_parts)
+{
+	std::size_t parts{statement_pdf.generate(pdf_statement).size()};
+	for (const data::pdf_invoice& pdf_invoice : pdf_statement.get_pdf_invoices())
+	{
+		parts += invoice_pdf.generate(pdf_invoice).size();
+	}
+
+	const std::string pdf{bundle_pdf.generate(pdf_statement)};
+	std::unique_ptr<poppler::document> document{
+		poppler::document::load_from_raw_data(pdf.data(), static_cast<int>(pdf.size()))};
+
+	CHECK(document != nullptr);
+	CHECK_EQUAL(static_cast<int>(bundle_pdf.layout(std::span<const data::pdf_statement>{&pdf_statement, 1},
+						       feature::font_service::instance()).size()),
+		    document->pages());
+	CHECK(pdf.size() < parts);
+}
+
+TEST(bundle_pdf_test, invalid_statements_are_left_out_of_the_bundle)
+{
+	std::vector<data::pdf_statement> pdf_statements{data::pdf_statement{}, pdf_statement};
+
+	CHECK_EQUAL(bundle_pdf.layout(std::span<const data::pdf_statement>{&pdf_statement, 1}, metrics).size(),
+		    bundle_pdf.layout(pdf_statements, metrics).size());
+	CHECK_EQUAL(true, bundle_pdf.generate(data::pdf_statement{}).empty());
+	CHECK_EQUAL(true, bundle_pdf.generate(std::span<const data::pdf_statement>{}).empty());
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * @test_list Font Service Test Suite
+ *
+ * @brief
+ *   This suite verifies the process-wide font service the PDF generators
+ *   measure text with.
+ *
+ * @details
+ *   The following behaviors are tested:
+ *
+ *   1. **Cairo-equivalent extents**
+ *      - Strings measured from the glyph table have the ink bearing and
+ *        width Cairo reports for them on a PDF surface, including strings
+ *        with blanks and non-ASCII characters.
+ *
+ *   2. **No per-string queries**
+ *      - Once a size and its glyphs are known, measuring more strings makes
+ *        no further Cairo queries.
+ *
+ *   3. **One face per process**
+ *      - The face handed to the emitter is resolved once and shared.
+ *
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <gtkmm.h>
+#include <font_service.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Strings measure as Cairo measures them on a PDF surface. (Done)
+ * 2) Known glyphs are measured without Cairo queries. (Done)
+ * 3) The face is resolved once. (Done)
+ ******************************************************************************/
+TEST_GROUP(font_service_test)
+{
+	feature::font_service& service{feature::font_service::instance()};
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+
+	feature::text_extent cairo_extent(const std::string& _text, const double& _size)
+	{
+		Cairo::RefPtr<Cairo::PdfSurface> surface{Cairo::PdfSurface::create_for_stream(
+				[](const unsigned char*, unsigned int) -> cairo_status_t {
+					return CAIRO_STATUS_SUCCESS;
+				}, feature::page::width, feature::page::height)};
+		Cairo::RefPtr<Cairo::Context> context{Cairo::Context::create(surface)};
+		context->select_font_face("monospace", Cairo::ToyFontFace::Slant::NORMAL, Cairo::ToyFontFace::Weight::NORMAL);
+		context->set_font_size(_size);
+		Cairo::TextExtents extents;
+		context->get_text_extents(_text.c_str(), extents);
+		surface->finish();
+
+		return feature::text_extent{extents.x_bearing, extents.width};
+	}
+};
+
+TEST(font_service_test, strings_measure_as_cairo_measures_them)
+{
+	const std::vector<std::string> texts{"Grand Total: R 1234.00", "  Invoice #  ", "Caf\xC3\xA9 \xE2\x82\xAC 5", "", "   "};
+	for (const double size : {12.0, 15.0, 50.0})
+	{
+		for (const std::string& text : texts)
+		{
+			const feature::text_extent expected{cairo_extent(text, size)};
+			const feature::text_extent measured{service.measure(text, size)};
+			DOUBLES_EQUAL(expected.x_bearing, measured.x_bearing, 0.01);
+			DOUBLES_EQUAL(expected.width, measured.width, 0.01);
+		}
+	}
+}
+
+TEST(font_service_test, known_glyphs_are_measured_without_cairo_queries)
+{
+	(void)service.measure("warm up", 13.0);
+	const feature::font_statistics before{service.statistics()};
+	for (int row{0}; row < 5000; ++row)
+	{
+		(void)service.measure("# " + std::to_string(row) + " Paid R " + std::to_string(row * 7) + ".00", 13.0);
+	}
+	const feature::font_statistics after{service.statistics()};
+
+	CHECK_EQUAL(before.queries, after.queries);
+	CHECK_EQUAL(before.sizes, after.sizes);
+	CHECK(service.measure("R 10.00", 13.0).width > 0.0);
+}
+
+TEST(font_service_test, the_face_is_resolved_once)
+{
+	CHECK(service.face() != nullptr);
+	CHECK((service.face() == feature::font_service::instance().face()));
+}
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * @test_list Page Templates Test Suite
+ *
+ * @brief
+ *   This suite verifies the recorded page templates the PDF emitter paints
+ *   the static regions of invoices and statements from.
+ *
+ * @details
+ *   The following behaviors are tested:
+ *
+ *   1. **One recording per stamp**
+ *      - The same stamp is recorded once and served from the cache after.
+ *
+ *   2. **No stale templates**
+ *      - A stamp whose runs differ from the recorded ones under the same key
+ *        is recorded again.
+ *
+ *   3. **Batches of one business**
+ *      - Generating several invoices for the same business records their
+ *        static regions once.
+ *
+ *   4. **Concurrent documents**
+ *      - Threads generating invoices for the same business at once each
+ *        record and paint their own templates, never a shared surface.
+ *
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <future>
+#include <vector>
+#include <gtkmm.h>
+#include <invoice_pdf.h>
+#include <generate_pdf.h>
+#include <page_templates.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) A stamp is recorded once. (Done)
+ * 2) Changed runs under the same key are recorded again. (Done)
+ * 3) A batch for one business records its static regions once. (Done)
+ * 4) Concurrent documents paint templates of their own thread. (Done)
+ ******************************************************************************/
+TEST_GROUP(page_templates_test)
+{
+	feature::page_templates& templates{feature::page_templates::instance()};
+	feature::stamp stamp{"test\x1f", 100.0, {feature::text_run{20.0, 0.0, 12.0, "Bank Name"}}};
+	void setup()
+	{
+		templates.clear();
+	}
+
+	void teardown()
+	{
+		templates.clear();
+	}
+};
+
+TEST(page_templates_test, a_stamp_is_recorded_once)
+{
+	Cairo::RefPtr<Cairo::RecordingSurface> first{templates.find(stamp)};
+	stamp.y = 400.0;
+	Cairo::RefPtr<Cairo::RecordingSurface> second{templates.find(stamp)};
+
+	CHECK(first != nullptr);
+	CHECK((first == second));
+	CHECK_EQUAL(1, templates.statistics().hits);
+	CHECK_EQUAL(1, templates.statistics().misses);
+	CHECK_EQUAL(1, templates.statistics().entries);
+}
+
+TEST(page_templates_test, changed_runs_under_the_same_key_are_recorded_again)
+{
+	Cairo::RefPtr<Cairo::RecordingSurface> first{templates.find(stamp)};
+	stamp.runs.front().text = "Account #";
+	Cairo::RefPtr<Cairo::RecordingSurface> second{templates.find(stamp)};
+
+	CHECK((first == second) == false);
+	CHECK_EQUAL(0, templates.statistics().hits);
+	CHECK_EQUAL(2, templates.statistics().misses);
+	CHECK_EQUAL(1, templates.statistics().entries);
+}
+
+TEST(page_templates_test, a_batch_for_one_business_records_its_static_regions_once)
+{
+	feature::invoice_pdf invoice_pdf{};
+	data::pdf_invoice pdf_invoice{};
+	pdf_invoice.set_business(test::generate_business_data());
+	pdf_invoice.set_client(test::generate_client_data());
+	pdf_invoice.set_invoice(test::generate_invoice_data("Machining steel"));
+
+	CHECK_EQUAL(false, invoice_pdf.generate(pdf_invoice).empty());
+	const feature::template_statistics first{templates.statistics()};
+	for (int copy{0}; copy < 10; ++copy)
+	{
+		CHECK_EQUAL(false, invoice_pdf.generate(pdf_invoice).empty());
+	}
+	const feature::template_statistics batch{templates.statistics()};
+
+	CHECK(first.misses > 0);
+	CHECK_EQUAL(first.misses, batch.misses);
+	CHECK_EQUAL(first.misses * 10, batch.hits);
+}
+
+TEST(page_templates_test, concurrent_documents_paint_templates_of_their_own_thread)
+{
+	data::pdf_invoice pdf_invoice{};
+	pdf_invoice.set_business(test::generate_business_data());
+	pdf_invoice.set_client(test::generate_client_data());
+	pdf_invoice.set_invoice(test::generate_invoice_data("Machining steel"));
+	struct result {
+		Cairo::RefPtr<Cairo::RecordingSurface> surface{};
+		bool generated{false};
+		std::uint64_t misses{0};
+	};
+
+	std::vector<std::future<result>> documents{};
+	for (int thread{0}; thread < 8; ++thread)
+	{
+		documents.push_back(std::async(std::launch::async, [this, &pdf_invoice] {
+			feature::invoice_pdf invoice_pdf{};
+			result outcome{};
+			outcome.generated = invoice_pdf.generate(pdf_invoice).empty() == false &&
+					    invoice_pdf.generate(pdf_invoice).empty() == false;
+			outcome.surface = feature::page_templates::instance().find(stamp);
+			outcome.misses = feature::page_templates::instance().statistics().misses;
+			return outcome;
+		}));
+	}
+
+	Cairo::RefPtr<Cairo::RecordingSurface> own{templates.find(stamp)};
+	std::vector<result> results{};
+	for (std::future<result>& document : documents)
+	{
+		results.push_back(document.get());
+	}
+
+	for (std::size_t index{0}; index < results.size(); ++index)
+	{
+		CHECK_EQUAL(true, results[index].generated);
+		CHECK(results[index].surface != nullptr);
+		CHECK((results[index].surface == own) == false);
+		CHECK_EQUAL(results.front().misses, results[index].misses);
+		for (std::size_t other{index + 1}; other < results.size(); ++other)
+		{
+			CHECK((results[index].surface == results[other].surface) == false);
+		}
+	}
+	CHECK_EQUAL(1, templates.statistics().misses);
+}
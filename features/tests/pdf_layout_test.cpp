@@ -0,0 +1,275 @@
+/******************************************************************************
+ * @test_list PDF Layout Test Suite
+ *
+ * @brief
+ *   This suite verifies the layout pass of the PDF generators.
+ *
+ * @details
+ *   The following behaviors are tested:
+ *
+ *   1. **Placements**
+ *      - Text is placed at the pen, centered, right-aligned and in the
+ *        statement columns from its measured extents.
+ *
+ *   2. **Pagination**
+ *      - A line that would reach the bottom margin starts a new page with the
+ *        pen back at the top-left corner, and keep() breaks before a block
+ *        that does not fit.
+ *
+ *   3. **Rules and finishing**
+ *      - Rules are recorded on the current page and finish() hands the pages
+ *        over and starts an empty document.
+ *
+ *   4. **Deterministic documents**
+ *      - Laying the same invoice or statement out twice gives equal pages,
+ *        and a long statement runs over several pages.
+ *
+ *   5. **Stamps**
+ *      - Fixed runs are kept relative to the stamp origin under their key,
+ *        so the same section is equal wherever it lands, and fall back to
+ *        plain runs when a page break splits them.
+ *
+ *   6. **Wrapping**
+ *      - Text is wrapped on the advances of the layout's metrics, so the
+ *        same string breaks differently at another size, and the breaks are
+ *        memoized.
+ *
+ *   The text metrics are a fixed-advance fake with the 0.6 em advance of
+ *   Courier, so no Cairo surface is used.
+ *
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <gtkmm.h>
+#include <pdf_layout.h>
+#include <invoice_pdf.h>
+#include <generate_pdf.h>
+#include <statement_pdf.h>
+#include <pdf_statement_data.h>
+extern "C"
+{
+
+}
+
+
+namespace test {
+class fixed_metrics : public interface::text_metrics {
+public:
+	[[nodiscard]] feature::text_extent measure(const std::string& _text, const double& _size) override
+	{
+		return feature::text_extent{1.0, static_cast<double>(_text.size()) * _size * 0.6};
+	}
+
+	[[nodiscard]] double advance(std::string_view _text, const double& _size) override
+	{
+		return static_cast<double>(_text.size()) * _size * 0.6;
+	}
+
+	[[nodiscard]] std::string font() const override
+	{
+		return "fixed";
+	}
+};
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Text is placed from its measured extents. (Done)
+ * 2) A line at the bottom margin starts a new page. (Done)
+ * 3) keep() breaks before a block that does not fit. (Done)
+ * 4) Rules are recorded and finish() starts over. (Done)
+ * 5) Invoices and statements lay out the same every time. (Done)
+ * 6) Stamps hold their runs relative to where they were opened. (Done)
+ * 7) A page break inside a stamp turns it into plain runs. (Done)
+ * 8) Text wraps on the measured advances and reuses its breaks. (Done)
+ ******************************************************************************/
+TEST_GROUP(pdf_layout_test)
+{
+	test::fixed_metrics metrics{};
+	feature::pdf_layout layout{metrics};
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(pdf_layout_test, text_is_placed_from_its_measured_extents)
+{
+	layout.align(feature::page::information_left);
+	layout.write("abcd", 10.0, feature::placement::pen);
+	layout.write("abcd", 10.0, feature::placement::center);
+	layout.write("abcd", 10.0, feature::placement::right);
+	layout.write("abcd", 10.0, feature::placement::right_information);
+	layout.write("abcd", 10.0, feature::placement::first_quarter);
+	layout.write("abcd", 10.0, feature::placement::second_quarter);
+	layout.write_at("Title", 50.0, 350.0, 90.0);
+	std::vector<feature::page_layout> pages{layout.finish()};
+
+	CHECK_EQUAL(1, pages.size());
+	CHECK_EQUAL(7, pages[0].runs.size());
+	DOUBLES_EQUAL(40.0, pages[0].runs[0].x, 0.001);
+	DOUBLES_EQUAL(60.0, pages[0].runs[0].y, 0.001);
+	DOUBLES_EQUAL(284.5, pages[0].runs[1].x, 0.001);
+	DOUBLES_EQUAL(550.0, pages[0].runs[2].x, 0.001);
+	DOUBLES_EQUAL(530.0, pages[0].runs[3].x, 0.001);
+	DOUBLES_EQUAL(151.75, pages[0].runs[4].x, 0.001);
+	DOUBLES_EQUAL(391.75, pages[0].runs[5].x, 0.001);
+	CHECK((feature::text_run{350.0, 90.0, 50.0, "Title"} == pages[0].runs[6]));
+}
+
+TEST(pdf_layout_test, a_line_at_the_bottom_margin_starts_a_new_page)
+{
+	layout.align(feature::page::information_left);
+	for (int line{0}; line < 42; ++line)
+	{
+		layout.new_line();
+	}
+	layout.write("last", 12.0, feature::placement::pen);
+	DOUBLES_EQUAL(774.0, layout.pen_y(), 0.001);
+	DOUBLES_EQUAL(40.0, layout.pen_x(), 0.001);
+
+	layout.new_line();
+	layout.write("next", 12.0, feature::placement::pen);
+	std::vector<feature::page_layout> pages{layout.finish()};
+
+	CHECK_EQUAL(2, pages.size());
+	STRCMP_EQUAL("last", pages[0].runs.back().text.c_str());
+	CHECK((feature::text_run{20.0, 77.0, 12.0, "next"} == pages[1].runs.front()));
+}
+
+TEST(pdf_layout_test, keep_breaks_before_a_block_that_does_not_fit)
+{
+	layout.align(feature::page::right_border);
+	for (int section{0}; section < 17; ++section)
+	{
+		layout.new_section();
+	}
+	layout.keep(0.0);
+	DOUBLES_EQUAL(740.0, layout.pen_y(), 0.001);
+	layout.keep(42.0);
+	layout.write("block", 12.0, feature::placement::pen);
+	std::vector<feature::page_layout> pages{layout.finish()};
+
+	CHECK_EQUAL(2, pages.size());
+	CHECK_EQUAL(true, pages[0].runs.empty());
+	CHECK((feature::text_run{575.0, 60.0, 12.0, "block"} == pages[1].runs.front()));
+}
+
+TEST(pdf_layout_test, rules_are_recorded_and_finish_starts_over)
+{
+	layout.new_line();
+	layout.rule();
+	std::vector<feature::page_layout> pages{layout.finish()};
+
+	CHECK_EQUAL(1, pages.size());
+	CHECK((feature::rule{20.0, 575.0, 87.0, 1.5} == pages[0].rules.front()));
+	DOUBLES_EQUAL(20.0, layout.pen_x(), 0.001);
+	DOUBLES_EQUAL(60.0, layout.pen_y(), 0.001);
+	pages = layout.finish();
+	CHECK_EQUAL(1, pages.size());
+	CHECK_EQUAL(true, pages[0].runs.empty());
+	CHECK_EQUAL(true, pages[0].rules.empty());
+}
+
+TEST(pdf_layout_test, invoices_and_statements_lay_out_the_same_every_time)
+{
+	feature::invoice_pdf invoice_pdf{};
+	feature::statement_pdf statement_pdf{};
+	std::vector<data::pdf_invoice> pdf_invoices{};
+	for (int i = 0; i < 60; ++i)
+	{
+		data::pdf_invoice pdf_invoice;
+		pdf_invoice.set_business(test::generate_business_data());
+		pdf_invoice.set_client(test::generate_client_data());
+		pdf_invoice.set_invoice(test::generate_invoice_data("Machining steel"));
+		pdf_invoices.push_back(pdf_invoice);
+	}
+	data::pdf_statement pdf_statement{};
+	pdf_statement.set_number("#1");
+	pdf_statement.set_date("2025-06-14");
+	pdf_statement.set_total("1234567898.00");
+	pdf_statement.set_statement(test::generate_statement_data());
+	pdf_statement.set_pdf_invoices(pdf_invoices);
+
+	std::vector<feature::page_layout> invoice_pages{invoice_pdf.layout(pdf_invoices[0], metrics)};
+	std::vector<feature::page_layout> statement_pages{statement_pdf.layout(pdf_statement, metrics)};
+
+	CHECK(invoice_pages == invoice_pdf.layout(pdf_invoices[0], metrics));
+	CHECK(statement_pages == statement_pdf.layout(pdf_statement, metrics));
+	CHECK(statement_pages.size() > 1);
+	STRCMP_EQUAL("Statement", statement_pages.front().stamps.front().runs.front().text.c_str());
+	CHECK_EQUAL(1, statement_pages.front().rules.size());
+	CHECK_EQUAL(1, statement_pages.back().rules.size());
+}
+
+TEST(pdf_layout_test, stamps_hold_their_runs_relative_to_where_they_were_opened)
+{
+	std::vector<feature::page_layout> pages{};
+	for (int lines{1}; lines <= 2; ++lines)
+	{
+		for (int line{0}; line < lines; ++line)
+		{
+			layout.new_line();
+		}
+		layout.begin_stamp({"payment", "Bank"});
+		layout.write_fixed("Bank", 12.0, feature::placement::pen);
+		layout.write("R 5.00", 12.0, feature::placement::right);
+		layout.new_line();
+		layout.write_fixed("abcd", 10.0, feature::placement::center);
+		layout.end_stamp();
+		layout.begin_stamp({"empty"});
+		layout.end_stamp();
+		std::vector<feature::page_layout> document{layout.finish()};
+		pages.push_back(document.front());
+	}
+
+	CHECK_EQUAL(1, pages[0].stamps.size());
+	CHECK_EQUAL(1, pages[0].runs.size());
+	STRCMP_EQUAL("payment\x1f" "Bank\x1f", pages[0].stamps[0].key.c_str());
+	DOUBLES_EQUAL(77.0, pages[0].stamps[0].y, 0.001);
+	DOUBLES_EQUAL(94.0, pages[1].stamps[0].y, 0.001);
+	CHECK((feature::text_run{20.0, 0.0, 12.0, "Bank"} == pages[0].stamps[0].runs[0]));
+	CHECK((feature::text_run{284.5, 17.0, 10.0, "abcd"} == pages[0].stamps[0].runs[1]));
+	CHECK((pages[0].stamps == pages[1].stamps) == false);
+	CHECK((pages[0].stamps[0].runs == pages[1].stamps[0].runs));
+}
+
+TEST(pdf_layout_test, a_page_break_inside_a_stamp_turns_it_into_plain_runs)
+{
+	for (int line{0}; line < 42; ++line)
+	{
+		layout.new_line();
+	}
+	layout.begin_stamp({"payment"});
+	layout.write_fixed("Payment Method", 15.0, feature::placement::pen);
+	layout.new_line();
+	layout.write_fixed("Bank", 12.0, feature::placement::pen);
+	layout.end_stamp();
+	std::vector<feature::page_layout> pages{layout.finish()};
+
+	CHECK_EQUAL(2, pages.size());
+	CHECK_EQUAL(true, pages[0].stamps.empty());
+	CHECK_EQUAL(true, pages[1].stamps.empty());
+	CHECK((feature::text_run{20.0, 774.0, 15.0, "Payment Method"} == pages[0].runs.back()));
+	CHECK((feature::text_run{20.0, 77.0, 12.0, "Bank"} == pages[1].runs.front()));
+}
+
+TEST(pdf_layout_test, text_wraps_on_the_measured_advances_and_reuses_its_breaks)
+{
+	utility::line_breaker::instance().clear();
+	const std::vector<std::string> small{layout.wrap("Machining steel shaft", 10.0, 90.0, utility::hyphenation::off)};
+	const std::vector<std::string> large{layout.wrap("Machining steel shaft", 15.0, 90.0, utility::hyphenation::off)};
+	const std::vector<std::string> again{layout.wrap("Machining steel shaft", 10.0, 90.0, utility::hyphenation::off)};
+
+	CHECK_EQUAL(2, small.size());
+	CHECK_EQUAL(std::string{"Machining steel"}, small[0]);
+	CHECK_EQUAL(std::string{"shaft"}, small[1]);
+	CHECK_EQUAL(3, large.size());
+	CHECK_TRUE(small == again);
+	CHECK_EQUAL(1, utility::line_breaker::instance().statistics().hits);
+}
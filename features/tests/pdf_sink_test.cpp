@@ -0,0 +1,171 @@
+/******************************************************************************
+ * @test_list PDF Sink Test Suite
+ *
+ * @brief
+ *   This suite verifies the sinks the PDF generators stream their output
+ *   into, and generation straight into them.
+ *
+ * @details
+ *   The following behaviors are tested:
+ *
+ *   1. **Buffer sink**
+ *      - Bytes are appended in order, counted, and moved out by `take()`.
+ *
+ *   2. **Descriptor sinks**
+ *      - Every byte written to an fd_sink reaches the descriptor, and a
+ *        sink without an open descriptor refuses writes.
+ *      - A file_sink creates its file, and reports a path it cannot open.
+ *      - A file_sink reports whether its file closed, closes it once, and
+ *        refuses writes after it.
+ *
+ *   3. **Streamed generation**
+ *      - An invoice streamed into a memfd is the PDF the string overload
+ *        returns, and a statement streamed into a file is a PDF.
+ *      - Generation into a sink that cannot be written fails.
+ *
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <gtkmm.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <pdf_sink.h>
+#include <invoice_pdf.h>
+#include <generate_pdf.h>
+#include <statement_pdf.h>
+#include <pdf_statement_data.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) A buffer sink keeps the bytes in order and moves them out. (Done)
+ * 2) An fd sink writes every byte to its descriptor. (Done)
+ * 3) A sink without a descriptor refuses writes. (Done)
+ * 4) A streamed invoice is the PDF the string overload returns. (Done)
+ * 5) A statement streams into a file. (Done)
+ * 6) A file sink closes its file once and refuses writes after. (Done)
+ ******************************************************************************/
+TEST_GROUP(pdf_sink_test)
+{
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / "mint-bill-pdf-sink-test"};
+	void setup()
+	{
+		std::filesystem::create_directories(directory);
+	}
+
+	void teardown()
+	{
+		std::filesystem::remove_all(directory);
+	}
+
+	std::string read(const int& _descriptor)
+	{
+		std::string bytes(static_cast<std::size_t>(::lseek(_descriptor, 0, SEEK_END)), '\0');
+		(void)::pread(_descriptor, bytes.data(), bytes.size(), 0);
+		return bytes;
+	}
+
+	data::pdf_invoice invoice()
+	{
+		data::pdf_invoice pdf_invoice{};
+		pdf_invoice.set_business(test::generate_business_data());
+		pdf_invoice.set_client(test::generate_client_data());
+		pdf_invoice.set_invoice(test::generate_invoice_data("Machining steel"));
+		return pdf_invoice;
+	}
+};
+
+TEST(pdf_sink_test, a_buffer_sink_keeps_the_bytes_in_order_and_moves_them_out)
+{
+	feature::buffer_sink sink{64};
+
+	CHECK_EQUAL(true, sink.write("%PDF", 4));
+	CHECK_EQUAL(true, sink.write("-1.4", 4));
+	CHECK_EQUAL(8, sink.written());
+	CHECK_EQUAL("%PDF-1.4", sink.take());
+}
+
+TEST(pdf_sink_test, an_fd_sink_writes_every_byte_to_its_descriptor)
+{
+	const int descriptor{::memfd_create("pdf_sink_test", MFD_CLOEXEC)};
+	const std::string bytes(1 << 20, 'x');
+	{
+		feature::fd_sink sink{descriptor};
+		CHECK_EQUAL(true, sink.write(bytes.data(), bytes.size()));
+		CHECK_EQUAL(bytes.size(), sink.written());
+	}
+
+	CHECK_EQUAL(bytes, read(descriptor));
+	(void)::close(descriptor);
+}
+
+TEST(pdf_sink_test, a_sink_without_a_descriptor_refuses_writes)
+{
+	feature::fd_sink sink{-1};
+	feature::file_sink missing{directory / "missing" / "invoice.pdf"};
+	feature::invoice_pdf invoice_pdf{};
+
+	CHECK_EQUAL(false, sink.write("%PDF", 4));
+	CHECK_EQUAL(false, missing.is_open());
+	CHECK_EQUAL(false, invoice_pdf.generate(invoice(), missing));
+}
+
+TEST(pdf_sink_test, a_streamed_invoice_is_the_pdf_the_string_overload_returns)
+{
+	feature::invoice_pdf invoice_pdf{feature::pdf_backend::native};
+	const int descriptor{::memfd_create("pdf_sink_test", MFD_CLOEXEC)};
+	feature::fd_sink sink{descriptor};
+
+	CHECK_EQUAL(true, invoice_pdf.generate(invoice(), sink));
+	CHECK_EQUAL(invoice_pdf.generate(invoice()), read(descriptor));
+	(void)::close(descriptor);
+}
+
+TEST(pdf_sink_test, a_statement_streams_into_a_file)
+{
+	std::vector<data::pdf_invoice> pdf_invoices(20, invoice());
+	data::pdf_statement pdf_statement{};
+	pdf_statement.set_number("#1");
+	pdf_statement.set_date("2025-06-14");
+	pdf_statement.set_total("1234567898.00");
+	pdf_statement.set_statement(test::generate_statement_data());
+	pdf_statement.set_pdf_invoices(pdf_invoices);
+	feature::statement_pdf statement_pdf{};
+	const std::filesystem::path path{directory / "statement.pdf"};
+	std::size_t written{0};
+	{
+		feature::file_sink sink{path};
+		CHECK_EQUAL(true, sink.is_open());
+		CHECK_EQUAL(true, statement_pdf.generate(pdf_statement, sink));
+		written = sink.written();
+	}
+
+	std::ifstream file{path, std::ios::binary};
+	const std::string bytes{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	CHECK_EQUAL(written, bytes.size());
+	CHECK_EQUAL(0, bytes.rfind("%PDF", 0));
+}
+
+TEST(pdf_sink_test, a_file_sink_closes_its_file_once_and_refuses_writes_after)
+{
+	const std::filesystem::path path{directory / "invoice.pdf"};
+	feature::file_sink sink{path};
+	feature::file_sink missing{directory / "missing" / "invoice.pdf"};
+
+	CHECK_EQUAL(true, sink.write("%PDF", 4));
+	CHECK_EQUAL(true, sink.close());
+	CHECK_EQUAL(false, sink.is_open());
+	CHECK_EQUAL(false, sink.close());
+	CHECK_EQUAL(false, sink.write("%PDF", 4));
+	CHECK_EQUAL(false, missing.close());
+	CHECK_EQUAL(4, std::filesystem::file_size(path));
+}
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * @test_list Native PDF Writer Test Suite
+ *
+ * @brief
+ *   This suite verifies the native PDF backend by loading what it writes
+ *   through Poppler.
+ *
+ * @details
+ *   The following behaviors are tested:
+ *
+ *   1. **Valid documents**
+ *      - Laid out pages with runs, rules and stamps are written as a PDF
+ *        Poppler opens, with every page and its text, escaped delimiters and
+ *        WinAnsi characters included.
+ *
+ *   2. **Encoding limits**
+ *      - Text outside WinAnsi is reported, and the writer writes nothing.
+ *
+ *   3. **Generators on the native backend**
+ *      - Invoices and long statements generated with the native backend
+ *        load in Poppler with the expected page count and text, and text
+ *        the writer cannot encode still yields a PDF through Cairo.
+ *
+ *   4. **Backend selection**
+ *      - MINTBILL_PDF_BACKEND=native selects the native backend; no value,
+ *        "cairo" or an unknown name select Cairo.
+ *
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <memory>
+#include <cstdlib>
+#include <gtkmm.h>
+#include <pdf_writer.h>
+#include <invoice_pdf.h>
+#include <generate_pdf.h>
+#include <statement_pdf.h>
+#include <pdf_statement_data.h>
+#include <poppler/cpp/poppler-page.h>
+#include <poppler/cpp/poppler-document.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Written pages load in Poppler with their text. (Done)
+ * 2) Text outside WinAnsi is not written. (Done)
+ * 3) Native invoices and statements load in Poppler. (Done)
+ * 4) The environment selects the backend, Cairo by default. (Done)
+ ******************************************************************************/
+TEST_GROUP(pdf_writer_test)
+{
+	feature::pdf_writer writer{};
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+
+	std::unique_ptr<poppler::document> load(const std::string& _pdf)
+	{
+		return std::unique_ptr<poppler::document>{
+			poppler::document::load_from_raw_data(_pdf.data(), static_cast<int>(_pdf.size()))};
+	}
+
+	std::string text(const std::unique_ptr<poppler::document>& _document, const int& _page)
+	{
+		std::unique_ptr<poppler::page> page{_document->create_page(_page)};
+		if (page == nullptr)
+		{
+			return "";
+		}
+
+		return page->text().to_latin1();
+	}
+
+	data::pdf_invoice invoice(const std::string& _description)
+	{
+		data::pdf_invoice pdf_invoice{};
+		pdf_invoice.set_business(test::generate_business_data());
+		pdf_invoice.set_client(test::generate_client_data());
+		pdf_invoice.set_invoice(test::generate_invoice_data(_description));
+		return pdf_invoice;
+	}
+};
+
+TEST(pdf_writer_test, written_pages_load_in_poppler_with_their_text)
+{
+	feature::stamp stamp{"payment\x1f", 700.0, {feature::text_run{20.0, 0.0, 15.0, "Payment Method"}}};
+	std::vector<feature::page_layout> pages(2);
+	pages[0].runs.push_back(feature::text_run{20.0, 100.0, 12.0, "Total (incl. VAT) R 10.00"});
+	pages[0].runs.push_back(feature::text_run{20.0, 120.0, 12.0, "Caf\xC3\xA9 \xE2\x82\xAC 5"});
+	pages[0].rules.push_back(feature::rule{20.0, 575.0, 130.0, 1.5});
+	pages[0].stamps.push_back(stamp);
+	stamp.y = 90.0;
+	pages[1].stamps.push_back(stamp);
+	pages[1].runs.push_back(feature::text_run{20.0, 60.0, 12.0, "Back\\slash"});
+
+	CHECK_EQUAL(true, writer.encodable(pages));
+	const std::string pdf{writer.write(pages)};
+	std::unique_ptr<poppler::document> document{load(pdf)};
+
+	CHECK(document != nullptr);
+	CHECK_EQUAL(2, document->pages());
+	CHECK(text(document, 0).find("Total (incl. VAT) R 10.00") != std::string::npos);
+	CHECK(text(document, 0).find("Caf\xE9") != std::string::npos);
+	CHECK(text(document, 0).find("Payment Method") != std::string::npos);
+	CHECK(text(document, 1).find("Payment Method") != std::string::npos);
+	CHECK(text(document, 1).find("Back\\slash") != std::string::npos);
+	CHECK_EQUAL(1, [&pdf] {
+		std::size_t forms{0};
+		for (std::size_t at{pdf.find("/Subtype /Form")}; at != std::string::npos; at = pdf.find("/Subtype /Form", at + 1))
+		{
+			++forms;
+		}
+		return forms;
+	}());
+}
+
+TEST(pdf_writer_test, text_outside_win_ansi_is_not_written)
+{
+	std::vector<feature::page_layout> pages(1);
+	pages[0].runs.push_back(feature::text_run{20.0, 100.0, 12.0, "\xE6\x97\xA5\xE6\x9C\xAC"});
+
+	CHECK_EQUAL(false, writer.encodable(pages));
+	CHECK_EQUAL(true, writer.write(pages).empty());
+	CHECK_EQUAL(true, writer.write(std::vector<feature::page_layout>{}).empty());
+}
+
+TEST(pdf_writer_test, native_invoices_and_statements_load_in_poppler)
+{
+	feature::invoice_pdf invoice_pdf{feature::pdf_backend::native};
+	feature::statement_pdf statement_pdf{feature::pdf_backend::native};
+	std::vector<data::pdf_invoice> pdf_invoices{};
+	for (int i = 0; i < 60; ++i)
+	{
+		pdf_invoices.push_back(invoice("Machining steel"));
+	}
+	data::pdf_statement pdf_statement{};
+	pdf_statement.set_number("#1");
+	pdf_statement.set_date("2025-06-14");
+	pdf_statement.set_total("1234567898.00");
+	pdf_statement.set_statement(test::generate_statement_data());
+	pdf_statement.set_pdf_invoices(pdf_invoices);
+	feature::courier_metrics metrics{};
+
+	std::unique_ptr<poppler::document> invoice_document{load(invoice_pdf.generate(pdf_invoices[0]))};
+	std::unique_ptr<poppler::document> statement_document{load(statement_pdf.generate(pdf_statement))};
+	std::unique_ptr<poppler::document> fallback{load(invoice_pdf.generate(invoice("\xE6\x97\xA5\xE6\x9C\xAC")))};
+
+	CHECK(invoice_document != nullptr);
+	CHECK(text(invoice_document, 0).find("Invoice") != std::string::npos);
+	CHECK(text(invoice_document, 0).find("Labor Description") != std::string::npos);
+	CHECK(statement_document != nullptr);
+	CHECK_EQUAL(static_cast<int>(statement_pdf.layout(pdf_statement, metrics).size()), statement_document->pages());
+	CHECK(statement_document->pages() > 1);
+	CHECK(fallback != nullptr);
+}
+
+TEST(pdf_writer_test, the_environment_selects_the_backend_cairo_by_default)
+{
+	unsetenv(feature::pdf_backend_variable);
+	CHECK(feature::pdf_backend::cairo == feature::configured_pdf_backend());
+
+	setenv(feature::pdf_backend_variable, "native", 1);
+	CHECK(feature::pdf_backend::native == feature::configured_pdf_backend());
+
+	setenv(feature::pdf_backend_variable, "cairo", 1);
+	CHECK(feature::pdf_backend::cairo == feature::configured_pdf_backend());
+
+	setenv(feature::pdf_backend_variable, "postscript", 1);
+	CHECK(feature::pdf_backend::cairo == feature::configured_pdf_backend());
+	unsetenv(feature::pdf_backend_variable);
+}
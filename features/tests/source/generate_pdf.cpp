@@ -84,8 +84,8 @@
  * Design Notes:
  *  - Centralizing test data creation reduces duplication across test suites and
  *    keeps test cases focused on behavior rather than setup.
- *  - Using std::any for bulk collections aligns with the interface::pdf API,
- *    which expects opaque data containers for rendering.
+ *  - Using std::any for bulk collections aligns with the gui::part view API,
+ *    which stores opaque records in its list models.
  *
  ******************************************************************************/
 #include <generate_pdf.h>
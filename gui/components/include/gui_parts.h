@@ -41,12 +41,18 @@
  *               a row is activated.
  *             - statement_pdf_view: supports registration of single-click and
  *               double-click callbacks to propagate selected statements to
- *               higher-level controllers.
+ *               higher-level controllers, appending further pages and an
+ *               end-reached callback fired when the vertical adjustment
+ *               scrolls within one page of the bottom.
  *
  *   - gui::part::search_bar:
  *       * Encapsulates a Gtk::SearchEntry and a simple pub-sub mechanism.
  *         Pages subscribe with a name and callback; whenever the search text
  *         changes, all subscribers are notified with the current keyword.
+ *       * With a suggestion source set, typing shows the matching business
+ *         names in a popover instead; subscribers are only notified once the
+ *         text is a suggested name (picked, or taken with Enter), so pages
+ *         no longer run a full load per keystroke.
  *
  *   - gui::part::dialog:
  *       * Wrapper around Gtk::MessageDialog that exposes a uniform interface
@@ -373,8 +379,11 @@ public:
         [[nodiscard]] virtual std::vector<std::any> extract() override;
 	[[nodiscard]] virtual bool double_click(std::function<void(const std::any&)>) override;
 	[[nodiscard]] virtual bool single_click(std::function<void(const std::vector<std::any>&)>) override;
+	[[nodiscard]] virtual bool append(const std::vector<std::any>&);
+	[[nodiscard]] virtual bool end_reached(std::function<void()>);
 
 private:
+	void scrolled();
 	void edit_statement(uint);
 	void selected_statement(uint, uint);
 	void setup(const Glib::RefPtr<Gtk::ListItem>&);
@@ -389,6 +398,7 @@ private:
         std::shared_ptr<Gio::ListStore<rows::statement_pdf_entries>> store{};
 	std::function<void(const std::any&)> double_click_callback{};
 	std::function<void(const std::vector<std::any>&)> single_click_callback{};
+	std::function<void()> end_reached_callback{};
 
 	enum DURATION {
 		MS_30 = 30
@@ -411,15 +421,25 @@ public:
         [[nodiscard]] virtual bool is_not_valid() const override;
 	[[nodiscard]] virtual bool subscribe(const std::string&,
 				      std::function<void(const std::string&)>) const override;
+	[[nodiscard]] virtual bool set_suggestion_source(
+			std::function<std::vector<std::string>(const std::string&)>);
 
 private:
 	void on_search_changed();
+	void on_search_activated();
+	void on_suggestion_activated(Gtk::ListBoxRow*);
+	void show_suggestions(const std::vector<std::string>&);
+	void notify(const std::string&) const;
 
 private:
 	std::string search_bar_name{""};
 	std::string search_keyword{""};
 	std::string stack_page_name{""};
 	std::unique_ptr<Gtk::SearchEntry> gui_search_bar{};
+	std::unique_ptr<Gtk::Popover> suggestion_popover{};
+	std::unique_ptr<Gtk::ListBox> suggestion_list{};
+	std::vector<std::string> suggestions{};
+	std::function<std::vector<std::string>(const std::string&)> suggestion_source{};
 	mutable std::unordered_map<std::string,
 		std::function<void(const std::string&)>> subscribers{};
 };
@@ -49,9 +49,14 @@
  *         them to a registered single-click callback.
  *
  *   - search_bar:
- *       * create(): binds to a Gtk::SearchEntry and hooks signal_search_changed.
+ *       * create(): binds to a Gtk::SearchEntry, hooks signal_search_changed
+ *         and signal_activate, and parents the suggestion popover to it.
  *       * on_search_changed(): fetches the current keyword and invokes all
  *         subscriber callbacks, enabling cross-page search coordination.
+ *         With a suggestion source, the popover lists the suggested names
+ *         and the subscribers only hear a keyword that is one of them.
+ *       * on_search_activated()/on_suggestion_activated(): Enter takes the
+ *         first suggestion, a click takes the clicked one.
  *       * update(): clears the entry and triggers a fresh notification when
  *         the active stack page changes.
  *
@@ -71,6 +76,7 @@
  * the GUI layer.
  *******************************************************************************/
 #include <gui_parts.h>
+#include <algorithm>
 #include <invoice_pdf.h>
 #include <errors.h>
 #include <invoice_data.h>
@@ -1126,7 +1132,7 @@ void gui::part::statement::invoice_pdf_view::display_invoice(uint _position)
 		return;
 	}
 
-	data::pdf_invoice pdf_invoice{data->pdf_invoice};
+	const data::pdf_invoice& pdf_invoice{data->pdf_invoice};
 	if (pdf_invoice.is_valid() == false)
 	{
 		syslog(LOG_CRIT, "The invoice data is not valid - "
@@ -1407,6 +1413,63 @@ bool gui::part::statement::statement_pdf_view::single_click(std::function<void(c
 	return success;
 }
 
+bool gui::part::statement::statement_pdf_view::append(const std::vector<std::any>& _statements)
+{
+	bool success{false};
+	if (this->is_not_valid())
+	{
+		syslog(LOG_CRIT, "The view or store is not valid - "
+				"filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		success = true;
+		for (const std::any& statement : _statements)
+		{
+			const data::pdf_statement& data{std::any_cast<const data::pdf_statement&> (statement)};
+			if (data.is_valid() == false)
+			{
+				syslog(LOG_INFO, "Skipping a statement without invoices - "
+						"filename %s, line number %d", __FILE__, __LINE__);
+			}
+			else
+			{
+				this->store->append(rows::statement_pdf_entries::create(data));
+			}
+		}
+	}
+
+	return success;
+}
+
+bool gui::part::statement::statement_pdf_view::end_reached(std::function<void()> _callback)
+{
+	bool success{false};
+	if (!_callback || !this->vadjustment)
+	{
+		syslog(LOG_CRIT, "The _callback or vadjustment is not valid - "
+				"filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		success = true;
+		this->end_reached_callback = std::move(_callback);
+		this->vadjustment->signal_value_changed().connect(
+				sigc::mem_fun(*this, &statement_pdf_view::scrolled));
+	}
+
+	return success;
+}
+
+void gui::part::statement::statement_pdf_view::scrolled()
+{
+	double page_size{this->vadjustment->get_page_size()};
+	if (this->vadjustment->get_value() + page_size >= this->vadjustment->get_upper() - page_size)
+	{
+		this->end_reached_callback();
+	}
+}
+
 void gui::part::statement::statement_pdf_view::edit_statement(uint _position)
 {
 	auto item = this->store->get_item(_position);
@@ -1547,7 +1610,13 @@ gui::part::search_bar::search_bar(const std::string& _search_bar_name)
 
 }
 
-gui::part::search_bar::~search_bar() {}
+gui::part::search_bar::~search_bar()
+{
+	if (this->suggestion_popover)
+	{
+		this->suggestion_popover->unparent();
+	}
+}
 
 bool gui::part::search_bar::create(const Glib::RefPtr<Gtk::Builder>& _ui_builder)
 {
@@ -1569,8 +1638,20 @@ bool gui::part::search_bar::create(const Glib::RefPtr<Gtk::Builder>& _ui_builder
 		else
 		{
 			success = true;
+			this->suggestion_list = std::make_unique<Gtk::ListBox>();
+			this->suggestion_list->set_selection_mode(Gtk::SelectionMode::BROWSE);
+			this->suggestion_list->signal_row_activated()
+				.connect(sigc::mem_fun(*this, &search_bar::on_suggestion_activated));
+			this->suggestion_popover = std::make_unique<Gtk::Popover>();
+			this->suggestion_popover->set_child(*this->suggestion_list);
+			this->suggestion_popover->set_autohide(false);
+			this->suggestion_popover->set_has_arrow(false);
+			this->suggestion_popover->set_position(Gtk::PositionType::BOTTOM);
+			this->suggestion_popover->set_parent(*this->gui_search_bar);
 			this->gui_search_bar->signal_search_changed()
 				.connect(sigc::mem_fun(*this, &search_bar::on_search_changed));
+			this->gui_search_bar->signal_activate()
+				.connect(sigc::mem_fun(*this, &search_bar::on_search_activated));
 		}
 	}
 
@@ -1630,6 +1711,24 @@ bool gui::part::search_bar::subscribe(const std::string& _page_name,
 	return success;
 }
 
+bool gui::part::search_bar::set_suggestion_source(
+		std::function<std::vector<std::string>(const std::string&)> _source)
+{
+	bool success{false};
+	if (!_source)
+	{
+		syslog(LOG_CRIT, "The _source is not valid - "
+				"filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		success = true;
+		this->suggestion_source = _source;
+	}
+
+	return success;
+}
+
 void gui::part::search_bar::on_search_changed()
 {
 	if (this->is_not_valid())
@@ -1640,21 +1739,110 @@ void gui::part::search_bar::on_search_changed()
 	else
 	{
 		const std::string keyword{this->gui_search_bar->get_text()};
-		for (const auto& [key, callback] : this->subscribers)
+		if (!this->suggestion_source || keyword.empty())
+		{
+			show_suggestions({});
+			notify(keyword);
+		}
+		else
 		{
-			if (!callback)
+			const std::vector<std::string> names{this->suggestion_source(keyword)};
+			if (std::find(names.begin(), names.end(), keyword) != names.end())
 			{
-				syslog(LOG_CRIT, "The subscriber has not been registered - "
-						"filename %s, line number %d", __FILE__, __LINE__);
+				show_suggestions({});
+				notify(keyword);
 			}
 			else
 			{
-				callback(keyword);
+				show_suggestions(names);
 			}
 		}
 	}
 }
 
+void gui::part::search_bar::on_search_activated()
+{
+	if (this->is_not_valid())
+	{
+		syslog(LOG_CRIT, "The search_bar is not valid - "
+				"filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (this->suggestions.empty())
+	{
+		notify(this->gui_search_bar->get_text());
+	}
+	else
+	{
+		this->gui_search_bar->set_text(this->suggestions.front());
+		this->gui_search_bar->set_position(-1);
+	}
+}
+
+void gui::part::search_bar::on_suggestion_activated(Gtk::ListBoxRow* _row)
+{
+	if (this->is_not_valid() || _row == nullptr)
+	{
+		syslog(LOG_CRIT, "The search_bar or _row is not valid - "
+				"filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		const int index{_row->get_index()};
+		if (index >= 0 && static_cast<std::size_t> (index) < this->suggestions.size())
+		{
+			this->gui_search_bar->set_text(this->suggestions[static_cast<std::size_t> (index)]);
+			this->gui_search_bar->set_position(-1);
+			this->gui_search_bar->grab_focus();
+		}
+	}
+}
+
+void gui::part::search_bar::show_suggestions(const std::vector<std::string>& _names)
+{
+	this->suggestions = _names;
+	if (!this->suggestion_popover || !this->suggestion_list)
+	{
+		return;
+	}
+
+	while (Gtk::ListBoxRow* row = this->suggestion_list->get_row_at_index(0))
+	{
+		this->suggestion_list->remove(*row);
+	}
+
+	for (const std::string& name : this->suggestions)
+	{
+		Gtk::Label* label{Gtk::make_managed<Gtk::Label>(name)};
+		label->set_xalign(0.0);
+		this->suggestion_list->append(*label);
+	}
+
+	if (this->suggestions.empty())
+	{
+		this->suggestion_popover->popdown();
+	}
+	else
+	{
+		this->suggestion_popover->popup();
+	}
+}
+
+void gui::part::search_bar::notify(const std::string& _keyword) const
+{
+	for (const auto& [key, callback] : this->subscribers)
+	{
+		if (!callback)
+		{
+			syslog(LOG_CRIT, "The subscriber has not been registered - "
+					"filename %s, line number %d", __FILE__, __LINE__);
+		}
+		else
+		{
+			callback(_keyword);
+		}
+	}
+}
+
 
 
 
@@ -77,6 +77,7 @@
 #include <errors.h>
 #include <algorithm>
 #include <printer.h>
+#include <trace.h>
 
 
 gui::part::printer::printer(const std::string& _job_name)
@@ -137,6 +138,7 @@ gui::part::printer::printer(const std::string& _job_name)
 
 bool gui::part::printer::print(const std::vector<std::string>& _documents, const std::shared_ptr<Gtk::Window>& _main_window)
 {
+	TRACE_SPAN("printer", "print");
 	bool success{false};
 	if (_documents.empty() || _main_window == nullptr)
 	{
@@ -171,6 +173,7 @@ bool gui::part::printer::print(const std::vector<std::string>& _documents, const
 
 bool gui::part::printer::render_poppler_documents(const std::vector<std::string>& _documents)
 {
+	TRACE_SPAN("printer", "render_poppler_documents");
 	bool success{false};
 	if (_documents.empty())
 	{
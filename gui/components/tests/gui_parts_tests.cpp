@@ -708,6 +708,8 @@ TEST(invoice_pdf_view_test, extract_invoice_view_data_unsuccessfully)
  * 7) Add a column to the list view.
  * 8) Add a single data line to the list view.
  * 9) Populate the list view based on a search.
+ * 10) Append a further page to the list view.
+ * 11) Register an end-reached callback on the list view.
  ******************************************************************************/
 TEST_GROUP(statement_pdf_view_test)
 {
@@ -808,6 +810,38 @@ TEST(statement_pdf_view_test, extract_statement_view_data_after_creation)
 	CHECK_EQUAL(false, records.empty());
 }
 
+TEST(statement_pdf_view_test, append_before_creation)
+{
+	std::vector<std::any> statements = std::move(test::get_pdf_statements("Test business"));
+
+	CHECK_EQUAL(false, statement_pdf_view.append(statements));
+}
+
+TEST(statement_pdf_view_test, append_keeps_the_previous_page)
+{
+	std::vector<std::any> statements = std::move(test::get_pdf_statements("Test business"));
+	(void) statement_pdf_view.create(builder);
+	(void) statement_pdf_view.populate(statements);
+	std::size_t first_page{statement_pdf_view.extract().size()};
+
+	CHECK_EQUAL(true, statement_pdf_view.append(statements));
+	CHECK_EQUAL(2 * first_page, statement_pdf_view.extract().size());
+}
+
+TEST(statement_pdf_view_test, end_reached_without_callback)
+{
+	(void) statement_pdf_view.create(builder);
+
+	CHECK_EQUAL(false, statement_pdf_view.end_reached(nullptr));
+}
+
+TEST(statement_pdf_view_test, end_reached_with_callback)
+{
+	(void) statement_pdf_view.create(builder);
+
+	CHECK_EQUAL(true, statement_pdf_view.end_reached([] () {}));
+}
+
 
 
 
@@ -150,6 +150,7 @@ namespace gui {
                         void invoice_teardown(const Glib::RefPtr<Gtk::ListItem>&);
                         void populate_list_store(const std::vector<data::pdf_invoice>&);
                         void selected_invoice(uint, uint);
+                        void invoices_scrolled();
 
                 private: // View events
                         void connect_material_view();
@@ -185,13 +186,15 @@ namespace gui {
                         std::string paid_status{"Not Paid"};
                         std::string grand_total{""};
 			std::string business_name{""};
+			model::page next_page{};
+			bool last_page_loaded{false};
 			data::admin admin_data{};
 			data::client client_data{};
                         data::invoice invoice_edit{};
                         std::string material_total{""};
                         std::string description_total{""};
                         Glib::Dispatcher email_dispatcher{};
-                        std::vector<std::any> invoices_selected{};
+                        std::vector<data::pdf_invoice> invoices_selected{};
 
                 private: // Member Entries
                         std::unique_ptr<Gtk::Entry> job_card{};
@@ -75,13 +75,17 @@ private:
 	Glib::Dispatcher email_dispatcher{};
 	bool on_double_click();
 	bool on_single_click();
+	void fetch_next_page();
 	void clear();
 
 
 private:
 	std::string database_password{""};
-	std::vector<std::any> documents{};
-	std::vector<std::any> invoice_data{};
+	std::string business_name{""};
+	model::page next_page{};
+	bool last_page_loaded{false};
+	std::vector<data::pdf_statement> documents{};
+	std::vector<data::invoice> invoice_data{};
 	data::pdf_statement selected_pdf_statement{};
 	std::unique_ptr<Gtk::Label> total_label{};
         part::dialog no_item_selected{"statement-no-item-selected-alert"};
@@ -21,6 +21,12 @@
 #include <syslog.h>
 #include <admin_page.h>
 #include <password_manager.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& search_time{utility::metrics::histogram_named("gui.search_ns")};
+}
 
 
 //GCOVR_EXCL_START
@@ -67,6 +73,7 @@ bool gui::admin_page::set_database_password(const std::string& _database_passwor
 
 bool gui::admin_page::search(const std::string& _business_name)
 {
+	utility::metrics::timer search_timer{search_time};
         bool searched{false};
 	clear_entries();
         if (_business_name.empty())
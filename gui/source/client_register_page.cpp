@@ -22,6 +22,12 @@
 #include <syslog.h>
 #include <client_data.h>
 #include <client_register_page.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& search_time{utility::metrics::histogram_named("gui.search_ns")};
+}
 
 //GCOVR_EXCL_START
 gui::client_register_page::~client_register_page()
@@ -66,6 +72,7 @@ bool gui::client_register_page::set_database_password(const std::string& _databa
 
 bool gui::client_register_page::search(const std::string& _business_name)
 {
+	utility::metrics::timer search_timer{search_time};
         bool searched{true};
 	this->clear_all_entries();
         if (_business_name.empty())
@@ -16,9 +16,10 @@
  *   - Validates user input for quantity (integer) and amount (double) columns,
  *     showing error dialogs when formats are incorrect and resetting values
  *     to safe defaults.
- *   - Loads invoice data from the database via model::invoice, converts it
- *     into data::pdf_invoice and data::invoice objects, and populates both the
- *     “known invoices” list and the editable invoice fields.
+ *   - Loads invoice data from the database via model::invoice a page at a
+ *     time, newest first, populates both the “known invoices” list and the
+ *     editable invoice fields, and fetches the next page once the list is
+ *     scrolled near its end.
  *   - Extracts the current GUI state into a data::invoice instance, including
  *     description and material columns tagged with is_description flags, ready
  *     for persistence or further processing.
@@ -37,6 +38,12 @@
 #include <config.h>
 #include <invoice_page.h>
 #include <date_manager.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& search_time{utility::metrics::histogram_named("gui.search_ns")};
+}
 
 
 //GCOVR_EXCL_START
@@ -153,6 +160,7 @@ bool gui::invoice_page::set_database_password(const std::string& _database_passw
 
 bool gui::invoice_page::search(const std::string& _business_name)
 {
+	utility::metrics::timer search_timer{search_time};
         bool searched{false};
 	this->clear();
         if (_business_name.empty() == true)
@@ -1318,15 +1326,11 @@ void gui::invoice_page::populate(const std::string& _business_name)
         {
 		this->business_name.clear();
 		this->business_name = _business_name;
+		this->next_page = model::page{};
+		this->last_page_loaded = false;
 		model::invoice invoice_model{MINTBILL_DB_PATH, this->database_password};
-		std::vector<std::any> db_invoices = invoice_model.load(_business_name);
-		std::vector<data::pdf_invoice> pdf_invoices;
-		std::transform(db_invoices.cbegin(),
-				db_invoices.cend(),
-				std::back_inserter(pdf_invoices),
-				[] (const std::any& _pdf_invoice) {
-					return std::any_cast<data::pdf_invoice> (_pdf_invoice);
-				});
+		const model::documents<data::pdf_invoice> loaded{invoice_model.load_page(_business_name, this->next_page)};
+		const std::vector<data::pdf_invoice>& pdf_invoices{*loaded};
 
 		data::client db_client_data{};
 		data::invoice db_invoice_data{};
@@ -1357,7 +1361,7 @@ void gui::invoice_page::populate(const std::string& _business_name)
 			}
 			else
 			{
-				data::pdf_invoice pdf_latest_invoice(pdf_invoices.back());
+				data::pdf_invoice pdf_latest_invoice(pdf_invoices.front());
 				data::invoice invoice{pdf_latest_invoice.get_invoice()};
 				int new_invoice_number{std::stoi(invoice.get_id())};
 				++new_invoice_number;
@@ -1365,6 +1369,8 @@ void gui::invoice_page::populate(const std::string& _business_name)
 				this->invoice_date->set_text(date_manager.current_date());
 				this->admin_data = pdf_latest_invoice.get_business();
 				this->client_data = pdf_latest_invoice.get_client();
+				this->next_page.before = std::stoll(pdf_invoices.back().get_invoice().get_id());
+				this->last_page_loaded = static_cast<long long> (pdf_invoices.size()) < this->next_page.limit;
 				populate_list_store(pdf_invoices);
 			}
 		}
@@ -1406,9 +1412,37 @@ void gui::invoice_page::connect_invoice_view()
         selection_model->signal_selection_changed().connect(
                         sigc::mem_fun(*this, &invoice_page::selected_invoice));
 
+        if (this->invoices_adjustment)
+        {
+                this->invoices_adjustment->signal_value_changed().connect(
+                        sigc::mem_fun(*this, &invoice_page::invoices_scrolled));
+        }
+
         invoices(this->invoice_view);
 }
 
+void gui::invoice_page::invoices_scrolled()
+{
+        double remaining{this->invoices_adjustment->get_upper() -
+                         this->invoices_adjustment->get_value() -
+                         this->invoices_adjustment->get_page_size()};
+        if (this->last_page_loaded || this->business_name.empty() ||
+            remaining > this->invoices_adjustment->get_page_size())
+        {
+                return;
+        }
+
+        model::invoice invoice_model{MINTBILL_DB_PATH, this->database_password};
+        const model::documents<data::pdf_invoice> loaded{invoice_model.load_page(this->business_name, this->next_page)};
+        const std::vector<data::pdf_invoice>& pdf_invoices{*loaded};
+        this->last_page_loaded = static_cast<long long> (pdf_invoices.size()) < this->next_page.limit;
+        if (pdf_invoices.empty() == false)
+        {
+                this->next_page.before = std::stoll(pdf_invoices.back().get_invoice().get_id());
+                populate_list_store(pdf_invoices);
+        }
+}
+
 void gui::invoice_page::invoices(const std::unique_ptr<Gtk::ListView>& view)
 {
         if (!view)
@@ -1512,9 +1546,6 @@ void gui::invoice_page::populate_list_store(const std::vector<data::pdf_invoice>
                 if (pdf_invoice.is_valid())
                 {
                         this->invoice_store->append(invoice_entries::create(pdf_invoice));
-                        Glib::signal_timeout().connect_once([this]() {
-                                this->invoices_adjustment->set_value(this->invoices_adjustment->get_upper());
-                        }, 30);
                 }
         }
 }
@@ -1543,7 +1574,6 @@ void gui::invoice_page::selected_invoice(uint _position, uint _items_selected)
                 if (!invoice)
                         return;
 
-                data::pdf_invoice temp{invoice->pdf_invoice};
                 this->invoices_selected.push_back(invoice->pdf_invoice);
         }
 }
@@ -17,16 +17,17 @@
  *   - Configures dialog workflows for:
  *       * Email (email_alert) — launches asynchronous email sending via
  *         std::async, prepares data through model::statement, and emits a
- *         Glib::Dispatcher signal to email_sent() on completion.
+ *         Glib::Dispatcher signal to email_sent() on completion. The
+ *         statements and their invoices are sent as one bundled PDF.
  *       * Print (print_alert) — prepares print data via model::statement and
  *         invokes gui::part::printer with the active documents.
  *       * Save (save_alert) — persists the selected statement and related
  *         invoices to the database via model::statement and model::invoice.
  *       * Error/edge conditions such as no selection and no internet.
  *
- *   - Populates the statement listing using model::statement::load(), converts
- *     entries into data::pdf_statement objects, and feeds them into
- *     statement_pdf_view.
+ *   - Populates the statement listing a page at a time using
+ *     model::statement::load_page(), newest first, and appends the next page
+ *     whenever statement_pdf_view reports that its end was reached.
  *
  *   - Reacts to single-clicks on statements to track the currently selected
  *     documents for email/print, and to double-clicks to:
@@ -50,6 +51,12 @@
 #include <printer.h>
 #include <config.h>
 #include <invoice_model.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& search_time{utility::metrics::histogram_named("gui.search_ns")};
+}
 
 
 gui::statement_page::statement_page()
@@ -152,6 +159,7 @@ bool gui::statement_page::set_database_password(const std::string& _database_pas
 
 bool gui::statement_page::search(const std::string& _keyword)
 {
+	utility::metrics::timer search_timer{search_time};
         bool searched{true};
 	this->clear();
 	if (_keyword.empty() == true)
@@ -228,8 +236,13 @@ bool gui::statement_page::email()
 bool gui::statement_page::save()
 {
 	bool success{false};
-	this->invoice_data = this->statement_view.extract();
-	if (invoice_data.empty() == true)
+	this->invoice_data.clear();
+	for (std::any& record : this->statement_view.extract())
+	{
+		this->invoice_data.emplace_back(std::move(std::any_cast<data::invoice&> (record)));
+	}
+
+	if (this->invoice_data.empty() == true)
 	{
 		if (this->no_item_selected.show() == false)
 		{
@@ -280,7 +293,8 @@ bool gui::statement_page::email_setup(const Glib::RefPtr<Gtk::Builder>& _ui_buil
 						{
 							this->email_future = std::move(std::async(std::launch::async, [this] () {
 								model::statement statement_model{MINTBILL_DB_PATH,
-												 this->database_password};
+												 this->database_password,
+												 model::attachments::bundle};
 								data::email data{statement_model.prepare_for_email(this->documents)};
 								feature::email email;
 								bool result{email.send(data)};
@@ -412,9 +426,8 @@ bool gui::statement_page::save_setup(const Glib::RefPtr<Gtk::Builder>& _ui_build
 							{
 								model::invoice invoice_model{MINTBILL_DB_PATH,
 											     this->database_password};
-								for (const std::any& data : this->invoice_data)
+								for (const data::invoice& invoice : this->invoice_data)
 								{
-									data::invoice invoice{std::any_cast<data::invoice> (data)};
 									if (invoice_model.save(invoice) == false)
 									{
 										syslog(LOG_CRIT, "STATEMENT_PAGE: Failed to save associated invoice - "
@@ -455,20 +468,43 @@ bool gui::statement_page::save_setup(const Glib::RefPtr<Gtk::Builder>& _ui_build
 
 bool gui::statement_page::populate(const std::string& _business_name)
 {
-	std::vector<std::any> pdf_statements{};
-	model::statement statement_model{MINTBILL_DB_PATH, this->database_password};
-	for (const std::any& data : statement_model.load(_business_name))
+	this->business_name = _business_name;
+	this->next_page = model::page{};
+	this->last_page_loaded = false;
+	if (this->statement_pdf_view.clear() == false)
 	{
-		data::pdf_statement pdf_statement{std::any_cast<data::pdf_statement>(data)};
-		pdf_statements.emplace_back(pdf_statement);
+		return false;
 	}
 
-	if (this->statement_pdf_view.populate(pdf_statements) == false)
+	this->fetch_next_page();
+
+	return this->statement_pdf_view.extract().empty() == false;
+}
+
+void gui::statement_page::fetch_next_page()
+{
+	if (this->last_page_loaded == true || this->business_name.empty() == true)
 	{
-		return false;
+		return;
 	}
 
-	return true;
+	model::statement statement_model{MINTBILL_DB_PATH, this->database_password};
+	const model::documents<data::pdf_statement> loaded{statement_model.load_page(this->business_name, this->next_page)};
+	if (static_cast<long long> (loaded->size()) < this->next_page.limit)
+	{
+		this->last_page_loaded = true;
+	}
+
+	if (loaded->empty() == false)
+	{
+		this->next_page.before = std::stoll(loaded->back().get_number());
+		std::vector<std::any> pdf_statements(loaded->begin(), loaded->end());
+		if (this->statement_pdf_view.append(pdf_statements) == false)
+		{
+			syslog(LOG_CRIT, "STATEMENT_PAGE: Failed to append the next page of statements - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+	}
 }
 
 bool gui::statement_page::no_item_selected_setup(const Glib::RefPtr<Gtk::Builder>& _ui_builder)
@@ -693,6 +729,12 @@ bool gui::statement_page::statement_pdf_view_setup(const Glib::RefPtr<Gtk::Build
 				syslog(LOG_CRIT, "STATEMENT_PAGE: The pdf_statements is not valid - "
 						 "filename %s, line number %d", __FILE__, __LINE__);
 			}
+
+			if (this->statement_pdf_view.end_reached([this] () { this->fetch_next_page(); }) == false)
+			{
+				syslog(LOG_CRIT, "STATEMENT_PAGE: Failed to connect the statement paging - "
+						 "filename %s, line number %d", __FILE__, __LINE__);
+			}
 			success = true;
 		}
 	}
@@ -704,7 +746,7 @@ bool gui::statement_page::on_double_click()
 {
 	return this->statement_pdf_view.double_click([this] (const std::any& _data) {
 		bool success{true};
-		data::pdf_statement pdf_statement_data{std::any_cast<data::pdf_statement> (_data)};
+		const data::pdf_statement& pdf_statement_data{std::any_cast<const data::pdf_statement&> (_data)};
 		if (pdf_statement_data.is_valid() == false)
 		{
 			syslog(LOG_CRIT, "STATEMENT_PAGE: The pdf_statement data is not valid - "
@@ -759,7 +801,11 @@ bool gui::statement_page::on_single_click()
 		else
 		{
 			this->documents.clear();
-			this->documents = _pdf_statements;
+			this->documents.reserve(_pdf_statements.size());
+			for (const std::any& pdf_statement : _pdf_statements)
+			{
+				this->documents.emplace_back(std::any_cast<const data::pdf_statement&> (pdf_statement));
+			}
 		}
 
 		return success;
@@ -51,6 +51,9 @@ DROP TABLE IF EXISTS client;
 DROP TABLE IF EXISTS statement;
 DROP TABLE IF EXISTS invoice;
 DROP TABLE IF EXISTS labor;
+DROP TABLE IF EXISTS business_search;
+DROP TABLE IF EXISTS invoice_search;
+DROP TABLE IF EXISTS labor_search;
 
 -- --------------------------------------------------------------------------------------------
 -- Table: business_details
@@ -147,6 +150,11 @@ CREATE TABLE client (
 --  Constraints:
 --    • UNIQUE (business_id, period_start, period_end)
 --        - Prevents multiple statements for the same business and period.
+--
+--  Maintained aggregates (kept by the statement_totals_* triggers below):
+--    • invoice_count : number of invoices linked through statement_id.
+--    • total_cents   : their grand totals in integer cents.
+--    • unpaid_cents  : the grand totals of those still 'Not Paid'.
 -- --------------------------------------------------------------------------------------------
 CREATE TABLE statement (
 	statement_id   INTEGER PRIMARY KEY,
@@ -155,6 +163,9 @@ CREATE TABLE statement (
 	period_end     TEXT    NOT NULL,  
 	statement_date TEXT    NOT NULL DEFAULT (date('now')),
 	paid_status    TEXT    NOT NULL DEFAULT 'Not Paid', 
+	invoice_count  INTEGER NOT NULL DEFAULT 0,
+	total_cents    INTEGER NOT NULL DEFAULT 0,
+	unpaid_cents   INTEGER NOT NULL DEFAULT 0,
 
 	FOREIGN KEY (business_id) REFERENCES client(business_id)
 		ON DELETE CASCADE ON UPDATE CASCADE,
@@ -183,6 +194,12 @@ CREATE TABLE statement (
 --  Constraints:
 --    • UNIQUE (business_id, order_number, job_card_number)
 --        - Prevents duplicate invoices with the same business + order + job card combo.
+--
+--  Generated columns (virtual, computed on read or when indexed):
+--    • total_cents : grand_total as integer cents, thousands separators removed.
+--    • created_on  : date_created as an ISO date (YYYY-MM-DD), whether it was written as
+--                    "Oct-09-2025", "10-9-2025", "10/9/2025" or ISO.
+--    The report model aggregates over these; it adds them to older databases.
 -- --------------------------------------------------------------------------------------------
 CREATE TABLE invoice (
 	invoice_id		INTEGER PRIMARY KEY,
@@ -195,6 +212,25 @@ CREATE TABLE invoice (
 	material_total		TEXT NOT NULL,
 	description_total	TEXT NOT NULL,
 	grand_total		TEXT NOT NULL,
+	total_cents		INTEGER GENERATED ALWAYS AS (
+		CAST(round(CAST(replace(grand_total, ',', '') AS REAL) * 100) AS INTEGER)
+	) VIRTUAL,
+	created_on		TEXT GENERATED ALWAYS AS (
+		CASE
+			WHEN date_created GLOB '[0-9][0-9][0-9][0-9]-[0-9][0-9]-[0-9][0-9]*'
+				THEN substr(date_created, 1, 10)
+			ELSE printf('%04d-%02d-%02d',
+				CAST(substr(substr(replace(date_created, '/', '-'), instr(replace(date_created, '/', '-'), '-') + 1),
+					    instr(substr(replace(date_created, '/', '-'), instr(replace(date_created, '/', '-'), '-') + 1), '-') + 1) AS INTEGER),
+				CASE
+					WHEN date_created GLOB '[0-9]*'
+						THEN CAST(substr(replace(date_created, '/', '-'), 1, instr(replace(date_created, '/', '-'), '-') - 1) AS INTEGER)
+					ELSE (instr('JanFebMarAprMayJunJulAugSepOctNovDec', substr(date_created, 1, 3)) + 2) / 3
+				END,
+				CAST(substr(substr(replace(date_created, '/', '-'), instr(replace(date_created, '/', '-'), '-') + 1), 1,
+					    instr(substr(replace(date_created, '/', '-'), instr(replace(date_created, '/', '-'), '-') + 1), '-') - 1) AS INTEGER))
+		END
+	) VIRTUAL,
 	FOREIGN KEY (business_id) REFERENCES client(business_id)
 		ON DELETE CASCADE ON UPDATE CASCADE,
 	FOREIGN KEY (statement_id) REFERENCES statement(statement_id)
@@ -240,4 +276,201 @@ CREATE TABLE labor (
 	UNIQUE(invoice_id, line_number, is_description)
 );
 
+-- --------------------------------------------------------------------------------------------
+-- Indices
+-- --------------------------------------------------------------------------------------------
+--  Purpose:
+--    Back the keyset-paginated list queries (newest first) used by the invoice and statement
+--    pages, and the invoice lookup by statement.
+--
+--    • invoice_business_page_idx   : WHERE business_id = ? AND invoice_id < ?
+--                                    ORDER BY invoice_id DESC LIMIT ?
+--    • statement_business_page_idx : WHERE business_id = ? AND statement_id < ?
+--                                    ORDER BY statement_id DESC LIMIT ?
+--    • invoice_statement_idx       : WHERE statement_id = ? (also serves ON DELETE SET NULL)
+--
+--  The models issue the same CREATE INDEX IF NOT EXISTS statements, so databases created
+--  before these indices existed pick them up on first use.
+-- --------------------------------------------------------------------------------------------
+CREATE INDEX IF NOT EXISTS invoice_business_page_idx ON invoice (business_id, invoice_id);
+CREATE INDEX IF NOT EXISTS statement_business_page_idx ON statement (business_id, statement_id);
+CREATE INDEX IF NOT EXISTS invoice_statement_idx ON invoice (statement_id);
+
+-- --------------------------------------------------------------------------------------------
+-- Report indices
+-- --------------------------------------------------------------------------------------------
+--  Purpose:
+--    Cover the aggregate queries of the report model so month-end figures read index pages
+--    only.
+--
+--    • invoice_period_idx : revenue per month and top clients, WHERE created_on BETWEEN ? AND ?
+--    • invoice_unpaid_idx : aged receivables and unpaid per client, WHERE paid_status = 'Not Paid'
+-- --------------------------------------------------------------------------------------------
+CREATE INDEX IF NOT EXISTS invoice_period_idx ON invoice (created_on, business_id, paid_status, total_cents);
+CREATE INDEX IF NOT EXISTS invoice_unpaid_idx ON invoice (paid_status, business_id, created_on, total_cents);
+
+-- --------------------------------------------------------------------------------------------
+-- Statement totals
+-- --------------------------------------------------------------------------------------------
+--  Purpose:
+--    Keep statement.invoice_count, total_cents and unpaid_cents equal to the aggregates of
+--    the invoices linked to each statement, so statement pages read them from one row.
+--
+--    • statement_totals_insert : adds a linked invoice to its statement.
+--    • statement_totals_delete : subtracts a deleted one.
+--    • statement_totals_update : recomputes the old and new statement when statement_id,
+--                                grand_total or paid_status change; recomputing keeps the
+--                                cascades from statement (ON UPDATE CASCADE, ON DELETE SET
+--                                NULL) from being counted twice.
+--
+--  The totals model issues the same statements, and recomputes every statement, when the
+--  columns or triggers are missing; mint-bill-verify diffs the stored totals against the
+--  invoices.
+-- --------------------------------------------------------------------------------------------
+CREATE TRIGGER IF NOT EXISTS statement_totals_insert
+AFTER INSERT ON invoice
+WHEN NEW.statement_id IS NOT NULL
+BEGIN
+	UPDATE statement SET
+		invoice_count = invoice_count + 1,
+		total_cents   = total_cents + NEW.total_cents,
+		unpaid_cents  = unpaid_cents + CASE WHEN NEW.paid_status = 'Not Paid' THEN NEW.total_cents ELSE 0 END
+	WHERE statement_id = NEW.statement_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS statement_totals_delete
+AFTER DELETE ON invoice
+WHEN OLD.statement_id IS NOT NULL
+BEGIN
+	UPDATE statement SET
+		invoice_count = invoice_count - 1,
+		total_cents   = total_cents - OLD.total_cents,
+		unpaid_cents  = unpaid_cents - CASE WHEN OLD.paid_status = 'Not Paid' THEN OLD.total_cents ELSE 0 END
+	WHERE statement_id = OLD.statement_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS statement_totals_update
+AFTER UPDATE OF statement_id, grand_total, paid_status ON invoice
+WHEN OLD.statement_id IS NOT NEW.statement_id
+  OR OLD.grand_total IS NOT NEW.grand_total
+  OR OLD.paid_status IS NOT NEW.paid_status
+BEGIN
+	UPDATE statement SET (invoice_count, total_cents, unpaid_cents) = (
+		SELECT
+			count(*),
+			coalesce(sum(i.total_cents), 0),
+			coalesce(sum(CASE WHEN i.paid_status = 'Not Paid' THEN i.total_cents ELSE 0 END), 0)
+		FROM invoice i
+		WHERE i.statement_id = statement.statement_id
+	)
+	WHERE statement_id IN (OLD.statement_id, NEW.statement_id);
+END;
+
+-- --------------------------------------------------------------------------------------------
+-- Full-text search
+-- --------------------------------------------------------------------------------------------
+--  Purpose:
+--    Back the as-you-type search bar with FTS5 prefix queries instead of exact-name lookups.
+--
+--    • business_search : business_name, email_address          (rowid = business_id)
+--    • invoice_search  : order_number, job_card_number         (rowid = invoice_id)
+--    • labor_search    : description, invoice_id (unindexed)   (rowid = labor_id)
+--
+--  The triggers keep the tables in step with business_details, invoice and labor. The
+--  search model issues the same statements when invoice_search is missing and then indexes
+--  the existing rows once, so older databases pick the search up on first use.
+-- --------------------------------------------------------------------------------------------
+CREATE VIRTUAL TABLE IF NOT EXISTS business_search USING fts5(
+	business_name,
+	email_address,
+	tokenize = 'unicode61 remove_diacritics 2',
+	prefix = '1 2 3 4 5 6'
+);
+
+CREATE VIRTUAL TABLE IF NOT EXISTS invoice_search USING fts5(
+	order_number,
+	job_card_number,
+	tokenize = 'unicode61 remove_diacritics 2',
+	prefix = '1 2 3 4 5 6'
+);
+
+CREATE VIRTUAL TABLE IF NOT EXISTS labor_search USING fts5(
+	description,
+	invoice_id UNINDEXED,
+	tokenize = 'unicode61 remove_diacritics 2',
+	prefix = '1 2 3 4 5 6'
+);
+
+CREATE TRIGGER IF NOT EXISTS business_search_insert
+AFTER INSERT ON business_details
+BEGIN
+	INSERT INTO business_search (rowid, business_name, email_address)
+	VALUES (NEW.business_id, NEW.business_name, NEW.email_address);
+END;
+
+CREATE TRIGGER IF NOT EXISTS business_search_update
+AFTER UPDATE OF business_id, business_name, email_address ON business_details
+WHEN OLD.business_id IS NOT NEW.business_id
+  OR OLD.business_name IS NOT NEW.business_name
+  OR OLD.email_address IS NOT NEW.email_address
+BEGIN
+	DELETE FROM business_search WHERE rowid = OLD.business_id;
+	INSERT INTO business_search (rowid, business_name, email_address)
+	VALUES (NEW.business_id, NEW.business_name, NEW.email_address);
+END;
+
+CREATE TRIGGER IF NOT EXISTS business_search_delete
+AFTER DELETE ON business_details
+BEGIN
+	DELETE FROM business_search WHERE rowid = OLD.business_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS invoice_search_insert
+AFTER INSERT ON invoice
+BEGIN
+	INSERT INTO invoice_search (rowid, order_number, job_card_number)
+	VALUES (NEW.invoice_id, NEW.order_number, NEW.job_card_number);
+END;
+
+CREATE TRIGGER IF NOT EXISTS invoice_search_update
+AFTER UPDATE OF invoice_id, order_number, job_card_number ON invoice
+WHEN OLD.invoice_id IS NOT NEW.invoice_id
+  OR OLD.order_number IS NOT NEW.order_number
+  OR OLD.job_card_number IS NOT NEW.job_card_number
+BEGIN
+	DELETE FROM invoice_search WHERE rowid = OLD.invoice_id;
+	INSERT INTO invoice_search (rowid, order_number, job_card_number)
+	VALUES (NEW.invoice_id, NEW.order_number, NEW.job_card_number);
+END;
+
+CREATE TRIGGER IF NOT EXISTS invoice_search_delete
+AFTER DELETE ON invoice
+BEGIN
+	DELETE FROM invoice_search WHERE rowid = OLD.invoice_id;
+END;
+
+CREATE TRIGGER IF NOT EXISTS labor_search_insert
+AFTER INSERT ON labor
+BEGIN
+	INSERT INTO labor_search (rowid, description, invoice_id)
+	VALUES (NEW.labor_id, NEW.description, NEW.invoice_id);
+END;
+
+CREATE TRIGGER IF NOT EXISTS labor_search_update
+AFTER UPDATE OF labor_id, invoice_id, description ON labor
+WHEN OLD.labor_id IS NOT NEW.labor_id
+  OR OLD.invoice_id IS NOT NEW.invoice_id
+  OR OLD.description IS NOT NEW.description
+BEGIN
+	DELETE FROM labor_search WHERE rowid = OLD.labor_id;
+	INSERT INTO labor_search (rowid, description, invoice_id)
+	VALUES (NEW.labor_id, NEW.description, NEW.invoice_id);
+END;
+
+CREATE TRIGGER IF NOT EXISTS labor_search_delete
+AFTER DELETE ON labor
+BEGIN
+	DELETE FROM labor_search WHERE rowid = OLD.labor_id;
+END;
+
 COMMIT;
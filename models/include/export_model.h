@@ -0,0 +1,225 @@
+/*******************************************************************************
+ * @file export_model.h
+ *
+ * @brief Streaming export of invoices, labor lines and statements.
+ *
+ * @details
+ * Declares `model::exporter`, which writes the book out for accounting as
+ * CSV or JSON Lines (see export_writer.h) without loading it:
+ *
+ *  - `write()`       : one stream holding every selected client's rows.
+ *  - `write_split()` : one file per client in a directory, the clients
+ *                      shared between worker threads that each open their
+ *                      own connection. A client's file is named
+ *                      `<business_id>-<name>.<kind>.<csv|jsonl>`; the name
+ *                      keeps letters, digits, '-' and '_' and replaces the
+ *                      rest with '_', so the id is what keeps "A&B" and "A/B"
+ *                      apart.
+ *
+ * What is exported is chosen by `model::export_kind`:
+ *
+ *  - `invoices`   : one row per invoice header, with the ISO date and the
+ *                   total in cents next to the stored text.
+ *  - `labor`      : one row per labor line, keyed by invoice_id.
+ *  - `statements` : one row per statement, with the invoice count, total and
+ *                   unpaid total the statement row maintains.
+ *
+ * and narrowed by `model::export_filter`: an inclusive ISO date range over
+ * the invoices' `created_on` (a statement is exported when one of its
+ * invoices falls in the range; without a range every statement is), and the
+ * business names of the clients to export (empty means every client).
+ *
+ * Rows go from the `storage::database::sqlite::stream()` cursor straight to
+ * the writer, one client at a time in business-name order and, within a
+ * client, in invoice or statement id order. Every per-client query walks an
+ * index on business_id in id order, so the export is a single pass without
+ * a sort, and the memory it needs is one row plus the client list however
+ * many rows are written. Querying per client rather than once over the
+ * whole book is what avoids the sort: in id order across all clients,
+ * a year of labor lines needed a temporary b-tree and took six times as
+ * long.
+ *
+ * Like the search and report models, the exporter keeps its connection open;
+ * the constructor prepares the generated invoice columns and the statement
+ * totals (see totals_model.h) on a database that predates them.
+ * `write()` uses that connection, so one exporter runs one export at a time.
+ ******************************************************************************/
+#ifndef _EXPORT_MODEL_H_
+#define _EXPORT_MODEL_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <utility>
+#include <filesystem>
+#include <sqlite.h>
+#include <export_writer.h>
+
+namespace model {
+enum class export_kind {
+	invoices = 0,
+	labor,
+	statements
+};
+
+enum class export_format {
+	csv = 0,
+	jsonl
+};
+
+struct export_filter {
+	std::string from{""};
+	std::string to{""};
+	std::vector<std::string> clients{};
+};
+
+class exporter {
+public:
+	exporter() = delete;
+	explicit exporter(const std::string&, const std::string&);
+	exporter(const exporter&) = delete;
+	exporter(exporter&&) = delete;
+	exporter& operator=(const exporter&) = delete;
+	exporter& operator=(exporter&&) = delete;
+	virtual ~exporter();
+
+	[[nodiscard]] virtual bool is_available() const;
+	[[nodiscard]] virtual bool write(std::ostream&, const model::export_kind&, const model::export_format&,
+					 const model::export_filter&, std::size_t&) const;
+	[[nodiscard]] virtual bool write_split(const std::filesystem::path&, const model::export_kind&,
+					       const model::export_format&, const model::export_filter&,
+					       const std::size_t&, std::size_t&) const;
+	[[nodiscard]] static std::string file_name(const std::string&, const model::export_kind&,
+						   const model::export_format&);
+	[[nodiscard]] static std::string file_name(const sqlite3_int64&, const std::string&, const model::export_kind&,
+						   const model::export_format&);
+
+private:
+	using client = std::pair<sqlite3_int64, std::string>;
+
+	[[nodiscard]] static bool select_clients(storage::database::sqlite&, const model::export_filter&,
+						 std::vector<client>&);
+	[[nodiscard]] static bool write_client(storage::database::sqlite&, interface::record_writer&,
+					       const model::export_kind&, const model::export_filter&,
+					       const sqlite3_int64&, std::size_t&);
+	[[nodiscard]] static std::unique_ptr<interface::record_writer> make_writer(std::ostream&,
+										  const model::export_format&);
+
+private:
+	std::string database_file{""};
+	std::string database_password{""};
+	std::unique_ptr<storage::database::sqlite> database{nullptr};
+	bool available{false};
+};
+}
+
+
+namespace sql {
+namespace query {
+constexpr const char* export_invoice_columns[]{
+	"invoice_id", "business_name", "statement_id", "order_number", "job_card_number", "date_created",
+	"created_on", "paid_status", "material_total", "description_total", "grand_total", "total_cents"
+};
+
+constexpr const char* export_labor_columns[]{
+	"invoice_id", "business_name", "line_number", "is_description", "quantity", "description", "amount"
+};
+
+constexpr const char* export_statement_columns[]{
+	"statement_id", "business_name", "period_start", "period_end", "statement_date", "paid_status",
+	"invoice_count", "total_cents", "unpaid_cents"
+};
+
+constexpr const char* export_clients_select{R"sql(
+	SELECT b.business_id, b.business_name
+	FROM client c
+	JOIN business_details b ON b.business_id = c.business_id
+	ORDER BY b.business_name;
+)sql"};
+
+constexpr const char* export_client_select{R"sql(
+	SELECT b.business_id, b.business_name
+	FROM client c
+	JOIN business_details b ON b.business_id = c.business_id
+	WHERE b.business_name = ?;
+)sql"};
+
+constexpr const char* export_invoices_select{R"sql(
+	SELECT
+		i.invoice_id,
+		b.business_name,
+		i.statement_id,
+		i.order_number,
+		i.job_card_number,
+		i.date_created,
+		i.created_on,
+		i.paid_status,
+		i.material_total,
+		i.description_total,
+		i.grand_total,
+		i.total_cents
+	FROM invoice i
+	JOIN business_details b ON b.business_id = i.business_id
+	WHERE i.business_id = ?1
+	  AND i.created_on BETWEEN ?2 AND ?3
+	ORDER BY i.invoice_id;
+)sql"};
+
+constexpr const char* export_labor_select{R"sql(
+	SELECT
+		l.invoice_id,
+		b.business_name,
+		l.line_number,
+		l.is_description,
+		l.quantity,
+		l.description,
+		l.amount
+	FROM invoice i
+	JOIN business_details b ON b.business_id = i.business_id
+	JOIN labor l ON l.invoice_id = i.invoice_id
+	WHERE i.business_id = ?1
+	  AND i.created_on BETWEEN ?2 AND ?3
+	ORDER BY i.invoice_id, l.line_number, l.is_description;
+)sql"};
+
+constexpr const char* export_statements_select{R"sql(
+	SELECT
+		s.statement_id,
+		b.business_name,
+		s.period_start,
+		s.period_end,
+		s.statement_date,
+		s.paid_status,
+		s.invoice_count,
+		s.total_cents,
+		s.unpaid_cents
+	FROM statement s
+	JOIN business_details b ON b.business_id = s.business_id
+	WHERE s.business_id = ?1
+	ORDER BY s.statement_id;
+)sql"};
+
+constexpr const char* export_statements_range_select{R"sql(
+	SELECT
+		s.statement_id,
+		b.business_name,
+		s.period_start,
+		s.period_end,
+		s.statement_date,
+		s.paid_status,
+		s.invoice_count,
+		s.total_cents,
+		s.unpaid_cents
+	FROM statement s
+	JOIN business_details b ON b.business_id = s.business_id
+	WHERE s.business_id = ?1
+	  AND EXISTS (
+		SELECT 1 FROM invoice i
+		WHERE i.statement_id = s.statement_id
+		  AND i.created_on BETWEEN ?2 AND ?3
+	  )
+	ORDER BY s.statement_id;
+)sql"};
+}
+}
+#endif
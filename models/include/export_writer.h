@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * @file export_writer.h
+ *
+ * @brief Row writers for the CSV and JSON Lines exports.
+ *
+ * @details
+ * Declares `interface::record_writer`, which the exporter hands every row of
+ * a query as it is stepped, and its two implementations:
+ *
+ *  - `model::csv_writer`   : RFC 4180 CSV. A header line of column names,
+ *                            then one line per row; a field containing a
+ *                            comma, quote, CR or LF is quoted and its quotes
+ *                            doubled. NULL is an empty field.
+ *  - `model::jsonl_writer` : JSON Lines. One object per row keyed by column
+ *                            name; text is escaped per RFC 8259, NULL is
+ *                            `null` and numbers are written unquoted.
+ *
+ * Both write straight to the std::ostream they were given and keep nothing
+ * but the column names, so the memory an export needs does not grow with
+ * the number of rows. Lines end in "\n" (CSV included, which spreadsheet and
+ * accounting imports accept). Reals are written in their shortest round-trip
+ * form; blobs, which no exported column holds, are written as hex.
+ *
+ * `begin()` must be called once before the first `write()`; `finish()`
+ * flushes the stream and reports whether every write reached it.
+ ******************************************************************************/
+#ifndef _EXPORT_WRITER_H_
+#define _EXPORT_WRITER_H_
+#include <span>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <string_view>
+#include <sqlite.h>
+
+namespace interface {
+class record_writer {
+public:
+	virtual ~record_writer() = default;
+
+	[[nodiscard]] virtual bool begin(std::span<const char* const>) = 0;
+	[[nodiscard]] virtual bool write(const storage::database::part::row&) = 0;
+	[[nodiscard]] virtual bool finish() = 0;
+};
+}
+
+namespace model {
+class csv_writer: public interface::record_writer {
+public:
+	csv_writer() = delete;
+	explicit csv_writer(std::ostream&);
+	csv_writer(const csv_writer&) = delete;
+	csv_writer(csv_writer&&) = delete;
+	csv_writer& operator=(const csv_writer&) = delete;
+	csv_writer& operator=(csv_writer&&) = delete;
+	virtual ~csv_writer() override;
+
+	[[nodiscard]] virtual bool begin(std::span<const char* const>) override;
+	[[nodiscard]] virtual bool write(const storage::database::part::row&) override;
+	[[nodiscard]] virtual bool finish() override;
+
+private:
+	void field(const std::string_view&);
+
+private:
+	std::ostream& output;
+	std::size_t columns{0};
+};
+
+class jsonl_writer: public interface::record_writer {
+public:
+	jsonl_writer() = delete;
+	explicit jsonl_writer(std::ostream&);
+	jsonl_writer(const jsonl_writer&) = delete;
+	jsonl_writer(jsonl_writer&&) = delete;
+	jsonl_writer& operator=(const jsonl_writer&) = delete;
+	jsonl_writer& operator=(jsonl_writer&&) = delete;
+	virtual ~jsonl_writer() override;
+
+	[[nodiscard]] virtual bool begin(std::span<const char* const>) override;
+	[[nodiscard]] virtual bool write(const storage::database::part::row&) override;
+	[[nodiscard]] virtual bool finish() override;
+
+private:
+	void text(const std::string_view&);
+
+private:
+	std::ostream& output;
+	std::vector<std::string> keys{};
+};
+}
+#endif
@@ -0,0 +1,175 @@
+/*******************************************************************************
+ * @file import_model.h
+ *
+ * @brief Bulk import of historical invoices and their labor lines.
+ *
+ * @details
+ * Declares `model::importer`, which loads a client's invoice history from
+ * two files, one of invoice headers and one of labor lines, in CSV or JSON
+ * Lines (see import_reader.h). The columns are those the exporter writes,
+ * so an export of one book imports into another:
+ *
+ *  - invoices : invoice_id, business_name, order_number, job_card_number,
+ *               date_created, paid_status, material_total,
+ *               description_total, grand_total, and optionally period_start
+ *               and period_end naming the statement the invoice belongs to.
+ *  - labor    : invoice_id, line_number, is_description, quantity,
+ *               description, amount.
+ *
+ * Every row is checked with the `data::invoice` and `data::column` rules the
+ * pages save through. A row that breaks one, names an unknown client,
+ * repeats a stored invoice, or (for labor) belongs to an invoice this import
+ * did not write, is rejected with its file and line in
+ * `model::import_report::errors`, and the import carries on. After
+ * `app::config::import_error_limit` rejected rows it gives up instead.
+ *
+ * Unlike `model::invoice::save_many()`, the importer does not diff against
+ * what is stored. The invoice ids are taken from the file, each client's
+ * business id and each (client, period) statement id are resolved once, and
+ * the rows go through the same prepared INSERT statements. The whole import
+ * is one transaction, rolled back when it fails, so a failed import leaves
+ * nothing behind and can be run again. By default the statement totals
+ * triggers fire per row. With `defer_indexes` the invoice indexes and the
+ * totals triggers are dropped first, then rebuilt once at the end, and the
+ * statement totals are recomputed. In both modes the importer writes the
+ * search index rows itself (see import_model.cpp for why).
+ *
+ * Like the search and report models, the importer keeps its connection
+ * open; the constructor prepares the generated invoice columns and the
+ * statement totals (see totals_model.h) on a database that predates them.
+ ******************************************************************************/
+#ifndef _IMPORT_MODEL_H_
+#define _IMPORT_MODEL_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include <istream>
+#include <config.h>
+#include <sqlite.h>
+#include <export_model.h>
+#include <import_reader.h>
+
+namespace model {
+struct import_options {
+	bool defer_indexes{false};
+};
+
+struct import_error {
+	std::string file{""};
+	std::size_t line{0};
+	std::string message{""};
+};
+
+struct import_report {
+	std::size_t invoices{0};
+	std::size_t labor{0};
+	std::vector<model::import_error> errors{};
+	double seconds{0.0};
+};
+
+class importer {
+public:
+	importer() = delete;
+	explicit importer(const std::string&, const std::string&);
+	importer(const importer&) = delete;
+	importer(importer&&) = delete;
+	importer& operator=(const importer&) = delete;
+	importer& operator=(importer&&) = delete;
+	virtual ~importer();
+
+	[[nodiscard]] virtual bool is_available() const;
+	[[nodiscard]] virtual bool import(std::istream&, std::istream&, const model::export_format&,
+					  const model::import_options&, model::import_report&) const;
+
+private:
+	[[nodiscard]] bool defer() const;
+	[[nodiscard]] bool restore() const;
+	[[nodiscard]] static std::unique_ptr<interface::record_reader> make_reader(std::istream&,
+										  const model::export_format&);
+
+private:
+	std::string database_file{""};
+	std::unique_ptr<storage::database::sqlite> database{nullptr};
+	bool available{false};
+};
+}
+
+
+namespace sql {
+namespace query {
+constexpr const char* import_invoice_columns[]{
+	"invoice_id", "business_name", "order_number", "job_card_number", "date_created", "paid_status",
+	"material_total", "description_total", "grand_total", "period_start", "period_end"
+};
+
+constexpr std::size_t import_invoice_required{9};
+
+constexpr const char* import_labor_columns[]{
+	"invoice_id", "line_number", "is_description", "quantity", "description", "amount"
+};
+
+constexpr const char* import_client_select{R"sql(
+	SELECT c.business_id
+	FROM client c
+	JOIN business_details b ON b.business_id = c.business_id
+	WHERE b.business_name = ?;
+)sql"};
+
+constexpr const char* import_statement_insert{R"sql(
+	INSERT INTO statement (business_id, period_start, period_end)
+	VALUES (?, ?, ?)
+	ON CONFLICT (business_id, period_start, period_end) DO NOTHING;
+)sql"};
+
+constexpr const char* import_statement_select{R"sql(
+	SELECT statement_id
+	FROM statement
+	WHERE business_id = ? AND period_start = ? AND period_end = ?;
+)sql"};
+
+constexpr const char* import_invoice_insert{R"sql(
+	INSERT INTO invoice (
+		invoice_id,
+		business_id,
+		statement_id,
+		order_number,
+		job_card_number,
+		date_created,
+		paid_status,
+		material_total,
+		description_total,
+		grand_total
+	)
+	VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);
+)sql"};
+
+constexpr const char* import_invoice_search_insert{R"sql(
+	INSERT INTO invoice_search (rowid, order_number, job_card_number)
+	VALUES (?, ?, ?);
+)sql"};
+
+constexpr const char* import_labor_mark_select{R"sql(
+	SELECT coalesce(max(labor_id), 0) FROM labor;
+)sql"};
+
+constexpr const char* import_labor_search_fill{R"sql(
+	INSERT INTO labor_search (rowid, description, invoice_id)
+	SELECT labor_id, description, invoice_id
+	FROM labor
+	WHERE labor_id > ?;
+)sql"};
+
+constexpr const char* import_search_triggers_drop[]{
+	"DROP TRIGGER IF EXISTS invoice_search_insert;",
+	"DROP TRIGGER IF EXISTS labor_search_insert;"
+};
+
+constexpr const char* import_indexes_drop[]{
+	"DROP INDEX IF EXISTS invoice_business_page_idx;",
+	"DROP INDEX IF EXISTS invoice_statement_idx;",
+	"DROP INDEX IF EXISTS invoice_period_idx;",
+	"DROP INDEX IF EXISTS invoice_unpaid_idx;"
+};
+}
+}
+#endif
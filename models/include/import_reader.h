@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * @file import_reader.h
+ *
+ * @brief Record readers for the CSV and JSON Lines imports.
+ *
+ * @details
+ * Declares `interface::record_reader`, which the importer pulls one record at
+ * a time from, and its two implementations:
+ *
+ *  - `model::csv_reader`   : RFC 4180 CSV with a header line. Quoted fields
+ *                            may hold commas, doubled quotes and line breaks;
+ *                            "\r\n" and "\n" both end a record.
+ *  - `model::jsonl_reader` : JSON Lines. One flat object per line; strings
+ *                            are unescaped (\uXXXX and surrogate pairs to
+ *                            UTF-8), numbers and true/false are kept as their
+ *                            text, null is an empty field.
+ *
+ * They read the files the exporter writes (see export_writer.h), so an
+ * export of one book imports into another.
+ *
+ * `begin()` names the fields the caller wants, in the order `read()` should
+ * return them; fields the record does not have are returned empty and fields
+ * the caller did not ask for are skipped. The first fields it names are
+ * required: a CSV file whose header lacks one of them is not read at all.
+ * `read()` fills the fields of the
+ * next record and returns false at the end of the input. A record it cannot
+ * parse is still returned, with `error()` saying why, so the caller can
+ * reject it and read on. `line()` is the line the last record started on,
+ * for the error messages of the importer.
+ *
+ * Neither reader keeps more than the record being parsed.
+ ******************************************************************************/
+#ifndef _IMPORT_READER_H_
+#define _IMPORT_READER_H_
+#include <span>
+#include <string>
+#include <vector>
+#include <istream>
+
+namespace interface {
+class record_reader {
+public:
+	virtual ~record_reader() = default;
+
+	[[nodiscard]] virtual bool begin(std::span<const char* const>, const std::size_t&) = 0;
+	[[nodiscard]] virtual bool read(std::vector<std::string>&) = 0;
+	[[nodiscard]] virtual std::size_t line() const = 0;
+	[[nodiscard]] virtual std::string error() const = 0;
+};
+}
+
+namespace model {
+class csv_reader: public interface::record_reader {
+public:
+	csv_reader() = delete;
+	explicit csv_reader(std::istream&);
+	csv_reader(const csv_reader&) = delete;
+	csv_reader(csv_reader&&) = delete;
+	csv_reader& operator=(const csv_reader&) = delete;
+	csv_reader& operator=(csv_reader&&) = delete;
+	virtual ~csv_reader() override;
+
+	[[nodiscard]] virtual bool begin(std::span<const char* const>, const std::size_t&) override;
+	[[nodiscard]] virtual bool read(std::vector<std::string>&) override;
+	[[nodiscard]] virtual std::size_t line() const override;
+	[[nodiscard]] virtual std::string error() const override;
+
+private:
+	[[nodiscard]] bool record(std::vector<std::string>&);
+
+private:
+	std::istream& input;
+	std::vector<std::size_t> positions{};
+	std::vector<std::string> fields{};
+	std::size_t wanted{0};
+	std::size_t next_line{1};
+	std::size_t record_line{0};
+	std::string message{""};
+};
+
+class jsonl_reader: public interface::record_reader {
+public:
+	jsonl_reader() = delete;
+	explicit jsonl_reader(std::istream&);
+	jsonl_reader(const jsonl_reader&) = delete;
+	jsonl_reader(jsonl_reader&&) = delete;
+	jsonl_reader& operator=(const jsonl_reader&) = delete;
+	jsonl_reader& operator=(jsonl_reader&&) = delete;
+	virtual ~jsonl_reader() override;
+
+	[[nodiscard]] virtual bool begin(std::span<const char* const>, const std::size_t&) override;
+	[[nodiscard]] virtual bool read(std::vector<std::string>&) override;
+	[[nodiscard]] virtual std::size_t line() const override;
+	[[nodiscard]] virtual std::string error() const override;
+
+private:
+	[[nodiscard]] bool parse(std::vector<std::string>&);
+	[[nodiscard]] bool text(std::size_t&, std::string&) const;
+	void skip(std::size_t&) const;
+
+private:
+	std::istream& input;
+	std::vector<std::string> keys{};
+	std::string buffer{""};
+	std::size_t record_line{0};
+	std::string message{""};
+};
+}
+#endif
@@ -5,18 +5,28 @@
  *
  * @details
  * Declares the `model::invoice` class, which implements the
- * `interface::model_operations` interface for invoice-related workflows.
+ * `interface::model_operations<data::pdf_invoice, data::invoice>` interface
+ * for invoice-related workflows.
  *
  * Responsibilities:
  *  - Load invoice-related data for a given business from persistent storage
  *    and assemble it into higher-level domain objects.
  *  - Persist invoice data (including related labor/line items and statement
- *    information) to the database.
+ *    information) to the database, writing only what differs from the
+ *    stored invoice.
  *  - Prepare invoice data for downstream use cases:
  *      * `prepare_for_email()` – build a `data::email` object with all
  *        necessary context and PDF attachments.
  *      * `prepare_for_print()` – generate raw PDF documents as strings for
  *        printing.
+ *      * `write_pdfs()` – stream one PDF file per invoice into a directory
+ *        without holding the batch in memory.
+ *  - Page through a business's invoices newest first with `load_page()`,
+ *    using keyset pagination on invoice_id.
+ *  - Persist many invoices at once with `save_many()`, opening the database
+ *    and resolving the admin, client and billing period once per batch
+ *    instead of once per invoice. The batch is one transaction: false means
+ *    none of the invoices were saved.
  *
  * The model holds:
  *  - `database_file`      : path to the underlying SQLite database.
@@ -25,11 +35,17 @@
 #ifndef _INVOICE_MODEL_H_
 #define _INVOICE_MODEL_H_
 #include <string>
+#include <filesystem>
+#include <sqlite.h>
 #include <models.h>
+#include <admin_data.h>
+#include <client_data.h>
+#include <calendar.h>
+#include <invoice_data.h>
 #include <pdf_invoice_data.h>
 
 namespace model {
-class invoice: public interface::model_operations {
+class invoice: public interface::model_operations<data::pdf_invoice, data::invoice> {
 public:
 	invoice() = delete;
 	explicit invoice(const std::string&, const std::string&);
@@ -39,11 +55,23 @@ public:
 	invoice& operator=(invoice&&) = delete;
 	virtual ~invoice() override;
 
-	[[nodiscard]] virtual std::vector<std::any> load(const std::string&) const override;
-	[[nodiscard]] virtual bool save(const std::any&) const override;
-	[[nodiscard]] virtual data::email prepare_for_email(const std::vector<std::any>&) const override;
-	[[nodiscard]] virtual std::vector<std::string> prepare_for_print(const std::vector<std::any>&) const override;
+	[[nodiscard]] virtual model::documents<data::pdf_invoice> load(const std::string&) const override;
+	[[nodiscard]] virtual model::documents<data::pdf_invoice> load_page(const std::string&, const model::page&) const override;
+	[[nodiscard]] virtual bool save(const data::invoice&) const override;
+	[[nodiscard]] virtual bool save_many(std::span<const data::invoice>) const;
+	[[nodiscard]] virtual data::email prepare_for_email(std::span<const data::pdf_invoice>) const override;
+	[[nodiscard]] virtual std::vector<std::string> prepare_for_print(std::span<const data::pdf_invoice>) const override;
+	[[nodiscard]] virtual bool write_pdfs(std::span<const data::pdf_invoice>, const std::filesystem::path&) const;
 
+private:
+	[[nodiscard]] std::vector<data::pdf_invoice> assemble(storage::database::sqlite&,
+							      const storage::database::part::rows&,
+							      const data::client&,
+							      const data::admin&) const;
+	[[nodiscard]] bool write(storage::database::sqlite&, const data::invoice&,
+				 const utility::period_bounds&, const std::string&, bool&) const;
+	[[nodiscard]] bool header_changed(storage::database::sqlite&, const data::invoice&) const;
+	[[nodiscard]] bool save_labor(storage::database::sqlite&, const data::invoice&) const;
 
 private:
 	std::string database_file;
@@ -27,8 +27,17 @@
  *                                         associated with invoices.
  *      * `invoice_client_select`        – query client and scheduling info.
  *      * `invoice_select`               – query invoice header details.
+ *      * `invoice_page_select`          – keyset page of invoice headers,
+ *                                         newest first.
+ *      * `invoice_page_index`           – index backing the keyset page.
+ *      * `invoice_snapshot_select`      – the stored header of one invoice,
+ *                                         diffed against on save.
  *      * `labor_usert`                  – upsert for labor (line item) rows.
- *      * `labor_delete_all_for_invoice` – delete all labor rows for an invoice.
+ *      * `labor_snapshot_select`        – every stored labor row of one
+ *                                         invoice, diffed against on save.
+ *      * `labor_insert`                 – insert one new labor row.
+ *      * `labor_update`                 – update one changed labor row.
+ *      * `labor_delete`                 – delete one removed labor row.
  *      * `description_labor_select`     – select description-type line items.
  *      * `material_labor_select`        – select material-type line items.
  *
@@ -188,6 +197,46 @@ constexpr const char* invoice_select{R"sql(
 	WHERE b.business_name = ?;
 )sql"};
 
+constexpr const char* invoice_page_select{R"sql(
+	SELECT
+		b.business_name,
+		i.invoice_id,
+		i.order_number,
+		i.job_card_number,
+		i.date_created,
+		i.paid_status,
+		i.material_total,
+		i.description_total,
+		i.grand_total
+	FROM invoice i
+	JOIN business_details b ON b.business_id = i.business_id
+	WHERE b.business_name = ?
+	  AND i.invoice_id < ?
+	ORDER BY i.invoice_id DESC
+	LIMIT ?;
+)sql"};
+
+constexpr const char* invoice_snapshot_select{R"sql(
+	SELECT
+		b.business_name,
+		i.invoice_id,
+		i.order_number,
+		i.job_card_number,
+		i.date_created,
+		i.paid_status,
+		i.material_total,
+		i.description_total,
+		i.grand_total
+	FROM invoice i
+	JOIN business_details b ON b.business_id = i.business_id
+	WHERE i.invoice_id = ?;
+)sql"};
+
+constexpr const char* invoice_page_index{R"sql(
+	CREATE INDEX IF NOT EXISTS invoice_business_page_idx
+		ON invoice (business_id, invoice_id);
+)sql"};
+
 constexpr const char* labor_usert{R"sql(
 	INSERT INTO labor (
 		invoice_id,
@@ -212,11 +261,45 @@ constexpr const char* labor_usert{R"sql(
 		amount      = excluded.amount;
 )sql"};
 
-constexpr const char* labor_delete_all_for_invoice{R"SQL(
-        DELETE FROM labor
-        WHERE invoice_id = ?;
-    )SQL"
-};
+constexpr const char* labor_snapshot_select{R"sql(
+	SELECT
+		quantity,
+		description,
+		amount,
+		line_number,
+		is_description
+	FROM labor
+	WHERE invoice_id = ?;
+)sql"};
+
+constexpr const char* labor_insert{R"sql(
+	INSERT INTO labor (
+		invoice_id,
+		line_number,
+		is_description,
+		quantity,
+		description,
+		amount
+	)
+	VALUES (?, ?, ?, ?, ?, ?);
+)sql"};
+
+constexpr const char* labor_update{R"sql(
+	UPDATE labor SET
+		quantity    = ?,
+		description = ?,
+		amount      = ?
+	WHERE invoice_id = ?
+	  AND line_number = ?
+	  AND is_description = ?;
+)sql"};
+
+constexpr const char* labor_delete{R"sql(
+	DELETE FROM labor
+	WHERE invoice_id = ?
+	  AND line_number = ?
+	  AND is_description = ?;
+)sql"};
 
 constexpr const char* description_labor_select{R"sql(
 	SELECT
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * @file model_cache.h
+ *
+ * @brief Process-wide read-through cache for loaded model data.
+ *
+ * @details
+ * Declares `model::cache`, a single LRU cache shared by every model instance
+ * in the process. The GUI constructs a fresh model for each operation, and
+ * page switches re-run the same loads for the same client. With the cache
+ * those repeated loads are served from memory instead of SQLite.
+ *
+ *  - Entries are keyed by database file, entity type, business name and an
+ *    optional detail (the keyset page cursor for `load_page()`).
+ *  - Every entry carries an estimated footprint in bytes; the least recently
+ *    used entries are evicted once the total exceeds the memory budget
+ *    (`app::config::model_cache_budget` by default).
+ *  - The models invalidate precisely on save: a client or document save
+ *    drops that business's entries, an admin save drops everything because
+ *    the admin details are embedded in every document.
+ *  - Reports span every business and are stored under an empty business
+ *    name; any client or document save drops them.
+ *  - Values are stored as `std::shared_ptr<const T>`. A hit hands out
+ *    another reference to the same immutable value, so no value is copied
+ *    under the lock; a value stays alive for its readers after eviction.
+ *    The invoice and statement models return that reference itself (see
+ *    `model::documents` in models.h), so their hits allocate nothing.
+ *  - `statistics()` exposes hits, misses, evictions, invalidations and the
+ *    current size.
+ *
+ * Only the models write to the cache. Code that changes the database behind
+ * the models' back (tests, tools) must call `clear()`.
+ ******************************************************************************/
+#ifndef _MODEL_CACHE_H_
+#define _MODEL_CACHE_H_
+#include <map>
+#include <list>
+#include <tuple>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <typeinfo>
+#include <config.h>
+#include <models.h>
+#include <admin_data.h>
+#include <client_data.h>
+#include <pdf_invoice_data.h>
+#include <pdf_statement_data.h>
+
+namespace model {
+enum class entity {
+	admin = 0,
+	client,
+	invoices,
+	statements,
+	reports
+};
+
+struct cache_statistics {
+	std::uint64_t hits{0};
+	std::uint64_t misses{0};
+	std::uint64_t evictions{0};
+	std::uint64_t invalidations{0};
+	std::size_t entries{0};
+	std::size_t bytes{0};
+	std::size_t budget{0};
+};
+
+class cache {
+public:
+	cache(const cache&) = delete;
+	cache(cache&&) = delete;
+	cache& operator= (const cache&) = delete;
+	cache& operator= (cache&&) = delete;
+	virtual ~cache() = default;
+
+	[[nodiscard]] static cache& instance();
+
+	template <typename value_type>
+	[[nodiscard]] std::shared_ptr<const value_type> find(const std::string& _database, const entity& _entity,
+							     const std::string& _business_name,
+							     const std::string& _detail = "")
+	{
+		return std::static_pointer_cast<const value_type>(
+				lookup(_database, _entity, _business_name, _detail, typeid(value_type)));
+	}
+
+	template <typename value_type>
+	void store(const std::string& _database, const entity& _entity, const std::string& _business_name,
+		   const std::string& _detail, std::shared_ptr<const value_type> _value, const std::size_t& _bytes)
+	{
+		insert(_database, _entity, _business_name, _detail, std::move(_value), typeid(value_type), _bytes);
+	}
+
+	virtual void invalidate(const std::string&, const entity&, const std::string&);
+	virtual void invalidate(const std::string&, const std::string&);
+	virtual void clear();
+	virtual void set_budget(const std::size_t&);
+	[[nodiscard]] virtual cache_statistics statistics() const;
+
+private:
+	cache() = default;
+
+	[[nodiscard]] std::shared_ptr<const void> lookup(const std::string&, const entity&, const std::string&,
+							 const std::string&, const std::type_info&);
+	void insert(const std::string&, const entity&, const std::string&, const std::string&,
+		    std::shared_ptr<const void>, const std::type_info&, const std::size_t&);
+	void evict();
+
+private:
+	using key = std::tuple<std::string, entity, std::string, std::string>;
+
+	struct entry {
+		std::shared_ptr<const void> value{};
+		const std::type_info* type{nullptr};
+		std::size_t bytes{0};
+		std::list<key>::iterator position{};
+	};
+
+	mutable std::mutex guard{};
+	std::list<key> recently_used{};
+	std::map<key, entry> entries{};
+	cache_statistics counters{.budget = app::config::model_cache_budget};
+};
+
+[[nodiscard]] std::string page_detail(const model::page&);
+[[nodiscard]] std::size_t footprint(const data::admin&);
+[[nodiscard]] std::size_t footprint(const data::client&);
+[[nodiscard]] std::size_t footprint(const std::vector<data::pdf_invoice>&);
+[[nodiscard]] std::size_t footprint(const std::vector<data::pdf_statement>&);
+}
+#endif
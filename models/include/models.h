@@ -9,14 +9,30 @@
  * saving, and preparing model data for downstream consumers such as PDF or
  * email generation.
  *
- *   • interface::model_operations
- *       - Represents the primary contract for all data models (Admin, Client,
- *         Invoice, Statement).
+ *   • interface::model_operations<document_type, record_type>
+ *       - Represents the primary contract for the document models (Invoice,
+ *         Statement).
+ *       - Strongly typed: `document_type` is what the model loads and hands
+ *         to the PDF features (e.g. data::pdf_invoice), `record_type` is
+ *         what the model persists (e.g. data::invoice).
  *       - Ensures every model can:
  *            • Load domain data from storage using a string key.
- *            • Save domain data using std::any-based type erasure.
+ *            • Save a record passed by const reference.
  *            • Prepare email data structures for outbound messages.
  *            • Produce printable artifacts such as encoded PDFs.
+ *       - Documents are accepted as std::span<const document_type>, so the
+ *         GUI → model → PDF path never copies the document graphs.
+ *       - load() and load_page() return model::documents, a shared pointer
+ *         to an immutable vector. It is the vector the model cache holds, so
+ *         a cache hit hands it out without copying or allocating. It is
+ *         never null: a failed load returns an empty vector.
+ *
+ *       - load_page() returns one keyset page (newest first) described by a
+ *         model::page cursor, so long histories can be fetched incrementally.
+ *
+ *   • model::page
+ *       - Keyset cursor: rows with an id strictly below `before`, at most
+ *         `limit` of them. The next cursor is the id of the last row returned.
  *
  *   • interface::model_register
  *       - Minimal interface intended for registry-like components that act as
@@ -30,20 +46,39 @@
 #ifndef _MODELS_H_
 #define _MODELS_H_
 #include <any>
+#include <span>
 #include <memory>
 #include <string>
+#include <limits>
 #include <vector>
+#include <config.h>
 #include <email_data.h>
 
+namespace model {
+struct page
+{
+	long long before{std::numeric_limits<long long>::max()};
+	long long limit{app::config::page_size};
+
+	[[nodiscard]] bool first() const { return before == std::numeric_limits<long long>::max(); }
+	[[nodiscard]] bool is_valid() const { return before > 0 && limit > 0; }
+};
+
+template <typename document_type>
+using documents = std::shared_ptr<const std::vector<document_type>>;
+}
+
 namespace interface {
+template <typename document_type, typename record_type>
 class model_operations {
 public:
 	virtual ~model_operations() = default;
 
-	[[nodiscard]] virtual std::vector<std::any> load(const std::string&) const = 0;
-	[[nodiscard]] virtual bool save(const std::any&) const = 0;
-	[[nodiscard]] virtual data::email prepare_for_email(const std::vector<std::any>&) const = 0;
-	[[nodiscard]] virtual std::vector<std::string> prepare_for_print(const std::vector<std::any>&) const = 0;
+	[[nodiscard]] virtual model::documents<document_type> load(const std::string&) const = 0;
+	[[nodiscard]] virtual model::documents<document_type> load_page(const std::string&, const model::page&) const = 0;
+	[[nodiscard]] virtual bool save(const record_type&) const = 0;
+	[[nodiscard]] virtual data::email prepare_for_email(std::span<const document_type>) const = 0;
+	[[nodiscard]] virtual std::vector<std::string> prepare_for_print(std::span<const document_type>) const = 0;
 };
 
 class model_register {
@@ -0,0 +1,32 @@
+/*******************************************************************************
+ * @file render_batch.h
+ *
+ * @brief Renders a batch of documents on a fixed set of worker threads.
+ *
+ * @details
+ * Printing or emailing a batch turns every document into a PDF string. The
+ * documents are independent, so they are rendered in parallel, but each
+ * rendering thread keeps per-thread state that pays off across documents:
+ * the recorded page templates (see page_templates.h) and the trace ring.
+ * Starting one thread per document throws that state away after a single
+ * document, so a batch for one business records its templates again for
+ * every invoice.
+ *
+ * `model::render_batch()` starts at most `std::thread::hardware_concurrency()`
+ * workers (never more than there are documents). Each worker takes the next
+ * unrendered index until the batch is done, so a worker renders many
+ * documents and reuses what its thread cached for the first one. The result
+ * holds the rendered strings in the order of the indices.
+ ******************************************************************************/
+#ifndef _RENDER_BATCH_H_
+#define _RENDER_BATCH_H_
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+namespace model {
+[[nodiscard]] std::vector<std::string> render_batch(const std::size_t&,
+						    const std::function<std::string(const std::size_t&)>&);
+}
+#endif
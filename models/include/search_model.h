@@ -0,0 +1,346 @@
+/*******************************************************************************
+ * @file search_model.h
+ *
+ * @brief Full-text search over businesses and invoices.
+ *
+ * @details
+ * Declares `model::search`, which answers as-you-type queries from three
+ * FTS5 tables kept in sync with the base tables by triggers:
+ *
+ *  - `business_search`: business name and email address, rowid = business_id.
+ *  - `invoice_search`  : order number and job card number, rowid = invoice_id.
+ *  - `labor_search`    : one labor description per row, rowid = labor_id,
+ *                        with the owning invoice_id stored unindexed.
+ *
+ * Every table carries prefix indexes, so every word of the query is matched
+ * as a prefix ("weld brack" finds "Welding bracket") without scanning the
+ * base tables. Labor lines are indexed one row each so that saving a line
+ * touches one index row instead of re-indexing the whole invoice.
+ *
+ * Hits come back best first:
+ *
+ *  - Businesses, ranked with bm25 (name weighted over email address).
+ *  - Invoices whose order or job card number matched, newest first.
+ *  - Invoices whose labor lines matched, most matching lines first, then
+ *    newest first.
+ *
+ * Businesses are ranked over every match and the best `limit` kept, so the
+ * best business is found however many others share its prefix. The invoice
+ * queries read a bounded window of index rows (`limit` invoice headers, 64
+ * labor lines) and rank inside it, so a common prefix such as "c" or "mach"
+ * stays well under a millisecond on a million labor lines. bm25 is only used
+ * for businesses: it first counts every row that matches each term, which
+ * is cheap over the businesses but costs tens of milliseconds over a million
+ * labor lines.
+ *
+ * Unlike the other models, `model::search` keeps its database connection
+ * open for its whole lifetime: the SQLCipher key derivation costs far more
+ * than a query, and a query runs on every keystroke. The constructor creates
+ * the tables and triggers when the database predates them and indexes the
+ * existing rows once.
+ *
+ * Bulk loaders that would pay the triggers once per row can drop them with
+ * `sql::query::search_triggers_drop` and afterwards run
+ * `search_index_create`, `search_index_clear` and `search_index_fill` in
+ * one transaction. A database missing any of the search objects is repaired
+ * the same way by the constructor.
+ *
+ * `is_available()` is false when the database could not be opened or the
+ * SQLite library lacks FTS5; `find()` and `suggest()` then return nothing.
+ ******************************************************************************/
+#ifndef _SEARCH_MODEL_H_
+#define _SEARCH_MODEL_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <sqlite.h>
+
+namespace model {
+enum class hit_kind {
+	business = 0,
+	invoice
+};
+
+struct search_hit {
+	hit_kind kind{hit_kind::business};
+	long long id{0};
+	std::string business_name{""};
+	std::string detail{""};
+};
+
+class search {
+public:
+	search() = delete;
+	explicit search(const std::string&, const std::string&);
+	search(const search&) = delete;
+	search(search&&) = delete;
+	search& operator=(const search&) = delete;
+	search& operator=(search&&) = delete;
+	virtual ~search();
+
+	[[nodiscard]] virtual bool is_available() const;
+	[[nodiscard]] virtual std::vector<model::search_hit> find(const std::string&, const std::size_t&) const;
+	[[nodiscard]] virtual std::vector<std::string> suggest(const std::string&, const std::size_t&) const;
+	[[nodiscard]] virtual bool rebuild() const;
+	[[nodiscard]] static std::string match_expression(const std::string&);
+
+private:
+	[[nodiscard]] bool create_index() const;
+	[[nodiscard]] bool fill_index() const;
+	[[nodiscard]] bool run(std::span<const char* const>) const;
+
+private:
+	std::unique_ptr<storage::database::sqlite> database{nullptr};
+	bool available{false};
+};
+}
+
+namespace sql {
+namespace query {
+constexpr const char* search_index_objects{R"sql(
+	SELECT count(*) FROM sqlite_master
+	WHERE name IN ('business_search', 'invoice_search', 'labor_search',
+		       'business_search_insert', 'business_search_update', 'business_search_delete',
+		       'invoice_search_insert', 'invoice_search_update', 'invoice_search_delete',
+		       'labor_search_insert', 'labor_search_update', 'labor_search_delete');
+)sql"};
+
+constexpr const char* business_search_table{R"sql(
+	CREATE VIRTUAL TABLE IF NOT EXISTS business_search USING fts5(
+		business_name,
+		email_address,
+		tokenize = 'unicode61 remove_diacritics 2',
+		prefix = '1 2 3 4 5 6'
+	);
+)sql"};
+
+constexpr const char* business_search_insert_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS business_search_insert
+	AFTER INSERT ON business_details
+	BEGIN
+		INSERT INTO business_search (rowid, business_name, email_address)
+		VALUES (NEW.business_id, NEW.business_name, NEW.email_address);
+	END;
+)sql"};
+
+constexpr const char* business_search_update_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS business_search_update
+	AFTER UPDATE OF business_id, business_name, email_address ON business_details
+	WHEN OLD.business_id IS NOT NEW.business_id
+	  OR OLD.business_name IS NOT NEW.business_name
+	  OR OLD.email_address IS NOT NEW.email_address
+	BEGIN
+		DELETE FROM business_search WHERE rowid = OLD.business_id;
+		INSERT INTO business_search (rowid, business_name, email_address)
+		VALUES (NEW.business_id, NEW.business_name, NEW.email_address);
+	END;
+)sql"};
+
+constexpr const char* business_search_delete_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS business_search_delete
+	AFTER DELETE ON business_details
+	BEGIN
+		DELETE FROM business_search WHERE rowid = OLD.business_id;
+	END;
+)sql"};
+
+constexpr const char* invoice_search_table{R"sql(
+	CREATE VIRTUAL TABLE IF NOT EXISTS invoice_search USING fts5(
+		order_number,
+		job_card_number,
+		tokenize = 'unicode61 remove_diacritics 2',
+		prefix = '1 2 3 4 5 6'
+	);
+)sql"};
+
+constexpr const char* invoice_search_insert_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS invoice_search_insert
+	AFTER INSERT ON invoice
+	BEGIN
+		INSERT INTO invoice_search (rowid, order_number, job_card_number)
+		VALUES (NEW.invoice_id, NEW.order_number, NEW.job_card_number);
+	END;
+)sql"};
+
+constexpr const char* invoice_search_update_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS invoice_search_update
+	AFTER UPDATE OF invoice_id, order_number, job_card_number ON invoice
+	WHEN OLD.invoice_id IS NOT NEW.invoice_id
+	  OR OLD.order_number IS NOT NEW.order_number
+	  OR OLD.job_card_number IS NOT NEW.job_card_number
+	BEGIN
+		DELETE FROM invoice_search WHERE rowid = OLD.invoice_id;
+		INSERT INTO invoice_search (rowid, order_number, job_card_number)
+		VALUES (NEW.invoice_id, NEW.order_number, NEW.job_card_number);
+	END;
+)sql"};
+
+constexpr const char* invoice_search_delete_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS invoice_search_delete
+	AFTER DELETE ON invoice
+	BEGIN
+		DELETE FROM invoice_search WHERE rowid = OLD.invoice_id;
+	END;
+)sql"};
+
+constexpr const char* labor_search_table{R"sql(
+	CREATE VIRTUAL TABLE IF NOT EXISTS labor_search USING fts5(
+		description,
+		invoice_id UNINDEXED,
+		tokenize = 'unicode61 remove_diacritics 2',
+		prefix = '1 2 3 4 5 6'
+	);
+)sql"};
+
+constexpr const char* labor_search_insert_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS labor_search_insert
+	AFTER INSERT ON labor
+	BEGIN
+		INSERT INTO labor_search (rowid, description, invoice_id)
+		VALUES (NEW.labor_id, NEW.description, NEW.invoice_id);
+	END;
+)sql"};
+
+constexpr const char* labor_search_update_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS labor_search_update
+	AFTER UPDATE OF labor_id, invoice_id, description ON labor
+	WHEN OLD.labor_id IS NOT NEW.labor_id
+	  OR OLD.invoice_id IS NOT NEW.invoice_id
+	  OR OLD.description IS NOT NEW.description
+	BEGIN
+		DELETE FROM labor_search WHERE rowid = OLD.labor_id;
+		INSERT INTO labor_search (rowid, description, invoice_id)
+		VALUES (NEW.labor_id, NEW.description, NEW.invoice_id);
+	END;
+)sql"};
+
+constexpr const char* labor_search_delete_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS labor_search_delete
+	AFTER DELETE ON labor
+	BEGIN
+		DELETE FROM labor_search WHERE rowid = OLD.labor_id;
+	END;
+)sql"};
+
+constexpr const char* business_search_clear{R"sql(
+	DELETE FROM business_search;
+)sql"};
+
+constexpr const char* business_search_fill{R"sql(
+	INSERT INTO business_search (rowid, business_name, email_address)
+	SELECT business_id, business_name, email_address FROM business_details;
+)sql"};
+
+constexpr const char* invoice_search_clear{R"sql(
+	DELETE FROM invoice_search;
+)sql"};
+
+constexpr const char* invoice_search_fill{R"sql(
+	INSERT INTO invoice_search (rowid, order_number, job_card_number)
+	SELECT invoice_id, order_number, job_card_number FROM invoice;
+)sql"};
+
+constexpr const char* labor_search_clear{R"sql(
+	DELETE FROM labor_search;
+)sql"};
+
+constexpr const char* labor_search_fill{R"sql(
+	INSERT INTO labor_search (rowid, description, invoice_id)
+	SELECT labor_id, description, invoice_id FROM labor;
+)sql"};
+
+constexpr const char* business_search_select{R"sql(
+	SELECT  b.business_id,
+		b.business_name,
+		b.email_address
+	FROM (
+		SELECT rowid AS business_id, rank
+		FROM business_search
+		WHERE business_search MATCH ? AND rank MATCH 'bm25(10.0, 2.0)'
+		ORDER BY rank
+		LIMIT ?
+	) hit
+	JOIN business_details b ON b.business_id = hit.business_id
+	ORDER BY hit.rank;
+)sql"};
+
+constexpr const char* invoice_header_search_select{R"sql(
+	SELECT  i.invoice_id,
+		b.business_name,
+		i.order_number,
+		i.job_card_number
+	FROM (
+		SELECT rowid AS invoice_id
+		FROM invoice_search
+		WHERE invoice_search MATCH ?
+		ORDER BY rowid DESC
+		LIMIT ?
+	) hit
+	JOIN invoice i ON i.invoice_id = hit.invoice_id
+	JOIN business_details b ON b.business_id = i.business_id
+	ORDER BY i.invoice_id DESC;
+)sql"};
+
+constexpr const char* invoice_labor_search_select{R"sql(
+	SELECT  i.invoice_id,
+		b.business_name,
+		i.order_number,
+		i.job_card_number,
+		count(*) AS lines
+	FROM (
+		SELECT invoice_id
+		FROM labor_search
+		WHERE labor_search MATCH ?
+		ORDER BY rowid DESC
+		LIMIT 64
+	) hit
+	JOIN invoice i ON i.invoice_id = hit.invoice_id
+	JOIN business_details b ON b.business_id = i.business_id
+	GROUP BY i.invoice_id
+	ORDER BY lines DESC, i.invoice_id DESC
+	LIMIT ?;
+)sql"};
+
+constexpr const char* search_index_create[]{
+	business_search_table,
+	invoice_search_table,
+	labor_search_table,
+	business_search_insert_trigger,
+	business_search_update_trigger,
+	business_search_delete_trigger,
+	invoice_search_insert_trigger,
+	invoice_search_update_trigger,
+	invoice_search_delete_trigger,
+	labor_search_insert_trigger,
+	labor_search_update_trigger,
+	labor_search_delete_trigger
+};
+
+constexpr const char* search_index_clear[]{
+	business_search_clear,
+	invoice_search_clear,
+	labor_search_clear
+};
+
+constexpr const char* search_index_fill[]{
+	business_search_fill,
+	invoice_search_fill,
+	labor_search_fill
+};
+
+constexpr const char* search_triggers_drop[]{
+	"DROP TRIGGER IF EXISTS business_search_insert;",
+	"DROP TRIGGER IF EXISTS business_search_update;",
+	"DROP TRIGGER IF EXISTS business_search_delete;",
+	"DROP TRIGGER IF EXISTS invoice_search_insert;",
+	"DROP TRIGGER IF EXISTS invoice_search_update;",
+	"DROP TRIGGER IF EXISTS invoice_search_delete;",
+	"DROP TRIGGER IF EXISTS labor_search_insert;",
+	"DROP TRIGGER IF EXISTS labor_search_update;",
+	"DROP TRIGGER IF EXISTS labor_search_delete;"
+};
+}
+}
+#endif
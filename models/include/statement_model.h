@@ -5,13 +5,21 @@
  *        generate printable/email-ready customer statements.
  *
  * @details
- * The model::statement class implements the interface::model_operations API and
+ * The model::statement class implements the
+ * interface::model_operations<data::pdf_statement, data::statement> API and
  * provides model-layer functionality for:
  *
  *   • Loading statement records for a specific business/client.
+ *   • Paging through those statements newest first (keyset on statement_id),
+ *     each carrying only the invoices linked to it.
  *   • Saving a statement entry and its associated metadata to the database.
  *   • Preparing statement data for email distribution (PDF generation + metadata).
+ *     With model::attachments::bundle the statements and all the invoices
+ *     they reference go out as one PDF (see bundle_pdf.h) instead of one
+ *     attachment per statement.
  *   • Preparing statement data for printing (PDF file generation).
+ *   • Streaming one PDF file per statement into a directory (write_pdfs),
+ *     without holding the batch in memory.
  *
  * Responsibilities:
  *   - Wrap lower-level serializer/database logic behind a clean high-level API.
@@ -20,37 +28,65 @@
  *   - Enforce basic validation of provided input (business name, statement data).
  *
  * Protected helpers:
- *   - convert_pdfs_to_strings() — Turns std::any PDF handles into file paths for print workflows.
+ *   - convert_pdfs_to_strings() — Renders the pdf_statement span into raw PDF documents.
+ *   - convert_pdfs_to_bundle() — Renders the pdf_statement span and its invoices into
+ *                                one raw PDF document.
+ *   - assemble() — Builds one pdf_statement from a statement and its invoice rows,
+ *                  totalled from the stored total_cents when given and from the
+ *                  invoices' grand totals otherwise.
  *
  * The statement model owns the database file path and password, which are used
  * for all database operations. This class is non-copyable but movable.
  *******************************************************************************/
 #ifndef _STATEMENT_MODEL_H_
 #define _STATEMENT_MODEL_H_
+#include <optional>
+#include <filesystem>
+#include <sqlite.h>
 #include <models.h>
+#include <admin_data.h>
+#include <client_data.h>
+#include <statement_data.h>
+#include <pdf_statement_data.h>
 
 namespace model {
-class statement: public interface::model_operations {
+enum class attachments {
+	separate = 0,
+	bundle
+};
+
+class statement: public interface::model_operations<data::pdf_statement, data::statement> {
 public:
 	statement() = delete;
 	explicit statement(const std::string&, const std::string&);
+	explicit statement(const std::string&, const std::string&, const model::attachments&);
 	statement(const statement&) = default;
 	statement(statement&&) = default;
 	statement& operator= (const statement&) = default;
 	statement& operator= (statement&&) = default;
 	virtual ~statement() override;
 
-	[[nodiscard]] virtual std::vector<std::any> load(const std::string&) const override;
-	[[nodiscard]] virtual bool save(const std::any&) const override;
-	[[nodiscard]] virtual data::email prepare_for_email(const std::vector<std::any>&) const override;
-	[[nodiscard]] virtual std::vector<std::string> prepare_for_print(const std::vector<std::any>&) const override;
+	[[nodiscard]] virtual model::documents<data::pdf_statement> load(const std::string&) const override;
+	[[nodiscard]] virtual model::documents<data::pdf_statement> load_page(const std::string&, const model::page&) const override;
+	[[nodiscard]] virtual bool save(const data::statement&) const override;
+	[[nodiscard]] virtual data::email prepare_for_email(std::span<const data::pdf_statement>) const override;
+	[[nodiscard]] virtual std::vector<std::string> prepare_for_print(std::span<const data::pdf_statement>) const override;
+	[[nodiscard]] virtual bool write_pdfs(std::span<const data::pdf_statement>, const std::filesystem::path&) const;
 
 protected:
-	[[nodiscard]] virtual std::vector<std::string> convert_pdfs_to_strings(const std::vector<std::any>&) const;
+	[[nodiscard]] virtual std::vector<std::string> convert_pdfs_to_strings(std::span<const data::pdf_statement>) const;
+	[[nodiscard]] virtual std::vector<std::string> convert_pdfs_to_bundle(std::span<const data::pdf_statement>) const;
+	[[nodiscard]] virtual data::pdf_statement assemble(storage::database::sqlite&,
+							   const data::statement&,
+							   const storage::database::part::rows&,
+							   const data::client&,
+							   const data::admin&,
+							   const std::optional<long long>&) const;
 
 private:
 	std::string database_file;
 	std::string database_password;
+	model::attachments mode{model::attachments::separate};
 };
 }
 #endif
@@ -25,6 +25,11 @@
  *   The nested sql::query namespace provides the SQL statements used for:
  *     - Inserting/updating a statement record          (statement_usert)
  *     - Selecting a specific business’s statement      (statement_select)
+ *     - Selecting one keyset page of statements        (statement_page_select),
+ *       with each statement's maintained total_cents as a trailing column
+ *     - Selecting the invoices linked to one statement (statement_page_invoices_select)
+ *     - Indices backing the keyset page                (statement_page_index,
+ *                                                        statement_invoice_index)
  *     - Selecting invoices associated with a statement (statement_invoices_select)
  *     - Selecting administrative business information   (statement_admin_select)
  *
@@ -102,6 +107,51 @@ constexpr const char* statement_select{R"sql(
 	ORDER BY s.period_start DESC;
 )sql"};
 
+constexpr const char* statement_page_select{R"sql(
+	SELECT
+		b.business_name,
+		s.statement_id,
+		s.period_start,
+		s.period_end,
+		s.statement_date,
+		s.paid_status,
+		s.total_cents
+	FROM statement s
+	JOIN client c          ON c.business_id = s.business_id
+	JOIN business_details b ON b.business_id = c.business_id
+	WHERE b.business_name = ?
+	  AND s.statement_id < ?
+	ORDER BY s.statement_id DESC
+	LIMIT ?;
+)sql"};
+
+constexpr const char* statement_page_invoices_select{R"sql(
+	SELECT
+		b.business_name,
+		i.invoice_id,
+		i.order_number,
+		i.job_card_number,
+		i.date_created,
+		i.paid_status,
+		i.material_total,
+		i.description_total,
+		i.grand_total
+	FROM invoice i
+	JOIN business_details b ON b.business_id = i.business_id
+	WHERE i.statement_id = ?
+	ORDER BY i.invoice_id ASC;
+)sql"};
+
+constexpr const char* statement_page_index{R"sql(
+	CREATE INDEX IF NOT EXISTS statement_business_page_idx
+		ON statement (business_id, statement_id);
+)sql"};
+
+constexpr const char* statement_invoice_index{R"sql(
+	CREATE INDEX IF NOT EXISTS invoice_statement_idx
+		ON invoice (statement_id);
+)sql"};
+
 constexpr const char* statement_invoices_select{R"sql(
 	SELECT
 		i.statement_id,
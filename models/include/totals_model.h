@@ -0,0 +1,207 @@
+/*******************************************************************************
+ * @file totals_model.h
+ *
+ * @brief Statement totals maintained by triggers, and their verification.
+ *
+ * @details
+ * Every statement row carries the aggregates of the invoices linked to it
+ * through statement_id:
+ *
+ *  - `invoice_count` : the number of linked invoices.
+ *  - `total_cents`   : their grand totals, in integer cents.
+ *  - `unpaid_cents`  : the grand totals of those still 'Not Paid'.
+ *
+ * Three triggers on the invoice table keep them correct, so a statement
+ * page reads its totals from the statement rows instead of loading and
+ * parsing every invoice:
+ *
+ *  - `statement_totals_insert` : adds a new linked invoice to its statement.
+ *  - `statement_totals_delete` : subtracts a deleted one.
+ *  - `statement_totals_update` : recomputes the old and the new statement
+ *                                when an invoice's statement_id, grand_total
+ *                                or paid_status changes. Recomputing rather
+ *                                than adjusting keeps the totals right when
+ *                                the change is a cascade from the statement
+ *                                itself (ON UPDATE CASCADE, ON DELETE SET
+ *                                NULL), which adjusting would count twice.
+ *
+ * The triggers use the invoice.total_cents generated column of the report
+ * model; a database that predates it gets both generated columns first.
+ *
+ * Declares `model::totals`, which:
+ *
+ *  - `prepare()` : adds the columns and triggers to a database that predates
+ *                  them and computes every statement once, in one
+ *                  transaction. The models run it through
+ *                  `model::prepare_once()`, so it runs once per database
+ *                  file rather than on every page load.
+ *  - `verify()`  : recomputes every statement from its invoices and returns
+ *                  the ones whose stored totals differ.
+ *  - `repair()`  : recomputes and stores every statement, for use after the
+ *                  invoice table was changed with the triggers absent.
+ *
+ * `mint-bill-verify` runs `verify()` and, on request, `repair()` over a
+ * database from the command line.
+ ******************************************************************************/
+#ifndef _TOTALS_MODEL_H_
+#define _TOTALS_MODEL_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include <sqlite.h>
+
+namespace model {
+struct statement_total {
+	long long invoices{0};
+	long long total_cents{0};
+	long long unpaid_cents{0};
+
+	bool operator==(const statement_total&) const = default;
+};
+
+struct total_drift {
+	long long statement_id{0};
+	model::statement_total stored{};
+	model::statement_total actual{};
+};
+
+class totals {
+public:
+	totals() = delete;
+	explicit totals(const std::string&, const std::string&);
+	totals(const totals&) = delete;
+	totals(totals&&) = delete;
+	totals& operator=(const totals&) = delete;
+	totals& operator=(totals&&) = delete;
+	virtual ~totals();
+
+	[[nodiscard]] virtual bool is_available() const;
+	[[nodiscard]] virtual std::vector<model::total_drift> verify() const;
+	[[nodiscard]] virtual bool repair() const;
+	[[nodiscard]] static bool prepare(storage::database::sqlite&);
+
+private:
+	std::unique_ptr<storage::database::sqlite> database{nullptr};
+	bool available{false};
+};
+}
+
+
+namespace sql {
+namespace query {
+constexpr const char* statement_totals_objects{R"sql(
+	SELECT
+		(SELECT count(*) FROM pragma_table_info('statement')
+		 WHERE name IN ('invoice_count', 'total_cents', 'unpaid_cents')) +
+		(SELECT count(*) FROM sqlite_master
+		 WHERE name IN ('statement_totals_insert', 'statement_totals_delete',
+				'statement_totals_update'));
+)sql"};
+
+constexpr const char* statement_totals_columns_select{R"sql(
+	SELECT count(*) FROM pragma_table_info('statement')
+	WHERE name IN ('invoice_count', 'total_cents', 'unpaid_cents');
+)sql"};
+
+constexpr const char* statement_totals_columns[]{
+	"ALTER TABLE statement ADD COLUMN invoice_count INTEGER NOT NULL DEFAULT 0;",
+	"ALTER TABLE statement ADD COLUMN total_cents INTEGER NOT NULL DEFAULT 0;",
+	"ALTER TABLE statement ADD COLUMN unpaid_cents INTEGER NOT NULL DEFAULT 0;"
+};
+
+constexpr const char* statement_totals_insert_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS statement_totals_insert
+	AFTER INSERT ON invoice
+	WHEN NEW.statement_id IS NOT NULL
+	BEGIN
+		UPDATE statement SET
+			invoice_count = invoice_count + 1,
+			total_cents   = total_cents + NEW.total_cents,
+			unpaid_cents  = unpaid_cents + CASE WHEN NEW.paid_status = 'Not Paid' THEN NEW.total_cents ELSE 0 END
+		WHERE statement_id = NEW.statement_id;
+	END;
+)sql"};
+
+constexpr const char* statement_totals_delete_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS statement_totals_delete
+	AFTER DELETE ON invoice
+	WHEN OLD.statement_id IS NOT NULL
+	BEGIN
+		UPDATE statement SET
+			invoice_count = invoice_count - 1,
+			total_cents   = total_cents - OLD.total_cents,
+			unpaid_cents  = unpaid_cents - CASE WHEN OLD.paid_status = 'Not Paid' THEN OLD.total_cents ELSE 0 END
+		WHERE statement_id = OLD.statement_id;
+	END;
+)sql"};
+
+constexpr const char* statement_totals_update_trigger{R"sql(
+	CREATE TRIGGER IF NOT EXISTS statement_totals_update
+	AFTER UPDATE OF statement_id, grand_total, paid_status ON invoice
+	WHEN OLD.statement_id IS NOT NEW.statement_id
+	  OR OLD.grand_total IS NOT NEW.grand_total
+	  OR OLD.paid_status IS NOT NEW.paid_status
+	BEGIN
+		UPDATE statement SET (invoice_count, total_cents, unpaid_cents) = (
+			SELECT
+				count(*),
+				coalesce(sum(i.total_cents), 0),
+				coalesce(sum(CASE WHEN i.paid_status = 'Not Paid' THEN i.total_cents ELSE 0 END), 0)
+			FROM invoice i
+			WHERE i.statement_id = statement.statement_id
+		)
+		WHERE statement_id IN (OLD.statement_id, NEW.statement_id);
+	END;
+)sql"};
+
+constexpr const char* statement_totals_triggers[]{
+	statement_totals_insert_trigger,
+	statement_totals_delete_trigger,
+	statement_totals_update_trigger
+};
+
+constexpr const char* statement_totals_recompute{R"sql(
+	UPDATE statement SET (invoice_count, total_cents, unpaid_cents) = (
+		SELECT
+			count(*),
+			coalesce(sum(i.total_cents), 0),
+			coalesce(sum(CASE WHEN i.paid_status = 'Not Paid' THEN i.total_cents ELSE 0 END), 0)
+		FROM invoice i
+		WHERE i.statement_id = statement.statement_id
+	);
+)sql"};
+
+constexpr const char* statement_totals_verify_select{R"sql(
+	SELECT
+		s.statement_id,
+		s.invoice_count,
+		s.total_cents,
+		s.unpaid_cents,
+		coalesce(a.invoices, 0),
+		coalesce(a.total, 0),
+		coalesce(a.unpaid, 0)
+	FROM statement s
+	LEFT JOIN (
+		SELECT
+			statement_id,
+			count(*) AS invoices,
+			sum(total_cents) AS total,
+			sum(CASE WHEN paid_status = 'Not Paid' THEN total_cents ELSE 0 END) AS unpaid
+		FROM invoice
+		WHERE statement_id IS NOT NULL
+		GROUP BY statement_id
+	) a ON a.statement_id = s.statement_id
+	WHERE s.invoice_count IS NOT coalesce(a.invoices, 0)
+	   OR s.total_cents IS NOT coalesce(a.total, 0)
+	   OR s.unpaid_cents IS NOT coalesce(a.unpaid, 0)
+	ORDER BY s.statement_id;
+)sql"};
+
+constexpr const char* statement_totals_drop[]{
+	"DROP TRIGGER IF EXISTS statement_totals_insert;",
+	"DROP TRIGGER IF EXISTS statement_totals_delete;",
+	"DROP TRIGGER IF EXISTS statement_totals_update;"
+};
+}
+}
+#endif
@@ -27,9 +27,18 @@
  *******************************************************************************/
 #include <string>
 #include <syslog.h>
+#include <model_cache.h>
 #include <admin_model.h>
 #include <admin_serialize.h>
 #include <business_serialize.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& load_time{utility::metrics::histogram_named("model.load_ns")};
+	utility::metrics::histogram& save_time{utility::metrics::histogram_named("model.save_ns")};
+}
 
 
 model::admin::admin(const std::string& _database_file, const std::string& _database_password)
@@ -39,7 +48,16 @@ model::admin::~admin() {}
 
 std::any model::admin::load()
 {
+	TRACE_SPAN("model", "admin::load");
+	utility::metrics::timer load_timer{load_time};
         data::admin admin_data;
+	std::shared_ptr<const data::admin> cached{
+		model::cache::instance().find<data::admin>(this->database_file, model::entity::admin, "")};
+	if (cached != nullptr)
+	{
+		return *cached;
+	}
+
 	serialize::admin admin_serialize{};
 	storage::database::sqlite database{this->database_file, this->database_password};
 	admin_data = std::move(std::any_cast<data::admin> (
@@ -49,11 +67,19 @@ std::any model::admin::load()
 				)
 			);
 
+	if (admin_data.is_valid() == true)
+	{
+		model::cache::instance().store(this->database_file, model::entity::admin, "", "",
+					       std::make_shared<const data::admin>(admin_data), model::footprint(admin_data));
+	}
+
         return admin_data;
 }
 
 std::any model::admin::load(const std::string& _business_name)
 {
+	TRACE_SPAN("model", "admin::load");
+	utility::metrics::timer load_timer{load_time};
         data::admin admin_data;
 	if (_business_name.empty() == true)
 	{
@@ -62,6 +88,13 @@ std::any model::admin::load(const std::string& _business_name)
 	}
 	else
 	{
+		std::shared_ptr<const data::admin> cached{
+			model::cache::instance().find<data::admin>(this->database_file, model::entity::admin, _business_name)};
+		if (cached != nullptr)
+		{
+			return *cached;
+		}
+
 		serialize::admin admin_serialize{};
 		storage::database::sql_parameters admin_param = {_business_name};
 		storage::database::sqlite database{this->database_file, this->database_password};
@@ -71,6 +104,12 @@ std::any model::admin::load(const std::string& _business_name)
 						)
 					)
 				);
+
+		if (admin_data.is_valid() == true)
+		{
+			model::cache::instance().store(this->database_file, model::entity::admin, _business_name, "",
+						       std::make_shared<const data::admin>(admin_data), model::footprint(admin_data));
+		}
 	}
 
         return admin_data;
@@ -78,6 +117,8 @@ std::any model::admin::load(const std::string& _business_name)
 
 bool model::admin::save(const std::any& _data)
 {
+	TRACE_SPAN("model", "admin::save");
+	utility::metrics::timer save_timer{save_time};
         bool saved{false};
 	data::admin admin_data{std::any_cast<data::admin> (_data)};
         if (admin_data.is_valid() == false)
@@ -150,6 +191,7 @@ bool model::admin::save(const std::any& _data)
 		else
 		{
 			saved = true;
+			model::cache::instance().clear();
 		}
         }
 
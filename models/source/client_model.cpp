@@ -34,10 +34,19 @@
  *    `false` is returned to the caller.
  ******************************************************************************/
 #include <syslog.h>
+#include <model_cache.h>
 #include <client_data.h>
 #include <client_model.h>
 #include <client_serialize.h>
 #include <business_serialize.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& load_time{utility::metrics::histogram_named("model.load_ns")};
+	utility::metrics::histogram& save_time{utility::metrics::histogram_named("model.save_ns")};
+}
 
 
 model::client::client(const std::string& _database_file, const std::string& _database_password)
@@ -51,6 +60,8 @@ model::client::~client()
 
 std::any model::client::load(const std::string& _business_name)
 {
+	TRACE_SPAN("model", "client::load");
+	utility::metrics::timer load_timer{load_time};
         data::client client_data{};
         if (_business_name.empty() == true)
 	{
@@ -59,6 +70,13 @@ std::any model::client::load(const std::string& _business_name)
 	}
 	else
         {
+		std::shared_ptr<const data::client> cached{
+			model::cache::instance().find<data::client>(this->database_file, model::entity::client, _business_name)};
+		if (cached != nullptr)
+		{
+			return *cached;
+		}
+
 		serialize::client client_serialize{};
 		storage::database::sql_parameters client_param = {_business_name};
 		storage::database::sqlite database{this->database_file, this->database_password};
@@ -68,6 +86,12 @@ std::any model::client::load(const std::string& _business_name)
 						)
 					)
 				);
+
+		if (client_data.is_valid() == true)
+		{
+			model::cache::instance().store(this->database_file, model::entity::client, _business_name, "",
+						       std::make_shared<const data::client>(client_data), model::footprint(client_data));
+		}
         }
 
         return client_data;
@@ -75,6 +99,8 @@ std::any model::client::load(const std::string& _business_name)
 
 bool model::client::save(const std::any& _data)
 {
+	TRACE_SPAN("model", "client::save");
+	utility::metrics::timer save_timer{save_time};
         bool saved{false};
 	data::client client_data = std::any_cast<data::client>(_data);
         if (client_data.is_valid() == false)
@@ -144,6 +170,7 @@ bool model::client::save(const std::any& _data)
 		else
 		{
 			saved = true;
+			model::cache::instance().invalidate(this->database_file, client_data.get_name());
 		}
         }
 
@@ -0,0 +1,333 @@
+/*******************************************************************************
+ * @file export_model.cpp
+ *
+ * @brief Implementation of the streaming export.
+ *
+ * @details
+ * Core operations:
+ *  - Constructor:
+ *      * Opens the database once, keeps the connection and prepares the
+ *        generated invoice columns and statement totals the export reads,
+ *        once per database file through `model::prepare_once()`.
+ *
+ *  - `write()`:
+ *      * Resolves the clients (the named ones, or all of them by name),
+ *        writes the header and streams each client's rows into the writer.
+ *
+ *  - `write_split()`:
+ *      * Resolves the clients once, then starts up to the requested number of
+ *        workers; worker n opens its own connection and writes clients n,
+ *        n + workers, ... each to its own file in the directory, named after
+ *        the business id and name.
+ *
+ * Error handling:
+ *  - Uses `syslog(LOG_CRIT, ...)` with file and line information to report
+ *    an unknown client, an invalid date, a failed query or a failed write;
+ *    the export stops at the first failure and returns false. Files already
+ *    written by `write_split()` are left in place.
+ ******************************************************************************/
+#include <export_model.h>
+#include <span>
+#include <future>
+#include <cctype>
+#include <fstream>
+#include <algorithm>
+#include <variant>
+#include <syslog.h>
+#include <trace.h>
+#include <totals_model.h>
+#include <schema_guard.h>
+#include <report_model.h>
+
+
+namespace {
+	constexpr const char* first_date{"0000-00-00"};
+	constexpr const char* last_date{"9999-99-99"};
+
+	std::span<const char* const> columns(const model::export_kind& _kind)
+	{
+		switch (_kind)
+		{
+		case model::export_kind::labor:
+			return sql::query::export_labor_columns;
+		case model::export_kind::statements:
+			return sql::query::export_statement_columns;
+		default:
+			return sql::query::export_invoice_columns;
+		}
+	}
+
+	const char* kind_name(const model::export_kind& _kind)
+	{
+		switch (_kind)
+		{
+		case model::export_kind::labor:
+			return "labor";
+		case model::export_kind::statements:
+			return "statements";
+		default:
+			return "invoices";
+		}
+	}
+
+	bool valid(const model::export_filter& _filter)
+	{
+		return (_filter.from.empty() || model::report::is_date(_filter.from)) &&
+		       (_filter.to.empty() || model::report::is_date(_filter.to));
+	}
+}
+
+
+
+model::exporter::exporter(const std::string& _database_file, const std::string& _database_password)
+	: database_file{_database_file}, database_password{_database_password}
+{
+	TRACE_SPAN("model", "exporter::open");
+	try
+	{
+		this->database = std::make_unique<storage::database::sqlite>(_database_file, _database_password);
+		this->available = model::prepare_once(_database_file, "totals", [this] () {
+			return model::totals::prepare(*this->database);
+		});
+	}
+	catch (...)
+	{
+		syslog(LOG_CRIT, "EXPORT_MODEL: failed to open the database - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+}
+
+model::exporter::~exporter() {}
+
+bool model::exporter::is_available() const
+{
+	return this->available;
+}
+
+bool model::exporter::write(std::ostream& _output, const model::export_kind& _kind, const model::export_format& _format,
+			    const model::export_filter& _filter, std::size_t& _rows) const
+{
+	TRACE_SPAN("model", "exporter::write");
+	bool success{false};
+	std::vector<client> clients{};
+	std::unique_ptr<interface::record_writer> writer{make_writer(_output, _format)};
+	if (this->available == false || valid(_filter) == false)
+	{
+		syslog(LOG_CRIT, "EXPORT_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (select_clients(*this->database, _filter, clients) == false)
+	{
+		syslog(LOG_CRIT, "EXPORT_MODEL: failed to select the clients - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (writer->begin(columns(_kind)) == false)
+	{
+		syslog(LOG_CRIT, "EXPORT_MODEL: failed to write the header - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		success = true;
+		for (const client& current : clients)
+		{
+			if (write_client(*this->database, *writer, _kind, _filter, current.first, _rows) == false)
+			{
+				success = false;
+				break;
+			}
+		}
+		success = (writer->finish() && success);
+	}
+
+	return success;
+}
+
+bool model::exporter::write_split(const std::filesystem::path& _directory, const model::export_kind& _kind,
+				  const model::export_format& _format, const model::export_filter& _filter,
+				  const std::size_t& _workers, std::size_t& _rows) const
+{
+	TRACE_SPAN("model", "exporter::write_split");
+	bool success{false};
+	std::error_code error{};
+	std::vector<client> clients{};
+	if (this->available == false || valid(_filter) == false || _workers == 0)
+	{
+		syslog(LOG_CRIT, "EXPORT_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (std::filesystem::create_directories(_directory, error); error)
+	{
+		syslog(LOG_CRIT, "EXPORT_MODEL: failed to create the export directory - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (select_clients(*this->database, _filter, clients) == false)
+	{
+		syslog(LOG_CRIT, "EXPORT_MODEL: failed to select the clients - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		const std::size_t workers{std::min(_workers, std::max<std::size_t>(clients.size(), 1))};
+		std::vector<std::future<std::pair<bool, std::size_t>>> futures{};
+		futures.reserve(workers);
+		for (std::size_t worker{0}; worker < workers; ++worker)
+		{
+			futures.push_back(std::async(std::launch::async, [this, worker, workers, &clients, &_directory,
+									  &_kind, &_format, &_filter] () {
+				std::size_t rows{0};
+				try
+				{
+					storage::database::sqlite connection{this->database_file, this->database_password};
+					for (std::size_t index{worker}; index < clients.size(); index += workers)
+					{
+						std::ofstream file{_directory / file_name(clients[index].first, clients[index].second, _kind, _format),
+								   std::ios::binary | std::ios::trunc};
+						std::unique_ptr<interface::record_writer> writer{make_writer(file, _format)};
+						if (file.is_open() == false || writer->begin(columns(_kind)) == false ||
+						    write_client(connection, *writer, _kind, _filter, clients[index].first, rows) == false ||
+						    writer->finish() == false)
+						{
+							syslog(LOG_CRIT, "EXPORT_MODEL: failed to write a client file - "
+									 "filename %s, line number %d", __FILE__, __LINE__);
+							return std::pair<bool, std::size_t>{false, rows};
+						}
+					}
+				}
+				catch (...)
+				{
+					syslog(LOG_CRIT, "EXPORT_MODEL: failed to open the database - "
+							 "filename %s, line number %d", __FILE__, __LINE__);
+					return std::pair<bool, std::size_t>{false, rows};
+				}
+
+				return std::pair<bool, std::size_t>{true, rows};
+			}));
+		}
+
+		success = true;
+		for (std::future<std::pair<bool, std::size_t>>& future : futures)
+		{
+			const std::pair<bool, std::size_t> result{future.get()};
+			success = (result.first && success);
+			_rows += result.second;
+		}
+	}
+
+	return success;
+}
+
+std::string model::exporter::file_name(const std::string& _business_name, const model::export_kind& _kind,
+				       const model::export_format& _format)
+{
+	std::string name{""};
+	for (const char character : _business_name)
+	{
+		const unsigned char code{static_cast<unsigned char> (character)};
+		const bool safe{std::isalnum(code) || character == '-' || character == '_' || code >= 0x80};
+		name.push_back(safe ? character : '_');
+	}
+	if (name.empty() == true)
+	{
+		name = "_";
+	}
+
+	return name + "." + kind_name(_kind) + ((_format == model::export_format::jsonl) ? ".jsonl" : ".csv");
+}
+
+std::string model::exporter::file_name(const sqlite3_int64& _business_id, const std::string& _business_name,
+				       const model::export_kind& _kind, const model::export_format& _format)
+{
+	return std::to_string(_business_id) + "-" + file_name(_business_name, _kind, _format);
+}
+
+bool model::exporter::select_clients(storage::database::sqlite& _database, const model::export_filter& _filter,
+				     std::vector<client>& _clients)
+{
+	bool success{true};
+	auto append = [&_clients] (const storage::database::part::row& _row) {
+		const sqlite3_int64* business_id{std::get_if<sqlite3_int64>(&_row[0])};
+		const std::string* business_name{std::get_if<std::string>(&_row[1])};
+		if (business_id != nullptr && business_name != nullptr)
+		{
+			_clients.emplace_back(*business_id, *business_name);
+		}
+
+		return true;
+	};
+
+	if (_filter.clients.empty() == true)
+	{
+		success = _database.stream(sql::query::export_clients_select, {}, append);
+	}
+	else
+	{
+		for (const std::string& business_name : _filter.clients)
+		{
+			const std::size_t before{_clients.size()};
+			if (_database.stream(sql::query::export_client_select, {business_name}, append) == false ||
+			    _clients.size() == before)
+			{
+				syslog(LOG_CRIT, "EXPORT_MODEL: unknown client - "
+						 "filename %s, line number %d", __FILE__, __LINE__);
+				success = false;
+				break;
+			}
+		}
+	}
+
+	return success;
+}
+
+bool model::exporter::write_client(storage::database::sqlite& _database, interface::record_writer& _writer,
+				   const model::export_kind& _kind, const model::export_filter& _filter,
+				   const sqlite3_int64& _business_id, std::size_t& _rows)
+{
+	const bool ranged{_filter.from.empty() == false || _filter.to.empty() == false};
+	const std::vector<storage::database::param_values> range{
+		_business_id,
+		_filter.from.empty() ? std::string{first_date} : _filter.from,
+		_filter.to.empty() ? std::string{last_date} : _filter.to
+	};
+
+	const char* query{sql::query::export_invoices_select};
+	std::vector<storage::database::param_values> params{range};
+	if (_kind == model::export_kind::labor)
+	{
+		query = sql::query::export_labor_select;
+	}
+	else if (_kind == model::export_kind::statements && ranged == true)
+	{
+		query = sql::query::export_statements_range_select;
+	}
+	else if (_kind == model::export_kind::statements)
+	{
+		query = sql::query::export_statements_select;
+		params.resize(1);
+	}
+
+	bool written{true};
+	const bool stepped{_database.stream(query, params, [&_writer, &_rows, &written] (const storage::database::part::row& _row) {
+		written = _writer.write(_row);
+		_rows += (written == true) ? 1 : 0;
+		return written;
+	})};
+	if (stepped == false || written == false)
+	{
+		syslog(LOG_CRIT, "EXPORT_MODEL: failed to export a client - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+
+	return (stepped && written);
+}
+
+std::unique_ptr<interface::record_writer> model::exporter::make_writer(std::ostream& _output,
+								      const model::export_format& _format)
+{
+	if (_format == model::export_format::jsonl)
+	{
+		return std::make_unique<model::jsonl_writer>(_output);
+	}
+
+	return std::make_unique<model::csv_writer>(_output);
+}
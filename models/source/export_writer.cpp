@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * @file export_writer.cpp
+ *
+ * @brief Implementation of the CSV and JSON Lines row writers.
+ *
+ * @details
+ * Each value of a row is one of the five SQLite storage classes; both
+ * writers format them through std::visit:
+ *
+ *  - NULL    : an empty CSV field, JSON `null`.
+ *  - INTEGER : decimal digits.
+ *  - REAL    : std::to_chars shortest round-trip form; a non-finite value
+ *              (which SQLite does not store) is written as NULL.
+ *  - TEXT    : CSV quoted when needed, JSON escaped.
+ *  - BLOB    : lower-case hex, as text.
+ *
+ * Error handling:
+ *  - `write()` before `begin()`, or a row whose width differs from the
+ *    header, is rejected and logged with `syslog(LOG_CRIT, ...)`; a failed
+ *    stream makes `write()` and `finish()` return false.
+ ******************************************************************************/
+#include <export_writer.h>
+#include <array>
+#include <cmath>
+#include <charconv>
+#include <variant>
+#include <syslog.h>
+
+
+namespace {
+	std::string_view real(const double& _value, std::array<char, 32>& _buffer)
+	{
+		const std::to_chars_result result{std::to_chars(_buffer.data(), _buffer.data() + _buffer.size(), _value)};
+		return std::string_view{_buffer.data(), static_cast<std::size_t> (result.ptr - _buffer.data())};
+	}
+
+	std::string hex(const storage::database::blob& _blob)
+	{
+		constexpr const char* digits{"0123456789abcdef"};
+		std::string text{};
+		text.reserve(_blob.size() * 2);
+		for (const std::byte& value : _blob)
+		{
+			text.push_back(digits[std::to_integer<unsigned>(value) >> 4]);
+			text.push_back(digits[std::to_integer<unsigned>(value) & 0x0f]);
+		}
+
+		return text;
+	}
+}
+
+
+
+model::csv_writer::csv_writer(std::ostream& _output) : output{_output} {}
+
+model::csv_writer::~csv_writer() {}
+
+bool model::csv_writer::begin(std::span<const char* const> _columns)
+{
+	this->columns = _columns.size();
+	for (std::size_t index{0}; index < _columns.size(); ++index)
+	{
+		if (index > 0)
+		{
+			this->output.put(',');
+		}
+		field(_columns[index]);
+	}
+	this->output.put('\n');
+
+	return this->output.good();
+}
+
+bool model::csv_writer::write(const storage::database::part::row& _row)
+{
+	if (this->columns == 0 || _row.size() != this->columns)
+	{
+		syslog(LOG_CRIT, "CSV_WRITER: the row does not match the header - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	std::array<char, 32> buffer{};
+	for (std::size_t index{0}; index < _row.size(); ++index)
+	{
+		if (index > 0)
+		{
+			this->output.put(',');
+		}
+
+		std::visit([this, &buffer] (const auto& _value) {
+			using type = std::decay_t<decltype(_value)>;
+			if constexpr (std::is_same_v<type, sqlite3_int64>)
+			{
+				this->output << _value;
+			}
+			else if constexpr (std::is_same_v<type, double>)
+			{
+				if (std::isfinite(_value))
+				{
+					this->output << real(_value, buffer);
+				}
+			}
+			else if constexpr (std::is_same_v<type, std::string>)
+			{
+				field(_value);
+			}
+			else if constexpr (std::is_same_v<type, storage::database::blob>)
+			{
+				this->output << hex(_value);
+			}
+		}, _row[index]);
+	}
+	this->output.put('\n');
+
+	return this->output.good();
+}
+
+bool model::csv_writer::finish()
+{
+	this->output.flush();
+	return this->output.good();
+}
+
+void model::csv_writer::field(const std::string_view& _text)
+{
+	if (_text.find_first_of(",\"\r\n") == std::string_view::npos)
+	{
+		this->output << _text;
+		return;
+	}
+
+	this->output.put('"');
+	for (const char character : _text)
+	{
+		if (character == '"')
+		{
+			this->output.put('"');
+		}
+		this->output.put(character);
+	}
+	this->output.put('"');
+}
+
+
+model::jsonl_writer::jsonl_writer(std::ostream& _output) : output{_output} {}
+
+model::jsonl_writer::~jsonl_writer() {}
+
+bool model::jsonl_writer::begin(std::span<const char* const> _columns)
+{
+	this->keys.clear();
+	this->keys.reserve(_columns.size());
+	for (const char* column : _columns)
+	{
+		std::string key{"\""};
+		for (const char character : std::string_view{column})
+		{
+			if (character == '"' || character == '\\')
+			{
+				key.push_back('\\');
+			}
+			key.push_back(character);
+		}
+		this->keys.push_back(key + "\":");
+	}
+
+	return this->output.good();
+}
+
+bool model::jsonl_writer::write(const storage::database::part::row& _row)
+{
+	if (this->keys.empty() == true || _row.size() != this->keys.size())
+	{
+		syslog(LOG_CRIT, "JSONL_WRITER: the row does not match the columns - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	std::array<char, 32> buffer{};
+	this->output.put('{');
+	for (std::size_t index{0}; index < _row.size(); ++index)
+	{
+		if (index > 0)
+		{
+			this->output.put(',');
+		}
+		this->output << this->keys[index];
+
+		std::visit([this, &buffer] (const auto& _value) {
+			using type = std::decay_t<decltype(_value)>;
+			if constexpr (std::is_same_v<type, sqlite3_int64>)
+			{
+				this->output << _value;
+			}
+			else if constexpr (std::is_same_v<type, double>)
+			{
+				if (std::isfinite(_value))
+				{
+					this->output << real(_value, buffer);
+				}
+				else
+				{
+					this->output << "null";
+				}
+			}
+			else if constexpr (std::is_same_v<type, std::string>)
+			{
+				text(_value);
+			}
+			else if constexpr (std::is_same_v<type, storage::database::blob>)
+			{
+				text(hex(_value));
+			}
+			else
+			{
+				this->output << "null";
+			}
+		}, _row[index]);
+	}
+	this->output << "}\n";
+
+	return this->output.good();
+}
+
+bool model::jsonl_writer::finish()
+{
+	this->output.flush();
+	return this->output.good();
+}
+
+void model::jsonl_writer::text(const std::string_view& _text)
+{
+	constexpr const char* digits{"0123456789abcdef"};
+	this->output.put('"');
+	for (const char character : _text)
+	{
+		const unsigned char code{static_cast<unsigned char> (character)};
+		if (character == '"' || character == '\\')
+		{
+			this->output.put('\\');
+			this->output.put(character);
+		}
+		else if (character == '\n')
+		{
+			this->output << "\\n";
+		}
+		else if (character == '\r')
+		{
+			this->output << "\\r";
+		}
+		else if (character == '\t')
+		{
+			this->output << "\\t";
+		}
+		else if (code < 0x20)
+		{
+			this->output << "\\u00" << digits[code >> 4] << digits[code & 0x0f];
+		}
+		else
+		{
+			this->output.put(character);
+		}
+	}
+	this->output.put('"');
+}
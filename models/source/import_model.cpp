@@ -0,0 +1,449 @@
+/*******************************************************************************
+ * @file import_model.cpp
+ *
+ * @brief Implementation of the bulk import.
+ *
+ * @details
+ * Core operations:
+ *  - Constructor:
+ *      * Opens the database once, keeps the connection and prepares the
+ *        generated invoice columns and statement totals, once per database
+ *        file through `model::prepare_once()`.
+ *
+ *  - `import()`:
+ *      * Reads both headers, begins the transaction and, with
+ *        `defer_indexes`, drops the invoice indexes and the totals triggers.
+ *      * Streams the invoice file: checks each row, resolves its client and
+ *        statement through per-import maps and inserts it, remembering its
+ *        id. Then streams the labor file the same way against those ids.
+ *      * Runs as one transaction: with `defer_indexes` it rebuilds what it
+ *        dropped, then commits once at the end. Any failure rolls the whole
+ *        import back, so an invoice is never stored without its labor lines
+ *        and the same files can be imported again.
+ *      * The invoice and labor search insert triggers are dropped for the
+ *        transaction and put back before the COMMIT. A trigger that writes
+ *        to an FTS5 table opens a statement savepoint, which makes FTS5
+ *        flush its pending terms to a new segment on every row. Instead each
+ *        invoice's search row is written next to it, and the imported labor
+ *        lines, the labor_ids above the largest one at the start, are added
+ *        to the search index in one INSERT ... SELECT before the COMMIT.
+ *
+ * Error handling:
+ *  - A rejected row is recorded in the report and logged at LOG_INFO; SQL
+ *    failures use `syslog(LOG_CRIT, ...)` with file and line information and
+ *    roll back the open transaction.
+ ******************************************************************************/
+#include <import_model.h>
+#include <span>
+#include <chrono>
+#include <charconv>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <syslog.h>
+#include <trace.h>
+#include <model_cache.h>
+#include <column_data.h>
+#include <invoice_data.h>
+#include <totals_model.h>
+#include <schema_guard.h>
+#include <report_model.h>
+#include <search_model.h>
+#include <invoice_serialize.h>
+#include <statement_serialize.h>
+
+
+namespace {
+	constexpr const char* import_indexes_create[]{
+		sql::query::invoice_page_index,
+		sql::query::statement_invoice_index,
+		sql::query::invoice_period_index,
+		sql::query::invoice_unpaid_index
+	};
+
+	constexpr const char* import_search_triggers_create[]{
+		sql::query::invoice_search_insert_trigger,
+		sql::query::labor_search_insert_trigger
+	};
+
+	enum invoice_field {
+		INVOICE_ID = 0,
+		BUSINESS_NAME,
+		ORDER_NUMBER,
+		JOB_CARD_NUMBER,
+		DATE_CREATED,
+		PAID_STATUS,
+		MATERIAL_TOTAL,
+		DESCRIPTION_TOTAL,
+		GRAND_TOTAL,
+		PERIOD_START,
+		PERIOD_END
+	};
+
+	enum labor_field {
+		LABOR_INVOICE_ID = 0,
+		LINE_NUMBER,
+		IS_DESCRIPTION,
+		QUANTITY,
+		DESCRIPTION,
+		AMOUNT
+	};
+
+	template <typename number>
+	bool parse(const std::string& _text, number& _value)
+	{
+		const char* end{_text.data() + _text.size()};
+		const std::from_chars_result result{std::from_chars(_text.data(), end, _value)};
+		return _text.empty() == false && result.ec == std::errc{} && result.ptr == end;
+	}
+
+	bool run(storage::database::sqlite& _database, std::span<const char* const> _statements)
+	{
+		return std::ranges::all_of(_statements, [&_database] (const char* _statement) {
+			return _database.transaction(_statement);
+		});
+	}
+
+	long long count(storage::database::sqlite& _database, const char* _query)
+	{
+		const storage::database::part::rows rows{_database.select(_query)};
+		const sqlite3_int64* value{rows.empty() ? nullptr : std::get_if<sqlite3_int64>(&rows.front()[0])};
+		return (value == nullptr) ? -1 : static_cast<long long> (*value);
+	}
+
+	std::string invalid_invoice(const std::vector<std::string>& _fields, sqlite3_int64& _invoice_id)
+	{
+		data::invoice invoice_data{};
+		invoice_data.set_id(_fields[INVOICE_ID]);
+		invoice_data.set_name(_fields[BUSINESS_NAME]);
+		invoice_data.set_order_number(_fields[ORDER_NUMBER]);
+		invoice_data.set_job_card_number(_fields[JOB_CARD_NUMBER]);
+		invoice_data.set_date(_fields[DATE_CREATED]);
+		invoice_data.set_paid_status(_fields[PAID_STATUS]);
+		invoice_data.set_material_total(_fields[MATERIAL_TOTAL]);
+		invoice_data.set_description_total(_fields[DESCRIPTION_TOTAL]);
+		invoice_data.set_grand_total(_fields[GRAND_TOTAL]);
+
+		const std::pair<std::string, std::string> checks[]{
+			{invoice_data.get_id(), "invoice_id"},
+			{invoice_data.get_name(), "business_name"},
+			{invoice_data.get_order_number(), "order_number"},
+			{invoice_data.get_job_card_number(), "job_card_number"},
+			{invoice_data.get_date(), "date_created"},
+			{invoice_data.get_paid_status(), "paid_status"},
+			{invoice_data.get_material_total(), "material_total"},
+			{invoice_data.get_description_total(), "description_total"},
+			{invoice_data.get_grand_total(), "grand_total"}
+		};
+		for (std::size_t index{0}; index < std::size(checks); ++index)
+		{
+			if (_fields[index].empty() == true || checks[index].first != _fields[index])
+			{
+				return "invalid " + checks[index].second;
+			}
+		}
+
+		if (parse(_fields[INVOICE_ID], _invoice_id) == false || _invoice_id <= 0)
+		{
+			return "invoice_id is not a positive whole number";
+		}
+		else if (_fields[PERIOD_START].empty() != _fields[PERIOD_END].empty())
+		{
+			return "period_start and period_end must be given together";
+		}
+
+		return "";
+	}
+
+	std::string invalid_labor(const std::vector<std::string>& _fields, sqlite3_int64& _invoice_id, data::column& _column)
+	{
+		long long line_number{0};
+		long long is_description{0};
+		unsigned int quantity{0};
+		double amount{0.0};
+		if (parse(_fields[LABOR_INVOICE_ID], _invoice_id) == false)
+		{
+			return "invalid invoice_id";
+		}
+		else if (parse(_fields[LINE_NUMBER], line_number) == false)
+		{
+			return "invalid line_number";
+		}
+		else if (parse(_fields[IS_DESCRIPTION], is_description) == false)
+		{
+			return "invalid is_description";
+		}
+		else if (parse(_fields[QUANTITY], quantity) == false)
+		{
+			return "invalid quantity";
+		}
+		else if (parse(_fields[AMOUNT], amount) == false)
+		{
+			return "invalid amount";
+		}
+
+		_column.set_row_number(line_number);
+		_column.set_is_description(is_description);
+		_column.set_quantity(quantity);
+		_column.set_description(_fields[DESCRIPTION]);
+		_column.set_amount(amount);
+		if (_column.is_valid() == false)
+		{
+			return (_column.get_description() != _fields[DESCRIPTION]) ? "invalid description" :
+			       "invalid is_description, quantity or amount";
+		}
+
+		return "";
+	}
+}
+
+
+
+model::importer::importer(const std::string& _database_file, const std::string& _database_password)
+	: database_file{_database_file}
+{
+	TRACE_SPAN("model", "importer::open");
+	try
+	{
+		this->database = std::make_unique<storage::database::sqlite>(_database_file, _database_password);
+		this->available = model::prepare_once(_database_file, "totals", [this] () {
+			return model::totals::prepare(*this->database);
+		});
+	}
+	catch (...)
+	{
+		syslog(LOG_CRIT, "IMPORT_MODEL: failed to open the database - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+}
+
+model::importer::~importer() {}
+
+bool model::importer::is_available() const
+{
+	return this->available;
+}
+
+bool model::importer::import(std::istream& _invoices, std::istream& _labor, const model::export_format& _format,
+			     const model::import_options& _options, model::import_report& _report) const
+{
+	TRACE_SPAN("model", "importer::import");
+	const std::chrono::steady_clock::time_point started{std::chrono::steady_clock::now()};
+	std::unique_ptr<interface::record_reader> invoice_reader{make_reader(_invoices, _format)};
+	std::unique_ptr<interface::record_reader> labor_reader{make_reader(_labor, _format)};
+	if (this->available == false)
+	{
+		syslog(LOG_CRIT, "IMPORT_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+	else if (invoice_reader->begin(sql::query::import_invoice_columns, sql::query::import_invoice_required) == false)
+	{
+		_report.errors.push_back(model::import_error{"invoices", 1, invoice_reader->error()});
+		return false;
+	}
+	else if (labor_reader->begin(sql::query::import_labor_columns, std::size(sql::query::import_labor_columns)) == false)
+	{
+		_report.errors.push_back(model::import_error{"labor", 1, labor_reader->error()});
+		return false;
+	}
+
+	storage::database::sqlite& database{*this->database};
+	const bool searched{count(database, sql::query::search_index_objects) ==
+			    static_cast<long long> (std::size(sql::query::search_index_create))};
+	if (database.transaction("BEGIN IMMEDIATE;") == false)
+	{
+		syslog(LOG_CRIT, "IMPORT_MODEL: failed to begin the transaction - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	sqlite3_int64 labor_mark{0};
+	auto unhook = [&database, &searched, &labor_mark] () {
+		labor_mark = count(database, sql::query::import_labor_mark_select);
+		return searched == false || (labor_mark >= 0 && run(database, sql::query::import_search_triggers_drop));
+	};
+
+	auto hook = [&database, &searched, &labor_mark] () {
+		return searched == false || (database.usert(sql::query::import_labor_search_fill, {labor_mark}) &&
+					     run(database, import_search_triggers_create));
+	};
+
+	bool success{unhook() && (_options.defer_indexes == false || defer())};
+	std::unordered_map<std::string, sqlite3_int64> clients{};
+	std::unordered_map<std::string, sqlite3_int64> statements{};
+	std::unordered_set<sqlite3_int64> invoice_ids{};
+	std::vector<std::string> fields{};
+
+	auto reject = [&_report] (const char* _file, const std::size_t& _line, const std::string& _message) {
+		syslog(LOG_INFO, "IMPORT_MODEL: %s line %zu rejected: %s", _file, _line, _message.c_str());
+		_report.errors.push_back(model::import_error{_file, _line, _message});
+		return _report.errors.size() <= app::config::import_error_limit;
+	};
+
+	auto client = [&database, &clients] (const std::string& _business_name) {
+		auto found{clients.find(_business_name)};
+		if (found == clients.end())
+		{
+			const storage::database::part::rows rows{database.select(sql::query::import_client_select, {_business_name})};
+			const sqlite3_int64* business_id{rows.empty() ? nullptr : std::get_if<sqlite3_int64>(&rows.front()[0])};
+			found = clients.emplace(_business_name, (business_id == nullptr) ? 0 : *business_id).first;
+		}
+
+		return found->second;
+	};
+
+	auto statement = [&database, &statements] (const sqlite3_int64& _business_id, const std::string& _start,
+						   const std::string& _end) -> storage::database::param_values {
+		if (_start.empty() == true)
+		{
+			return nullptr;
+		}
+
+		const std::string key{std::to_string(_business_id) + '\x1f' + _start + '\x1f' + _end};
+		auto found{statements.find(key)};
+		if (found == statements.end())
+		{
+			const storage::database::sql_parameters params{_business_id, _start, _end};
+			const storage::database::part::rows rows{
+				database.usert(sql::query::import_statement_insert, params) ?
+				database.select(sql::query::import_statement_select, params) : storage::database::part::rows{}};
+			const sqlite3_int64* statement_id{rows.empty() ? nullptr : std::get_if<sqlite3_int64>(&rows.front()[0])};
+			found = statements.emplace(key, (statement_id == nullptr) ? 0 : *statement_id).first;
+		}
+
+		if (found->second == 0)
+		{
+			return nullptr;
+		}
+
+		return found->second;
+	};
+
+	while (success == true && invoice_reader->read(fields) == true)
+	{
+		sqlite3_int64 invoice_id{0};
+		std::string message{invoice_reader->error()};
+		message = message.empty() ? invalid_invoice(fields, invoice_id) : message;
+		const sqlite3_int64 business_id{message.empty() ? client(fields[BUSINESS_NAME]) : 0};
+		if (message.empty() == true && business_id == 0)
+		{
+			message = "unknown client " + fields[BUSINESS_NAME];
+		}
+		else if (message.empty() == true && invoice_ids.contains(invoice_id) == true)
+		{
+			message = "invoice_id repeats an earlier line";
+		}
+		else if (message.empty() == true &&
+			 database.usert(sql::query::import_invoice_insert, {
+				invoice_id, business_id,
+				statement(business_id, fields[PERIOD_START], fields[PERIOD_END]),
+				fields[ORDER_NUMBER], fields[JOB_CARD_NUMBER], fields[DATE_CREATED], fields[PAID_STATUS],
+				fields[MATERIAL_TOTAL], fields[DESCRIPTION_TOTAL], fields[GRAND_TOTAL]}) == false)
+		{
+			message = "the invoice is already stored";
+		}
+
+		if (message.empty() == false)
+		{
+			success = reject("invoices", invoice_reader->line(), message);
+		}
+		else
+		{
+			invoice_ids.insert(invoice_id);
+			++_report.invoices;
+			success = (searched == false || database.usert(sql::query::import_invoice_search_insert, {
+					invoice_id, fields[ORDER_NUMBER], fields[JOB_CARD_NUMBER]}));
+		}
+	}
+
+	while (success == true && labor_reader->read(fields) == true)
+	{
+		sqlite3_int64 invoice_id{0};
+		data::column column{};
+		std::string message{labor_reader->error()};
+		message = message.empty() ? invalid_labor(fields, invoice_id, column) : message;
+		if (message.empty() == true && invoice_ids.contains(invoice_id) == false)
+		{
+			message = "invoice " + fields[LABOR_INVOICE_ID] + " is not in the imported invoices";
+		}
+		else if (message.empty() == true &&
+			 database.usert(sql::query::labor_insert, {
+				invoice_id, column.get_row_number(), column.get_is_description(),
+				static_cast<long long> (column.get_quantity()), column.get_description(),
+				column.get_amount()}) == false)
+		{
+			message = "the labor line repeats an earlier line_number and is_description";
+		}
+
+		if (message.empty() == false)
+		{
+			success = reject("labor", labor_reader->line(), message);
+		}
+		else
+		{
+			++_report.labor;
+		}
+	}
+
+	if (success == false || (_options.defer_indexes == true && restore() == false) || hook() == false ||
+	    database.transaction("COMMIT;") == false)
+	{
+		success = false;
+		syslog(LOG_CRIT, "IMPORT_MODEL: failed to import the invoices - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		if (database.transaction("ROLLBACK;") == false)
+		{
+			syslog(LOG_CRIT, "IMPORT_MODEL: failed to rollback - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+	}
+
+	for (const auto& [business_name, business_id] : clients)
+	{
+		model::cache::instance().invalidate(this->database_file, model::entity::invoices, business_name);
+		model::cache::instance().invalidate(this->database_file, model::entity::statements, business_name);
+	}
+	model::cache::instance().invalidate(this->database_file, model::entity::reports, "");
+	_report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+	return success;
+}
+
+bool model::importer::defer() const
+{
+	const bool success{run(*this->database, sql::query::statement_totals_drop) &&
+			   run(*this->database, sql::query::import_indexes_drop)};
+	if (success == false)
+	{
+		syslog(LOG_CRIT, "IMPORT_MODEL: failed to drop the indexes and totals triggers - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+
+	return success;
+}
+
+bool model::importer::restore() const
+{
+	const bool success{run(*this->database, import_indexes_create) &&
+			   run(*this->database, sql::query::statement_totals_triggers) &&
+			   this->database->transaction(sql::query::statement_totals_recompute)};
+	if (success == false)
+	{
+		syslog(LOG_CRIT, "IMPORT_MODEL: failed to rebuild the indexes and totals triggers - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+
+	return success;
+}
+
+std::unique_ptr<interface::record_reader> model::importer::make_reader(std::istream& _input,
+								      const model::export_format& _format)
+{
+	if (_format == model::export_format::jsonl)
+	{
+		return std::make_unique<model::jsonl_reader>(_input);
+	}
+
+	return std::make_unique<model::csv_reader>(_input);
+}
@@ -0,0 +1,483 @@
+/*******************************************************************************
+ * @file import_reader.cpp
+ *
+ * @brief Implementation of the CSV and JSON Lines record readers.
+ *
+ * @details
+ * Both readers take one physical line at a time with std::getline and parse
+ * it in place; a quoted CSV field that spans lines pulls in the following
+ * lines until its closing quote. The field strings are reused from record
+ * to record, so reading does not allocate once they have grown to the
+ * longest value.
+ *
+ * Error handling:
+ *  - A record that cannot be parsed (a CSV record with the wrong number of
+ *    fields or an unterminated quote, a JSON line that is not a flat object)
+ *    is returned with `error()` set, and reading carries on with the next
+ *    record. `read()` returns false only at the end of the input.
+ ******************************************************************************/
+#include <import_reader.h>
+#include <algorithm>
+#include <string_view>
+
+
+namespace {
+	bool blank(const std::string& _line)
+	{
+		return std::ranges::all_of(_line, [] (const char _character) {
+			return _character == ' ' || _character == '\t' || _character == '\r';
+		});
+	}
+
+	void utf8(const unsigned long& _code, std::string& _text)
+	{
+		if (_code < 0x80)
+		{
+			_text.push_back(static_cast<char> (_code));
+		}
+		else if (_code < 0x800)
+		{
+			_text.push_back(static_cast<char> (0xC0 | (_code >> 6)));
+			_text.push_back(static_cast<char> (0x80 | (_code & 0x3F)));
+		}
+		else if (_code < 0x10000)
+		{
+			_text.push_back(static_cast<char> (0xE0 | (_code >> 12)));
+			_text.push_back(static_cast<char> (0x80 | ((_code >> 6) & 0x3F)));
+			_text.push_back(static_cast<char> (0x80 | (_code & 0x3F)));
+		}
+		else
+		{
+			_text.push_back(static_cast<char> (0xF0 | (_code >> 18)));
+			_text.push_back(static_cast<char> (0x80 | ((_code >> 12) & 0x3F)));
+			_text.push_back(static_cast<char> (0x80 | ((_code >> 6) & 0x3F)));
+			_text.push_back(static_cast<char> (0x80 | (_code & 0x3F)));
+		}
+	}
+
+	bool hex4(const std::string& _buffer, const std::size_t& _position, unsigned long& _code)
+	{
+		if (_position + 4 > _buffer.size())
+		{
+			return false;
+		}
+
+		_code = 0;
+		for (std::size_t index{_position}; index < _position + 4; ++index)
+		{
+			const char character{_buffer[index]};
+			_code <<= 4;
+			if (character >= '0' && character <= '9')
+			{
+				_code |= static_cast<unsigned long> (character - '0');
+			}
+			else if (character >= 'a' && character <= 'f')
+			{
+				_code |= static_cast<unsigned long> (character - 'a' + 10);
+			}
+			else if (character >= 'A' && character <= 'F')
+			{
+				_code |= static_cast<unsigned long> (character - 'A' + 10);
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+
+
+model::csv_reader::csv_reader(std::istream& _input) : input{_input} {}
+
+model::csv_reader::~csv_reader() {}
+
+bool model::csv_reader::begin(std::span<const char* const> _columns, const std::size_t& _required)
+{
+	this->positions.clear();
+	this->wanted = _columns.size();
+	if (record(this->fields) == false)
+	{
+		this->message = "the file has no header line";
+		return false;
+	}
+
+	std::vector<std::string> header(this->fields.begin(), this->fields.end());
+	if (header.front().starts_with("\xEF\xBB\xBF") == true)
+	{
+		header.front().erase(0, 3);
+	}
+	for (std::size_t index{0}; index < _columns.size(); ++index)
+	{
+		const auto found{std::ranges::find(header, std::string_view{_columns[index]})};
+		if (found == header.end() && index < _required)
+		{
+			this->message = std::string{"the header has no "} + _columns[index] + " column";
+			return false;
+		}
+		this->positions.push_back((found == header.end()) ? std::string::npos :
+					  static_cast<std::size_t> (found - header.begin()));
+	}
+	this->fields.resize(header.size());
+	this->message.clear();
+
+	return true;
+}
+
+bool model::csv_reader::read(std::vector<std::string>& _fields)
+{
+	const std::size_t width{this->fields.size()};
+	if (this->positions.size() != this->wanted || width == 0)
+	{
+		return false;
+	}
+
+	bool more{record(this->fields)};
+	while (more == true && this->message.empty() == true && this->fields.size() == 1 && blank(this->fields.front()))
+	{
+		this->fields.resize(width);
+		more = record(this->fields);
+	}
+
+	if (more == false)
+	{
+		return false;
+	}
+
+	if (this->message.empty() == true && this->fields.size() != width)
+	{
+		this->message = "expected " + std::to_string(width) + " fields, found " + std::to_string(this->fields.size());
+	}
+
+	_fields.resize(this->wanted);
+	if (this->message.empty() == true)
+	{
+		for (std::size_t index{0}; index < this->wanted; ++index)
+		{
+			if (this->positions[index] == std::string::npos)
+			{
+				_fields[index].clear();
+			}
+			else
+			{
+				_fields[index].swap(this->fields[this->positions[index]]);
+			}
+		}
+	}
+	this->fields.resize(width);
+
+	return true;
+}
+
+std::size_t model::csv_reader::line() const
+{
+	return this->record_line;
+}
+
+std::string model::csv_reader::error() const
+{
+	return this->message;
+}
+
+bool model::csv_reader::record(std::vector<std::string>& _fields)
+{
+	std::string text{};
+	if (std::getline(this->input, text).fail() == true)
+	{
+		return false;
+	}
+
+	this->message.clear();
+	this->record_line = this->next_line++;
+	std::size_t count{0};
+	auto field = [&_fields, &count] () -> std::string& {
+		if (count == _fields.size())
+		{
+			_fields.emplace_back();
+		}
+		_fields[count].clear();
+		return _fields[count++];
+	};
+
+	std::string* current{&field()};
+	bool quoted{false};
+	bool start{true};
+	for (;;)
+	{
+		for (std::size_t index{0}; index < text.size(); ++index)
+		{
+			const char character{text[index]};
+			if (quoted == true)
+			{
+				if (character != '"')
+				{
+					current->push_back(character);
+				}
+				else if (index + 1 < text.size() && text[index + 1] == '"')
+				{
+					current->push_back('"');
+					++index;
+				}
+				else
+				{
+					quoted = false;
+				}
+			}
+			else if (character == ',')
+			{
+				current = &field();
+				start = true;
+				continue;
+			}
+			else if (character == '"' && start == true)
+			{
+				quoted = true;
+			}
+			else if (character != '\r' || index + 1 != text.size())
+			{
+				current->push_back(character);
+			}
+			start = false;
+		}
+
+		if (quoted == false)
+		{
+			break;
+		}
+		else if (std::getline(this->input, text).fail() == true)
+		{
+			this->message = "the quoted field is not closed";
+			break;
+		}
+
+		++this->next_line;
+		current->push_back('\n');
+	}
+	_fields.resize(count);
+
+	return true;
+}
+
+
+model::jsonl_reader::jsonl_reader(std::istream& _input) : input{_input} {}
+
+model::jsonl_reader::~jsonl_reader() {}
+
+bool model::jsonl_reader::begin(std::span<const char* const> _columns, const std::size_t&)
+{
+	this->keys.assign(_columns.begin(), _columns.end());
+	this->message.clear();
+
+	return this->input.good();
+}
+
+bool model::jsonl_reader::read(std::vector<std::string>& _fields)
+{
+	do
+	{
+		if (std::getline(this->input, this->buffer).fail() == true)
+		{
+			return false;
+		}
+		++this->record_line;
+	}
+	while (blank(this->buffer) == true);
+
+	this->message.clear();
+	_fields.resize(this->keys.size());
+	for (std::string& field : _fields)
+	{
+		field.clear();
+	}
+
+	if (parse(_fields) == false && this->message.empty() == true)
+	{
+		this->message = "the line is not a flat JSON object";
+	}
+
+	return true;
+}
+
+std::size_t model::jsonl_reader::line() const
+{
+	return this->record_line;
+}
+
+std::string model::jsonl_reader::error() const
+{
+	return this->message;
+}
+
+bool model::jsonl_reader::parse(std::vector<std::string>& _fields)
+{
+	std::size_t position{0};
+	std::string key{};
+	std::string value{};
+	skip(position);
+	if (position == this->buffer.size() || this->buffer[position++] != '{')
+	{
+		return false;
+	}
+
+	skip(position);
+	bool closed{position < this->buffer.size() && this->buffer[position] == '}'};
+	position += closed ? 1 : 0;
+	while (closed == false)
+	{
+		key.clear();
+		value.clear();
+		skip(position);
+		if (text(position, key) == false)
+		{
+			return false;
+		}
+
+		skip(position);
+		if (position == this->buffer.size() || this->buffer[position++] != ':')
+		{
+			return false;
+		}
+
+		skip(position);
+		if (position == this->buffer.size())
+		{
+			return false;
+		}
+		else if (this->buffer[position] == '"')
+		{
+			if (text(position, value) == false)
+			{
+				return false;
+			}
+		}
+		else if (this->buffer[position] == '{' || this->buffer[position] == '[')
+		{
+			this->message = "the value of " + key + " is not a string, number or literal";
+			return false;
+		}
+		else
+		{
+			const std::size_t end{this->buffer.find_first_of(",} \t\r", position)};
+			if (end == std::string::npos || end == position)
+			{
+				return false;
+			}
+
+			value.assign(this->buffer, position, end - position);
+			position = end;
+			if (value == "null")
+			{
+				value.clear();
+			}
+		}
+
+		const auto found{std::ranges::find(this->keys, key)};
+		if (found != this->keys.end())
+		{
+			_fields[static_cast<std::size_t> (found - this->keys.begin())].swap(value);
+		}
+
+		skip(position);
+		if (position == this->buffer.size())
+		{
+			return false;
+		}
+
+		const char separator{this->buffer[position++]};
+		if (separator == '}')
+		{
+			closed = true;
+		}
+		else if (separator != ',')
+		{
+			return false;
+		}
+	}
+
+	skip(position);
+	return position == this->buffer.size();
+}
+
+bool model::jsonl_reader::text(std::size_t& _position, std::string& _text) const
+{
+	if (_position == this->buffer.size() || this->buffer[_position] != '"')
+	{
+		return false;
+	}
+
+	for (++_position; _position < this->buffer.size(); ++_position)
+	{
+		const char character{this->buffer[_position]};
+		if (character == '"')
+		{
+			++_position;
+			return true;
+		}
+		else if (static_cast<unsigned char> (character) < 0x20)
+		{
+			return false;
+		}
+		else if (character != '\\')
+		{
+			_text.push_back(character);
+			continue;
+		}
+
+		if (++_position == this->buffer.size())
+		{
+			return false;
+		}
+
+		unsigned long code{0};
+		unsigned long low{0};
+		switch (this->buffer[_position])
+		{
+		case '"':  _text.push_back('"'); break;
+		case '\\': _text.push_back('\\'); break;
+		case '/':  _text.push_back('/'); break;
+		case 'b':  _text.push_back('\b'); break;
+		case 'f':  _text.push_back('\f'); break;
+		case 'n':  _text.push_back('\n'); break;
+		case 'r':  _text.push_back('\r'); break;
+		case 't':  _text.push_back('\t'); break;
+		case 'u':
+			if (hex4(this->buffer, _position + 1, code) == false)
+			{
+				return false;
+			}
+			_position += 4;
+			if (code >= 0xD800 && code <= 0xDBFF)
+			{
+				if (this->buffer.compare(_position + 1, 2, "\\u") != 0 ||
+				    hex4(this->buffer, _position + 3, low) == false || low < 0xDC00 || low > 0xDFFF)
+				{
+					return false;
+				}
+				_position += 6;
+				code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+			}
+			else if (code >= 0xDC00 && code <= 0xDFFF)
+			{
+				return false;
+			}
+			utf8(code, _text);
+			break;
+		default:
+			return false;
+		}
+	}
+
+	return false;
+}
+
+void model::jsonl_reader::skip(std::size_t& _position) const
+{
+	while (_position < this->buffer.size() &&
+	       (this->buffer[_position] == ' ' || this->buffer[_position] == '\t' || this->buffer[_position] == '\r'))
+	{
+		++_position;
+	}
+}
@@ -12,30 +12,61 @@
  *      * Validates the business name.
  *      * Queries the database for admin, client, invoice, and labor data.
  *      * Assembles each invoice into a `data::pdf_invoice` object containing
- *        invoice, client, and business details, then returns a vector of
- *        `std::any` wrapping these objects.
+ *        invoice, client, and business details, moves them into one
+ *        immutable vector and returns it as `model::documents`. The cache
+ *        keeps the same vector, so a cache hit returns it without a copy.
  *      * If no invoice rows are found, still returns a single
  *        `data::pdf_invoice` with business and client information.
  *
- *  - `save(const std::any&)`:
- *      * Validates a `data::invoice` object extracted from the `std::any`.
- *      * Starts a transaction and:
- *          - Upserts statement metadata for the client and billing period.
- *          - Deletes all existing labor rows for the invoice.
- *          - Upserts the invoice header.
- *          - Re-inserts each description and material line item.
- *      * Commits the transaction on success, or attempts a rollback on error,
- *        logging failures via syslog.
+ *  - `load_page(const std::string&, const model::page&)`:
+ *      * Same assembly as `load()`, restricted to one keyset page
+ *        (`invoice_id < before ORDER BY invoice_id DESC LIMIT limit`).
+ *      * Ensures the backing index exists when the first page is requested.
+ *      * Only the first page falls back to the client/business-only
+ *        `data::pdf_invoice`; an empty later page means the end was reached.
  *
- *  - `prepare_for_email(const std::vector<std::any>&)`:
+ *  - `save(const data::invoice&)`:
+ *      * Validates the `data::invoice` passed by reference.
+ *      * Starts a transaction and diffs against the stored invoice:
+ *          - Upserts the statement and the invoice header only when the
+ *            invoice is new or one of its header fields changed.
+ *          - Inserts new, updates changed and deletes removed labor rows,
+ *            keyed by (line_number, is_description); unchanged rows are
+ *            not written.
+ *      * Commits the transaction on success, or rolls back on the first
+ *        failed statement, logging failures via syslog.
+ *
+ *  - `save_many(std::span<const data::invoice>)`:
+ *      * Validates every invoice before touching the database.
+ *      * Opens the database and checks the admin row once, reads each
+ *        client's schedule once and computes every billing period in one
+ *        `utility::calendar` batch call before the transaction starts, and
+ *        upserts each period's statement once.
+ *      * Writes every invoice through the same diff as `save()` in one
+ *        transaction, committed once at the end. A failure rolls the whole
+ *        call back, so it either saves every invoice or none of them.
+ *
+ *  - `prepare_for_email(std::span<const data::pdf_invoice>)`:
  *      * Extracts the first `data::pdf_invoice` to determine client and
  *        business metadata.
- *      * Generates PDFs asynchronously for each invoice using `feature::invoice_pdf`.
+ *      * Generates the PDFs through `prepare_for_print()`.
  *      * Returns a `data::email` populated with subject and attachments.
  *
- *  - `prepare_for_print(const std::vector<std::any>&)`:
- *      * Asynchronously generates and returns a vector of PDF documents
- *        (encoded as strings) for printing.
+ *  - `prepare_for_print(std::span<const data::pdf_invoice>)`:
+ *      * Generates and returns a vector of PDF documents (encoded as
+ *        strings) for printing, on the workers of `model::render_batch()`,
+ *        so each worker's recorded page templates serve many invoices.
+ *
+ *  - `write_pdfs(std::span<const data::pdf_invoice>, const std::filesystem::path&)`:
+ *      * Streams each invoice into `invoice-<id>.pdf` in the directory
+ *        through a `feature::file_sink`, one at a time, so a batch never
+ *        holds its PDFs in memory. A file that could not be written in full,
+ *        or did not close cleanly, is removed and the rest of the batch is
+ *        still written.
+ *
+ *  - Every generator is built on `feature::configured_pdf_backend()`, so
+ *    `MINTBILL_PDF_BACKEND=native` selects the native PDF writer; Cairo is
+ *    the default.
  *
  * Error handling:
  *  - Uses `syslog(LOG_CRIT, ...)` with file and line information to report
@@ -45,8 +76,13 @@
  ******************************************************************************/
 #include <invoice_model.h>
 #include <invoice_pdf.h>
-#include <future>
+#include <map>
+#include <algorithm>
+#include <set>
+#include <render_batch.h>
+#include <pdf_sink.h>
 #include <syslog.h>
+#include <model_cache.h>
 #include <sqlite.h>
 #include <admin_data.h>
 #include <client_data.h>
@@ -55,7 +91,15 @@
 #include <client_serialize.h>
 #include <invoice_serialize.h>
 #include <statement_serialize.h>
-#include <date_manager.h>
+#include <calendar.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& load_time{utility::metrics::histogram_named("model.load_ns")};
+	utility::metrics::histogram& save_time{utility::metrics::histogram_named("model.save_ns")};
+}
 
 
 
@@ -64,9 +108,11 @@ model::invoice::invoice(const std::string& _database_file, const std::string& _d
 
 model::invoice::~invoice() {}
 
-std::vector<std::any> model::invoice::load(const std::string& _business_name) const
+model::documents<data::pdf_invoice> model::invoice::load(const std::string& _business_name) const
 {
-	std::vector<std::any> pdf_invoices_data{};
+	TRACE_SPAN("model", "invoice::load");
+	utility::metrics::timer load_timer{load_time};
+	std::vector<data::pdf_invoice> pdf_invoices_data{};
         if (_business_name.empty())
 	{
 		syslog(LOG_CRIT, "INVOICE_MODEL: invalid argument - "
@@ -74,6 +120,14 @@ std::vector<std::any> model::invoice::load(const std::string& _business_name) co
 	}
 	else
         {
+		model::documents<data::pdf_invoice> cached{
+			model::cache::instance().find<std::vector<data::pdf_invoice>>(
+				this->database_file, model::entity::invoices, _business_name)};
+		if (cached != nullptr)
+		{
+			return cached;
+		}
+
 		storage::database::sqlite database{this->database_file, this->database_password};
 		serialize::admin admin_serialize{};
 		data::admin admin_data{
@@ -94,33 +148,84 @@ std::vector<std::any> model::invoice::load(const std::string& _business_name) co
 			)
 		};
 
-		serialize::labor labor_serialize{};
-		serialize::invoice invoice_serialize{};
 		storage::database::sql_parameters invoice_params = {_business_name};
-		for (const std::any& data : invoice_serialize.extract_data(
-				database.select(sql::query::invoice_select, invoice_params)))
-		{
-			data::invoice invoice_data{std::any_cast<data::invoice> (data)};
-			storage::database::sql_parameters column_params = {std::stoi(invoice_data.get_id())};
-			std::vector<data::column> material_column_data{labor_serialize.extract_data(
-						database.select(sql::query::material_labor_select, column_params)
-					)};
-			std::vector<data::column> description_column_data{labor_serialize.extract_data(
-						database.select(sql::query::description_labor_select, column_params)
-					)};
-
-			invoice_data.set_material_column(material_column_data);
-			invoice_data.set_description_column(description_column_data);
+		pdf_invoices_data = this->assemble(database,
+						   database.select(sql::query::invoice_select, invoice_params),
+						   client_data,
+						   admin_data);
 
+		if (pdf_invoices_data.empty() == true)
+		{
 			data::pdf_invoice pdf_invoice_data{};
-			pdf_invoice_data.set_invoice(invoice_data);
 			pdf_invoice_data.set_client(client_data);
 			pdf_invoice_data.set_business(admin_data);
 
 			pdf_invoices_data.emplace_back(std::move(pdf_invoice_data));
 		}
 
-		if (pdf_invoices_data.empty() == true)
+		model::documents<data::pdf_invoice> loaded{std::make_shared<const std::vector<data::pdf_invoice>>(std::move(pdf_invoices_data))};
+		model::cache::instance().store(this->database_file, model::entity::invoices, _business_name, "",
+					       loaded, model::footprint(*loaded));
+		return loaded;
+        }
+
+
+        return std::make_shared<const std::vector<data::pdf_invoice>>(std::move(pdf_invoices_data));
+}
+
+model::documents<data::pdf_invoice> model::invoice::load_page(const std::string& _business_name, const model::page& _page) const
+{
+	TRACE_SPAN("model", "invoice::load_page");
+	utility::metrics::timer load_timer{load_time};
+	std::vector<data::pdf_invoice> pdf_invoices_data{};
+        if (_business_name.empty() || _page.is_valid() == false)
+	{
+		syslog(LOG_CRIT, "INVOICE_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+        {
+		model::documents<data::pdf_invoice> cached{
+			model::cache::instance().find<std::vector<data::pdf_invoice>>(
+				this->database_file, model::entity::invoices, _business_name, model::page_detail(_page))};
+		if (cached != nullptr)
+		{
+			return cached;
+		}
+
+		storage::database::sqlite database{this->database_file, this->database_password};
+		if (_page.first() == true && database.transaction(sql::query::invoice_page_index) == false)
+		{
+			syslog(LOG_CRIT, "INVOICE_MODEL: failed to create the page index - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+
+		serialize::admin admin_serialize{};
+		data::admin admin_data{
+			std::any_cast<data::admin>(
+				admin_serialize.extract_data(
+					database.select(sql::query::invoice_admin_select)
+				)
+			)
+		};
+
+		storage::database::sql_parameters client_params = {_business_name};
+		serialize::client client_serialize{};
+		data::client client_data{
+			std::any_cast<data::client>(
+				client_serialize.extract_data(
+					database.select(sql::query::invoice_client_select, client_params)
+				)
+			)
+		};
+
+		storage::database::sql_parameters invoice_params = {_business_name, _page.before, _page.limit};
+		pdf_invoices_data = this->assemble(database,
+						   database.select(sql::query::invoice_page_select, invoice_params),
+						   client_data,
+						   admin_data);
+
+		if (pdf_invoices_data.empty() == true && _page.first() == true)
 		{
 			data::pdf_invoice pdf_invoice_data{};
 			pdf_invoice_data.set_client(client_data);
@@ -128,17 +233,23 @@ std::vector<std::any> model::invoice::load(const std::string& _business_name) co
 
 			pdf_invoices_data.emplace_back(std::move(pdf_invoice_data));
 		}
-        }
 
+		model::documents<data::pdf_invoice> loaded{std::make_shared<const std::vector<data::pdf_invoice>>(std::move(pdf_invoices_data))};
+		model::cache::instance().store(this->database_file, model::entity::invoices, _business_name,
+					       model::page_detail(_page),
+					       loaded, model::footprint(*loaded));
+		return loaded;
+        }
 
-        return pdf_invoices_data;
+        return std::make_shared<const std::vector<data::pdf_invoice>>(std::move(pdf_invoices_data));
 }
 
-bool model::invoice::save(const std::any& _data) const
+bool model::invoice::save(const data::invoice& _invoice_data) const
 {
+	TRACE_SPAN("model", "invoice::save");
+	utility::metrics::timer save_timer{save_time};
         bool success{false};
-	data::invoice invoice_data{std::any_cast<data::invoice> (_data)};
-        if (invoice_data.is_valid() == false)
+        if (_invoice_data.is_valid() == false)
 	{
 		syslog(LOG_CRIT, "INVOICE_MODEL: invalid argument - "
 				 "filename %s, line number %d", __FILE__, __LINE__);
@@ -146,8 +257,6 @@ bool model::invoice::save(const std::any& _data) const
 	else
         {
 		storage::database::sqlite database{this->database_file, this->database_password};
-		storage::database::sql_parameters labor_delete_all_params{std::stoi(invoice_data.get_id())};
-
 		serialize::admin admin_serialize{};
 		data::admin admin_data{
 			std::any_cast<data::admin>(
@@ -162,7 +271,7 @@ bool model::invoice::save(const std::any& _data) const
 			return success;
 		}
 
-		storage::database::sql_parameters params = {invoice_data.get_name()};
+		storage::database::sql_parameters params = {_invoice_data.get_name()};
 		serialize::client client_serialize{};
 		data::client client_data{
 			std::any_cast<data::client>(
@@ -172,33 +281,19 @@ bool model::invoice::save(const std::any& _data) const
 			)
 		};
 
-		utility::date_manager date_manager{};
-		utility::period_bounds pb{date_manager.compute_period_bounds(client_data.get_statement_schedule())};
-		serialize::statement statement_serialize{};
-		storage::database::sql_parameters statement_params{
-			invoice_data.get_name(),
-			pb.period_start,
-			pb.period_end,
-			date_manager.current_date(),
-			"Not Paid",
-		};
-
-		storage::database::sql_parameters invoice_params{
-			static_cast<long long>(std::stoi(invoice_data.get_id())),
-			invoice_data.get_name(),
-			invoice_data.get_name(),
-			pb.period_start,
-			pb.period_end,
-			invoice_data.get_order_number(),
-			invoice_data.get_job_card_number(),
-			invoice_data.get_date(),
-			invoice_data.get_paid_status(),
-			invoice_data.get_material_total(),
-			invoice_data.get_description_total(),
-			invoice_data.get_grand_total()
-		};
-
+		utility::calendar& calendar{utility::calendar::instance()};
+		utility::period_bounds pb{calendar.compute_period_bounds(
+				utility::calendar::parse(client_data.get_statement_schedule()))};
 		if (database.transaction("BEGIN IMMEDIATE;") == false)
+		{
+			syslog(LOG_CRIT, "INVOICE_MODEL: failed to begin the transaction - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			return success;
+		}
+
+		bool statement_written{false};
+		if (write(database, _invoice_data, pb, calendar.current_date(), statement_written) == false ||
+		    database.transaction("COMMIT;") == false)
 		{
 			if (database.transaction("ROLLBACK;") == false)
 			{
@@ -206,25 +301,107 @@ bool model::invoice::save(const std::any& _data) const
 						 "filename %s, line number %d", __FILE__, __LINE__);
 			}
 		}
-		if (database.usert(sql::query::statement_usert, statement_params) == false)
+		else
 		{
-			if (database.transaction("ROLLBACK;") == false)
+			success = true;
+			model::cache::instance().invalidate(this->database_file, model::entity::invoices, _invoice_data.get_name());
+			model::cache::instance().invalidate(this->database_file, model::entity::statements, _invoice_data.get_name());
+			model::cache::instance().invalidate(this->database_file, model::entity::reports, "");
+		}
+        }
+
+        return success;
+}
+
+bool model::invoice::save_many(std::span<const data::invoice> _invoices) const
+{
+	TRACE_SPAN("model", "invoice::save_many");
+	utility::metrics::timer save_timer{save_time};
+	bool success{false};
+	if (_invoices.empty() || std::ranges::any_of(_invoices, [] (const data::invoice& _invoice_data) {
+			return _invoice_data.is_valid() == false;
+		}))
+	{
+		syslog(LOG_CRIT, "INVOICE_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		storage::database::sqlite database{this->database_file, this->database_password};
+		serialize::admin admin_serialize{};
+		data::admin admin_data{
+			std::any_cast<data::admin>(
+				admin_serialize.extract_data(
+					database.select(sql::query::admin_no_name_select)
+				)
+			)
+		};
+
+		if (admin_data.is_valid() == false)
+		{
+			return success;
+		}
+
+		struct client_period {
+			utility::period_bounds bounds{};
+			bool statement_written{false};
+		};
+
+		std::map<std::string, client_period> periods{};
+		std::vector<client_period*> unresolved{};
+		std::vector<utility::schedule> schedules{};
+		for (const data::invoice& invoice_data : _invoices)
+		{
+			auto [period, inserted]{periods.try_emplace(invoice_data.get_name())};
+			if (inserted == false)
 			{
-				syslog(LOG_CRIT, "INVOICE_MODEL: failed to rollback - "
-						"filename %s, line number %d", __FILE__, __LINE__);
+				continue;
 			}
+
+			storage::database::sql_parameters params = {invoice_data.get_name()};
+			serialize::client client_serialize{};
+			data::client client_data{
+				std::any_cast<data::client>(
+					client_serialize.extract_data(
+						database.select(sql::query::invoice_client_select, params)
+					)
+				)
+			};
+			unresolved.push_back(&period->second);
+			schedules.push_back(utility::calendar::parse(client_data.get_statement_schedule()));
 		}
-		else if (database.usert(sql::query::labor_delete_all_for_invoice, labor_delete_all_params) == false)
+
+		utility::calendar& calendar{utility::calendar::instance()};
+		const std::string today{calendar.current_date()};
+		std::vector<utility::period_bounds> bounds{calendar.compute_period_bounds(schedules)};
+		for (std::size_t index = 0; index < unresolved.size(); ++index)
 		{
-			if (database.transaction("ROLLBACK;") == false)
+			unresolved[index]->bounds = std::move(bounds[index]);
+		}
+
+		if (database.transaction("BEGIN IMMEDIATE;") == false)
+		{
+			syslog(LOG_CRIT, "INVOICE_MODEL: failed to begin the transaction - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			return success;
+		}
+
+		success = true;
+		for (const data::invoice& invoice_data : _invoices)
+		{
+			auto period{periods.find(invoice_data.get_name())};
+			if (write(database, invoice_data, period->second.bounds, today, period->second.statement_written) == false)
 			{
-				syslog(LOG_CRIT, "INVOICE_MODEL: failed to rollback - "
-						"filename %s, line number %d", __FILE__, __LINE__);
+				success = false;
+				break;
 			}
-			return success;
 		}
-		else if (database.usert(sql::query::invoice_usert, invoice_params) == false)
+
+		if (success == false || database.transaction("COMMIT;") == false)
 		{
+			success = false;
+			syslog(LOG_CRIT, "INVOICE_MODEL: failed to save the invoices - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
 			if (database.transaction("ROLLBACK;") == false)
 			{
 				syslog(LOG_CRIT, "INVOICE_MODEL: failed to rollback - "
@@ -232,129 +409,272 @@ bool model::invoice::save(const std::any& _data) const
 			}
 		}
 
-		serialize::labor labor_serialize{};
-		for (const data::column& column_data : invoice_data.get_description_column())
+		for (const auto& [business_name, period] : periods)
 		{
-			storage::database::sql_parameters description_params{
-				invoice_data.get_name(),
-				invoice_data.get_order_number(),
-				invoice_data.get_job_card_number(),
-				column_data.get_row_number(),
-				column_data.get_is_description(),
-				column_data.get_quantity(),
-				column_data.get_description(),
-				column_data.get_amount(),
-			};
-			if (database.usert(sql::query::labor_usert, description_params) == false)
+			model::cache::instance().invalidate(this->database_file, model::entity::invoices, business_name);
+			model::cache::instance().invalidate(this->database_file, model::entity::statements, business_name);
+		}
+		model::cache::instance().invalidate(this->database_file, model::entity::reports, "");
+	}
+
+	return success;
+}
+
+bool model::invoice::write(storage::database::sqlite& _database, const data::invoice& _invoice_data,
+			   const utility::period_bounds& _period, const std::string& _today,
+			   bool& _statement_written) const
+{
+	if (header_changed(_database, _invoice_data) == true)
+	{
+		storage::database::sql_parameters statement_params{
+			_invoice_data.get_name(),
+			_period.period_start,
+			_period.period_end,
+			_today,
+			"Not Paid",
+		};
+
+		storage::database::sql_parameters invoice_params{
+			std::stoll(_invoice_data.get_id()),
+			_invoice_data.get_name(),
+			_invoice_data.get_name(),
+			_period.period_start,
+			_period.period_end,
+			_invoice_data.get_order_number(),
+			_invoice_data.get_job_card_number(),
+			_invoice_data.get_date(),
+			_invoice_data.get_paid_status(),
+			_invoice_data.get_material_total(),
+			_invoice_data.get_description_total(),
+			_invoice_data.get_grand_total()
+		};
+
+		if (_statement_written == false)
+		{
+			if (_database.usert(sql::query::statement_usert, statement_params) == false)
 			{
-				if (database.transaction("ROLLBACK;") == false)
-				{
-					syslog(LOG_CRIT, "INVOICE_MODEL: failed to rollback - "
-							 "filename %s, line number %d", __FILE__, __LINE__);
-				}
+				syslog(LOG_CRIT, "INVOICE_MODEL: failed to write the statement - "
+						 "filename %s, line number %d", __FILE__, __LINE__);
+				return false;
 			}
+			_statement_written = true;
+		}
+
+		if (_database.usert(sql::query::invoice_usert, invoice_params) == false)
+		{
+			syslog(LOG_CRIT, "INVOICE_MODEL: failed to write the invoice - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			return false;
 		}
+	}
+
+	return save_labor(_database, _invoice_data);
+}
+
+bool model::invoice::header_changed(storage::database::sqlite& _database, const data::invoice& _invoice_data) const
+{
+	storage::database::sql_parameters params{std::stoll(_invoice_data.get_id())};
+	serialize::invoice invoice_serialize{};
+	std::vector<std::any> stored(
+		invoice_serialize.extract_data(
+			_database.select(sql::query::invoice_snapshot_select, params)
+		)
+	);
+
+	if (stored.empty() == true)
+	{
+		return true;
+	}
+
+	const data::invoice& stored_invoice{std::any_cast<const data::invoice&>(stored.front())};
+	return stored_invoice.get_name() != _invoice_data.get_name() ||
+	       stored_invoice.get_order_number() != _invoice_data.get_order_number() ||
+	       stored_invoice.get_job_card_number() != _invoice_data.get_job_card_number() ||
+	       stored_invoice.get_date() != _invoice_data.get_date() ||
+	       stored_invoice.get_paid_status() != _invoice_data.get_paid_status() ||
+	       stored_invoice.get_material_total() != _invoice_data.get_material_total() ||
+	       stored_invoice.get_description_total() != _invoice_data.get_description_total() ||
+	       stored_invoice.get_grand_total() != _invoice_data.get_grand_total();
+}
 
-		for (const data::column& column_data : invoice_data.get_material_column())
+bool model::invoice::save_labor(storage::database::sqlite& _database, const data::invoice& _invoice_data) const
+{
+	const long long invoice_id{std::stoll(_invoice_data.get_id())};
+	storage::database::sql_parameters params{invoice_id};
+	serialize::labor labor_serialize{};
+	std::map<std::pair<long long, long long>, data::column> stored{};
+	for (data::column& column_data : labor_serialize.extract_data(
+			_database.select(sql::query::labor_snapshot_select, params)))
+	{
+		std::pair<long long, long long> key{column_data.get_row_number(), column_data.get_is_description()};
+		stored.emplace(key, std::move(column_data));
+	}
+
+	std::set<std::pair<long long, long long>> kept{};
+	std::vector<data::column> columns{_invoice_data.get_description_column()};
+	std::vector<data::column> material_columns{_invoice_data.get_material_column()};
+	columns.insert(columns.end(), std::make_move_iterator(material_columns.begin()),
+		       std::make_move_iterator(material_columns.end()));
+	for (const data::column& column_data : columns)
+	{
+		std::pair<long long, long long> key{column_data.get_row_number(), column_data.get_is_description()};
+		kept.insert(key);
+		auto found{stored.find(key)};
+		if (found == stored.end())
 		{
-			storage::database::sql_parameters material_params{
-				invoice_data.get_name(),
-				invoice_data.get_order_number(),
-				invoice_data.get_job_card_number(),
+			storage::database::sql_parameters insert_params{
+				invoice_id,
 				column_data.get_row_number(),
 				column_data.get_is_description(),
-				column_data.get_quantity(),
+				static_cast<long long>(column_data.get_quantity()),
 				column_data.get_description(),
-				column_data.get_amount(),
+				column_data.get_amount()
 			};
-			if (database.usert(sql::query::labor_usert, material_params) == false)
+			if (_database.usert(sql::query::labor_insert, insert_params) == false)
 			{
-				if (database.transaction("ROLLBACK;") == false)
-				{
-					syslog(LOG_CRIT, "INVOICE_MODEL: failed to rollback - "
-							 "filename %s, line number %d", __FILE__, __LINE__);
-				}
+				syslog(LOG_CRIT, "INVOICE_MODEL: failed to insert a labor row - "
+						 "filename %s, line number %d", __FILE__, __LINE__);
+				return false;
 			}
+			stored.emplace(key, column_data);
 		}
-
-		if (database.transaction("COMMIT;") == false)
+		else if (found->second.get_quantity() != column_data.get_quantity() ||
+			 found->second.get_description() != column_data.get_description() ||
+			 found->second.get_amount() != column_data.get_amount())
 		{
-			if (database.transaction("ROLLBACK;") == false)
+			storage::database::sql_parameters update_params{
+				static_cast<long long>(column_data.get_quantity()),
+				column_data.get_description(),
+				column_data.get_amount(),
+				invoice_id,
+				column_data.get_row_number(),
+				column_data.get_is_description()
+			};
+			if (_database.usert(sql::query::labor_update, update_params) == false)
 			{
-				syslog(LOG_CRIT, "INVOICE_MODEL: failed to rollback - "
+				syslog(LOG_CRIT, "INVOICE_MODEL: failed to update a labor row - "
 						 "filename %s, line number %d", __FILE__, __LINE__);
+				return false;
 			}
+			found->second = column_data;
 		}
-		else
+	}
+
+	for (const auto& [key, column_data] : stored)
+	{
+		if (kept.contains(key) == true)
 		{
-			success = true;
+			continue;
 		}
-        }
 
-        return success;
+		storage::database::sql_parameters delete_params{invoice_id, key.first, key.second};
+		if (_database.usert(sql::query::labor_delete, delete_params) == false)
+		{
+			syslog(LOG_CRIT, "INVOICE_MODEL: failed to delete a labor row - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			return false;
+		}
+	}
+
+	return true;
 }
 
-data::email model::invoice::prepare_for_email(const std::vector<std::any>& _pdf_invoices) const
+data::email model::invoice::prepare_for_email(std::span<const data::pdf_invoice> _pdf_invoices) const
 {
 	data::email email_data;
-	for (const std::any& pdf_invoice : _pdf_invoices)
+	if (_pdf_invoices.empty() == false)
 	{
-		data::pdf_invoice pdf_invoice_data{std::any_cast<data::pdf_invoice> (pdf_invoice)};
-		email_data.set_client(pdf_invoice_data.get_client());
-		email_data.set_business(pdf_invoice_data.get_business());
-		break;
+		email_data.set_client(_pdf_invoices.front().get_client());
+		email_data.set_business(_pdf_invoices.front().get_business());
 	}
 
-	std::vector<std::future<std::string>> pdf_documents;
-	std::transform(_pdf_invoices.cbegin(),
-			_pdf_invoices.cend(),
-			std::back_inserter(pdf_documents),
-			[] (const std::any& _pdf_invoice) {
-				return std::async(std::launch::async, [&_pdf_invoice] {
-					feature::invoice_pdf pdf;
-					return pdf.generate(_pdf_invoice);
-				});
-			});
+	email_data.set_subject("Invoice");
+	email_data.set_attachments(prepare_for_print(_pdf_invoices));
 
+	return email_data;
+}
 
-	std::vector<std::string> pdfs;
-	std::transform(
-		std::make_move_iterator(pdf_documents.begin()),
-		std::make_move_iterator(pdf_documents.end()),
-		std::back_inserter(pdfs),
-		[](std::future<std::string> _pdf) {
-			return _pdf.get();
-		});
+std::vector<std::string> model::invoice::prepare_for_print(std::span<const data::pdf_invoice> _pdf_invoice) const
+{
+	const feature::pdf_backend backend{feature::configured_pdf_backend()};
+	return model::render_batch(_pdf_invoice.size(), [&_pdf_invoice, backend] (const std::size_t& _index) {
+		feature::invoice_pdf pdf{backend};
+		return pdf.generate(_pdf_invoice[_index]);
+	});
+}
 
+bool model::invoice::write_pdfs(std::span<const data::pdf_invoice> _pdf_invoices,
+				const std::filesystem::path& _directory) const
+{
+	TRACE_SPAN("model", "invoice::write_pdfs");
+	std::error_code error{};
+	std::filesystem::create_directories(_directory, error);
+	if (error)
+	{
+		syslog(LOG_CRIT, "INVOICE_MODEL: failed to create the PDF directory - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
 
-	email_data.set_subject("Invoice");
-	email_data.set_attachments(pdfs);
+	bool success{true};
+	feature::invoice_pdf pdf{feature::configured_pdf_backend()};
+	for (const data::pdf_invoice& pdf_invoice : _pdf_invoices)
+	{
+		const std::filesystem::path path{_directory / ("invoice-" + pdf_invoice.get_invoice().get_id() + ".pdf")};
+		bool written{false};
+		feature::file_sink sink{path};
+		if (sink.is_open() == true)
+		{
+			written = pdf.generate(pdf_invoice, sink);
+			written = sink.close() == true && written == true;
+		}
 
-	return email_data;
+		if (written == false)
+		{
+			syslog(LOG_CRIT, "INVOICE_MODEL: failed to write an invoice PDF - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			std::filesystem::remove(path, error);
+			success = false;
+		}
+	}
+
+	return success;
 }
 
-std::vector<std::string> model::invoice::prepare_for_print(const std::vector<std::any>& _pdf_invoice) const
+std::vector<data::pdf_invoice> model::invoice::assemble(storage::database::sqlite& _database,
+							 const storage::database::part::rows& _invoice_rows,
+							 const data::client& _client_data,
+							 const data::admin& _admin_data) const
 {
-	std::vector<std::future<std::string>> pdf_documents;
-	std::transform(_pdf_invoice.cbegin(),
-			_pdf_invoice.cend(),
-			std::back_inserter(pdf_documents),
-			[] (const std::any& _pdf_invoice) {
-				return std::async(std::launch::async, [&_pdf_invoice] {
-					feature::invoice_pdf pdf;
-					return pdf.generate(_pdf_invoice);
-				});
-			});
-
-
-	std::vector<std::string> pdfs;
-	std::transform(
-		std::make_move_iterator(pdf_documents.begin()),
-		std::make_move_iterator(pdf_documents.end()),
-		std::back_inserter(pdfs),
-		[](std::future<std::string> _pdf) {
-			return _pdf.get();
-		});
-
-	return pdfs;
+	std::vector<data::pdf_invoice> pdf_invoices_data{};
+	if (_invoice_rows.empty() == true)
+	{
+		return pdf_invoices_data;
+	}
+
+	serialize::labor labor_serialize{};
+	serialize::invoice invoice_serialize{};
+	for (std::any& data : invoice_serialize.extract_data(_invoice_rows))
+	{
+		data::invoice invoice_data{std::move(std::any_cast<data::invoice&> (data))};
+		storage::database::sql_parameters column_params = {std::stoi(invoice_data.get_id())};
+		std::vector<data::column> material_column_data{labor_serialize.extract_data(
+					_database.select(sql::query::material_labor_select, column_params)
+				)};
+		std::vector<data::column> description_column_data{labor_serialize.extract_data(
+					_database.select(sql::query::description_labor_select, column_params)
+				)};
+
+		invoice_data.set_material_column(material_column_data);
+		invoice_data.set_description_column(description_column_data);
+
+		data::pdf_invoice pdf_invoice_data{};
+		pdf_invoice_data.set_invoice(invoice_data);
+		pdf_invoice_data.set_client(_client_data);
+		pdf_invoice_data.set_business(_admin_data);
+
+		pdf_invoices_data.emplace_back(std::move(pdf_invoice_data));
+	}
+
+	return pdf_invoices_data;
 }
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * @file model_cache.cpp
+ *
+ * @brief Implementation of the process-wide model cache.
+ *
+ * @details
+ * A single mutex guards an ordered map of entries and a recency list. The
+ * map is ordered by (database, entity, business name, detail), so all the
+ * pages cached for one business and entity are adjacent and can be dropped
+ * with one range erase. Each hit moves its key to the front of the recency
+ * list; eviction pops from the back until the estimated size fits the budget.
+ * A hit copies the entry's shared_ptr, never the value; an entry stored
+ * under another type than the one asked for is a miss.
+ *
+ * The footprint() helpers estimate the heap held by a cached value from the
+ * object sizes and the variable-length text it carries. They are estimates,
+ * good enough to keep the cache within its budget, not exact accounting.
+ ******************************************************************************/
+#include <model_cache.h>
+#include <syslog.h>
+
+
+model::cache& model::cache::instance()
+{
+	static cache shared{};
+	return shared;
+}
+
+std::shared_ptr<const void> model::cache::lookup(const std::string& _database, const entity& _entity,
+						  const std::string& _business_name, const std::string& _detail,
+						  const std::type_info& _type)
+{
+	std::lock_guard<std::mutex> lock{this->guard};
+	auto found{this->entries.find(key{_database, _entity, _business_name, _detail})};
+	if (found == this->entries.end() || *found->second.type != _type)
+	{
+		++this->counters.misses;
+		return nullptr;
+	}
+
+	++this->counters.hits;
+	this->recently_used.splice(this->recently_used.begin(), this->recently_used, found->second.position);
+
+	return found->second.value;
+}
+
+void model::cache::insert(const std::string& _database, const entity& _entity, const std::string& _business_name,
+			  const std::string& _detail, std::shared_ptr<const void> _value, const std::type_info& _type,
+			  const std::size_t& _bytes)
+{
+	std::lock_guard<std::mutex> lock{this->guard};
+	if (_value == nullptr)
+	{
+		syslog(LOG_CRIT, "MODEL_CACHE: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return;
+	}
+	else if (_bytes > this->counters.budget)
+	{
+		syslog(LOG_INFO, "MODEL_CACHE: value larger than the budget is not cached - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return;
+	}
+
+	key entry_key{_database, _entity, _business_name, _detail};
+	auto found{this->entries.find(entry_key)};
+	if (found != this->entries.end())
+	{
+		this->counters.bytes -= found->second.bytes;
+		this->recently_used.erase(found->second.position);
+		this->entries.erase(found);
+	}
+
+	this->recently_used.push_front(entry_key);
+	this->entries.emplace(std::move(entry_key), entry{std::move(_value), &_type, _bytes, this->recently_used.begin()});
+	this->counters.bytes += _bytes;
+	evict();
+}
+
+void model::cache::invalidate(const std::string& _database, const entity& _entity, const std::string& _business_name)
+{
+	std::lock_guard<std::mutex> lock{this->guard};
+	auto first{this->entries.lower_bound(key{_database, _entity, _business_name, ""})};
+	auto last{first};
+	while (last != this->entries.end() && std::get<0>(last->first) == _database &&
+	       std::get<1>(last->first) == _entity && std::get<2>(last->first) == _business_name)
+	{
+		this->counters.bytes -= last->second.bytes;
+		this->recently_used.erase(last->second.position);
+		++this->counters.invalidations;
+		++last;
+	}
+
+	this->entries.erase(first, last);
+}
+
+void model::cache::invalidate(const std::string& _database, const std::string& _business_name)
+{
+	invalidate(_database, entity::client, _business_name);
+	invalidate(_database, entity::invoices, _business_name);
+	invalidate(_database, entity::statements, _business_name);
+	invalidate(_database, entity::reports, "");
+}
+
+void model::cache::clear()
+{
+	std::lock_guard<std::mutex> lock{this->guard};
+	this->counters.invalidations += this->entries.size();
+	this->entries.clear();
+	this->recently_used.clear();
+	this->counters.bytes = 0;
+}
+
+void model::cache::set_budget(const std::size_t& _budget)
+{
+	std::lock_guard<std::mutex> lock{this->guard};
+	this->counters.budget = _budget;
+	evict();
+}
+
+model::cache_statistics model::cache::statistics() const
+{
+	std::lock_guard<std::mutex> lock{this->guard};
+	cache_statistics snapshot{this->counters};
+	snapshot.entries = this->entries.size();
+
+	return snapshot;
+}
+
+void model::cache::evict()
+{
+	while (this->counters.bytes > this->counters.budget && this->recently_used.empty() == false)
+	{
+		auto oldest{this->entries.find(this->recently_used.back())};
+		this->counters.bytes -= oldest->second.bytes;
+		this->entries.erase(oldest);
+		this->recently_used.pop_back();
+		++this->counters.evictions;
+	}
+}
+
+std::string model::page_detail(const model::page& _page)
+{
+	return std::to_string(_page.before) + ":" + std::to_string(_page.limit);
+}
+
+std::size_t model::footprint(const data::admin& _admin)
+{
+	return sizeof(data::admin) + _admin.get_name().size() + _admin.get_address().size() +
+	       _admin.get_email().size() + _admin.get_client_message().size();
+}
+
+std::size_t model::footprint(const data::client& _client)
+{
+	return sizeof(data::client) + _client.get_name().size() + _client.get_address().size() +
+	       _client.get_email().size();
+}
+
+std::size_t model::footprint(const std::vector<data::pdf_invoice>& _pdf_invoices)
+{
+	std::size_t bytes{sizeof(_pdf_invoices)};
+	for (const data::pdf_invoice& pdf_invoice : _pdf_invoices)
+	{
+		const data::invoice& invoice_data{pdf_invoice.get_invoice()};
+		bytes += sizeof(data::pdf_invoice) + sizeof(data::invoice);
+		for (const std::vector<data::column>* columns : {&invoice_data.get_description_column(),
+								 &invoice_data.get_material_column()})
+		{
+			for (const data::column& column_data : *columns)
+			{
+				bytes += sizeof(data::column) + column_data.get_description().size();
+			}
+		}
+	}
+
+	return bytes;
+}
+
+std::size_t model::footprint(const std::vector<data::pdf_statement>& _pdf_statements)
+{
+	std::size_t bytes{sizeof(_pdf_statements)};
+	for (const data::pdf_statement& pdf_statement : _pdf_statements)
+	{
+		bytes += sizeof(data::pdf_statement) + footprint(pdf_statement.get_pdf_invoices());
+	}
+
+	return bytes;
+}
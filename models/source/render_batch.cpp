@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * @file render_batch.cpp
+ *
+ * @brief Implementation of the worker-thread batch renderer.
+ *
+ * @details
+ * The workers share an atomic cursor and each writes only the slots of the
+ * indices it took, so the result needs no lock. The calling thread waits
+ * for every worker before it returns.
+ ******************************************************************************/
+#include <render_batch.h>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <algorithm>
+
+
+std::vector<std::string> model::render_batch(const std::size_t& _count,
+					     const std::function<std::string(const std::size_t&)>& _render)
+{
+	std::vector<std::string> documents(_count);
+	if (_count == 0 || _render == nullptr)
+	{
+		return documents;
+	}
+
+	const std::size_t workers{std::min<std::size_t>(_count, std::max(1u, std::thread::hardware_concurrency()))};
+	std::atomic<std::size_t> next{0};
+	std::vector<std::future<void>> futures{};
+	futures.reserve(workers);
+	for (std::size_t worker{0}; worker < workers; ++worker)
+	{
+		futures.push_back(std::async(std::launch::async, [&documents, &next, &_count, &_render] () {
+			for (std::size_t index{next++}; index < _count; index = next++)
+			{
+				documents[index] = _render(index);
+			}
+		}));
+	}
+
+	for (std::future<void>& future : futures)
+	{
+		future.get();
+	}
+
+	return documents;
+}
@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * @file report_model.cpp
+ *
+ * @brief Implementation of the receivable and revenue reports.
+ *
+ * @details
+ * Core operations:
+ *  - Constructor:
+ *      * Opens the database once and keeps the connection.
+ *      * Adds the `total_cents` and `created_on` generated columns when the
+ *        invoice table predates them, and creates the report indices, in one
+ *        transaction. This runs once per database file and process (see
+ *        schema_guard.h); later reports skip it.
+ *
+ *  - `aged()`, `revenue()`, `unpaid()`, `top_clients()`:
+ *      * Validate the ISO dates, look the result up in `model::cache`, and on
+ *        a miss run one aggregate query and cache its (small) result.
+ *
+ * Error handling:
+ *  - Uses `syslog(LOG_CRIT, ...)` with file and line information to report
+ *    invalid arguments and SQL failures; a report with invalid arguments is
+ *    empty.
+ ******************************************************************************/
+#include <report_model.h>
+#include <chrono>
+#include <variant>
+#include <syslog.h>
+#include <trace.h>
+#include <metrics.h>
+#include <model_cache.h>
+#include <schema_guard.h>
+
+
+namespace {
+	utility::metrics::histogram& query_time{utility::metrics::histogram_named("report.query_ns")};
+
+	using storage::database::part::integer_at;
+	using storage::database::part::text_at;
+
+	std::size_t estimate(const std::vector<model::client_total>& _totals)
+	{
+		std::size_t bytes{sizeof(_totals) + _totals.capacity() * sizeof(model::client_total)};
+		for (const model::client_total& total : _totals)
+		{
+			bytes += total.business_name.capacity();
+		}
+
+		return bytes;
+	}
+
+	std::size_t estimate(const std::vector<model::period_revenue>& _revenue)
+	{
+		return sizeof(_revenue) + _revenue.capacity() * (sizeof(model::period_revenue) + 8);
+	}
+}
+
+
+
+model::report::report(const std::string& _database_file, const std::string& _database_password)
+	: database_file{_database_file}
+{
+	TRACE_SPAN("model", "report::open");
+	try
+	{
+		this->database = std::make_unique<storage::database::sqlite>(_database_file, _database_password);
+		this->available = model::prepare_once(_database_file, "report", [this] () {
+			return prepare_schema();
+		});
+	}
+	catch (...)
+	{
+		syslog(LOG_CRIT, "REPORT_MODEL: failed to open the database - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+}
+
+model::report::~report() {}
+
+bool model::report::is_available() const
+{
+	return this->available;
+}
+
+model::aging model::report::aged(const std::string& _as_of) const
+{
+	TRACE_SPAN("model", "report::aged");
+	model::aging aging{};
+	const std::string detail{"aged|" + _as_of};
+	if (this->available == false || is_date(_as_of) == false)
+	{
+		syslog(LOG_CRIT, "REPORT_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (std::shared_ptr<const model::aging> cached{
+			model::cache::instance().find<model::aging>(this->database_file, model::entity::reports, "", detail)};
+		 cached != nullptr)
+	{
+		aging = *cached;
+	}
+	else
+	{
+		utility::metrics::timer query_timer{query_time};
+		const storage::database::part::rows rows{this->database->select(sql::query::report_aged_select, {_as_of})};
+		if (rows.empty() == true)
+		{
+			syslog(LOG_CRIT, "REPORT_MODEL: failed to compute the aged receivables - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+		else
+		{
+			aging.days_0_30_cents = integer_at(rows.front(), 0);
+			aging.days_31_60_cents = integer_at(rows.front(), 1);
+			aging.days_61_90_cents = integer_at(rows.front(), 2);
+			aging.days_over_90_cents = integer_at(rows.front(), 3);
+			model::cache::instance().store(this->database_file, model::entity::reports, "", detail,
+						       std::make_shared<const model::aging>(aging), sizeof(aging));
+		}
+	}
+
+	return aging;
+}
+
+std::vector<model::period_revenue> model::report::revenue(const std::string& _from, const std::string& _to) const
+{
+	TRACE_SPAN("model", "report::revenue");
+	std::vector<model::period_revenue> revenue{};
+	const std::string detail{"revenue|" + _from + "|" + _to};
+	if (this->available == false || is_date(_from) == false || is_date(_to) == false)
+	{
+		syslog(LOG_CRIT, "REPORT_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (std::shared_ptr<const std::vector<model::period_revenue>> cached{
+			model::cache::instance().find<std::vector<model::period_revenue>>(
+				this->database_file, model::entity::reports, "", detail)};
+		 cached != nullptr)
+	{
+		revenue = *cached;
+	}
+	else
+	{
+		utility::metrics::timer query_timer{query_time};
+		for (const storage::database::part::row& row : this->database->select(sql::query::report_revenue_select,
+										       {_from, _to}))
+		{
+			const std::string period{text_at(row, 0).substr(0, 7)};
+			if (revenue.empty() == true || revenue.back().period != period)
+			{
+				revenue.push_back(model::period_revenue{.period = period});
+			}
+
+			revenue.back().invoices += integer_at(row, 1);
+			revenue.back().total_cents += integer_at(row, 2);
+			revenue.back().unpaid_cents += integer_at(row, 3);
+		}
+		model::cache::instance().store(this->database_file, model::entity::reports, "", detail,
+					       std::make_shared<const std::vector<model::period_revenue>>(revenue),
+					       estimate(revenue));
+	}
+
+	return revenue;
+}
+
+std::vector<model::client_total> model::report::unpaid() const
+{
+	TRACE_SPAN("model", "report::unpaid");
+	std::vector<model::client_total> totals{};
+	if (this->available == false)
+	{
+		syslog(LOG_CRIT, "REPORT_MODEL: the reports are not available - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (std::shared_ptr<const std::vector<model::client_total>> cached{
+			model::cache::instance().find<std::vector<model::client_total>>(
+				this->database_file, model::entity::reports, "", "unpaid")};
+		 cached != nullptr)
+	{
+		totals = *cached;
+	}
+	else
+	{
+		utility::metrics::timer query_timer{query_time};
+		totals = client_totals(this->database->select(sql::query::report_unpaid_select));
+		model::cache::instance().store(this->database_file, model::entity::reports, "", "unpaid",
+					       std::make_shared<const std::vector<model::client_total>>(totals),
+					       estimate(totals));
+	}
+
+	return totals;
+}
+
+std::vector<model::client_total> model::report::top_clients(const std::string& _from, const std::string& _to,
+							    const std::size_t& _limit) const
+{
+	TRACE_SPAN("model", "report::top_clients");
+	std::vector<model::client_total> totals{};
+	const std::string detail{"top|" + _from + "|" + _to + "|" + std::to_string(_limit)};
+	if (this->available == false || is_date(_from) == false || is_date(_to) == false || _limit == 0)
+	{
+		syslog(LOG_CRIT, "REPORT_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (std::shared_ptr<const std::vector<model::client_total>> cached{
+			model::cache::instance().find<std::vector<model::client_total>>(
+				this->database_file, model::entity::reports, "", detail)};
+		 cached != nullptr)
+	{
+		totals = *cached;
+	}
+	else
+	{
+		utility::metrics::timer query_timer{query_time};
+		totals = client_totals(this->database->select(sql::query::report_top_clients_select,
+							      {_from, _to, static_cast<sqlite3_int64> (_limit)}));
+		model::cache::instance().store(this->database_file, model::entity::reports, "", detail,
+					       std::make_shared<const std::vector<model::client_total>>(totals),
+					       estimate(totals));
+	}
+
+	return totals;
+}
+
+bool model::report::is_date(const std::string& _date)
+{
+	if (_date.size() != 10 || _date[4] != '-' || _date[7] != '-')
+	{
+		return false;
+	}
+
+	for (const std::size_t index : {0, 1, 2, 3, 5, 6, 8, 9})
+	{
+		if (_date[index] < '0' || _date[index] > '9')
+		{
+			return false;
+		}
+	}
+
+	const std::chrono::year_month_day date{
+		std::chrono::year{std::stoi(_date.substr(0, 4))},
+		std::chrono::month{static_cast<unsigned> (std::stoi(_date.substr(5, 2)))},
+		std::chrono::day{static_cast<unsigned> (std::stoi(_date.substr(8, 2)))}};
+
+	return date.ok();
+}
+
+bool model::report::prepare_schema() const
+{
+	const storage::database::part::rows columns{this->database->select(sql::query::report_columns_select)};
+	if (columns.empty() == true)
+	{
+		syslog(LOG_CRIT, "REPORT_MODEL: failed to inspect the invoice table - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	bool success{false};
+	const bool migrate{integer_at(columns.front(), 0) == 0};
+	if (this->database->transaction("BEGIN IMMEDIATE;") == false)
+	{
+		syslog(LOG_CRIT, "REPORT_MODEL: failed to begin the transaction - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if ((migrate == true && (this->database->transaction(sql::query::invoice_total_cents_column) == false ||
+				      this->database->transaction(sql::query::invoice_created_on_column) == false)) ||
+		 this->database->transaction(sql::query::invoice_period_index) == false ||
+		 this->database->transaction(sql::query::invoice_unpaid_index) == false ||
+		 this->database->transaction("COMMIT;") == false)
+	{
+		syslog(LOG_CRIT, "REPORT_MODEL: failed to prepare the report columns - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		if (this->database->transaction("ROLLBACK;") == false)
+		{
+			syslog(LOG_CRIT, "REPORT_MODEL: failed to rollback - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+	}
+	else
+	{
+		success = true;
+	}
+
+	return success;
+}
+
+std::vector<model::client_total> model::report::client_totals(const storage::database::part::rows& _rows)
+{
+	std::vector<model::client_total> totals{};
+	totals.reserve(_rows.size());
+	for (const storage::database::part::row& row : _rows)
+	{
+		totals.push_back(model::client_total{
+			.business_name = text_at(row, 0),
+			.invoices = integer_at(row, 1),
+			.total_cents = integer_at(row, 2)
+		});
+	}
+
+	return totals;
+}
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * @file schema_guard.cpp
+ *
+ * @brief Implementation of the once-per-database-file schema steps.
+ *
+ * @details
+ * A set of "file\x1fstep" keys under one mutex. The mutex is held while a
+ * step runs, so a second caller for the same file waits for the first and
+ * then finds the step done.
+ ******************************************************************************/
+#include <schema_guard.h>
+#include <mutex>
+#include <set>
+
+
+namespace {
+	std::mutex guard{};
+	std::set<std::string> prepared{};
+}
+
+
+
+bool model::prepare_once(const std::string& _database_file, const std::string& _step,
+			 const std::function<bool()>& _prepare)
+{
+	const std::string key{_database_file + '\x1f' + _step};
+	std::lock_guard<std::mutex> lock{guard};
+	if (prepared.contains(key) == true)
+	{
+		return true;
+	}
+	else if (_prepare == nullptr || _prepare() == false)
+	{
+		return false;
+	}
+
+	prepared.insert(key);
+	return true;
+}
+
+void model::forget_prepared(const std::string& _database_file)
+{
+	const std::string prefix{_database_file + '\x1f'};
+	std::lock_guard<std::mutex> lock{guard};
+	auto first{prepared.lower_bound(prefix)};
+	auto last{first};
+	while (last != prepared.end() && last->starts_with(prefix) == true)
+	{
+		++last;
+	}
+
+	prepared.erase(first, last);
+}
@@ -0,0 +1,248 @@
+/*******************************************************************************
+ * @file search_model.cpp
+ *
+ * @brief Implementation of the full-text search model.
+ *
+ * @details
+ * Core operations:
+ *  - Constructor:
+ *      * Opens the database once and keeps the connection.
+ *      * When any of the FTS5 tables or triggers is missing, creates the
+ *        missing ones and re-indexes the existing rows, all in one
+ *        transaction so a failure leaves the database untouched.
+ *
+ *  - `find(const std::string&, const std::size_t&)`:
+ *      * Turns the text into an FTS5 prefix query with `match_expression()`;
+ *        text without a letter or digit finds nothing.
+ *      * Queries businesses, invoice headers and labor lines, each limited
+ *        to the requested count, and concatenates them in that order; an
+ *        invoice found both ways is reported once, at its header rank.
+ *
+ *  - `suggest(const std::string&, const std::size_t&)`:
+ *      * The distinct business names behind the hits of `find()`, best first.
+ *        These are the keys the pages load by.
+ *
+ *  - `rebuild()`:
+ *      * Empties and refills the search tables from the base tables; for use after
+ *        the base tables were changed with the triggers absent.
+ *
+ * Error handling:
+ *  - Uses `syslog(LOG_CRIT, ...)` with file and line information to report
+ *    invalid arguments and SQL failures.
+ ******************************************************************************/
+#include <search_model.h>
+#include <set>
+#include <cctype>
+#include <variant>
+#include <iterator>
+#include <algorithm>
+#include <syslog.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& query_time{utility::metrics::histogram_named("search.query_ns")};
+
+	using storage::database::part::integer_at;
+	using storage::database::part::text_at;
+}
+
+
+
+model::search::search(const std::string& _database_file, const std::string& _database_password)
+{
+	TRACE_SPAN("model", "search::open");
+	try
+	{
+		this->database = std::make_unique<storage::database::sqlite>(_database_file, _database_password);
+		this->available = create_index();
+	}
+	catch (...)
+	{
+		syslog(LOG_CRIT, "SEARCH_MODEL: failed to open the database - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+}
+
+model::search::~search() {}
+
+bool model::search::is_available() const
+{
+	return this->available;
+}
+
+std::vector<model::search_hit> model::search::find(const std::string& _text, const std::size_t& _limit) const
+{
+	TRACE_SPAN("model", "search::find");
+	utility::metrics::timer query_timer{query_time};
+	std::vector<model::search_hit> hits{};
+	const std::string expression{match_expression(_text)};
+	if (expression.empty())
+	{
+		return hits;
+	}
+
+	if (_limit == 0)
+	{
+		syslog(LOG_CRIT, "SEARCH_MODEL: invalid argument - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (this->available == true)
+	{
+		const storage::database::sql_parameters params{expression, static_cast<sqlite3_int64> (_limit)};
+		for (const storage::database::part::row& row : this->database->select(sql::query::business_search_select, params))
+		{
+			hits.push_back(model::search_hit{
+				.kind = model::hit_kind::business,
+				.id = integer_at(row, 0),
+				.business_name = text_at(row, 1),
+				.detail = text_at(row, 2)
+			});
+		}
+
+		std::set<long long> invoices{};
+		for (const char* query : {sql::query::invoice_header_search_select, sql::query::invoice_labor_search_select})
+		{
+			for (const storage::database::part::row& row : this->database->select(query, params))
+			{
+				if (invoices.insert(integer_at(row, 0)).second == true)
+				{
+					hits.push_back(model::search_hit{
+						.kind = model::hit_kind::invoice,
+						.id = integer_at(row, 0),
+						.business_name = text_at(row, 1),
+						.detail = text_at(row, 2) + " / " + text_at(row, 3)
+					});
+				}
+			}
+		}
+
+		if (hits.size() > _limit)
+		{
+			hits.resize(_limit);
+		}
+	}
+
+	return hits;
+}
+
+std::vector<std::string> model::search::suggest(const std::string& _text, const std::size_t& _limit) const
+{
+	std::vector<std::string> names{};
+	std::set<std::string> seen{};
+	for (const model::search_hit& hit : find(_text, _limit * 4))
+	{
+		if (names.size() == _limit)
+		{
+			break;
+		}
+
+		if (seen.insert(hit.business_name).second == true)
+		{
+			names.push_back(hit.business_name);
+		}
+	}
+
+	return names;
+}
+
+bool model::search::rebuild() const
+{
+	TRACE_SPAN("model", "search::rebuild");
+	bool success{false};
+	if (this->available == false)
+	{
+		syslog(LOG_CRIT, "SEARCH_MODEL: the search index is not available - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (this->database->transaction("BEGIN IMMEDIATE;") == false)
+	{
+		syslog(LOG_CRIT, "SEARCH_MODEL: failed to begin the transaction - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (fill_index() == false || this->database->transaction("COMMIT;") == false)
+	{
+		syslog(LOG_CRIT, "SEARCH_MODEL: failed to rebuild the search index - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		if (this->database->transaction("ROLLBACK;") == false)
+		{
+			syslog(LOG_CRIT, "SEARCH_MODEL: failed to rollback - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+	}
+	else
+	{
+		success = true;
+	}
+
+	return success;
+}
+
+std::string model::search::match_expression(const std::string& _text)
+{
+	std::string expression{""};
+	std::string token{""};
+	for (std::size_t index{0}; index <= _text.size(); ++index)
+	{
+		const unsigned char character{index < _text.size() ? static_cast<unsigned char> (_text[index])
+								    : static_cast<unsigned char> (' ')};
+		if (std::isalnum(character) != 0 || character >= 0x80)
+		{
+			token.push_back(static_cast<char> (character));
+		}
+		else if (token.empty() == false)
+		{
+			expression += (expression.empty() ? "\"" : " \"") + token + "\"*";
+			token.clear();
+		}
+	}
+
+	return expression;
+}
+
+bool model::search::create_index() const
+{
+	const storage::database::part::rows objects{this->database->select(sql::query::search_index_objects)};
+	if (objects.empty() == false && integer_at(objects.front(), 0) == static_cast<long long> (std::size(sql::query::search_index_create)))
+	{
+		return true;
+	}
+
+	bool success{false};
+	if (this->database->transaction("BEGIN IMMEDIATE;") == false)
+	{
+		syslog(LOG_CRIT, "SEARCH_MODEL: failed to begin the transaction - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (run(sql::query::search_index_create) == false ||
+		 fill_index() == false ||
+		 this->database->transaction("COMMIT;") == false)
+	{
+		syslog(LOG_CRIT, "SEARCH_MODEL: failed to create the search index - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		if (this->database->transaction("ROLLBACK;") == false)
+		{
+			syslog(LOG_CRIT, "SEARCH_MODEL: failed to rollback - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+	}
+	else
+	{
+		success = true;
+	}
+
+	return success;
+}
+
+bool model::search::fill_index() const
+{
+	return run(sql::query::search_index_clear) == true && run(sql::query::search_index_fill) == true;
+}
+
+bool model::search::run(std::span<const char* const> _statements) const
+{
+	return std::ranges::all_of(_statements, [this] (const char* _statement) {
+		return this->database->transaction(_statement);
+	});
+}
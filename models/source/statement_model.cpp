@@ -15,26 +15,48 @@
  *       - data::admin (business) information
  *       - data::pdf_invoice entries (each containing invoice + labor details)
  *
+ *   • Paging through statements newest first (load_page), where each
+ *     statement only carries the invoices linked to it through statement_id
+ *     and the total is the one the statement row maintains (see
+ *     totals_model.h) rather than a sum over the parsed invoices.
+ *
  *   • Persisting statement records to the database using parameterized SQL
  *     queries and transactional semantics to preserve data integrity.
  *
  *   • Preparing email payloads (data::email) containing the correct client,
- *     business details, and a collection of generated PDF documents.
+ *     business details, and a collection of generated PDF documents, or, in
+ *     model::attachments::bundle mode, a single PDF holding every statement
+ *     followed by the invoices it references, drawn in one surface pass by
+ *     feature::bundle_pdf.
+ *
+ *   • Streaming one PDF file per statement into a directory (write_pdfs)
+ *     through a feature::file_sink, one statement at a time, so a batch
+ *     never holds its PDFs in memory. A file that could not be written in
+ *     full, or did not close cleanly, is removed and the rest of the batch
+ *     is still written.
  *
  *   • Preparing data for printing by converting statement aggregates into a
  *     vector<std::string> of in-memory PDF representations using the
- *     feature::statement_pdf facility. PDF generation is parallelized using
- *     std::async to keep the implementation scalable.
+ *     feature::statement_pdf facility. PDF generation runs on the workers
+ *     of model::render_batch(), so each worker's recorded page templates
+ *     serve many statements.
+ *
+ *   • Building every generator on feature::configured_pdf_backend(), so
+ *     MINTBILL_PDF_BACKEND=native selects the native PDF writer; Cairo is
+ *     the default.
  *
  * Error handling:
  *   All critical failures (invalid arguments, empty result sets, failed
  *   transactions) are logged via syslog with file name and line number
  *   information to aid debugging and troubleshooting.
  *******************************************************************************/
-#include <future>
+#include <render_batch.h>
+#include <pdf_sink.h>
 #include <syslog.h>
+#include <model_cache.h>
 #include <sqlite.h>
 #include <algorithm>
+#include <bundle_pdf.h>
 #include <statement_pdf.h>
 #include <statement_model.h>
 #include <pdf_invoice_data.h>
@@ -46,18 +68,46 @@
 #include <client_serialize.h>
 #include <invoice_serialize.h>
 #include <statement_serialize.h>
+#include <totals_model.h>
+#include <schema_guard.h>
 #include <date_manager.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::histogram& load_time{utility::metrics::histogram_named("model.load_ns")};
+	utility::metrics::histogram& save_time{utility::metrics::histogram_named("model.save_ns")};
+
+	constexpr std::size_t total_cents_column{6};
+
+	std::string amount(const long long& _cents)
+	{
+		const long long cents{_cents < 0 ? -_cents : _cents};
+		std::ostringstream amount_ss{""};
+		amount_ss << (_cents < 0 ? "-" : "") << cents / 100 << "."
+			  << std::setw(2) << std::setfill('0') << cents % 100;
+
+		return amount_ss.str();
+	}
+}
 
 
 
 model::statement::statement(const std::string& _database_file, const std::string& _database_password)
 	: database_file{_database_file}, database_password{_database_password} {}
 
+model::statement::statement(const std::string& _database_file, const std::string& _database_password,
+			    const model::attachments& _mode)
+	: database_file{_database_file}, database_password{_database_password}, mode{_mode} {}
+
 model::statement::~statement() {}
 
-std::vector<std::any> model::statement::load(const std::string& _business_name) const
+model::documents<data::pdf_statement> model::statement::load(const std::string& _business_name) const
 {
-	std::vector<std::any> pdf_statements_data{};
+	TRACE_SPAN("model", "statement::load");
+	utility::metrics::timer load_timer{load_time};
+	std::vector<data::pdf_statement> pdf_statements_data{};
 	if (_business_name.empty())
 	{
 		syslog(LOG_CRIT, "STATEMENT_MODEL: argument not valid - "
@@ -65,6 +115,14 @@ std::vector<std::any> model::statement::load(const std::string& _business_name)
 	}
 	else
 	{
+		model::documents<data::pdf_statement> cached{
+			model::cache::instance().find<std::vector<data::pdf_statement>>(
+				this->database_file, model::entity::statements, _business_name)};
+		if (cached != nullptr)
+		{
+			return cached;
+		}
+
 		storage::database::sqlite database{this->database_file, this->database_password};
 		serialize::admin admin_serialize{};
 		data::admin admin_data{
@@ -85,74 +143,119 @@ std::vector<std::any> model::statement::load(const std::string& _business_name)
 			)
 		};
 
-		serialize::invoice invoice_serialize{};
 		serialize::statement statement_serialize{};
 		storage::database::sql_parameters params = {_business_name};
-		for (const std::any& stmt_sql_data : statement_serialize.extract_data(
+		for (std::any& stmt_sql_data : statement_serialize.extract_data(
 				database.select(sql::query::statement_select, params)))
 		{
-			float total{0.0f};
-			data::statement statement_data{std::any_cast<data::statement> (stmt_sql_data)};
-			serialize::labor labor_serialize{};
-			std::vector<data::pdf_invoice> pdf_invoices_data{};
+			const data::statement& statement_data{std::any_cast<data::statement&> (stmt_sql_data)};
 			storage::database::sql_parameters invoice_params = {_business_name};
-			for (const std::any& data : invoice_serialize.extract_data(
-					database.select(sql::query::invoice_select, invoice_params)))
-			{
-				data::invoice invoice_data{std::any_cast<data::invoice> (data)};
-				storage::database::sql_parameters column_params = {std::stoi(invoice_data.get_id())};
-				std::vector<data::column> material_column_data{labor_serialize.extract_data(
-							database.select(sql::query::material_labor_select, column_params)
-						)};
-				std::vector<data::column> description_column_data{labor_serialize.extract_data(
-							database.select(sql::query::description_labor_select, column_params)
-						)};
-
-				invoice_data.set_material_column(material_column_data);
-				invoice_data.set_description_column(description_column_data);
-
-				data::pdf_invoice pdf_invoice_data{};
-				pdf_invoice_data.set_invoice(invoice_data);
-				pdf_invoice_data.set_client(client_data);
-				pdf_invoice_data.set_business(admin_data);
+			pdf_statements_data.emplace_back(this->assemble(database,
+									statement_data,
+									database.select(sql::query::invoice_select, invoice_params),
+									client_data,
+									admin_data,
+									std::nullopt));
+		}
 
-				total += [&]() -> float
-				{
-					std::string input{ invoice_data.get_grand_total() };
+		model::documents<data::pdf_statement> loaded{std::make_shared<const std::vector<data::pdf_statement>>(std::move(pdf_statements_data))};
+		model::cache::instance().store(this->database_file, model::entity::statements, _business_name, "",
+					       loaded, model::footprint(*loaded));
+		return loaded;
+	}
 
-					std::string cleaned;
-					cleaned.reserve(input.size());
-					for (char c : input)
-						if (c != ',')
-							cleaned.push_back(c);
+	return std::make_shared<const std::vector<data::pdf_statement>>(std::move(pdf_statements_data));
+}
 
-					return std::stof(cleaned);
-				}();
-				pdf_invoices_data.emplace_back(std::move(pdf_invoice_data));
-			}
+model::documents<data::pdf_statement> model::statement::load_page(const std::string& _business_name, const model::page& _page) const
+{
+	TRACE_SPAN("model", "statement::load_page");
+	utility::metrics::timer load_timer{load_time};
+	std::vector<data::pdf_statement> pdf_statements_data{};
+	if (_business_name.empty() || _page.is_valid() == false)
+	{
+		syslog(LOG_CRIT, "STATEMENT_MODEL: argument not valid - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		model::documents<data::pdf_statement> cached{
+			model::cache::instance().find<std::vector<data::pdf_statement>>(
+				this->database_file, model::entity::statements, _business_name, model::page_detail(_page))};
+		if (cached != nullptr)
+		{
+			return cached;
+		}
 
-			std::ostringstream total_ss{""};
-			total_ss << std::fixed << std::setprecision(2) << total;
+		storage::database::sqlite database{this->database_file, this->database_password};
+		if (_page.first() == true &&
+		   (database.transaction(sql::query::statement_page_index) == false ||
+		    database.transaction(sql::query::statement_invoice_index) == false ||
+		    model::prepare_once(this->database_file, "totals", [&database] () {
+			return model::totals::prepare(database);
+		    }) == false))
+		{
+			syslog(LOG_CRIT, "STATEMENT_MODEL: failed to create the page indices - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
 
-			data::pdf_statement pdf_statement_data{};
-			pdf_statement_data.set_number(statement_data.get_id());
-			pdf_statement_data.set_date(statement_data.get_date());
-			pdf_statement_data.set_total(total_ss.str());
-			pdf_statement_data.set_statement(statement_data);
-			pdf_statement_data.set_pdf_invoices(pdf_invoices_data);
+		serialize::admin admin_serialize{};
+		data::admin admin_data{
+			std::any_cast<data::admin>(
+				admin_serialize.extract_data(
+					database.select(sql::query::statement_admin_select)
+				)
+			)
+		};
 
-			pdf_statements_data.push_back(std::move(pdf_statement_data));
+		storage::database::sql_parameters client_params = {_business_name};
+		serialize::client client_serialize{};
+		data::client client_data{
+			std::any_cast<data::client>(
+				client_serialize.extract_data(
+					database.select(sql::query::client_select, client_params)
+				)
+			)
+		};
+
+		storage::database::sql_parameters params = {_business_name, _page.before, _page.limit};
+		storage::database::part::rows statement_rows{database.select(sql::query::statement_page_select, params)};
+		if (statement_rows.empty() == false)
+		{
+			serialize::statement statement_serialize{};
+			std::vector<std::any> statements_data(statement_serialize.extract_data(statement_rows));
+			for (std::size_t index{0}; index < statements_data.size() && index < statement_rows.size(); ++index)
+			{
+				const data::statement& statement_data{std::any_cast<data::statement&> (statements_data[index])};
+				const sqlite3_int64* total_cents{std::get_if<sqlite3_int64>(&statement_rows[index][total_cents_column])};
+				storage::database::sql_parameters invoice_params = {std::stoll(statement_data.get_id())};
+				pdf_statements_data.emplace_back(this->assemble(database,
+										statement_data,
+										database.select(sql::query::statement_page_invoices_select,
+												invoice_params),
+										client_data,
+										admin_data,
+										(total_cents == nullptr) ? std::nullopt
+													 : std::optional<long long>{*total_cents}));
+			}
 		}
+
+		model::documents<data::pdf_statement> loaded{std::make_shared<const std::vector<data::pdf_statement>>(std::move(pdf_statements_data))};
+		model::cache::instance().store(this->database_file, model::entity::statements, _business_name,
+					       model::page_detail(_page),
+					       loaded, model::footprint(*loaded));
+		return loaded;
 	}
 
-	return pdf_statements_data;
+	return std::make_shared<const std::vector<data::pdf_statement>>(std::move(pdf_statements_data));
 }
 
-bool model::statement::save(const std::any& _data) const
+bool model::statement::save(const data::statement& _statement_data) const
 {
+	TRACE_SPAN("model", "statement::save");
+	utility::metrics::timer save_timer{save_time};
         bool success{false};
-	data::statement statement_data{std::any_cast<data::statement> (_data)};
-        if (statement_data.is_valid() == false)
+        if (_statement_data.is_valid() == false)
 	{
 		syslog(LOG_CRIT, "STATEMENT_MODEL: invalid argument - "
 				 "filename %s, line number %d", __FILE__, __LINE__);
@@ -176,11 +279,11 @@ bool model::statement::save(const std::any& _data) const
 		}
 
 		storage::database::sql_parameters statement_params = {
-			statement_data.get_name(),
-			statement_data.get_period_start(),
-			statement_data.get_period_end(),
-			statement_data.get_date(),
-			statement_data.get_paid_status()
+			_statement_data.get_name(),
+			_statement_data.get_period_start(),
+			_statement_data.get_period_end(),
+			_statement_data.get_date(),
+			_statement_data.get_paid_status()
 		};
 
 		if (database.transaction("BEGIN IMMEDIATE;") == false)
@@ -210,59 +313,172 @@ bool model::statement::save(const std::any& _data) const
 		else
 		{
 			success = true;
+			model::cache::instance().invalidate(this->database_file, model::entity::invoices, _statement_data.get_name());
+			model::cache::instance().invalidate(this->database_file, model::entity::statements, _statement_data.get_name());
+			model::cache::instance().invalidate(this->database_file, model::entity::reports, "");
 		}
         }
 
         return success;
 }
 
-data::email model::statement::prepare_for_email(const std::vector<std::any>& _pdf_statements) const
+data::email model::statement::prepare_for_email(std::span<const data::pdf_statement> _pdf_statements) const
 {
 	data::email email_data;
-	for (const std::any& _pdf_statement : _pdf_statements)
+	if (_pdf_statements.empty() == false)
 	{
-		data::pdf_statement pdf_statement_data{std::any_cast<data::pdf_statement> (_pdf_statement)};
-		for (const data::pdf_invoice& pdf_invoice : pdf_statement_data.get_pdf_invoices())
+		for (const data::pdf_invoice& pdf_invoice : _pdf_statements.front().get_pdf_invoices())
 		{
 			email_data.set_client(pdf_invoice.get_client());
 			email_data.set_business(pdf_invoice.get_business());
 			break;
 		}
-		break;
 	}
 	email_data.set_subject("Statement");
-	email_data.set_attachments(this->convert_pdfs_to_strings(_pdf_statements));
+	if (this->mode == model::attachments::bundle)
+	{
+		email_data.set_attachments(this->convert_pdfs_to_bundle(_pdf_statements));
+	}
+	else
+	{
+		email_data.set_attachments(this->convert_pdfs_to_strings(_pdf_statements));
+	}
 
 	return email_data;
 }
 
-std::vector<std::string> model::statement::prepare_for_print(const std::vector<std::any>& _pdf_statements) const
+std::vector<std::string> model::statement::prepare_for_print(std::span<const data::pdf_statement> _pdf_statements) const
 {
 	return this->convert_pdfs_to_strings(_pdf_statements);
 }
 
-std::vector<std::string> model::statement::convert_pdfs_to_strings(const std::vector<std::any>& _pdf_statements) const
+bool model::statement::write_pdfs(std::span<const data::pdf_statement> _pdf_statements,
+				  const std::filesystem::path& _directory) const
 {
-	std::vector<std::future<std::string>> pdf_documents;
-	std::transform(_pdf_statements.cbegin(),
-			_pdf_statements.cend(),
-			std::back_inserter(pdf_documents),
-			[] (const std::any& _pdf_statement) {
-				return std::async(std::launch::async, [&_pdf_statement] {
-					feature::statement_pdf pdf{};
-					return pdf.generate(_pdf_statement);
-				});
-			});
-
-
-	std::vector<std::string> pdfs;
-	std::transform(
-		std::make_move_iterator(pdf_documents.begin()),
-		std::make_move_iterator(pdf_documents.end()),
-		std::back_inserter(pdfs),
-		[](std::future<std::string> _pdf) {
-			return _pdf.get();
-		});
+	TRACE_SPAN("model", "statement::write_pdfs");
+	std::error_code error{};
+	std::filesystem::create_directories(_directory, error);
+	if (error)
+	{
+		syslog(LOG_CRIT, "STATEMENT_MODEL: failed to create the PDF directory - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		return false;
+	}
+
+	bool success{true};
+	feature::statement_pdf pdf{feature::configured_pdf_backend()};
+	for (const data::pdf_statement& pdf_statement : _pdf_statements)
+	{
+		const std::filesystem::path path{_directory / ("statement-" + pdf_statement.get_number() + ".pdf")};
+		bool written{false};
+		feature::file_sink sink{path};
+		if (sink.is_open() == true)
+		{
+			written = pdf.generate(pdf_statement, sink);
+			written = sink.close() == true && written == true;
+		}
+
+		if (written == false)
+		{
+			syslog(LOG_CRIT, "STATEMENT_MODEL: failed to write a statement PDF - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+			std::filesystem::remove(path, error);
+			success = false;
+		}
+	}
+
+	return success;
+}
+
+std::vector<std::string> model::statement::convert_pdfs_to_strings(std::span<const data::pdf_statement> _pdf_statements) const
+{
+	const feature::pdf_backend backend{feature::configured_pdf_backend()};
+	return model::render_batch(_pdf_statements.size(), [&_pdf_statements, backend] (const std::size_t& _index) {
+		feature::statement_pdf pdf{backend};
+		return pdf.generate(_pdf_statements[_index]);
+	});
+}
+
+std::vector<std::string> model::statement::convert_pdfs_to_bundle(std::span<const data::pdf_statement> _pdf_statements) const
+{
+	std::vector<std::string> pdfs{};
+	feature::bundle_pdf pdf{feature::configured_pdf_backend()};
+	std::string bundle{pdf.generate(_pdf_statements)};
+	if (bundle.empty() == false)
+	{
+		pdfs.push_back(std::move(bundle));
+	}
 
 	return pdfs;
 }
+
+data::pdf_statement model::statement::assemble(storage::database::sqlite& _database,
+						const data::statement& _statement_data,
+						const storage::database::part::rows& _invoice_rows,
+						const data::client& _client_data,
+						const data::admin& _admin_data,
+						const std::optional<long long>& _total_cents) const
+{
+	float total{0.0f};
+	std::vector<data::pdf_invoice> pdf_invoices_data{};
+	if (_invoice_rows.empty() == false)
+	{
+		serialize::labor labor_serialize{};
+		serialize::invoice invoice_serialize{};
+		for (std::any& data : invoice_serialize.extract_data(_invoice_rows))
+		{
+			data::invoice invoice_data{std::move(std::any_cast<data::invoice&> (data))};
+			storage::database::sql_parameters column_params = {std::stoi(invoice_data.get_id())};
+			std::vector<data::column> material_column_data{labor_serialize.extract_data(
+						_database.select(sql::query::material_labor_select, column_params)
+					)};
+			std::vector<data::column> description_column_data{labor_serialize.extract_data(
+						_database.select(sql::query::description_labor_select, column_params)
+					)};
+
+			invoice_data.set_material_column(material_column_data);
+			invoice_data.set_description_column(description_column_data);
+
+			data::pdf_invoice pdf_invoice_data{};
+			pdf_invoice_data.set_invoice(invoice_data);
+			pdf_invoice_data.set_client(_client_data);
+			pdf_invoice_data.set_business(_admin_data);
+
+			if (_total_cents.has_value() == false)
+			{
+				total += [&]() -> float
+				{
+					std::string input{ invoice_data.get_grand_total() };
+
+					std::string cleaned;
+					cleaned.reserve(input.size());
+					for (char c : input)
+						if (c != ',')
+							cleaned.push_back(c);
+
+					return std::stof(cleaned);
+				}();
+			}
+			pdf_invoices_data.emplace_back(std::move(pdf_invoice_data));
+		}
+	}
+
+	std::ostringstream total_ss{""};
+	if (_total_cents.has_value() == true)
+	{
+		total_ss << amount(_total_cents.value());
+	}
+	else
+	{
+		total_ss << std::fixed << std::setprecision(2) << total;
+	}
+
+	data::pdf_statement pdf_statement_data{};
+	pdf_statement_data.set_number(_statement_data.get_id());
+	pdf_statement_data.set_date(_statement_data.get_date());
+	pdf_statement_data.set_total(total_ss.str());
+	pdf_statement_data.set_statement(_statement_data);
+	pdf_statement_data.set_pdf_invoices(pdf_invoices_data);
+
+	return pdf_statement_data;
+}
@@ -0,0 +1,180 @@
+/*******************************************************************************
+ * @file totals_model.cpp
+ *
+ * @brief Implementation of the maintained statement totals.
+ *
+ * @details
+ * Core operations:
+ *  - Constructor:
+ *      * Opens the database once, keeps the connection and runs `prepare()`
+ *        once per database file and process (see schema_guard.h).
+ *
+ *  - `prepare(storage::database::sqlite&)`:
+ *      * Returns at once when the columns and triggers are all present.
+ *      * Otherwise, in one transaction: adds the invoice generated columns
+ *        when missing, adds the statement columns when missing, creates the
+ *        triggers and the statement_id index they recompute through, and
+ *        computes every statement.
+ *
+ *  - `verify()`:
+ *      * One query comparing the stored totals with a GROUP BY over the
+ *        invoices; only the statements that differ come back.
+ *
+ *  - `repair()`:
+ *      * Recomputes every statement in one transaction.
+ *
+ * Error handling:
+ *  - Uses `syslog(LOG_CRIT, ...)` with file and line information to report
+ *    SQL failures; a failed migration or repair is rolled back.
+ ******************************************************************************/
+#include <totals_model.h>
+#include <span>
+#include <variant>
+#include <algorithm>
+#include <syslog.h>
+#include <trace.h>
+#include <report_model.h>
+#include <schema_guard.h>
+#include <statement_serialize.h>
+
+
+namespace {
+	using storage::database::part::integer_at;
+
+	bool run(storage::database::sqlite& _database, std::span<const char* const> _statements)
+	{
+		return std::ranges::all_of(_statements, [&_database] (const char* _statement) {
+			return _database.transaction(_statement);
+		});
+	}
+
+	long long count(storage::database::sqlite& _database, const char* _query)
+	{
+		const storage::database::part::rows rows{_database.select(_query)};
+		return rows.empty() ? -1 : integer_at(rows.front(), 0);
+	}
+}
+
+
+
+model::totals::totals(const std::string& _database_file, const std::string& _database_password)
+{
+	TRACE_SPAN("model", "totals::open");
+	try
+	{
+		this->database = std::make_unique<storage::database::sqlite>(_database_file, _database_password);
+		this->available = model::prepare_once(_database_file, "totals", [this] () {
+			return prepare(*this->database);
+		});
+	}
+	catch (...)
+	{
+		syslog(LOG_CRIT, "TOTALS_MODEL: failed to open the database - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+}
+
+model::totals::~totals() {}
+
+bool model::totals::is_available() const
+{
+	return this->available;
+}
+
+std::vector<model::total_drift> model::totals::verify() const
+{
+	TRACE_SPAN("model", "totals::verify");
+	std::vector<model::total_drift> drifts{};
+	if (this->available == false)
+	{
+		syslog(LOG_CRIT, "TOTALS_MODEL: the statement totals are not available - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		for (const storage::database::part::row& row : this->database->select(sql::query::statement_totals_verify_select))
+		{
+			drifts.push_back(model::total_drift{
+				.statement_id = integer_at(row, 0),
+				.stored = {integer_at(row, 1), integer_at(row, 2), integer_at(row, 3)},
+				.actual = {integer_at(row, 4), integer_at(row, 5), integer_at(row, 6)}
+			});
+		}
+	}
+
+	return drifts;
+}
+
+bool model::totals::repair() const
+{
+	TRACE_SPAN("model", "totals::repair");
+	bool success{false};
+	if (this->available == false)
+	{
+		syslog(LOG_CRIT, "TOTALS_MODEL: the statement totals are not available - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (this->database->transaction("BEGIN IMMEDIATE;") == false)
+	{
+		syslog(LOG_CRIT, "TOTALS_MODEL: failed to begin the transaction - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if (this->database->transaction(sql::query::statement_totals_recompute) == false ||
+		 this->database->transaction("COMMIT;") == false)
+	{
+		syslog(LOG_CRIT, "TOTALS_MODEL: failed to recompute the statement totals - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		if (this->database->transaction("ROLLBACK;") == false)
+		{
+			syslog(LOG_CRIT, "TOTALS_MODEL: failed to rollback - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+	}
+	else
+	{
+		success = true;
+	}
+
+	return success;
+}
+
+bool model::totals::prepare(storage::database::sqlite& _database)
+{
+	constexpr long long objects{static_cast<long long> (std::size(sql::query::statement_totals_columns) +
+							    std::size(sql::query::statement_totals_triggers))};
+	if (count(_database, sql::query::statement_totals_objects) == objects)
+	{
+		return true;
+	}
+
+	bool success{false};
+	if (_database.transaction("BEGIN IMMEDIATE;") == false)
+	{
+		syslog(LOG_CRIT, "TOTALS_MODEL: failed to begin the transaction - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else if ((count(_database, sql::query::report_columns_select) == 0 &&
+		  (_database.transaction(sql::query::invoice_total_cents_column) == false ||
+		   _database.transaction(sql::query::invoice_created_on_column) == false)) ||
+		 (count(_database, sql::query::statement_totals_columns_select) == 0 &&
+		  run(_database, sql::query::statement_totals_columns) == false) ||
+		 _database.transaction(sql::query::statement_invoice_index) == false ||
+		 run(_database, sql::query::statement_totals_triggers) == false ||
+		 _database.transaction(sql::query::statement_totals_recompute) == false ||
+		 _database.transaction("COMMIT;") == false)
+	{
+		syslog(LOG_CRIT, "TOTALS_MODEL: failed to prepare the statement totals - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+		if (_database.transaction("ROLLBACK;") == false)
+		{
+			syslog(LOG_CRIT, "TOTALS_MODEL: failed to rollback - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+	}
+	else
+	{
+		success = true;
+	}
+
+	return success;
+}
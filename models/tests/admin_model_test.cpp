@@ -19,6 +19,7 @@
 #include "CppUTest/TestHarness.h"
 #include "CppUTestExt/MockSupport.h"
 
+#include <model_cache.h>
 #include <admin_model.h>
 #include <admin_data.h>
 #include <generate_pdf.h>
@@ -40,6 +41,7 @@ TEST_GROUP(admin_model_test)
         model::admin admin_model{db_file, db_password};
 	void setup()
 	{
+		model::cache::instance().clear();
 	}
 
 	void teardown()
@@ -22,6 +22,7 @@
 
 
 #include <client_data.h>
+#include <model_cache.h>
 #include <client_model.h>
 #include <generate_pdf.h>
 
@@ -42,6 +43,7 @@ TEST_GROUP(client_model_test)
         model::client client_model{db_file, db_password};
 	void setup()
 	{
+		model::cache::instance().clear();
 	}
 
 	void teardown()
@@ -0,0 +1,264 @@
+/*******************************************************************************
+ * @file export_model_test.cpp
+ *
+ * @brief Unit tests for the export writers and the model::exporter class.
+ *
+ * @details
+ * This test suite verifies the CSV and JSON Lines export:
+ *
+ *   • Quoting CSV fields and escaping JSON text, NULL and numbers.
+ *   • Rejecting a row that does not match the header.
+ *   • Exporting a client's invoices, labor lines and statements, with as
+ *     many rows as the tables hold.
+ *   • Narrowing the export to a date range, and rejecting an invalid date or
+ *     an unknown client.
+ *   • Splitting the export into one file per client, named by business id
+ *     so clients whose names sanitize alike do not overwrite each other.
+ *
+ * Exported row counts are checked against counts of the same rows selected
+ * from the tables; the split export writes to a temporary directory that
+ * the test removes.
+ *******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <generate_pdf.h>
+#include <model_cache.h>
+#include <admin_model.h>
+#include <client_model.h>
+#include <export_model.h>
+#include <invoice_model.h>
+#include <client_serialize.h>
+#include <business_serialize.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Quote the CSV fields that need it. (Done)
+ * 2) Escape JSON text and write NULL and numbers unquoted. (Done)
+ * 3) Reject a row that does not match the header. (Done)
+ * 4) Export a client's invoices, labor and statements. (Done)
+ * 5) Export nothing outside the date range. (Done)
+ * 6) Reject an invalid date and an unknown client. (Done)
+ * 7) Split the export into one file per client. (Done)
+ * 8) Keep the files of clients whose names collide apart. (Done)
+ ******************************************************************************/
+TEST_GROUP(export_writer_test)
+{
+	static constexpr const char* columns[]{"id", "text", "amount", "none"};
+	const storage::database::part::row row{
+		sqlite3_int64{7}, std::string{"Pipe, 2\" \"elbow\"\nfitted"}, 12.5, nullptr
+	};
+};
+
+TEST(export_writer_test, quote_the_csv_fields_that_need_it)
+{
+	std::ostringstream output{};
+	model::csv_writer writer{output};
+
+	CHECK_EQUAL(true, writer.begin(columns));
+	CHECK_EQUAL(true, writer.write(row));
+	CHECK_EQUAL(true, writer.finish());
+	STRCMP_EQUAL("id,text,amount,none\n7,\"Pipe, 2\"\" \"\"elbow\"\"\nfitted\",12.5,\n", output.str().c_str());
+}
+
+TEST(export_writer_test, escape_json_text_and_write_null_and_numbers_unquoted)
+{
+	std::ostringstream output{};
+	model::jsonl_writer writer{output};
+
+	CHECK_EQUAL(true, writer.begin(columns));
+	CHECK_EQUAL(true, writer.write(row));
+	CHECK_EQUAL(true, writer.finish());
+	STRCMP_EQUAL("{\"id\":7,\"text\":\"Pipe, 2\\\" \\\"elbow\\\"\\nfitted\",\"amount\":12.5,\"none\":null}\n",
+		     output.str().c_str());
+}
+
+TEST(export_writer_test, reject_a_row_that_does_not_match_the_header)
+{
+	std::ostringstream output{};
+	model::csv_writer csv{output};
+	model::jsonl_writer jsonl{output};
+	const storage::database::part::row narrow{sqlite3_int64{7}};
+
+	CHECK_EQUAL(false, csv.write(row));
+	CHECK_EQUAL(true, csv.begin(columns));
+	CHECK_EQUAL(false, csv.write(narrow));
+	CHECK_EQUAL(true, jsonl.begin(columns));
+	CHECK_EQUAL(false, jsonl.write(narrow));
+}
+
+
+TEST_GROUP(export_model_test)
+{
+	const std::string db_file{"../storage/tests/model_test.db"};
+	const std::string db_password{"123456789"};
+	const std::string client_name{"Client admin"};
+	model::exporter exporter{db_file, db_password};
+	void setup()
+	{
+		model::cache::instance().clear();
+		model::admin admin_model{db_file, db_password};
+		model::client client_model{db_file, db_password};
+		model::invoice invoice_model{db_file, db_password};
+		(void)admin_model.save(test::generate_business_data());
+		(void)client_model.save(test::generate_client_data());
+		(void)invoice_model.save(test::generate_invoice_data("export, \"milling\""));
+	}
+
+	void teardown()
+	{
+		model::cache::instance().clear();
+	}
+
+	std::size_t count(const std::string& _query)
+	{
+		storage::database::sqlite database{db_file, db_password};
+		storage::database::part::rows rows{database.select(_query, {client_name})};
+		return rows.empty() ? 0 : static_cast<std::size_t> (std::get<sqlite3_int64>(rows.front()[0]));
+	}
+
+	sqlite3_int64 business_id(const std::string& _business_name)
+	{
+		storage::database::sqlite database{db_file, db_password};
+		storage::database::part::rows rows{database.select("SELECT business_id FROM business_details "
+								   "WHERE business_name = ?;", {_business_name})};
+		return rows.empty() ? 0 : std::get<sqlite3_int64>(rows.front()[0]);
+	}
+
+	void save_client(const std::string& _business_name, const std::string& _email, const std::string& _vat_number)
+	{
+		storage::database::sqlite database{db_file, db_password};
+		data::client client_data{test::generate_client_data()};
+		(void)database.usert(sql::query::business_details_usert, storage::database::sql_parameters{
+			_business_name, client_data.get_address(), client_data.get_area_code(),
+			client_data.get_town(), client_data.get_cellphone(), _email});
+		(void)database.usert(sql::query::client_usert, storage::database::sql_parameters{
+			_business_name, _vat_number, client_data.get_statement_schedule()});
+	}
+
+	std::size_t lines(std::istream& _input)
+	{
+		std::size_t total{0};
+		for (std::string line{}; std::getline(_input, line);)
+		{
+			++total;
+		}
+
+		return total;
+	}
+};
+
+TEST(export_model_test, export_a_clients_invoices_labor_and_statements)
+{
+	const model::export_filter filter{.clients = {client_name}};
+	const std::size_t invoices{count("SELECT count(*) FROM invoice i JOIN business_details b USING (business_id) "
+					 "WHERE b.business_name = ?;")};
+	const std::size_t labor{count("SELECT count(*) FROM labor l JOIN invoice i USING (invoice_id) "
+				      "JOIN business_details b ON b.business_id = i.business_id WHERE b.business_name = ?;")};
+	const std::size_t statements{count("SELECT count(*) FROM statement s JOIN business_details b USING (business_id) "
+					   "WHERE b.business_name = ?;")};
+	std::ostringstream csv{};
+	std::ostringstream jsonl{};
+	std::ostringstream statement_csv{};
+	std::size_t invoice_rows{0};
+	std::size_t labor_rows{0};
+	std::size_t statement_rows{0};
+
+	CHECK_EQUAL(true, exporter.is_available());
+	CHECK_EQUAL(true, exporter.write(csv, model::export_kind::invoices, model::export_format::csv, filter, invoice_rows));
+	CHECK_EQUAL(true, exporter.write(jsonl, model::export_kind::labor, model::export_format::jsonl, filter, labor_rows));
+	CHECK_EQUAL(true, exporter.write(statement_csv, model::export_kind::statements, model::export_format::csv,
+					 filter, statement_rows));
+	CHECK_TRUE(invoice_rows > 0);
+	CHECK_EQUAL(invoices, invoice_rows);
+	CHECK_EQUAL(labor, labor_rows);
+	CHECK_EQUAL(statements, statement_rows);
+	CHECK_EQUAL(0, csv.str().rfind("invoice_id,business_name,statement_id,", 0));
+	CHECK_TRUE(jsonl.str().find("\"business_name\":\"Client admin\"") != std::string::npos);
+	CHECK_TRUE(jsonl.str().find("\"description\":\"export, \\\"milling\\\"\"") != std::string::npos);
+	std::istringstream input{jsonl.str()};
+	CHECK_EQUAL(labor_rows, lines(input));
+}
+
+TEST(export_model_test, export_nothing_outside_the_date_range)
+{
+	const model::export_filter filter{.from = "1999-01-01", .to = "1999-12-31", .clients = {client_name}};
+	std::ostringstream output{};
+	std::size_t rows{0};
+
+	CHECK_EQUAL(true, exporter.write(output, model::export_kind::invoices, model::export_format::csv, filter, rows));
+	CHECK_EQUAL(0, rows);
+	std::istringstream input{output.str()};
+	CHECK_EQUAL(1, lines(input));
+
+	CHECK_EQUAL(true, exporter.write(output, model::export_kind::statements, model::export_format::jsonl, filter, rows));
+	CHECK_EQUAL(0, rows);
+}
+
+TEST(export_model_test, reject_an_invalid_date_and_an_unknown_client)
+{
+	std::ostringstream output{};
+	std::size_t rows{0};
+
+	CHECK_EQUAL(false, exporter.write(output, model::export_kind::invoices, model::export_format::csv,
+					  model::export_filter{.from = "01-01-2025"}, rows));
+	CHECK_EQUAL(false, exporter.write(output, model::export_kind::invoices, model::export_format::csv,
+					  model::export_filter{.clients = {"No such client"}}, rows));
+	CHECK_EQUAL(0, rows);
+}
+
+TEST(export_model_test, split_the_export_into_one_file_per_client)
+{
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / "mint-bill-export-test"};
+	std::filesystem::remove_all(directory);
+	const std::size_t clients{count("SELECT count(*) FROM client WHERE ? IS NOT NULL;")};
+	std::ostringstream output{};
+	std::size_t split_rows{0};
+	std::size_t rows{0};
+
+	CHECK_EQUAL(true, exporter.write_split(directory, model::export_kind::invoices, model::export_format::csv,
+					       model::export_filter{}, 4, split_rows));
+	CHECK_EQUAL(true, exporter.write(output, model::export_kind::invoices, model::export_format::csv,
+					 model::export_filter{}, rows));
+	CHECK_EQUAL(rows, split_rows);
+	CHECK_EQUAL(clients, static_cast<std::size_t> (std::distance(std::filesystem::directory_iterator{directory},
+								     std::filesystem::directory_iterator{})));
+	std::ifstream file{directory / model::exporter::file_name(business_id(client_name), client_name,
+								  model::export_kind::invoices, model::export_format::csv)};
+	CHECK_EQUAL(true, file.is_open());
+	STRCMP_EQUAL((std::to_string(business_id(client_name)) + "-Client_admin.invoices.csv").c_str(),
+		     model::exporter::file_name(business_id(client_name), client_name, model::export_kind::invoices,
+						model::export_format::csv).c_str());
+	std::filesystem::remove_all(directory);
+}
+
+TEST(export_model_test, keep_the_files_of_clients_whose_names_collide_apart)
+{
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / "mint-bill-export-collide-test"};
+	std::filesystem::remove_all(directory);
+	save_client("A&B Works", "a-and-b@example.com", "4000000000001");
+	save_client("A/B Works", "a-slash-b@example.com", "4000000000002");
+	const std::string and_file{model::exporter::file_name(business_id("A&B Works"), "A&B Works",
+							      model::export_kind::invoices, model::export_format::csv)};
+	const std::string slash_file{model::exporter::file_name(business_id("A/B Works"), "A/B Works",
+								model::export_kind::invoices, model::export_format::csv)};
+	const std::size_t clients{count("SELECT count(*) FROM client WHERE ? IS NOT NULL;")};
+	std::size_t rows{0};
+
+	CHECK_EQUAL(true, and_file != slash_file);
+	CHECK_EQUAL(true, exporter.write_split(directory, model::export_kind::invoices, model::export_format::csv,
+					       model::export_filter{}, 2, rows));
+	CHECK_EQUAL(clients, static_cast<std::size_t> (std::distance(std::filesystem::directory_iterator{directory},
+								     std::filesystem::directory_iterator{})));
+	CHECK_EQUAL(true, std::filesystem::exists(directory / and_file));
+	CHECK_EQUAL(true, std::filesystem::exists(directory / slash_file));
+	std::filesystem::remove_all(directory);
+}
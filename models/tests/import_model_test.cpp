@@ -0,0 +1,283 @@
+/*******************************************************************************
+ * @file import_model_test.cpp
+ *
+ * @brief Unit tests for the import readers and the model::importer class.
+ *
+ * @details
+ * This test suite verifies the CSV and JSON Lines import:
+ *
+ *   • Reading quoted, multi-line CSV fields by header name, with line
+ *     numbers, and flagging a record of the wrong width.
+ *   • Unescaping JSON text and reading null and numbers.
+ *   • Importing invoices and labor lines, linked to their statement, with
+ *     the statement totals and search index kept.
+ *   • Rejecting rows with their file and line, and importing the rest.
+ *   • Importing with the indexes deferred and rebuilding them.
+ *   • Rolling back an import that fails halfway, so it can be run again.
+ *
+ * The imported invoices use ids from 900000 up, and the fixture deletes them
+ * and their labor lines around each test.
+ *******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <sstream>
+#include <generate_pdf.h>
+#include <model_cache.h>
+#include <admin_model.h>
+#include <client_model.h>
+#include <import_model.h>
+#include <totals_model.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Read quoted CSV fields by header name. (Done)
+ * 2) Flag a CSV record of the wrong width and read on. (Done)
+ * 3) Unescape JSON text and read null and numbers. (Done)
+ * 4) Import invoices and labor lines. (Done)
+ * 5) Reject rows with their file and line. (Done)
+ * 6) Import with the indexes deferred. (Done)
+ * 7) Roll back an import that fails halfway. (Done)
+ ******************************************************************************/
+TEST_GROUP(import_reader_test)
+{
+	static constexpr const char* columns[]{"id", "text", "extra"};
+};
+
+TEST(import_reader_test, read_quoted_csv_fields_by_header_name)
+{
+	std::istringstream input{"\xEF\xBB\xBFtext,unused,id\r\n\"Pipe, 2\"\" \"\"elbow\"\"\r\nfitted\",x,7\r\nplain,y,8\n"};
+	model::csv_reader reader{input};
+	std::vector<std::string> fields{};
+
+	CHECK_EQUAL(true, reader.begin(columns, 2));
+	CHECK_EQUAL(true, reader.read(fields));
+	CHECK_EQUAL(2, reader.line());
+	STRCMP_EQUAL("7", fields[0].c_str());
+	STRCMP_EQUAL("Pipe, 2\" \"elbow\"\r\nfitted", fields[1].c_str());
+	STRCMP_EQUAL("", fields[2].c_str());
+	CHECK_EQUAL(true, reader.read(fields));
+	CHECK_EQUAL(4, reader.line());
+	STRCMP_EQUAL("plain", fields[1].c_str());
+	CHECK_EQUAL(false, reader.read(fields));
+	CHECK_EQUAL(true, reader.error().empty());
+}
+
+TEST(import_reader_test, flag_a_csv_record_of_the_wrong_width_and_read_on)
+{
+	std::istringstream input{"id,text\n1\n\n2,two\n"};
+	std::istringstream headless{"id,other\n"};
+	model::csv_reader reader{input};
+	model::csv_reader without{headless};
+	std::vector<std::string> fields{};
+
+	CHECK_EQUAL(false, without.begin(columns, 2));
+	CHECK_EQUAL(false, without.error().empty());
+	CHECK_EQUAL(true, reader.begin(columns, 2));
+	CHECK_EQUAL(true, reader.read(fields));
+	CHECK_EQUAL(false, reader.error().empty());
+	CHECK_EQUAL(true, reader.read(fields));
+	CHECK_EQUAL(true, reader.error().empty());
+	CHECK_EQUAL(4, reader.line());
+	STRCMP_EQUAL("two", fields[1].c_str());
+}
+
+TEST(import_reader_test, unescape_json_text_and_read_null_and_numbers)
+{
+	std::istringstream input{
+		"{\"id\":7,\"text\":\"caf\\u00e9 \\\"tab\\\"\\t\\ud83d\\ude00\",\"extra\":null,\"other\":true}\n"
+		"\n"
+		"[1,2]\n"
+		"{ \"text\" : \"\" , \"id\" : -1.5e3 }\n"};
+	model::jsonl_reader reader{input};
+	std::vector<std::string> fields{};
+
+	CHECK_EQUAL(true, reader.begin(columns, 2));
+	CHECK_EQUAL(true, reader.read(fields));
+	CHECK_EQUAL(true, reader.error().empty());
+	STRCMP_EQUAL("7", fields[0].c_str());
+	STRCMP_EQUAL("caf\xC3\xA9 \"tab\"\t\xF0\x9F\x98\x80", fields[1].c_str());
+	STRCMP_EQUAL("", fields[2].c_str());
+	CHECK_EQUAL(true, reader.read(fields));
+	CHECK_EQUAL(3, reader.line());
+	CHECK_EQUAL(false, reader.error().empty());
+	CHECK_EQUAL(true, reader.read(fields));
+	CHECK_EQUAL(true, reader.error().empty());
+	STRCMP_EQUAL("-1.5e3", fields[0].c_str());
+	CHECK_EQUAL(false, reader.read(fields));
+}
+
+
+TEST_GROUP(import_model_test)
+{
+	const std::string db_file{"../storage/tests/model_test.db"};
+	const std::string db_password{"123456789"};
+	const std::string invoice_header{
+		"invoice_id,business_name,order_number,job_card_number,date_created,paid_status,"
+		"material_total,description_total,grand_total,period_start,period_end\n"};
+	const std::string labor_header{"invoice_id,line_number,is_description,quantity,description,amount\n"};
+	model::importer importer{db_file, db_password};
+	void setup()
+	{
+		model::cache::instance().clear();
+		model::admin admin_model{db_file, db_password};
+		model::client client_model{db_file, db_password};
+		(void)admin_model.save(test::generate_business_data());
+		(void)client_model.save(test::generate_client_data());
+		remove();
+	}
+
+	void teardown()
+	{
+		remove();
+		model::cache::instance().clear();
+	}
+
+	void remove()
+	{
+		storage::database::sqlite database{db_file, db_password};
+		(void)database.transaction("DELETE FROM labor WHERE invoice_id >= 900000;");
+		(void)database.transaction("DELETE FROM invoice WHERE invoice_id >= 900000;");
+	}
+
+	long long count(const std::string& _query)
+	{
+		storage::database::sqlite database{db_file, db_password};
+		storage::database::part::rows rows{database.select(_query, {900000LL})};
+		return rows.empty() ? -1 : std::get<sqlite3_int64>(rows.front()[0]);
+	}
+};
+
+TEST(import_model_test, import_invoices_and_labor_lines)
+{
+	std::istringstream invoices{invoice_header +
+		"900001,Client admin,IMP-1,JC-1,2019-03-05,Paid,10.00,20.00,30.00,Mar-1-2019,Mar-31-2019\n"
+		"900002,Client admin,IMP-2,JC-2,3-9-2019,Not Paid,1.00,2.00,3.00,,\n"};
+	std::istringstream labor{labor_header +
+		"900001,0,1,2,\"Turn shaft, 40 mm\",10.5\n"
+		"900001,0,0,1,\"Bearing \"\"6204\"\"\nsealed\",19.5\n"
+		"900002,0,1,1,Weld,3\n"};
+	model::import_report report{};
+	model::totals totals_model{db_file, db_password};
+
+	CHECK_EQUAL(true, importer.is_available());
+	CHECK_EQUAL(true, importer.import(invoices, labor, model::export_format::csv, model::import_options{}, report));
+	CHECK_EQUAL(true, report.errors.empty());
+	CHECK_EQUAL(2, report.invoices);
+	CHECK_EQUAL(3, report.labor);
+	CHECK_EQUAL(2, count("SELECT count(*) FROM invoice WHERE invoice_id >= ?;"));
+	CHECK_EQUAL(3, count("SELECT count(*) FROM labor WHERE invoice_id >= ?;"));
+	CHECK_EQUAL(1, count("SELECT count(*) FROM invoice i JOIN statement s USING (statement_id) "
+			     "WHERE i.invoice_id >= ? AND s.period_start = 'Mar-1-2019';"));
+	CHECK_EQUAL(1, count("SELECT count(*) FROM labor WHERE invoice_id >= ? AND description = 'Bearing \"6204\"\nsealed';"));
+	CHECK_EQUAL(3, count("SELECT count(*) FROM labor_search WHERE invoice_id >= ?;"));
+	CHECK_EQUAL(2, count("SELECT count(*) FROM invoice_search WHERE invoice_search MATCH 'IMP' AND rowid >= ?;"));
+	CHECK_EQUAL(9, count("SELECT count(*) FROM sqlite_master WHERE ? > 0 AND type = 'trigger' AND name LIKE '%_search_%';"));
+	CHECK_EQUAL(true, totals_model.verify().empty());
+}
+
+TEST(import_model_test, reject_rows_with_their_file_and_line)
+{
+	std::istringstream invoices{invoice_header +
+		"900011,Client admin,IMP-11,JC-11,2019-04-01,Paid,1.00,2.00,3.00,,\n"
+		"900012,Client admin,,JC-12,2019-04-01,Paid,1.00,2.00,3.00,,\n"
+		"900013,No such client,IMP-13,JC-13,2019-04-01,Paid,1.00,2.00,3.00,,\n"
+		"900011,Client admin,IMP-14,JC-14,2019-04-01,Paid,1.00,2.00,3.00,,\n"};
+	std::istringstream labor{labor_header +
+		"900011,0,1,1,Mill,2.5\n"
+		"900012,0,1,1,Mill,2.5\n"
+		"900011,1,2,1,Mill,2.5\n"
+		"900011,0,1,1,Again,1\n"};
+	model::import_report report{};
+
+	CHECK_EQUAL(true, importer.import(invoices, labor, model::export_format::csv, model::import_options{}, report));
+	CHECK_EQUAL(1, report.invoices);
+	CHECK_EQUAL(1, report.labor);
+	CHECK_EQUAL(6, report.errors.size());
+	STRCMP_EQUAL("invoices", report.errors[0].file.c_str());
+	CHECK_EQUAL(3, report.errors[0].line);
+	STRCMP_EQUAL("invalid order_number", report.errors[0].message.c_str());
+	CHECK_EQUAL(4, report.errors[1].line);
+	CHECK_EQUAL(5, report.errors[2].line);
+	STRCMP_EQUAL("labor", report.errors[3].file.c_str());
+	CHECK_EQUAL(3, report.errors[3].line);
+	CHECK_EQUAL(4, report.errors[4].line);
+	CHECK_EQUAL(5, report.errors[5].line);
+	CHECK_EQUAL(1, count("SELECT count(*) FROM invoice WHERE invoice_id >= ?;"));
+}
+
+TEST(import_model_test, import_with_the_indexes_deferred)
+{
+	std::ostringstream invoice_rows{};
+	std::ostringstream labor_rows{};
+	invoice_rows << invoice_header;
+	labor_rows << labor_header;
+	for (int invoice{0}; invoice < 50; ++invoice)
+	{
+		invoice_rows << 900100 + invoice << ",Client admin,IMP-D" << invoice << ",JC-D" << invoice
+			     << ",2019-05-01,Not Paid,1.00,2.00,3.00,May-1-2019,May-31-2019\n";
+		for (int line{0}; line < 10; ++line)
+		{
+			labor_rows << 900100 + invoice << "," << line << "," << (line % 2) << ",1,Turning," << line << ".25\n";
+		}
+	}
+	std::istringstream invoices{invoice_rows.str()};
+	std::istringstream labor{labor_rows.str()};
+	model::import_report report{};
+	model::totals totals_model{db_file, db_password};
+
+	CHECK_EQUAL(true, importer.import(invoices, labor, model::export_format::csv,
+					  model::import_options{.defer_indexes = true}, report));
+	CHECK_EQUAL(true, report.errors.empty());
+	CHECK_EQUAL(50, report.invoices);
+	CHECK_EQUAL(500, report.labor);
+	CHECK_EQUAL(4, count("SELECT count(*) FROM sqlite_master WHERE ? > 0 AND name IN ('invoice_business_page_idx', "
+			     "'invoice_statement_idx', 'invoice_period_idx', 'invoice_unpaid_idx');"));
+	CHECK_EQUAL(3, count("SELECT count(*) FROM sqlite_master WHERE ? > 0 AND type = 'trigger' "
+			     "AND name LIKE 'statement_totals_%';"));
+	CHECK_EQUAL(true, totals_model.verify().empty());
+}
+
+TEST(import_model_test, roll_back_an_import_that_fails_halfway)
+{
+	std::ostringstream invoice_rows{};
+	std::ostringstream labor_rows{};
+	invoice_rows << invoice_header;
+	labor_rows << labor_header;
+	for (int invoice{0}; invoice < 10; ++invoice)
+	{
+		invoice_rows << 900200 + invoice << ",Client admin,IMP-H" << invoice << ",JC-H" << invoice
+			     << ",2019-06-01,Not Paid,1.00,2.00,3.00,Jun-1-2019,Jun-30-2019\n";
+		labor_rows << 900200 + invoice << ",0,1,1,Boring,1.5\n";
+	}
+	const std::string valid_labor{labor_rows.str()};
+	for (std::size_t line{0}; line <= app::config::import_error_limit; ++line)
+	{
+		labor_rows << "800000," << line << ",1,1,Orphan,1\n";
+	}
+	std::istringstream invoices{invoice_rows.str()};
+	std::istringstream labor{labor_rows.str()};
+	std::istringstream again{invoice_rows.str()};
+	std::istringstream valid{valid_labor};
+	model::import_report failed{};
+	model::import_report report{};
+	const long long statements{count("SELECT count(*) FROM statement WHERE ? > 0;")};
+
+	CHECK_EQUAL(false, importer.import(invoices, labor, model::export_format::csv, model::import_options{}, failed));
+	CHECK_EQUAL(10, failed.invoices);
+	CHECK_EQUAL(10, failed.labor);
+	CHECK_EQUAL(0, count("SELECT count(*) FROM invoice WHERE invoice_id >= ?;"));
+	CHECK_EQUAL(0, count("SELECT count(*) FROM labor WHERE invoice_id >= ?;"));
+	CHECK_EQUAL(0, count("SELECT count(*) FROM invoice_search WHERE invoice_search MATCH 'IMP' AND rowid >= ?;"));
+	CHECK_EQUAL(statements, count("SELECT count(*) FROM statement WHERE ? > 0;"));
+	CHECK_EQUAL(9, count("SELECT count(*) FROM sqlite_master WHERE ? > 0 AND type = 'trigger' AND name LIKE '%_search_%';"));
+	CHECK_EQUAL(true, importer.import(again, valid, model::export_format::csv, model::import_options{}, report));
+	CHECK_EQUAL(true, report.errors.empty());
+	CHECK_EQUAL(10, count("SELECT count(*) FROM invoice WHERE invoice_id >= ?;"));
+	CHECK_EQUAL(10, count("SELECT count(*) FROM labor WHERE invoice_id >= ?;"));
+}
@@ -9,6 +9,16 @@
  *
  *   • Rejecting invalid invoice data on save.
  *   • Persisting valid invoices, including multiple invoices.
+ *   • Writing only the labor lines that changed on a repeated save, counted
+ *     by logging triggers that their own test group creates in setup() and
+ *     drops in teardown().
+ *   • Saving many invoices in one call, and none of them when one fails.
+ *   • Streaming loaded invoices to one PDF file each in a directory.
+ *   • Writing them with the native PDF backend when MINTBILL_PDF_BACKEND
+ *     selects it.
+ *   • Printing a batch with each rendering worker reusing its recorded page
+ *     templates.
+ *   • Handing every cache hit the same loaded invoices instead of a copy.
  *   • Loading invoices by client/business name and reconstructing:
  *       - Business (admin) details
  *       - Client details
@@ -22,8 +32,18 @@
 #include "CppUTestExt/MockSupport.h"
 
 
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <iterator>
+#include <filesystem>
 #include <sqlite.h>
 #include <generate_pdf.h>
+#include <pdf_writer.h>
+#include <metrics.h>
+#include <model_cache.h>
+#include <admin_model.h>
+#include <client_model.h>
 #include <invoice_model.h>
 #include <statement_model.h>
 #include <admin_serialize.h>
@@ -39,6 +59,14 @@ extern "C"
 /**********************************TEST LIST************************************
  * 1) Load the data from a database. (Done)
  * 2) Save the data into a database. (Done)
+ * 3) Prepare loaded invoices for printing through a span. (Done)
+ * 4) Load one keyset page of invoices, newest first. (Done)
+ * 5) Save only the labor lines that changed since the last save. (Done)
+ * 6) Save many invoices in one call, or none of them when one fails. (Done)
+ * 7) Write loaded invoices to PDF files in a directory. (Done)
+ * 8) Write them with the backend the environment selects. (Done)
+ * 9) Reuse the recorded page templates across a print batch. (Done)
+ * 10) Share the cached invoices with every load hit. (Done)
  ******************************************************************************/
 TEST_GROUP(invoice_model_test)
 {
@@ -48,6 +76,7 @@ TEST_GROUP(invoice_model_test)
 	storage::database::sqlite database{db_file, db_password};
 	void setup()
 	{
+		model::cache::instance().clear();
 		data::client client_data{test::generate_client_data()};
 		data::business client_business_data{client_data};
 		data::admin admin_data{test::generate_business_data()};
@@ -117,12 +146,60 @@ TEST(invoice_model_test, save_second_invoice_to_database_successfully)
         CHECK_EQUAL(true, invoice_model.save(invoice_data));
 }
 
-TEST(invoice_model_test, load_data_from_database_unsuccessfully)
+TEST(invoice_model_test, save_many_with_invalid_arguments)
+{
+	std::vector<data::invoice> invoices{data::invoice{}};
+
+        CHECK_EQUAL(false, invoice_model.save_many({}));
+        CHECK_EQUAL(false, invoice_model.save_many(invoices));
+}
+
+TEST(invoice_model_test, save_many_invoices_in_one_call)
+{
+	std::vector<data::invoice> invoices{};
+	for (int id = 3; id <= 5; ++id)
+	{
+		data::invoice invoice_data{test::generate_invoice_data("invoice model bulk")};
+		invoice_data.set_id(std::to_string(id));
+		invoice_data.set_order_number("bulk order " + std::to_string(id));
+		invoices.push_back(invoice_data);
+	}
+
+        CHECK_EQUAL(true, invoice_model.save_many(invoices));
+	std::vector<data::pdf_invoice> pdf_invoices{
+		*invoice_model.load_page(invoices.front().get_name(), model::page{.limit = 3})};
+	CHECK_EQUAL(3, pdf_invoices.size());
+	CHECK_EQUAL(invoices.back().get_id(), pdf_invoices.front().get_invoice().get_id());
+
+	for (const data::invoice& invoice_data : invoices)
+	{
+		storage::database::sql_parameters params{std::stoll(invoice_data.get_id())};
+		CHECK_EQUAL(true, database.usert("DELETE FROM invoice WHERE invoice_id = ?;", params));
+	}
+}
+
+TEST(invoice_model_test, save_none_of_many_invoices_when_one_fails)
 {
-	for (const std::any pdf_invoice_data : invoice_model.load(""))
+	std::vector<data::invoice> invoices{};
+	for (int id = 1000; id <= 1600; ++id)
 	{
-		data::pdf_invoice data{std::any_cast<data::pdf_invoice> (pdf_invoice_data)};
+		invoices.push_back(test::generate_invoice_data("invoice model bulk"));
+		invoices.back().set_id(std::to_string(id));
+		invoices.back().set_order_number("bulk order " + std::to_string(id));
+	}
+	invoices.back().set_name("Unknown client");
+	storage::database::sql_parameters params{sqlite3_int64{1000}};
 
+        CHECK_EQUAL(true, invoices.back().is_valid());
+        CHECK_EQUAL(false, invoice_model.save_many(invoices));
+	CHECK_EQUAL(true, database.select("SELECT invoice_id FROM invoice WHERE invoice_id >= ?;", params).empty());
+}
+
+TEST(invoice_model_test, load_data_from_database_unsuccessfully)
+{
+	const model::documents<data::pdf_invoice> loaded{invoice_model.load("")};
+	for (const data::pdf_invoice& data : *loaded)
+	{
 		CHECK_EQUAL(false, data.is_valid());
 	}
 }
@@ -130,9 +207,9 @@ TEST(invoice_model_test, load_data_from_database_unsuccessfully)
 TEST(invoice_model_test, load_data_from_database_successfully)
 {
         data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
-	for (const std::any pdf_invoice_data : invoice_model.load(invoice_data.get_name()))
+	const model::documents<data::pdf_invoice> loaded{invoice_model.load(invoice_data.get_name())};
+	for (const data::pdf_invoice& data : *loaded)
 	{
-		data::pdf_invoice data{std::any_cast<data::pdf_invoice> (pdf_invoice_data)};
 		data::admin admin_data{data.get_business()};
 		data::client client_data{data.get_client()};
 		data::invoice invoice_data{data.get_invoice()};
@@ -143,3 +220,214 @@ TEST(invoice_model_test, load_data_from_database_successfully)
 		CHECK_EQUAL(true, data.is_valid());
 	}
 }
+
+TEST(invoice_model_test, prepare_loaded_invoices_for_print)
+{
+        data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	std::vector<data::pdf_invoice> pdf_invoices{*invoice_model.load(invoice_data.get_name())};
+	std::vector<std::string> pdfs{invoice_model.prepare_for_print(pdf_invoices)};
+
+	CHECK_EQUAL(pdf_invoices.size(), pdfs.size());
+	for (const std::string& pdf : pdfs)
+	{
+		CHECK_EQUAL(false, pdf.empty());
+	}
+}
+
+TEST(invoice_model_test, prepare_a_sub_range_for_email)
+{
+        data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	std::vector<data::pdf_invoice> pdf_invoices{*invoice_model.load(invoice_data.get_name())};
+	data::email email_data{invoice_model.prepare_for_email(
+			std::span<const data::pdf_invoice>{pdf_invoices}.first(1))};
+
+	CHECK_EQUAL(1, email_data.get_attachments().size());
+	CHECK_EQUAL("Invoice", email_data.get_subject());
+}
+
+TEST(invoice_model_test, load_page_with_invalid_arguments)
+{
+	CHECK_EQUAL(true, invoice_model.load_page("", model::page{})->empty());
+	CHECK_EQUAL(true, invoice_model.load_page("Client admin", model::page{.before = 0})->empty());
+	CHECK_EQUAL(true, invoice_model.load_page("Client admin", model::page{.limit = 0})->empty());
+}
+
+TEST(invoice_model_test, load_first_page_newest_first)
+{
+        data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	std::vector<data::pdf_invoice> pdf_invoices{
+		*invoice_model.load_page(invoice_data.get_name(), model::page{.limit = 1})};
+
+	CHECK_EQUAL(1, pdf_invoices.size());
+	CHECK_EQUAL(true, pdf_invoices.front().is_valid());
+	CHECK_EQUAL(invoice_data.get_id(), pdf_invoices.front().get_invoice().get_id());
+}
+
+TEST(invoice_model_test, load_page_past_the_oldest_invoice)
+{
+        data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	model::page next{.before = std::stoll(invoice_data.get_id()), .limit = 1};
+	const model::documents<data::pdf_invoice> loaded{invoice_model.load_page(invoice_data.get_name(), next)};
+	for (const data::pdf_invoice& data : *loaded)
+	{
+		CHECK_COMPARE(std::stoll(data.get_invoice().get_id()), <, next.before);
+	}
+}
+
+TEST(invoice_model_test, write_loaded_invoices_to_pdf_files)
+{
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / "mint-bill-invoice-pdfs"};
+	data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	std::vector<data::pdf_invoice> pdf_invoices{*invoice_model.load(invoice_data.get_name())};
+
+	CHECK_EQUAL(false, pdf_invoices.empty());
+	CHECK_EQUAL(true, invoice_model.write_pdfs(pdf_invoices, directory));
+	for (const data::pdf_invoice& pdf_invoice : pdf_invoices)
+	{
+		const std::filesystem::path path{directory / ("invoice-" + pdf_invoice.get_invoice().get_id() + ".pdf")};
+		CHECK_EQUAL(true, std::filesystem::file_size(path) > 0);
+	}
+	std::filesystem::remove_all(directory);
+}
+
+TEST(invoice_model_test, write_pdfs_with_the_backend_the_environment_selects)
+{
+	const std::string native_font{"/BaseFont /Courier /Encoding /WinAnsiEncoding"};
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / "mint-bill-backend-pdfs"};
+	data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	std::vector<data::pdf_invoice> pdf_invoices{*invoice_model.load(invoice_data.get_name())};
+	CHECK_EQUAL(false, pdf_invoices.empty());
+	const std::filesystem::path path{directory / ("invoice-" + pdf_invoices.front().get_invoice().get_id() + ".pdf")};
+	auto contents = [&path] {
+		std::ifstream file{path, std::ios::binary};
+		return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	};
+
+	unsetenv(feature::pdf_backend_variable);
+	CHECK_EQUAL(true, invoice_model.write_pdfs(std::span{pdf_invoices}.first(1), directory));
+	CHECK_EQUAL(std::string::npos, contents().find(native_font));
+
+	setenv(feature::pdf_backend_variable, "native", 1);
+	CHECK_EQUAL(true, invoice_model.write_pdfs(std::span{pdf_invoices}.first(1), directory));
+	unsetenv(feature::pdf_backend_variable);
+	CHECK(contents().find(native_font) != std::string::npos);
+	std::filesystem::remove_all(directory);
+}
+
+TEST(invoice_model_test, reuse_the_recorded_page_templates_across_a_print_batch)
+{
+	utility::metrics::counter& hits{utility::metrics::counter_named("pdf.template_hits")};
+	utility::metrics::counter& misses{utility::metrics::counter_named("pdf.template_misses")};
+	const std::size_t workers{std::max(1u, std::thread::hardware_concurrency())};
+	data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	std::vector<data::pdf_invoice> loaded{*invoice_model.load(invoice_data.get_name())};
+	CHECK_EQUAL(false, loaded.empty());
+	std::vector<data::pdf_invoice> pdf_invoices{};
+	while (pdf_invoices.size() <= 2 * workers)
+	{
+		pdf_invoices.push_back(loaded.front());
+	}
+
+	unsetenv(feature::pdf_backend_variable);
+	const std::uint64_t single_before{misses.value()};
+	CHECK_EQUAL(1, invoice_model.prepare_for_print(std::span{pdf_invoices}.first(1)).size());
+	const std::uint64_t single_misses{misses.value() - single_before};
+	const std::uint64_t hits_before{hits.value()};
+	const std::uint64_t misses_before{misses.value()};
+	std::vector<std::string> pdfs{invoice_model.prepare_for_print(pdf_invoices)};
+
+	CHECK_EQUAL(pdf_invoices.size(), pdfs.size());
+	CHECK_COMPARE(hits.value() - hits_before, >, 0);
+	CHECK_COMPARE(misses.value() - misses_before, <=, workers * single_misses);
+}
+
+TEST(invoice_model_test, share_the_cached_invoices_with_every_load_hit)
+{
+	data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	const model::documents<data::pdf_invoice> first{invoice_model.load(invoice_data.get_name())};
+	const model::documents<data::pdf_invoice> second{invoice_model.load(invoice_data.get_name())};
+
+	CHECK_EQUAL(false, first->empty());
+	CHECK_EQUAL(first.get(), second.get());
+}
+
+
+TEST_GROUP(invoice_labor_write_test)
+{
+	const std::string db_file{"../storage/tests/model_test.db"};
+	const std::string db_password{"123456789"};
+	model::invoice invoice_model{db_file, db_password};
+	storage::database::sqlite database{db_file, db_password};
+	void setup()
+	{
+		model::cache::instance().clear();
+		model::admin admin_model{db_file, db_password};
+		model::client client_model{db_file, db_password};
+		(void)admin_model.save(test::generate_business_data());
+		(void)client_model.save(test::generate_client_data());
+		CHECK_EQUAL(true, invoice_model.save(test::generate_invoice_data("invoice model machining")));
+		CHECK_EQUAL(true, database.transaction("CREATE TABLE IF NOT EXISTS labor_write_log (kind TEXT, "
+							"line_number INTEGER, is_description INTEGER);"));
+		for (const std::string kind : {"INSERT", "UPDATE", "DELETE"})
+		{
+			const std::string row{kind == "DELETE" ? "OLD" : "NEW"};
+			CHECK_EQUAL(true, database.transaction("CREATE TRIGGER IF NOT EXISTS labor_write_log_" + kind +
+								" AFTER " + kind + " ON labor BEGIN INSERT INTO labor_write_log "
+								"VALUES ('" + kind + "', " + row + ".line_number, " + row +
+								".is_description); END;"));
+		}
+	}
+
+	void teardown()
+	{
+		for (const std::string kind : {"INSERT", "UPDATE", "DELETE"})
+		{
+			(void)database.transaction("DROP TRIGGER IF EXISTS labor_write_log_" + kind + ";");
+		}
+		(void)database.transaction("DROP TABLE IF EXISTS labor_write_log;");
+		(void)invoice_model.save(test::generate_invoice_data("invoice model machining"));
+		model::cache::instance().clear();
+	}
+};
+
+TEST(invoice_labor_write_test, save_only_the_changed_labor_lines)
+{
+        data::invoice invoice_data{test::generate_invoice_data("invoice model machining")};
+	std::vector<data::column> descriptions{};
+	std::vector<data::column> materials{};
+	for (const data::column& column_data : invoice_data.get_description_column())
+	{
+		(column_data.get_is_description() == 1 ? descriptions : materials).push_back(column_data);
+	}
+	const data::column removed{materials.back()};
+	materials.pop_back();
+	descriptions.front().set_amount(42.0);
+	invoice_data.set_description_column(descriptions);
+	invoice_data.set_material_column(materials);
+
+        CHECK_EQUAL(true, invoice_model.save(invoice_data));
+	storage::database::part::rows writes{database.select("SELECT kind, line_number, is_description FROM labor_write_log "
+						   "ORDER BY kind;")};
+
+	CHECK_EQUAL(2, writes.size());
+	CHECK_EQUAL("DELETE", std::get<std::string>(writes[0][0]));
+	CHECK_EQUAL(removed.get_row_number(), std::get<sqlite3_int64>(writes[0][1]));
+	CHECK_EQUAL(0, std::get<sqlite3_int64>(writes[0][2]));
+	CHECK_EQUAL("UPDATE", std::get<std::string>(writes[1][0]));
+	CHECK_EQUAL(descriptions.front().get_row_number(), std::get<sqlite3_int64>(writes[1][1]));
+	CHECK_EQUAL(1, std::get<sqlite3_int64>(writes[1][2]));
+
+	serialize::labor labor_serialize{};
+	storage::database::sql_parameters params{std::stoll(invoice_data.get_id())};
+	std::vector<data::column> stored{
+		labor_serialize.extract_data(database.select(sql::query::labor_snapshot_select, params))};
+	CHECK_EQUAL(descriptions.size() + materials.size(), stored.size());
+	for (const data::column& column_data : stored)
+	{
+		if (column_data.get_row_number() == descriptions.front().get_row_number() &&
+		    column_data.get_is_description() == 1)
+		{
+			DOUBLES_EQUAL(42.0, column_data.get_amount(), 0.001);
+		}
+	}
+}
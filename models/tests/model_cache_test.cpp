@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * @file model_cache_test.cpp
+ *
+ * @brief Unit tests for the process-wide model::cache.
+ *
+ * @details
+ * Covers the read-through cache used by the models:
+ *
+ *   • Misses and hits are counted, and a hit returns the stored value.
+ *   • Invalidating a business and entity drops every cached page of it and
+ *     nothing else.
+ *   • The least recently used entry is evicted once the budget is exceeded.
+ *   • A model load is served from the cache until a save invalidates it.
+ *   • A hit shares the stored value instead of copying it, and a reader
+ *     keeps it after it is evicted.
+ *******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <generate_pdf.h>
+#include <model_cache.h>
+#include <client_model.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Count a miss, then a hit for a stored value. (Done)
+ * 2) Invalidate every page of one business and entity. (Done)
+ * 3) Evict the least recently used entry over budget. (Done)
+ * 4) Serve a model load from the cache until a save. (Done)
+ * 5) Share the stored value with every hit. (Done)
+ ******************************************************************************/
+TEST_GROUP(model_cache_test)
+{
+	const std::string db_file{"../storage/tests/model_test.db"};
+	const std::string db_password{"123456789"};
+	model::cache& cache{model::cache::instance()};
+	void setup()
+	{
+		cache.clear();
+		cache.set_budget(app::config::model_cache_budget);
+	}
+
+	void teardown()
+	{
+		cache.clear();
+		cache.set_budget(app::config::model_cache_budget);
+	}
+};
+
+TEST(model_cache_test, miss_then_hit)
+{
+	data::client client_data{test::generate_client_data()};
+	model::cache_statistics before{cache.statistics()};
+
+	CHECK_EQUAL(true, cache.find<data::client>(db_file, model::entity::client, client_data.get_name()) == nullptr);
+	cache.store(db_file, model::entity::client, client_data.get_name(), "",
+		    std::make_shared<const data::client>(client_data), model::footprint(client_data));
+	std::shared_ptr<const data::client> cached{
+		cache.find<data::client>(db_file, model::entity::client, client_data.get_name())};
+
+	CHECK_EQUAL(true, cached != nullptr);
+	CHECK_EQUAL(client_data.get_vat_number(), cached->get_vat_number());
+	CHECK_EQUAL(before.misses + 1, cache.statistics().misses);
+	CHECK_EQUAL(before.hits + 1, cache.statistics().hits);
+	CHECK_EQUAL(1, cache.statistics().entries);
+}
+
+TEST(model_cache_test, invalidate_every_page_of_one_business)
+{
+	std::shared_ptr<const std::vector<data::pdf_statement>> statements{
+		std::make_shared<const std::vector<data::pdf_statement>>()};
+	std::shared_ptr<const data::client> client_data{std::make_shared<const data::client>()};
+	cache.store(db_file, model::entity::statements, "Client admin", "", statements, 1);
+	cache.store(db_file, model::entity::statements, "Client admin", model::page_detail(model::page{}), statements, 1);
+	cache.store(db_file, model::entity::statements, "Client admine", "", statements, 1);
+	cache.store(db_file, model::entity::client, "Client admin", "", client_data, 1);
+
+	cache.invalidate(db_file, model::entity::statements, "Client admin");
+
+	CHECK_EQUAL(2, cache.statistics().entries);
+	CHECK_EQUAL(2, cache.statistics().bytes);
+	CHECK_EQUAL(true, cache.find<std::vector<data::pdf_statement>>(
+				db_file, model::entity::statements, "Client admine") != nullptr);
+}
+
+TEST(model_cache_test, evict_the_least_recently_used)
+{
+	model::cache_statistics before{cache.statistics()};
+	std::shared_ptr<const data::client> client_data{std::make_shared<const data::client>()};
+	cache.set_budget(2);
+	cache.store(db_file, model::entity::client, "first", "", client_data, 1);
+	cache.store(db_file, model::entity::client, "second", "", client_data, 1);
+	(void)cache.find<data::client>(db_file, model::entity::client, "first");
+	cache.store(db_file, model::entity::client, "third", "", client_data, 1);
+
+	CHECK_EQUAL(2, cache.statistics().entries);
+	CHECK_EQUAL(before.evictions + 1, cache.statistics().evictions);
+	CHECK_EQUAL(true, cache.find<data::client>(db_file, model::entity::client, "first") != nullptr);
+	CHECK_EQUAL(true, cache.find<data::client>(db_file, model::entity::client, "second") == nullptr);
+}
+
+TEST(model_cache_test, serve_a_model_load_until_a_save)
+{
+	data::client client_data{test::generate_client_data()};
+	model::client client_model{db_file, db_password};
+
+	CHECK_EQUAL(true, client_model.save(client_data));
+	(void)client_model.load(client_data.get_name());
+	model::cache_statistics loaded{cache.statistics()};
+	(void)client_model.load(client_data.get_name());
+	CHECK_EQUAL(loaded.hits + 1, cache.statistics().hits);
+
+	CHECK_EQUAL(true, client_model.save(client_data));
+	(void)client_model.load(client_data.get_name());
+	CHECK_EQUAL(loaded.misses + 1, cache.statistics().misses);
+}
+
+TEST(model_cache_test, share_the_stored_value_with_every_hit)
+{
+	data::client client_data{test::generate_client_data()};
+	cache.set_budget(1);
+	cache.store(db_file, model::entity::client, client_data.get_name(), "",
+		    std::make_shared<const data::client>(client_data), 1);
+
+	std::shared_ptr<const data::client> first{
+		cache.find<data::client>(db_file, model::entity::client, client_data.get_name())};
+	std::shared_ptr<const data::client> second{
+		cache.find<data::client>(db_file, model::entity::client, client_data.get_name())};
+	cache.store(db_file, model::entity::client, "other", "", std::make_shared<const data::client>(), 1);
+
+	CHECK_EQUAL(true, first != nullptr);
+	CHECK_EQUAL(first.get(), second.get());
+	CHECK_EQUAL(true, cache.find<data::client>(db_file, model::entity::client, client_data.get_name()) == nullptr);
+	CHECK_EQUAL(true, cache.find<data::admin>(db_file, model::entity::client, "other") == nullptr);
+	CHECK_EQUAL(client_data.get_email(), first->get_email());
+}
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * @file report_model_test.cpp
+ *
+ * @brief Unit tests for the model::report class.
+ *
+ * @details
+ * This test suite verifies the SQL-side reports over the test database:
+ *
+ *   • Validating ISO dates.
+ *   • Aging an unpaid invoice into its bucket.
+ *   • Revenue per month and unpaid totals per client.
+ *   • Limiting the top clients.
+ *   • Serving repeated reports from the model cache until an invoice save.
+ *   • Opening another report while a second connection holds the write
+ *     lock, since the schema setup runs once per database file.
+ *
+ * Amounts are checked in integer cents as lower bounds set by the invoice
+ * the fixture saves, dated September 2023.
+ *******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <algorithm>
+#include <generate_pdf.h>
+#include <model_cache.h>
+#include <admin_model.h>
+#include <client_model.h>
+#include <report_model.h>
+#include <invoice_model.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Accept only valid ISO dates. (Done)
+ * 2) Age an unpaid invoice into the 0-30 day bucket. (Done)
+ * 3) Report revenue per month. (Done)
+ * 4) Report the unpaid total per client. (Done)
+ * 5) Limit the top clients. (Done)
+ * 6) Serve a repeated report from the cache until an invoice save. (Done)
+ * 7) Reject invalid report arguments. (Done)
+ * 8) Open another report while a writer holds the database. (Done)
+ ******************************************************************************/
+TEST_GROUP(report_model_test)
+{
+	const std::string db_file{"../storage/tests/model_test.db"};
+	const std::string db_password{"123456789"};
+	const long long invoice_cents{554567500};
+	model::report report_model{db_file, db_password};
+	void setup()
+	{
+		model::cache::instance().clear();
+		model::admin admin_model{db_file, db_password};
+		model::client client_model{db_file, db_password};
+		model::invoice invoice_model{db_file, db_password};
+		(void)admin_model.save(test::generate_business_data());
+		(void)client_model.save(test::generate_client_data());
+		(void)invoice_model.save(test::generate_invoice_data("report machining"));
+	}
+
+	void teardown()
+	{
+		model::cache::instance().clear();
+	}
+};
+
+TEST(report_model_test, accept_only_valid_iso_dates)
+{
+	CHECK_EQUAL(true, model::report::is_date("2023-09-04"));
+	CHECK_EQUAL(true, model::report::is_date("2024-02-29"));
+	CHECK_EQUAL(false, model::report::is_date("2023-02-29"));
+	CHECK_EQUAL(false, model::report::is_date("09-04-2023"));
+	CHECK_EQUAL(false, model::report::is_date("Sep-04-2023"));
+	CHECK_EQUAL(false, model::report::is_date(""));
+}
+
+TEST(report_model_test, age_an_unpaid_invoice_into_its_bucket)
+{
+	CHECK_EQUAL(true, report_model.is_available());
+	model::aging aging{report_model.aged("2023-10-01")};
+
+	CHECK_EQUAL(true, aging.days_0_30_cents >= invoice_cents);
+	CHECK_EQUAL(true, report_model.aged("2023-09-03").days_0_30_cents < aging.days_0_30_cents);
+}
+
+TEST(report_model_test, report_revenue_per_month)
+{
+	std::vector<model::period_revenue> revenue{report_model.revenue("2023-09-01", "2023-09-30")};
+
+	CHECK_EQUAL(1, revenue.size());
+	CHECK_EQUAL(std::string{"2023-09"}, revenue.front().period);
+	CHECK_EQUAL(true, revenue.front().invoices >= 1);
+	CHECK_EQUAL(true, revenue.front().total_cents >= invoice_cents);
+	CHECK_EQUAL(true, revenue.front().unpaid_cents >= invoice_cents);
+}
+
+TEST(report_model_test, report_the_unpaid_total_per_client)
+{
+	std::vector<model::client_total> totals{report_model.unpaid()};
+	std::vector<model::client_total>::iterator client{std::ranges::find(totals, std::string{"Client admin"},
+									    &model::client_total::business_name)};
+
+	CHECK_EQUAL(true, client != totals.end());
+	CHECK_EQUAL(true, client->total_cents >= invoice_cents);
+}
+
+TEST(report_model_test, limit_the_top_clients)
+{
+	std::vector<model::client_total> totals{report_model.top_clients("2023-01-01", "2023-12-31", 1)};
+
+	CHECK_EQUAL(1, totals.size());
+	CHECK_EQUAL(true, totals.front().total_cents >= invoice_cents);
+}
+
+TEST(report_model_test, serve_a_repeated_report_from_the_cache_until_a_save)
+{
+	model::invoice invoice_model{db_file, db_password};
+	(void)report_model.unpaid();
+	model::cache_statistics before{model::cache::instance().statistics()};
+
+	(void)report_model.unpaid();
+	CHECK_EQUAL(before.hits + 1, model::cache::instance().statistics().hits);
+
+	CHECK_EQUAL(true, invoice_model.save(test::generate_invoice_data("report turning")));
+	(void)report_model.unpaid();
+	CHECK_EQUAL(before.misses + 1, model::cache::instance().statistics().misses);
+}
+
+TEST(report_model_test, reject_invalid_report_arguments)
+{
+	CHECK_EQUAL(0, report_model.aged("10-1-2023").days_0_30_cents);
+	CHECK_EQUAL(true, report_model.revenue("2023-09-01", "").empty());
+	CHECK_EQUAL(true, report_model.top_clients("2023-01-01", "2023-12-31", 0).empty());
+}
+
+TEST(report_model_test, open_another_report_while_a_writer_holds_the_database)
+{
+	CHECK_EQUAL(true, report_model.is_available());
+	storage::database::sqlite writer{db_file, db_password};
+	CHECK_EQUAL(true, writer.transaction("BEGIN IMMEDIATE;"));
+
+	model::report second_report{db_file, db_password};
+
+	CHECK_EQUAL(true, writer.transaction("ROLLBACK;"));
+	CHECK_EQUAL(true, second_report.is_available());
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * @file schema_guard_test.cpp
+ *
+ * @brief Unit tests for model::prepare_once().
+ *
+ * @details
+ * Covers the once-per-database-file schema steps the report and totals
+ * models run before their first query:
+ *
+ *   • A step runs once per database file and step name.
+ *   • A step that fails runs again on the next call.
+ *   • forget_prepared() makes the steps of one file run again.
+ *   • Threads asking for the same step together run it once.
+ *
+ * The steps here are counters; the database files are only keys.
+ *******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <atomic>
+#include <future>
+#include <vector>
+#include <schema_guard.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Run a step once per database file and step. (Done)
+ * 2) Run a failed step again. (Done)
+ * 3) Run the steps of a forgotten file again. (Done)
+ * 4) Run a step once for threads asking together. (Done)
+ ******************************************************************************/
+TEST_GROUP(schema_guard_test)
+{
+	const std::string first_file{"schema_guard_first.db"};
+	const std::string second_file{"schema_guard_second.db"};
+	void setup()
+	{
+		model::forget_prepared(first_file);
+		model::forget_prepared(second_file);
+	}
+
+	void teardown()
+	{
+		model::forget_prepared(first_file);
+		model::forget_prepared(second_file);
+	}
+};
+
+TEST(schema_guard_test, run_a_step_once_per_database_file_and_step)
+{
+	int runs{0};
+	auto step = [&runs] () { ++runs; return true; };
+
+	CHECK_EQUAL(true, model::prepare_once(first_file, "report", step));
+	CHECK_EQUAL(true, model::prepare_once(first_file, "report", step));
+	CHECK_EQUAL(1, runs);
+	CHECK_EQUAL(true, model::prepare_once(first_file, "totals", step));
+	CHECK_EQUAL(true, model::prepare_once(second_file, "report", step));
+	CHECK_EQUAL(3, runs);
+}
+
+TEST(schema_guard_test, run_a_failed_step_again)
+{
+	int runs{0};
+
+	CHECK_EQUAL(false, model::prepare_once(first_file, "report", [&runs] () { return ++runs > 1; }));
+	CHECK_EQUAL(true, model::prepare_once(first_file, "report", [&runs] () { return ++runs > 1; }));
+	CHECK_EQUAL(true, model::prepare_once(first_file, "report", [&runs] () { return ++runs > 1; }));
+	CHECK_EQUAL(2, runs);
+	CHECK_EQUAL(false, model::prepare_once(second_file, "report", nullptr));
+}
+
+TEST(schema_guard_test, run_the_steps_of_a_forgotten_file_again)
+{
+	int runs{0};
+	auto step = [&runs] () { ++runs; return true; };
+	CHECK_EQUAL(true, model::prepare_once(first_file, "report", step));
+	CHECK_EQUAL(true, model::prepare_once(second_file, "report", step));
+
+	model::forget_prepared(first_file);
+
+	CHECK_EQUAL(true, model::prepare_once(first_file, "report", step));
+	CHECK_EQUAL(true, model::prepare_once(second_file, "report", step));
+	CHECK_EQUAL(3, runs);
+}
+
+TEST(schema_guard_test, run_a_step_once_for_threads_asking_together)
+{
+	std::atomic<int> runs{0};
+	std::vector<std::future<bool>> callers{};
+	for (int thread{0}; thread < 8; ++thread)
+	{
+		callers.push_back(std::async(std::launch::async, [this, &runs] () {
+			return model::prepare_once(first_file, "totals", [&runs] () { ++runs; return true; });
+		}));
+	}
+
+	for (std::future<bool>& caller : callers)
+	{
+		CHECK_EQUAL(true, caller.get());
+	}
+	CHECK_EQUAL(1, runs.load());
+}
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * @file search_model_test.cpp
+ *
+ * @brief Unit tests for the model::search class.
+ *
+ * @details
+ * This test suite verifies the full-text search over the test database:
+ *
+ *   • Building the FTS5 prefix query from free text.
+ *   • Finding businesses by a prefix of their name or email address, best
+ *     ranked over every business that matches.
+ *   • Finding invoices by order number and labor description.
+ *   • Following saved invoices through the triggers.
+ *   • Suggesting distinct business names.
+ *
+ * The tests use storage/tests/model_test.db; the search model creates and
+ * fills the search tables on first use when the database predates them.
+ *******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <string>
+#include <algorithm>
+#include <sqlite.h>
+#include <generate_pdf.h>
+#include <model_cache.h>
+#include <admin_model.h>
+#include <client_model.h>
+#include <search_model.h>
+#include <invoice_model.h>
+#include <business_serialize.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Build a prefix query from free text. (Done)
+ * 2) Find a business by a name prefix. (Done)
+ * 3) Find an invoice by a labor description prefix. (Done)
+ * 4) Find a newly saved invoice without a rebuild. (Done)
+ * 5) Suggest distinct business names. (Done)
+ * 6) Reject an empty query. (Done)
+ * 7) Rank every matching business, not the first ones by id. (Done)
+ ******************************************************************************/
+TEST_GROUP(search_model_test)
+{
+	const std::string db_file{"../storage/tests/model_test.db"};
+	const std::string db_password{"123456789"};
+	model::search search_model{db_file, db_password};
+	void setup()
+	{
+		model::cache::instance().clear();
+		model::admin admin_model{db_file, db_password};
+		model::client client_model{db_file, db_password};
+		(void)admin_model.save(test::generate_business_data());
+		(void)client_model.save(test::generate_client_data());
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(search_model_test, build_a_prefix_query_from_free_text)
+{
+	CHECK_EQUAL(std::string{"\"acme\"* \"24\"* \"md\"*"}, model::search::match_expression("acme 24/md"));
+	CHECK_EQUAL(std::string{"\"O\"* \"Reilly\"*"}, model::search::match_expression("  O\"Reilly  "));
+	CHECK_EQUAL(std::string{""}, model::search::match_expression(" -*\" "));
+}
+
+TEST(search_model_test, find_a_business_by_a_name_prefix)
+{
+	CHECK_EQUAL(true, search_model.is_available());
+	std::vector<model::search_hit> hits{search_model.find("clie adm", 10)};
+
+	CHECK_EQUAL(false, hits.empty());
+	CHECK_EQUAL(std::string{"Client admin"}, hits.front().business_name);
+}
+
+TEST(search_model_test, find_an_invoice_by_a_labor_description_prefix)
+{
+	model::invoice invoice_model{db_file, db_password};
+	data::invoice invoice_data{test::generate_invoice_data("search lathe turning")};
+	CHECK_EQUAL(true, invoice_model.save(invoice_data));
+
+	std::vector<model::search_hit> hits{search_model.find("lath turn", 10)};
+
+	CHECK_EQUAL(false, hits.empty());
+	CHECK_TRUE(hits.front().kind == model::hit_kind::invoice);
+	CHECK_EQUAL(std::stoll(invoice_data.get_id()), hits.front().id);
+	CHECK_EQUAL(std::string{"Client admin"}, hits.front().business_name);
+}
+
+TEST(search_model_test, find_a_newly_saved_invoice_without_a_rebuild)
+{
+	model::invoice invoice_model{db_file, db_password};
+	data::invoice invoice_data{test::generate_invoice_data("search knurling sleeve")};
+	CHECK_EQUAL(true, invoice_model.save(invoice_data));
+	CHECK_EQUAL(false, search_model.find("knurl", 10).empty());
+
+	invoice_data = test::generate_invoice_data("search threading sleeve");
+	CHECK_EQUAL(true, invoice_model.save(invoice_data));
+
+	CHECK_EQUAL(true, search_model.find("knurl", 10).empty());
+	CHECK_EQUAL(false, search_model.find("thread sleev", 10).empty());
+}
+
+TEST(search_model_test, suggest_distinct_business_names)
+{
+	std::vector<std::string> names{search_model.suggest("client", 5)};
+
+	CHECK_EQUAL(false, names.empty());
+	CHECK_EQUAL(true, std::count(names.begin(), names.end(), std::string{"Client admin"}) == 1);
+}
+
+TEST(search_model_test, reject_an_empty_query)
+{
+	CHECK_EQUAL(true, search_model.find("", 10).empty());
+	CHECK_EQUAL(true, search_model.find(" -*\" ", 10).empty());
+	CHECK_EQUAL(true, search_model.find("client", 0).empty());
+}
+
+TEST(search_model_test, rank_every_matching_business_not_the_first_ones_by_id)
+{
+	storage::database::sqlite database{db_file, db_password};
+	for (int filler{0}; filler < 70; ++filler)
+	{
+		const std::string name{"Rankprobe filler workshop number " + std::to_string(filler)};
+		(void)database.usert(sql::query::business_details_usert, storage::database::sql_parameters{
+			name, "1 Main road", "0001", "Town", "0820000000", "filler" + std::to_string(filler) + "@example.com"});
+	}
+	(void)database.usert(sql::query::business_details_usert, storage::database::sql_parameters{
+		std::string{"Rankprobe Rankprobe"}, "1 Main road", "0001", "Town", "0820000000", "best@example.com"});
+
+	std::vector<model::search_hit> hits{search_model.find("rankprobe", 1)};
+
+	CHECK_EQUAL(1, hits.size());
+	CHECK_EQUAL(std::string{"Rankprobe Rankprobe"}, hits.front().business_name);
+}
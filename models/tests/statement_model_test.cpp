@@ -26,8 +26,19 @@
  *       - Persists an invoice using model::invoice, then saves a statement
  *         associated with that client.
  *       - Calls model::statement::load with the invoice’s business name,
- *         deserializes each std::any into data::pdf_statement, and confirms
- *         that the resulting PDF-ready statement objects are valid.
+ *         and confirms that the returned data::pdf_statement objects are
+ *         valid.
+ *
+ *   • prepare_bundled_statements_for_email
+ *       - Loads the client's statements and prepares them for email with
+ *         model::attachments::bundle, and confirms they go out as a single
+ *         PDF attachment.
+ *
+ *   • write_loaded_statements_to_pdf_files
+ *       - Writes the client's statements to one PDF file each in a
+ *         directory, then again with the first file's path taken by a
+ *         directory, and confirms the call fails while every other
+ *         statement is still written.
  *
  * Together these tests confirm that statements can be saved, retrieved, and
  * transformed into PDF-facing aggregates in coordination with client and
@@ -38,9 +49,13 @@
 
 
 #include <vector>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <filesystem>
 #include <sqlite.h>
 #include <pdf_statement_data.h>
+#include <model_cache.h>
 #include <statement_model.h>
 #include <client_model.h>
 #include <invoice_model.h>
@@ -57,6 +72,9 @@ extern "C"
 /**********************************TEST LIST************************************
  * 1) Load the data from a database. (Done)
  * 2) Save the data into a database. (Done)
+ * 3) Load one keyset page of statements, newest first. (Done)
+ * 4) Prepare the statements for email as one bundled attachment. (Done)
+ * 5) Write loaded statements to PDF files in a directory. (Done)
  ******************************************************************************/
 TEST_GROUP(statement_model_test)
 {
@@ -67,6 +85,7 @@ TEST_GROUP(statement_model_test)
 	model::statement statement{db_file, db_password};
 	void setup()
 	{
+		model::cache::instance().clear();
 		model::client client_model{db_file, db_password};
 		(void) client_model.save(client_data);
 	}
@@ -99,10 +118,102 @@ TEST(statement_model_test, load_data_from_db)
 	model::invoice invoice_model{db_file, db_password};
 	(void) invoice_model.save(invoice_data);
 	(void) statement.save(statement_data);
-	for (const std::any& data : statement.load(invoice_data.get_name()))
+	const model::documents<data::pdf_statement> loaded{statement.load(invoice_data.get_name())};
+	for (const data::pdf_statement& pdf_statement_data : *loaded)
 	{
-		data::pdf_statement pdf_statement_data{std::any_cast<data::pdf_statement>(data)};
-
 		CHECK_EQUAL(true, pdf_statement_data.is_valid());
 	}
 }
+
+TEST(statement_model_test, load_page_with_invalid_arguments)
+{
+	CHECK_EQUAL(true, statement.load_page("", model::page{})->empty());
+	CHECK_EQUAL(true, statement.load_page("Client admin", model::page{.before = 0})->empty());
+}
+
+TEST(statement_model_test, load_pages_newest_first)
+{
+	data::invoice invoice_data{test::generate_invoice_data("model testing")};
+	model::invoice invoice_model{db_file, db_password};
+	(void) invoice_model.save(invoice_data);
+
+	std::vector<data::pdf_statement> first{*statement.load_page(invoice_data.get_name(), model::page{.limit = 1})};
+	CHECK_EQUAL(1, first.size());
+
+	model::page next{.before = std::stoll(first.back().get_number()), .limit = 1};
+	const model::documents<data::pdf_statement> loaded{statement.load_page(invoice_data.get_name(), next)};
+	for (const data::pdf_statement& pdf_statement_data : *loaded)
+	{
+		CHECK_COMPARE(std::stoll(pdf_statement_data.get_number()), <, next.before);
+	}
+}
+
+TEST(statement_model_test, load_page_totals_only_the_statements_invoices)
+{
+	data::invoice invoice_data{test::generate_invoice_data("model testing")};
+	model::invoice invoice_model{db_file, db_password};
+	(void) invoice_model.save(invoice_data);
+
+	const model::documents<data::pdf_statement> loaded{statement.load_page(invoice_data.get_name(), model::page{})};
+	for (const data::pdf_statement& pdf_statement_data : *loaded)
+	{
+		double total{0.0};
+		for (const data::pdf_invoice& pdf_invoice : pdf_statement_data.get_pdf_invoices())
+		{
+			total += std::stod(pdf_invoice.get_invoice().get_grand_total());
+		}
+
+		DOUBLES_EQUAL(total, std::stod(pdf_statement_data.get_total()), 0.01);
+	}
+}
+
+TEST(statement_model_test, prepare_bundled_statements_for_email)
+{
+	data::invoice invoice_data{test::generate_invoice_data("model testing")};
+	model::invoice invoice_model{db_file, db_password};
+	model::statement bundle{db_file, db_password, model::attachments::bundle};
+	(void) invoice_model.save(invoice_data);
+	(void) statement.save(test::generate_statement_data());
+
+	std::vector<data::pdf_statement> pdf_statements{*bundle.load(invoice_data.get_name())};
+	data::email email_data{bundle.prepare_for_email(pdf_statements)};
+
+	CHECK_EQUAL(false, pdf_statements.empty());
+	CHECK_EQUAL(1, email_data.get_attachments().size());
+	CHECK_EQUAL("Statement", email_data.get_subject());
+}
+
+TEST(statement_model_test, write_loaded_statements_to_pdf_files)
+{
+	const std::filesystem::path directory{std::filesystem::temp_directory_path() / "mint-bill-statement-pdfs"};
+	data::invoice invoice_data{test::generate_invoice_data("model testing")};
+	model::invoice invoice_model{db_file, db_password};
+	(void) invoice_model.save(invoice_data);
+	(void) statement.save(test::generate_statement_data());
+	std::vector<data::pdf_statement> pdf_statements{*statement.load(invoice_data.get_name())};
+	auto path = [&directory] (const data::pdf_statement& _pdf_statement) {
+		return directory / ("statement-" + _pdf_statement.get_number() + ".pdf");
+	};
+	auto contents = [] (const std::filesystem::path& _path) {
+		std::ifstream file{_path, std::ios::binary};
+		return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	};
+
+	CHECK_EQUAL(false, pdf_statements.empty());
+	std::filesystem::remove_all(directory);
+	CHECK_EQUAL(true, statement.write_pdfs(pdf_statements, directory));
+	for (const data::pdf_statement& pdf_statement : pdf_statements)
+	{
+		CHECK_EQUAL(0, contents(path(pdf_statement)).rfind("%PDF", 0));
+	}
+
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(path(pdf_statements.front()) / "taken");
+	CHECK_EQUAL(false, statement.write_pdfs(pdf_statements, directory));
+	CHECK_EQUAL(true, std::filesystem::is_directory(path(pdf_statements.front())));
+	for (const data::pdf_statement& pdf_statement : std::span{pdf_statements}.subspan(1))
+	{
+		CHECK_EQUAL(0, contents(path(pdf_statement)).rfind("%PDF", 0));
+	}
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * @file totals_model_test.cpp
+ *
+ * @brief Unit tests for the model::totals class.
+ *
+ * @details
+ * This test suite verifies the statement totals kept by the triggers over the
+ * test database:
+ *
+ *   • Finding no drift after saving invoices through the models.
+ *   • Following an invoice linked to a statement, moved to another and marked
+ *     paid.
+ *   • Reporting a statement whose totals were changed behind the triggers,
+ *     and repairing it.
+ *
+ * The checks read the invoice_count, total_cents and unpaid_cents columns
+ * of a statement row, or let verify() recompute them from the invoices.
+ *******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <generate_pdf.h>
+#include <model_cache.h>
+#include <admin_model.h>
+#include <client_model.h>
+#include <totals_model.h>
+#include <invoice_model.h>
+#include <statement_model.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Prepare the statement totals. (Done)
+ * 2) Find no drift after saving invoices. (Done)
+ * 3) Follow an invoice to another statement and into paid. (Done)
+ * 4) Report and repair totals changed behind the triggers. (Done)
+ ******************************************************************************/
+TEST_GROUP(totals_model_test)
+{
+	const std::string db_file{"../storage/tests/model_test.db"};
+	const std::string db_password{"123456789"};
+	const sqlite3_int64 invoice_id{2};
+	model::totals totals_model{db_file, db_password};
+	void setup()
+	{
+		model::cache::instance().clear();
+		model::admin admin_model{db_file, db_password};
+		model::client client_model{db_file, db_password};
+		model::invoice invoice_model{db_file, db_password};
+		model::statement statement_model{db_file, db_password};
+		(void)admin_model.save(test::generate_business_data());
+		(void)client_model.save(test::generate_client_data());
+		(void)statement_model.save(test::generate_statement_data());
+		(void)invoice_model.save(test::generate_invoice_data("totals machining"));
+	}
+
+	void teardown()
+	{
+		model::cache::instance().clear();
+	}
+
+	sqlite3_int64 statement_id(storage::database::sqlite& _database, const std::string& _period_start)
+	{
+		storage::database::part::rows rows{_database.select(
+			"SELECT statement_id FROM statement WHERE period_start = ?;", {_period_start})};
+		return rows.empty() ? 0 : std::get<sqlite3_int64>(rows.front()[0]);
+	}
+
+	model::statement_total stored(storage::database::sqlite& _database, const long long& _statement_id)
+	{
+		storage::database::part::rows rows{_database.select(
+			"SELECT invoice_count, total_cents, unpaid_cents FROM statement WHERE statement_id = ?;",
+			{static_cast<sqlite3_int64> (_statement_id)})};
+		if (rows.empty() == true)
+		{
+			return model::statement_total{};
+		}
+
+		return model::statement_total{
+			std::get<sqlite3_int64>(rows.front()[0]),
+			std::get<sqlite3_int64>(rows.front()[1]),
+			std::get<sqlite3_int64>(rows.front()[2])
+		};
+	}
+};
+
+TEST(totals_model_test, prepare_the_statement_totals)
+{
+	CHECK_EQUAL(true, totals_model.is_available());
+	storage::database::sqlite database{db_file, db_password};
+	CHECK_EQUAL(true, model::totals::prepare(database));
+}
+
+TEST(totals_model_test, find_no_drift_after_saving_invoices)
+{
+	model::invoice invoice_model{db_file, db_password};
+	CHECK_EQUAL(true, invoice_model.save(test::generate_invoice_data("totals turning")));
+
+	CHECK_EQUAL(true, totals_model.verify().empty());
+}
+
+TEST(totals_model_test, follow_an_invoice_to_another_statement_and_into_paid)
+{
+	storage::database::sqlite database{db_file, db_password};
+	const sqlite3_int64 from{statement_id(database, "Dec-1-2025")};
+	CHECK_EQUAL(true, database.transaction(
+		"INSERT OR IGNORE INTO statement (business_id, period_start, period_end) "
+		"SELECT business_id, 'Jan-1-1999', 'Jan-31-1999' FROM statement WHERE period_start = 'Dec-1-2025';"));
+	const sqlite3_int64 to{statement_id(database, "Jan-1-1999")};
+	CHECK_EQUAL(true, database.usert("UPDATE invoice SET statement_id = ? WHERE invoice_id = ?;", {from, invoice_id}));
+	const model::statement_total before{stored(database, to)};
+
+	CHECK_EQUAL(true, database.usert("UPDATE invoice SET statement_id = ?, paid_status = 'Paid' WHERE invoice_id = ?;",
+					 {to, invoice_id}));
+
+	CHECK_EQUAL(before.invoices + 1, stored(database, to).invoices);
+	CHECK_EQUAL(before.unpaid_cents, stored(database, to).unpaid_cents);
+	CHECK_EQUAL(true, totals_model.verify().empty());
+
+	CHECK_EQUAL(true, database.usert("UPDATE invoice SET statement_id = ?, paid_status = 'Not Paid' WHERE invoice_id = ?;",
+					 {from, invoice_id}));
+	CHECK_TRUE(before == stored(database, to));
+	CHECK_EQUAL(true, totals_model.verify().empty());
+}
+
+TEST(totals_model_test, report_and_repair_totals_changed_behind_the_triggers)
+{
+	storage::database::sqlite database{db_file, db_password};
+	const sqlite3_int64 statement{statement_id(database, "Dec-1-2025")};
+	CHECK_EQUAL(true, database.usert("UPDATE invoice SET statement_id = ? WHERE invoice_id = ?;", {statement, invoice_id}));
+	const model::statement_total actual{stored(database, statement)};
+
+	CHECK_EQUAL(true, database.usert("UPDATE statement SET total_cents = total_cents + 1 WHERE statement_id = ?;",
+					 {statement}));
+	std::vector<model::total_drift> drifts{totals_model.verify()};
+
+	CHECK_EQUAL(1, drifts.size());
+	CHECK_EQUAL(statement, drifts.front().statement_id);
+	CHECK_EQUAL(actual.total_cents + 1, drifts.front().stored.total_cents);
+	CHECK_TRUE(actual == drifts.front().actual);
+
+	CHECK_EQUAL(true, totals_model.repair());
+	CHECK_EQUAL(true, totals_model.verify().empty());
+}
@@ -22,15 +22,31 @@
  *            - Includes binder, a std::variant visitor that binds C++ values
  *              to SQLite prepared-statement parameters safely and consistently.
  *
+ *            - Streams large result sets through stream(), which hands each
+ *              row to a visitor as it is stepped instead of collecting the
+ *              rows, so an export of the whole book holds one row at a time.
+ *
+ *            - Keeps the statements prepared by usert() and select() for the
+ *              lifetime of the connection, keyed by their SQL text, so a
+ *              query repeated in a loop is prepared only once and afterwards
+ *              just reset and re-bound.
+ *
+ *            - Reads a column of a row through part::integer_at() and
+ *              part::text_at(), which treat NULL, another storage class or a
+ *              missing column as 0 or an empty string.
+ *
  *          These abstractions decouple the rest of the system from direct
  *          SQLite API usage, promote consistent error handling, and provide a
  *          clean interface for all database interactions.
  ******************************************************************************/
 #ifndef _SQLITE_H_
 #define _SQLITE_H_
+#include <memory>
 #include <string>
+#include <functional>
 #include <vector>
 #include <variant>
+#include <unordered_map>
 #include <sqlcipher/sqlite3.h>
 
 
@@ -45,6 +61,11 @@ namespace part {
 using column_value = param_values;
 using row = std::vector<column_value>;
 using rows = std::vector<row>;
+using row_visitor = std::function<bool(const row&)>;
+class sql_operations;
+
+[[nodiscard]] long long integer_at(const row&, const std::size_t&);
+[[nodiscard]] std::string text_at(const row&, const std::size_t&);
 }
 class sqlite {
 public:
@@ -60,9 +81,14 @@ public:
 	[[nodiscard]] virtual bool usert(const std::string&, const std::vector<param_values>&);
 	[[nodiscard]] virtual part::rows select(const std::string&, const std::vector<param_values>&);
 	[[nodiscard]] virtual part::rows select(const std::string&);
+	[[nodiscard]] virtual bool stream(const std::string&, const std::vector<param_values>&, const part::row_visitor&);
+
+private:
+	[[nodiscard]] part::sql_operations& prepared(const std::string&);
 
 private:
 	sqlite3 *database{nullptr};
+	std::unordered_map<std::string, std::unique_ptr<part::sql_operations>> statements{};
 };
 
 namespace part
@@ -80,6 +106,8 @@ public:
 	[[nodiscard]] bool virtual bind_params(const std::vector<param_values>&);
 	[[nodiscard]] bool virtual single_execute();
 	[[nodiscard]] rows virtual multi_execute();
+	[[nodiscard]] bool virtual stream_execute(const row_visitor&);
+	void virtual reset();
 
 private:
 	[[nodiscard]] row collect_row_data();
@@ -11,7 +11,8 @@
  *              foreign keys, and applying performance-related settings.
  *
  *            - Implements transaction(), usert(), and select() operations for
- *              executing SQL statements with or without bound parameters.
+ *              executing SQL statements with or without bound parameters, and
+ *              stream(), which visits the rows of a SELECT one at a time.
  *
  *            - Uses part::sql_operations to prepare SQL statements, bind
  *              parameters, step through results, and translate SQLite column
@@ -20,6 +21,19 @@
  *            - Implements binder, which performs type-specific parameter
  *              binding through std::visit.
  *
+ *            - Implements integer_at() and text_at(), the column readers the
+ *              models share.
+ *
+ *            - Caches the prepared statements of usert() and select() per
+ *              connection; each use resets the statement and clears its
+ *              bindings so no read or write lock outlives the call.
+ *
+ *          Opening a connection, preparing a statement and stepping it are
+ *          recorded as "sqlite" trace spans when TRACE_ENABLED is defined,
+ *          and counted in the "db.*" metrics: opens, open and key-derivation
+ *          time (the first read after sqlite3_key), statements prepared and
+ *          executed, and rows decoded.
+ *
  *          Errors encountered during database setup, binding, execution, or
  *          teardown are logged through syslog, and construction-time failures
  *          raise app::errors::construction exceptions to ensure safety.
@@ -29,11 +43,26 @@
 #include <errors.h>
 #include <sqlite.h>
 #include <syslog.h>
+#include <trace.h>
+#include <metrics.h>
+
+
+namespace {
+	utility::metrics::counter& opens{utility::metrics::counter_named("db.opens")};
+	utility::metrics::counter& prepares{utility::metrics::counter_named("db.statements_prepared")};
+	utility::metrics::counter& executions{utility::metrics::counter_named("db.statements_executed")};
+	utility::metrics::counter& rows_decoded{utility::metrics::counter_named("db.rows_decoded")};
+	utility::metrics::histogram& open_time{utility::metrics::histogram_named("db.open_ns")};
+	utility::metrics::histogram& kdf_time{utility::metrics::histogram_named("db.kdf_ns")};
+}
 
 
 //GCOVR_EXCL_START
 storage::database::sqlite::sqlite(const std::string& _path, const std::string& _db_password)
 {
+	TRACE_SPAN("sqlite", "open");
+	utility::metrics::timer open_timer{open_time};
+	opens.add();
 	if (_path.empty() == true || _db_password.empty() == true)
 	{
 		syslog(LOG_CRIT, "SQLITE: invalid parameters - "
@@ -51,6 +80,7 @@ storage::database::sqlite::sqlite(const std::string& _path, const std::string& _
 			throw app::errors::construction;
 		}
 
+		const std::uint64_t kdf_start{utility::metrics::now_ns()};
 		if (sqlite3_key(this->database, _db_password.data(), static_cast<int> (_db_password.size())) != SQLITE_OK)
 		{
 			sqlite3_close_v2(this->database);
@@ -77,6 +107,7 @@ storage::database::sqlite::sqlite(const std::string& _path, const std::string& _
 					 "filename %s, line number %d", __FILE__, __LINE__);
 			throw app::errors::construction;
 		}
+		kdf_time.record(utility::metrics::now_ns() - kdf_start);
 
 		if (sqlite3_exec(this->database, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr) != SQLITE_OK)
 		{
@@ -100,6 +131,7 @@ storage::database::sqlite::sqlite(const std::string& _path, const std::string& _
 
 storage::database::sqlite::~sqlite()
 {
+	this->statements.clear();
 	if (sqlite3_close_v2(this->database) != SQLITE_OK)
 	{
                 syslog(LOG_CRIT, "SQLITE: failed to close the database connection - "
@@ -135,7 +167,7 @@ bool storage::database::sqlite::usert(const std::string& _sql_query, const std::
 	}
 	else
 	{
-		part::sql_operations sql_operations{this->database, _sql_query};
+		part::sql_operations& sql_operations{prepared(_sql_query)};
 		if (sql_operations.bind_params(_sql_query_params) == false)
 		{
 			syslog(LOG_CRIT, "SQLITE: failed to bind the parameters - "
@@ -145,6 +177,7 @@ bool storage::database::sqlite::usert(const std::string& _sql_query, const std::
 		{
 			success = sql_operations.single_execute();
 		}
+		sql_operations.reset();
 	}
 
 	return success;
@@ -160,7 +193,7 @@ storage::database::part::rows storage::database::sqlite::select(const std::strin
 	}
 	else
 	{
-		part::sql_operations sql_operations{this->database, _sql_query};
+		part::sql_operations& sql_operations{prepared(_sql_query)};
 		if (sql_operations.bind_params(_sql_query_params) == false)
 		{
 			syslog(LOG_CRIT, "SQLITE: failed to bind the parameters - "
@@ -170,6 +203,7 @@ storage::database::part::rows storage::database::sqlite::select(const std::strin
 		{
 			rows = std::move(sql_operations.multi_execute());
 		}
+		sql_operations.reset();
 	}
 
 	return rows;
@@ -185,19 +219,61 @@ storage::database::part::rows storage::database::sqlite::select(const std::strin
 	}
 	else
 	{
-		part::sql_operations sql_operations{this->database, _sql_query};
+		part::sql_operations& sql_operations{prepared(_sql_query)};
 		rows = std::move(sql_operations.multi_execute());
+		sql_operations.reset();
 	}
 
 	return rows;
 } //GCOVR_EXCL_LINE
 
+bool storage::database::sqlite::stream(const std::string& _sql_query, const std::vector<param_values>& _sql_query_params,
+					const part::row_visitor& _visitor)
+{
+	bool success{false};
+	if (_sql_query.empty() || _visitor == nullptr)
+	{
+                syslog(LOG_CRIT, "SQLITE: invalid parameters - "
+                                 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+	else
+	{
+		part::sql_operations& sql_operations{prepared(_sql_query)};
+		if (_sql_query_params.empty() == false && sql_operations.bind_params(_sql_query_params) == false)
+		{
+			syslog(LOG_CRIT, "SQLITE: failed to bind the parameters - "
+					 "filename %s, line number %d", __FILE__, __LINE__);
+		}
+		else
+		{
+			success = sql_operations.stream_execute(_visitor);
+		}
+		sql_operations.reset();
+	}
+
+	return success;
+}
+
+storage::database::part::sql_operations& storage::database::sqlite::prepared(const std::string& _sql_query)
+{
+	auto statement{this->statements.find(_sql_query)};
+	if (statement == this->statements.end())
+	{
+		statement = this->statements.emplace(_sql_query,
+				std::make_unique<part::sql_operations>(this->database, _sql_query)).first;
+	}
+
+	return *statement->second;
+}
+
 
 /*********************************************************************************************************
  * SQL_OPERATIONS
  ********************************************************************************************************/
 storage::database::part::sql_operations::sql_operations(sqlite3* _db_conn, const std::string& _sql_query)
 {
+	TRACE_SPAN("sqlite", "prepare");
+	prepares.add();
 	if (_db_conn == nullptr || _sql_query.empty())
 	{
 		syslog(LOG_CRIT, "SQL_OPERATIONS: invalid parameters - "
@@ -259,21 +335,56 @@ bool storage::database::part::sql_operations::bind_params(const std::vector<para
 
 bool storage::database::part::sql_operations::single_execute()
 {
+	TRACE_SPAN("sqlite", "step");
+	executions.add();
 	int return_code{sqlite3_step(this->sql_stmt)};
 	return (return_code == SQLITE_DONE && return_code != SQLITE_ROW);
 }
 
 storage::database::part::rows storage::database::part::sql_operations::multi_execute()
 {
+	TRACE_SPAN("sqlite", "step");
+	executions.add();
 	rows rows;
 	while (sqlite3_step(this->sql_stmt) == SQLITE_ROW)
 	{
 		rows.emplace_back(std::move(this->collect_row_data()));
 	}
+	rows_decoded.add(rows.size());
 
 	return rows;
 } //GCOVR_EXCL_LINE
 
+bool storage::database::part::sql_operations::stream_execute(const row_visitor& _visitor)
+{
+	TRACE_SPAN("sqlite", "step");
+	executions.add();
+	std::size_t visited{0};
+	int return_code{sqlite3_step(this->sql_stmt)};
+	while (return_code == SQLITE_ROW)
+	{
+		++visited;
+		if (_visitor(this->collect_row_data()) == false)
+		{
+			break;
+		}
+		return_code = sqlite3_step(this->sql_stmt);
+	}
+	rows_decoded.add(visited);
+
+	return (return_code == SQLITE_DONE || return_code == SQLITE_ROW);
+}
+
+void storage::database::part::sql_operations::reset()
+{
+	(void)sqlite3_reset(this->sql_stmt);
+	if (sqlite3_clear_bindings(this->sql_stmt) != SQLITE_OK)
+	{
+		syslog(LOG_CRIT, "SQL_OPERATIONS: failed to clear the bindings - "
+				 "filename %s, line number %d", __FILE__, __LINE__);
+	}
+}
+
 storage::database::part::row storage::database::part::sql_operations::collect_row_data()
 {
 	row row;
@@ -354,3 +465,18 @@ int storage::database::part::binder::operator()(const blob& _data) const
 {
 	return sqlite3_bind_blob(this->sql_stmt, this->id_index, _data.data(), static_cast<int> (_data.size()), SQLITE_TRANSIENT);
 }
+
+/*************************************************
+ * column readers
+ *************************************************/
+long long storage::database::part::integer_at(const row& _row, const std::size_t& _index)
+{
+	const sqlite3_int64* value{(_index < _row.size()) ? std::get_if<sqlite3_int64>(&_row[_index]) : nullptr};
+	return (value == nullptr) ? 0 : static_cast<long long> (*value);
+}
+
+std::string storage::database::part::text_at(const row& _row, const std::size_t& _index)
+{
+	const std::string* value{(_index < _row.size()) ? std::get_if<std::string>(&_row[_index]) : nullptr};
+	return (value == nullptr) ? std::string{""} : *value;
+}
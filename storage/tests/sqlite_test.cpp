@@ -21,6 +21,7 @@
  *                • Detecting mismatched parameter counts.
  *                • Handling execution failures when parameters are invalid.
  *                • Successfully inserting/updating rows with valid parameters.
+ *                • Reusing a cached prepared statement, also after a failure.
  *
  *            - SELECT query behavior:
  *                • Handling empty queries and/or empty parameter lists safely.
@@ -29,6 +30,16 @@
  *                • Exercising column conversion for INTEGER, REAL, TEXT, and
  *                  BLOB-like data through the variant-based row representation.
  *
+ *            - Streaming SELECT queries (stream):
+ *                • Visiting the same rows select() returns, in order.
+ *                • Stopping early when the visitor returns false.
+ *                • Rejecting empty queries and unbindable parameters.
+ *
+ *            - Column readers (integer_at, text_at):
+ *                • Reading INTEGER and TEXT columns of a selected row.
+ *                • Falling back to 0 or "" for NULL, another storage class
+ *                  or a column past the end of the row.
+ *
  *            - sql_operations helper:
  *                • Preparing SQL statements on construction and throwing on
  *                  invalid input (null connection, empty SQL, syntax errors).
@@ -103,6 +114,9 @@ static std::string good_sql_query_blob_and_real_data{R"SQL(
  * 4) Ensure that the database is encrypted. (Done)
  * 5) Ensure database connection can handle multiple threads. (Done)
  * 6) Ensure transaction compatibility.
+ * 7) Reuse the prepared statement of a repeated query. (Done)
+ * 8) Stream the rows of a query one at a time. (Done)
+ * 9) Read a column as an integer or as text. (Done)
  ******************************************************************************/
 TEST_GROUP(sqlite_test)
 {
@@ -185,6 +199,34 @@ TEST(sqlite_test, usert_good_parameters)
 	CHECK_EQUAL(true, db.usert(good_sql_query, good_params));
 }
 
+TEST(sqlite_test, usert_reuses_the_statement_after_a_failure)
+{
+	std::vector<storage::database::param_values> bad_params = {
+		std::string("FedBank")
+	};
+
+	CHECK_EQUAL(true, db.usert(good_sql_query, good_params));
+	CHECK_EQUAL(false, db.usert(good_sql_query, bad_params));
+	CHECK_EQUAL(true, db.usert(good_sql_query, good_params));
+}
+
+TEST(sqlite_test, select_reuses_the_statement)
+{
+	const std::string sql_query{R"SQL(
+		  SELECT business_name
+		  FROM business_details
+		  WHERE business_id = ?
+		)SQL"};
+	std::vector<storage::database::param_values> params = {
+		1LL
+	};
+	storage::database::part::rows first{db.select(sql_query, params)};
+	storage::database::part::rows second{db.select(sql_query, params)};
+
+	CHECK_EQUAL(false, first.empty());
+	CHECK_EQUAL(true, first == second);
+}
+
 TEST(sqlite_test, select_with_empty_params)
 {
 	std::vector<storage::database::param_values> params;
@@ -274,6 +316,61 @@ TEST(sqlite_test, select_blob_data)
 }
 
 
+TEST(sqlite_test, stream_visits_the_rows_select_returns)
+{
+	const std::string sql_query{R"SQL(
+		SELECT business_id, business_name FROM business_details ORDER BY business_id;
+		)SQL"};
+	storage::database::part::rows streamed{};
+	CHECK_EQUAL(true, db.stream(sql_query, {}, [&streamed] (const storage::database::part::row& _row) {
+		streamed.push_back(_row);
+		return true;
+	}));
+
+	CHECK_EQUAL(false, streamed.empty());
+	CHECK_EQUAL(true, streamed == db.select(sql_query));
+}
+
+TEST(sqlite_test, stream_stops_when_the_visitor_returns_false)
+{
+	std::size_t visited{0};
+	CHECK_EQUAL(true, db.stream(R"SQL(
+		SELECT business_name FROM business_details WHERE business_id >= ?;
+		)SQL", {1LL}, [&visited] (const storage::database::part::row&) {
+		++visited;
+		return false;
+	}));
+
+	CHECK_EQUAL(1, visited);
+}
+
+TEST(sqlite_test, stream_rejects_bad_arguments)
+{
+	const storage::database::part::row_visitor visitor{[] (const storage::database::part::row&) { return true; }};
+
+	CHECK_EQUAL(false, db.stream("", {}, visitor));
+	CHECK_EQUAL(false, db.stream("SELECT business_name FROM business_details;", {}, nullptr));
+	CHECK_EQUAL(false, db.stream("SELECT business_name FROM business_details WHERE business_id = ?;",
+				     {1LL, 2LL}, visitor));
+}
+
+TEST(sqlite_test, read_a_column_as_an_integer_or_as_text)
+{
+	storage::database::part::rows rows{db.select("SELECT 42, 'text', NULL, 1.5;")};
+
+	CHECK_EQUAL(1, rows.size());
+	CHECK_EQUAL(42, storage::database::part::integer_at(rows.front(), 0));
+	STRCMP_EQUAL("text", storage::database::part::text_at(rows.front(), 1).c_str());
+	CHECK_EQUAL(0, storage::database::part::integer_at(rows.front(), 1));
+	STRCMP_EQUAL("", storage::database::part::text_at(rows.front(), 0).c_str());
+	CHECK_EQUAL(0, storage::database::part::integer_at(rows.front(), 2));
+	STRCMP_EQUAL("", storage::database::part::text_at(rows.front(), 2).c_str());
+	CHECK_EQUAL(0, storage::database::part::integer_at(rows.front(), 3));
+	CHECK_EQUAL(0, storage::database::part::integer_at(rows.front(), 4));
+	STRCMP_EQUAL("", storage::database::part::text_at(rows.front(), 4).c_str());
+}
+
+
 
 
 
@@ -2,22 +2,28 @@
  * @file    boundary_slicer.h
  * @brief   Line-boundary text slicer with configurable maximum width.
  *
- * @details This class implements a deterministic, thread-safe text slicing
- *          utility that breaks an input string into multiple lines according to
- *          a caller-specified maximum character boundary.
+ * @details This class implements a deterministic text slicing utility that
+ *          breaks an input string into multiple lines according to a
+ *          caller-specified maximum byte boundary.
  *
  *          The algorithm processes text word-by-word and applies the following
  *          behavior:
  *
  *            - Words that fit on the current line are appended normally.
  *            - Words that exceed the maximum length are sliced into multiple
- *              segments of size @ref max.
+ *              segments of at most @ref max bytes, never inside a UTF-8
+ *              sequence.
  *            - Words that would overflow the current line cause a new line to
  *              be started.
  *
+ *          Each line is a view into the input: it runs from its first word to
+ *          its last, so the whitespace between the words is kept as written.
+ *
  *          Concurrency:
- *            A mutex protects updates to the mutable internal buffer
- *            (`current_line`) ensuring safe usage in multi-threaded contexts.
+ *            The slicer holds nothing but @ref max. next(), count() and the
+ *            span overload of slice() are const and keep their position in
+ *            the caller's view, so one slicer can be shared between threads
+ *            without a lock, and none of them allocate.
  *
  *          This class derives from interface::slicer, providing a concrete
  *          implementation of the slice() operation for use by formatting,
@@ -25,10 +31,10 @@
  ******************************************************************************/
 #ifndef _BOUNDARY_SLICER_H_
 #define _BOUNDARY_SLICER_H_
-#include <mutex>
+#include <span>
 #include <string>
 #include <vector>
-#include <sstream>
+#include <string_view>
 #include <slicer.h>
 
 namespace utility {
@@ -43,25 +49,15 @@ namespace utility {
                         virtual ~boundary_slicer() override;
 
                         [[nodiscard]] virtual std::vector<std::string> slice(const std::string&) override;
+                        [[nodiscard]] virtual std::size_t slice(std::string_view, std::span<std::string_view>) const;
+                        [[nodiscard]] virtual std::size_t count(std::string_view) const;
+                        [[nodiscard]] virtual bool next(std::string_view&, std::string_view&) const;
 
                 private:
-                        [[nodiscard]] bool word_does_not_exceed_max(const std::string&);
-                        [[nodiscard]] bool word_does_exceed_max(const std::string&);
-                        void add_word_to_current_line(const std::string&);
-                        void handle_large_word(const std::string&);
-                        void add_new_current_line(const std::string&);
-                        void add_whats_left_over();
+                        [[nodiscard]] std::string_view::size_type chunk(std::string_view) const;
 
                 private:
-                        std::mutex data_mutex{};
-                        std::string current_line{""};
                         std::string::size_type max{40};
-                        std::vector<std::string> sliced_data{};
-
-                        enum DECISION {
-                                NO = 0,
-                                YES
-                        };
         };
 }
 #endif
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * @file    calendar.h
+ * @brief   Cached local date and batched statement period bounds.
+ *
+ * @details Saving an invoice needs today's local date and the statement period
+ *          of its client. Looking the time zone up, converting the clock and
+ *          parsing the schedule again for every invoice is wasted work: the
+ *          zone never changes while the application runs, the date changes
+ *          once a day, and a schedule "N,D" has 28 valid values.
+ *
+ *          Features:
+ *            • utility::schedule
+ *                A parsed "N,D" schedule, two bytes. parse() validates it
+ *                once, so a client's schedule can be parsed when it is read
+ *                and reused for every period computed from it.
+ *
+ *            • current_date() / today()
+ *                Today's local date, as "Mon-DD-YYYY" (e.g. "Jun-05-2025")
+ *                like utility::date_manager::current_date() always returned.
+ *                The zone is looked up once; the date and its formatted text
+ *                are kept until the next local midnight.
+ *
+ *            • compute_period_bounds(schedule)
+ *                The period bounds of a schedule for today, formatted as
+ *                "M-D-YYYY". The bounds of every schedule seen today are kept
+ *                in a table indexed by N and D that is reset on day rollover.
+ *
+ *            • compute_period_bounds(span of schedules)
+ *                The bounds of many schedules in one call, under one lock and
+ *                one clock read, e.g. for every client of a month-end run.
+ *
+ *            • bounds(schedule, date) / format(date)
+ *                The computation itself, for any date, without the clock.
+ *
+ *          The period semantics are those of utility::date_manager:
+ *
+ *            N = 1   → the Monday-aligned week of today, ending on day D.
+ *            N = 2–4 → from the first of the month to day D of the N-th week
+ *                      that starts on a Monday in the month, clamped to the
+ *                      last day of the month.
+ *
+ *          Error handling:
+ *            parse() throws std::runtime_error for a malformed schedule or an
+ *            N or D out of range. An empty schedule parses to an unset one,
+ *            whose bounds are empty.
+ *
+ *          Concurrency:
+ *            instance() is shared by the models; a mutex guards the cached
+ *            date and table. Without a zone given, the zone is the one current
+ *            when the calendar is first used; a later change of the system
+ *            zone is not picked up.
+ ******************************************************************************/
+#ifndef _CALENDAR_H_
+#define _CALENDAR_H_
+#include <span>
+#include <array>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace utility {
+        struct period_bounds
+        {
+                std::string period_start;
+                std::string period_end;
+        };
+
+        struct schedule
+        {
+                std::uint8_t week{0};
+                std::uint8_t day{0};
+
+                [[nodiscard]] bool is_set() const;
+        };
+
+        class calendar {
+                public:
+                        calendar();
+                        explicit calendar(const std::chrono::time_zone*);
+                        calendar(const calendar&) = delete;
+                        calendar(calendar&&) = delete;
+                        calendar& operator= (const calendar&) = delete;
+                        calendar& operator= (calendar&&) = delete;
+                        virtual ~calendar();
+
+                        [[nodiscard]] static calendar& instance();
+                        [[nodiscard]] static utility::schedule parse(std::string_view);
+                        [[nodiscard]] static utility::period_bounds bounds(const utility::schedule&,
+                                                                           const std::chrono::year_month_day&);
+                        [[nodiscard]] static std::string format(const std::chrono::year_month_day&);
+
+                        [[nodiscard]] virtual std::chrono::year_month_day today();
+                        [[nodiscard]] virtual std::string current_date();
+                        [[nodiscard]] virtual utility::period_bounds compute_period_bounds(const utility::schedule&);
+                        [[nodiscard]] virtual std::vector<utility::period_bounds> compute_period_bounds(
+                                                                std::span<const utility::schedule>);
+
+                protected:
+                        [[nodiscard]] virtual std::chrono::system_clock::time_point now() const;
+
+                private:
+                        void refresh();
+                        [[nodiscard]] const utility::period_bounds& lookup(const utility::schedule&);
+
+                private:
+                        std::mutex guard{};
+                        const std::chrono::time_zone* zone{nullptr};
+                        std::chrono::year_month_day date{};
+                        std::chrono::system_clock::time_point midnight{};
+                        std::chrono::system_clock::time_point rollover{};
+                        std::string formatted{""};
+                        std::array<std::optional<utility::period_bounds>, 5 * 8> periods{};
+        };
+}
+#endif
@@ -7,7 +7,7 @@
  *
  *          Features:
  *            • current_date()
- *                Returns the current local date formatted as MM-DD-YYYY.
+ *                Returns the current local date formatted as Mon-DD-YYYY.
  *
  *            • compute_period_bounds(schedule)
  *                Parses a schedule string of the form "N,D" and computes the
@@ -21,18 +21,19 @@
  *          end date strings. Errors in schedule parsing (invalid N or D) are
  *          surfaced via exceptions, ensuring that invalid configurations do not
  *          propagate into statement generation.
+ *
+ *          Both calls are served by utility::calendar::instance() (see
+ *          calendar.h), which caches the zone, today's date and the bounds
+ *          of every schedule until the next local midnight. Code computing
+ *          many periods should parse the schedules once and use the
+ *          calendar's batch API directly.
  ******************************************************************************/
 #ifndef _DATE_MANAGER_H_
 #define _DATE_MANAGER_H_
 #include <string>
+#include <calendar.h>
 
 namespace utility {
-struct period_bounds
-{
-    std::string period_start;
-    std::string period_end;
-};
-
 class date_manager {
 public:
 	date_manager() = default;
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * @file    line_breaker.h
+ * @brief   Width-aware line breaking on measured glyph advances.
+ *
+ * @details Breaks text into lines that fit a width in points, measured with
+ *          the advances of the font the lines will be set in, instead of a
+ *          character count. Wrapping descriptions at a fixed number of
+ *          characters only fits a column for one font and size; at a larger
+ *          size the same lines overflow it.
+ *
+ *          Features:
+ *            • interface::glyph_advances
+ *                What the breaker measures with: the summed advance of a
+ *                UTF-8 string at a font size, and the name of the font, which
+ *                is part of the memoization key. The PDF text metrics
+ *                implement it from their cached advance tables.
+ *
+ *            • wrap(text, width, size, advances, hyphenation)
+ *                Greedy breaking at whitespace; the words of a line are
+ *                joined by one space. A word wider than the width on its own
+ *                is cut into pieces that fit, never inside a UTF-8 sequence,
+ *                and with hyphenation::on every piece but the last ends in a
+ *                hyphen.
+ *
+ *            • Memoization
+ *                Results are kept per (text, width, font, size, hyphenation)
+ *                in a least recently used table of @ref capacity entries, so
+ *                laying out the same document again reuses its breaks.
+ *                instance() is the table shared by the PDF generators.
+ *
+ *          Concurrency:
+ *            A mutex guards the table. Lines are computed outside of it, so
+ *            the advances may take their own lock.
+ ******************************************************************************/
+#ifndef _LINE_BREAKER_H_
+#define _LINE_BREAKER_H_
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace interface {
+        class glyph_advances {
+                public:
+                        virtual ~glyph_advances() = default;
+
+                        [[nodiscard]] virtual double advance(std::string_view, const double&) = 0;
+                        [[nodiscard]] virtual std::string font() const = 0;
+        };
+}
+
+namespace utility {
+        enum class hyphenation {
+                off = 0,
+                on
+        };
+
+        struct break_statistics {
+                std::uint64_t hits{0};
+                std::uint64_t misses{0};
+                std::size_t entries{0};
+        };
+
+        class line_breaker {
+                public:
+                        line_breaker() = default;
+                        explicit line_breaker(const std::size_t& _capacity) : capacity{_capacity} {}
+                        line_breaker(const line_breaker&) = delete;
+                        line_breaker(line_breaker&&) = delete;
+                        line_breaker& operator= (const line_breaker&) = delete;
+                        line_breaker& operator= (line_breaker&&) = delete;
+                        virtual ~line_breaker();
+
+                        [[nodiscard]] static line_breaker& instance();
+
+                        [[nodiscard]] virtual std::vector<std::string> wrap(const std::string&, const double&, const double&,
+                                                                            interface::glyph_advances&,
+                                                                            const utility::hyphenation& = utility::hyphenation::off);
+                        [[nodiscard]] virtual break_statistics statistics() const;
+                        virtual void clear();
+
+                private:
+                        [[nodiscard]] std::vector<std::string> compute(std::string_view, const double&, const double&,
+                                                                       interface::glyph_advances&,
+                                                                       const utility::hyphenation&) const;
+                        void split(std::string_view&, std::vector<std::string>&, const double&, const double&,
+                                   interface::glyph_advances&, const utility::hyphenation&) const;
+
+                private:
+                        using entry = std::pair<std::string, std::vector<std::string>>;
+
+                        mutable std::mutex guard{};
+                        std::size_t capacity{1024};
+                        std::list<entry> recent{};
+                        std::unordered_map<std::string_view, std::list<entry>::iterator> index{};
+                        std::uint64_t hits{0};
+                        std::uint64_t misses{0};
+        };
+}
+#endif
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * @file    metrics.h
+ * @brief   Process-wide runtime metrics: counters and latency histograms.
+ *
+ * @details This component keeps the numbers worth watching in production
+ *          (database opens and key derivation time, statements prepared and
+ *          executed, rows decoded, PDFs rendered, email latency, main-thread
+ *          search stalls) without adding locks to the paths being measured.
+ *
+ *          Features:
+ *            • counter_named(name) / histogram_named(name)
+ *                Return the metric registered under a name, creating it on
+ *                first use. The lookup takes a mutex, so call sites keep the
+ *                returned reference in a static and pay for it once.
+ *
+ *            • counter
+ *                A relaxed atomic total.
+ *
+ *            • histogram
+ *                Log-linear buckets (eight per power of two, so about 12%
+ *                relative error) held in per-thread shards of atomics. A
+ *                thread only ever writes its own shard; reads merge them.
+ *
+ *            • timer
+ *                Records the lifetime of a scope, in nanoseconds, into a
+ *                histogram.
+ *
+ *            • take() / json() / write(path)
+ *                Snapshot every metric and dump the snapshot as JSON.
+ *
+ *          Metrics are never unregistered; references stay valid for the
+ *          lifetime of the process.
+ ******************************************************************************/
+#ifndef _METRICS_H_
+#define _METRICS_H_
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace utility::metrics {
+        constexpr std::size_t shard_count{16};
+        constexpr std::size_t sub_buckets{8};
+        constexpr std::size_t bucket_count{2 * sub_buckets + (64 - 4) * sub_buckets};
+
+        struct histogram_summary {
+                std::string name{""};
+                std::uint64_t count{0};
+                std::uint64_t sum{0};
+                std::uint64_t min{0};
+                std::uint64_t max{0};
+                std::uint64_t p50{0};
+                std::uint64_t p90{0};
+                std::uint64_t p99{0};
+        };
+
+        struct snapshot {
+                std::vector<std::pair<std::string, std::uint64_t>> counters{};
+                std::vector<histogram_summary> histograms{};
+        };
+
+        class counter {
+                public:
+                        counter() = default;
+                        counter(const counter&) = delete;
+                        counter(counter&&) = delete;
+                        counter& operator= (const counter&) = delete;
+                        counter& operator= (counter&&) = delete;
+                        virtual ~counter() = default;
+
+                        virtual void add(const std::uint64_t& _amount = 1);
+                        [[nodiscard]] virtual std::uint64_t value() const;
+                        virtual void reset();
+
+                private:
+                        std::atomic<std::uint64_t> total{0};
+        };
+
+        class histogram {
+                public:
+                        histogram() = default;
+                        histogram(const histogram&) = delete;
+                        histogram(histogram&&) = delete;
+                        histogram& operator= (const histogram&) = delete;
+                        histogram& operator= (histogram&&) = delete;
+                        virtual ~histogram() = default;
+
+                        virtual void record(const std::uint64_t&);
+                        [[nodiscard]] virtual histogram_summary summary() const;
+                        virtual void reset();
+
+                        [[nodiscard]] static std::size_t bucket_of(const std::uint64_t&);
+                        [[nodiscard]] static std::uint64_t lower_bound_of(const std::size_t&);
+
+                private:
+                        struct shard {
+                                std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+                                std::atomic<std::uint64_t> sum{0};
+                        };
+
+                        std::array<shard, shard_count> shards{};
+                        std::atomic<std::uint64_t> smallest{std::numeric_limits<std::uint64_t>::max()};
+                        std::atomic<std::uint64_t> largest{0};
+        };
+
+        class timer {
+                public:
+                        timer() = delete;
+                        explicit timer(histogram&);
+                        timer(const timer&) = delete;
+                        timer(timer&&) = delete;
+                        timer& operator= (const timer&) = delete;
+                        timer& operator= (timer&&) = delete;
+                        virtual ~timer();
+
+                private:
+                        histogram& target;
+                        std::uint64_t start_ns{0};
+        };
+
+        [[nodiscard]] std::uint64_t now_ns();
+        [[nodiscard]] counter& counter_named(const std::string&);
+        [[nodiscard]] histogram& histogram_named(const std::string&);
+        [[nodiscard]] snapshot take();
+        [[nodiscard]] std::string json(const snapshot&);
+        [[nodiscard]] bool write(const std::string&);
+        void reset();
+}
+#endif
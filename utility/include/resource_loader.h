@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * @file    resource_loader.h
+ * @brief   Cached loader for read-only assets.
+ *
+ * @details The email templates are read on every send and the UI and CSS
+ *          definitions at startup. utility::file streams a file through an
+ *          std::ostringstream into a string on each read; this loader reads
+ *          every file once into an immutable string and hands out shared
+ *          references to it instead.
+ *
+ *          Features:
+ *            • resource
+ *                A cheap, copyable handle to one loaded file. view() stays
+ *                valid and unchanged for as long as the handle is held, even
+ *                after the loader has replaced or dropped the content, and
+ *                whatever happens to the file on disk.
+ *
+ *            • load(path)
+ *                Resolves the path to an absolute one, reads the file the
+ *                first time it is asked for and serves the same content
+ *                afterwards. An empty file is a valid resource with an empty
+ *                view.
+ *
+ *            • reload::on_change
+ *                Watches the directory of every loaded file with inotify. A
+ *                file that was written, replaced or removed since the last
+ *                load() is read again on the next one. The events are
+ *                drained on load(), so no thread is involved.
+ *
+ *            • instance()
+ *                The loader shared by the application, with reload on.
+ *
+ *          Error handling:
+ *            A file that cannot be opened or read is logged with syslog and
+ *            returned as an invalid resource; nothing is cached for it.
+ *
+ *          Concurrency:
+ *            A mutex guards the table. The loaded strings are const once
+ *            made, so handles may be read from any thread without it.
+ ******************************************************************************/
+#ifndef _RESOURCE_LOADER_H_
+#define _RESOURCE_LOADER_H_
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <filesystem>
+#include <unordered_map>
+
+namespace utility {
+        enum class reload {
+                never = 0,
+                on_change
+        };
+
+        struct resource_statistics {
+                std::uint64_t reads{0};
+                std::uint64_t hits{0};
+                std::uint64_t reloads{0};
+                std::size_t resources{0};
+        };
+
+        class resource {
+                public:
+                        resource() = default;
+                        explicit resource(const std::shared_ptr<const std::string>& _data) : data{_data} {}
+
+                        [[nodiscard]] bool is_valid() const;
+                        [[nodiscard]] std::string_view view() const;
+
+                private:
+                        std::shared_ptr<const std::string> data{};
+        };
+
+        class resource_loader {
+                public:
+                        resource_loader() = default;
+                        explicit resource_loader(const utility::reload&);
+                        resource_loader(const resource_loader&) = delete;
+                        resource_loader(resource_loader&&) = delete;
+                        resource_loader& operator= (const resource_loader&) = delete;
+                        resource_loader& operator= (resource_loader&&) = delete;
+                        virtual ~resource_loader();
+
+                        [[nodiscard]] static resource_loader& instance();
+
+                        [[nodiscard]] virtual utility::resource load(const std::string&);
+                        [[nodiscard]] virtual resource_statistics statistics() const;
+                        virtual void clear();
+
+                private:
+                        [[nodiscard]] static std::shared_ptr<const std::string> read(const std::filesystem::path&);
+                        void watch(const std::filesystem::path&);
+                        void drain();
+
+                private:
+                        mutable std::mutex guard{};
+                        int notify{-1};
+                        std::unordered_map<std::string, std::shared_ptr<const std::string>> contents{};
+                        std::map<int, std::filesystem::path> directories{};
+                        std::uint64_t reads{0};
+                        std::uint64_t hits{0};
+                        std::uint64_t reloads{0};
+        };
+}
+#endif
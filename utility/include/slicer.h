@@ -16,15 +16,29 @@
  *            • No assumptions about formatting or parsing rules.
  *            • Polymorphic destruction through a virtual destructor.
  *
+ *          The concrete slicers also offer a stateless form: next() takes the
+ *          unsliced rest of the text as a std::string_view, returns the next
+ *          piece as a view into the same text and advances the rest past it.
+ *          The caller owns that cursor, so the slicers keep no state, need no
+ *          lock and do not allocate; slice() into a std::span of views fills
+ *          a caller-provided buffer the same way. The views are only valid
+ *          while the sliced text is.
+ *
+ *          `utility::text::whitespace` is the separator set of both, the one
+ *          `std::isspace` uses in the "C" locale.
+ *
  *          This abstraction allows interchangeable slicing behavior across UI,
  *          formatting, and storage components.
  ******************************************************************************/
 #ifndef _SLICER_H_
 #define _SLICER_H_
-#include <mutex>
 #include <string>
 #include <vector>
-#include <sstream>
+#include <string_view>
+
+namespace utility::text {
+        constexpr std::string_view whitespace{" \t\n\v\f\r"};
+}
 
 namespace interface {
         class slicer {
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * @file    trace.h
+ * @brief   Scoped tracing spans with Chrome trace-event export.
+ *
+ * @details This component records where time is spent without touching the
+ *          syslog path used for errors. A span is an RAII object: it takes a
+ *          steady-clock timestamp when constructed and, when it goes out of
+ *          scope, appends one complete event (name, category, thread, start
+ *          and duration in nanoseconds) to the ring buffer of the calling
+ *          thread.
+ *
+ *          Features:
+ *            • TRACE_SPAN(category, name)
+ *                Opens a span for the rest of the enclosing scope. The macro
+ *                expands to nothing unless TRACE_ENABLED is defined (Debug
+ *                builds), so release builds carry no tracing cost at all.
+ *
+ *            • chrome_json() / write_chrome_json(path)
+ *                Collects the events of every thread, including threads that
+ *                have already exited, into the Chrome trace-event format that
+ *                chrome://tracing and Perfetto load directly.
+ *
+ *            • clear()
+ *                Drops every recorded event.
+ *
+ *            • rings()
+ *                The number of rings allocated. A thread hands its ring back
+ *                when it exits and a later thread reuses it, so this is the
+ *                largest number of threads that traced at the same time.
+ *
+ *          Each thread writes only to its own ring, so recording never waits
+ *          on another thread. A full ring overwrites its oldest events; a
+ *          reused ring keeps the events of the thread that exited until they
+ *          are overwritten. The name and category must be string literals
+ *          because only the pointers are stored.
+ ******************************************************************************/
+#ifndef _TRACE_H_
+#define _TRACE_H_
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace utility::trace {
+        constexpr std::size_t ring_capacity{8192};
+
+        struct event {
+                const char* name{nullptr};
+                const char* category{nullptr};
+                std::uint64_t start_ns{0};
+                std::uint64_t duration_ns{0};
+                std::uint32_t thread{0};
+        };
+
+        class span {
+                public:
+                        span() = delete;
+                        explicit span(const char*, const char*);
+                        span(const span&) = delete;
+                        span(span&&) = delete;
+                        span& operator= (const span&) = delete;
+                        span& operator= (span&&) = delete;
+                        virtual ~span();
+
+                private:
+                        const char* category{nullptr};
+                        const char* name{nullptr};
+                        std::uint64_t start_ns{0};
+        };
+
+        [[nodiscard]] std::vector<event> events();
+        [[nodiscard]] std::string chrome_json();
+        [[nodiscard]] bool write_chrome_json(const std::string&);
+        [[nodiscard]] std::size_t rings();
+        void clear();
+}
+
+#define TRACE_CONCAT_INNER(_a, _b) _a##_b
+#define TRACE_CONCAT(_a, _b) TRACE_CONCAT_INNER(_a, _b)
+
+#if defined(TRACE_ENABLED)
+#define TRACE_SPAN(_category, _name) \
+        utility::trace::span TRACE_CONCAT(trace_span_, __LINE__){_category, _name}
+#else
+#define TRACE_SPAN(_category, _name) ((void)0)
+#endif
+#endif
@@ -8,17 +8,24 @@
  *
  *            • Rejecting empty input strings.
  *            • Limiting the maximum number of output words.
- *            • Thread-safe modification of the internal sliced_data container.
+ *
+ *          The static next() and slice() overloads work on std::string_view
+ *          and keep no state, so they are reentrant and safe to call from any
+ *          thread without a lock:
+ *
+ *            • next(rest, word)   yields the next word and advances rest.
+ *            • slice(text, words) fills a caller-provided span of views and
+ *              returns how many it wrote.
  *
  *          Typical use cases include preparing text for UI display, formatting
  *          invoice content, or breaking larger strings into manageable chunks.
  ******************************************************************************/
 #ifndef _WORD_SLICER_H_
 #define _WORD_SLICER_H_
-#include <mutex>
+#include <span>
 #include <string>
 #include <vector>
-#include <sstream>
+#include <string_view>
 #include <slicer.h>
 
 namespace utility {
@@ -32,16 +39,8 @@ namespace utility {
                         virtual ~word_slicer() override;
 
                         [[nodiscard]] virtual std::vector<std::string> slice(const std::string&) override;
-
-                private:
-                        [[nodiscard]] bool data_ok(const std::string&);
-                        [[nodiscard]] bool not_maxed();
-                        void slice_data(const std::string&);
-                        void safely_add(const std::string&);
-
-                private:
-                        std::mutex data_mutex{};
-                        std::vector<std::string> sliced_data{""};
+                        [[nodiscard]] static std::size_t slice(std::string_view, std::span<std::string_view>);
+                        [[nodiscard]] static bool next(std::string_view&, std::string_view&);
         };
 }
 #endif
@@ -3,105 +3,120 @@
  * @brief   Implementation of the boundary-based text slicing utility.
  *
  * @details This file provides the runtime logic for converting a long string
- *          into multiple bounded lines. The implementation follows a structured
- *          decision model:
+ *          into multiple bounded lines. Every operation is built on next(),
+ *          which follows a structured decision model:
  *
- *            - Determine whether the next word fits on the current line.
- *            - Slice oversized words into multiple fixed-width segments.
- *            - Emit completed lines into the output vector before starting new
- *              ones.
- *            - Append any leftover buffered text at the end.
+ *            - Skip the whitespace in front of the next line.
+ *            - Slice an oversized first word into a fixed-width segment,
+ *              backed off to the start of a UTF-8 sequence.
+ *            - Otherwise extend the line word by word while it still fits.
  *
- *          Internal helpers encapsulate each decision:
- *            • word_does_not_exceed_max() — safe to append word to line.
- *            • word_does_exceed_max()     — word must be segmented.
- *            • add_word_to_current_line() — appends with optional whitespace.
- *            • add_new_current_line()     — flushes current line and begins new.
- *            • handle_large_word()        — slices very long words.
- *            • add_whats_left_over()      — emits the trailing line.
+ *          The line and the rest of the text are views into the caller's
+ *          string; nothing is copied until slice(const std::string&) builds
+ *          its vector.
  *
  *          The design ensures deterministic line wrapping suitable for
  *          UI rendering, PDF creation, or any text environment requiring
  *          predictable formatting boundaries.
  ******************************************************************************/
 #include <boundary_slicer.h>
+#include <algorithm>
 
+namespace utf8 {
+        constexpr bool continuation(const char& _byte)
+        {
+                return (static_cast<unsigned char>(_byte) & 0xC0) == 0x80;
+        }
+}
 
 utility::boundary_slicer::~boundary_slicer() {}
 
 std::vector<std::string> utility::boundary_slicer::slice(const std::string& _data)
 {
-        this->sliced_data.clear();
-        this->current_line.clear();
-        if (!_data.empty())
+        std::vector<std::string> sliced_data{};
+        sliced_data.reserve(count(_data));
+        std::string_view rest{_data};
+        std::string_view line{};
+        while (next(rest, line) == true)
         {
-		std::string word{};
-                std::istringstream stream{_data};
-                while (stream >> word)
-                {
-                        if (word_does_not_exceed_max(word))
-                        {
-                                add_word_to_current_line(word);
-                        }
-                        else if (word_does_exceed_max(word))
-                        {
-                                handle_large_word(word);
-                        }
-                        else
-                        {
-                                add_new_current_line(word);
-                        }
-                }
-                add_whats_left_over();
+                sliced_data.emplace_back(line);
         }
 
-        return this->sliced_data;
+        return sliced_data;
 }
 
-bool utility::boundary_slicer::word_does_not_exceed_max(const std::string& _word)
+std::size_t utility::boundary_slicer::slice(std::string_view _data, std::span<std::string_view> _lines) const
 {
-        std::lock_guard<std::mutex> guard(this->data_mutex);
-        return (this->current_line.size() +
-                        _word.size() +
-                        (this->current_line.empty() ?
-                         DECISION::NO : DECISION::YES) <= this->max);
-}
+        std::size_t lines{0};
+        while (lines < _lines.size() && next(_data, _lines[lines]) == true)
+        {
+                ++lines;
+        }
 
-bool utility::boundary_slicer::word_does_exceed_max(const std::string& _word)
-{
-        return (_word.size() >= this->max);
+        return lines;
 }
 
-void utility::boundary_slicer::add_word_to_current_line(const std::string& _word)
+std::size_t utility::boundary_slicer::count(std::string_view _data) const
 {
-        std::lock_guard<std::mutex> guard(this->data_mutex);
-        if (!this->current_line.empty())
+        std::size_t lines{0};
+        std::string_view line{};
+        while (next(_data, line) == true)
         {
-                this->current_line += " ";
+                ++lines;
         }
 
-        this->current_line += _word;
+        return lines;
 }
 
-void utility::boundary_slicer::handle_large_word(const std::string& _word)
+bool utility::boundary_slicer::next(std::string_view& _rest, std::string_view& _line) const
 {
-        size_t pos{0};
-        while (pos < _word.size())
+        const std::string_view::size_type begin{_rest.find_first_not_of(utility::text::whitespace)};
+        if (begin == std::string_view::npos || this->max == 0)
         {
-                size_t len = std::min(this->max, _word.size() - pos);
-                this->sliced_data.emplace_back(_word.substr(pos, len));
-                pos += len;
+                _rest = {};
+                return false;
         }
-}
 
-void utility::boundary_slicer::add_new_current_line(const std::string& _word)
-{
-        std::lock_guard<std::mutex> guard(this->data_mutex);
-        this->sliced_data.push_back(this->current_line);
-        this->current_line = _word;
+        _rest.remove_prefix(begin);
+        std::string_view::size_type end{std::min(_rest.find_first_of(utility::text::whitespace), _rest.size())};
+        if (end > this->max)
+        {
+                end = chunk(_rest);
+        }
+        else
+        {
+                while (end < _rest.size())
+                {
+                        const std::string_view::size_type word{_rest.find_first_not_of(utility::text::whitespace, end)};
+                        if (word == std::string_view::npos)
+                        {
+                                break;
+                        }
+
+                        const std::string_view::size_type word_end{std::min(_rest.find_first_of(utility::text::whitespace, word),
+                                                                            _rest.size())};
+                        if (word_end > this->max)
+                        {
+                                break;
+                        }
+
+                        end = word_end;
+                }
+        }
+
+        _line = _rest.substr(0, end);
+        _rest.remove_prefix(end);
+
+        return true;
 }
 
-void utility::boundary_slicer::add_whats_left_over()
+std::string_view::size_type utility::boundary_slicer::chunk(std::string_view _word) const
 {
-        this->sliced_data.push_back(this->current_line);
+        std::string_view::size_type end{this->max};
+        while (end > 0 && utf8::continuation(_word[end]) == true)
+        {
+                --end;
+        }
+
+        return (end == 0) ? this->max : end;
 }
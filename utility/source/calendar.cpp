@@ -0,0 +1,227 @@
+/*******************************************************************************
+ * @file    calendar.cpp
+ * @brief   Implementation of the cached calendar and period computation.
+ *
+ * @details refresh() runs when the clock leaves the cached day: it reaches the
+ *          next local midnight converted to system time (the earliest one,
+ *          should a zone skip or repeat midnight), or is set back before the
+ *          midnight that started it. It recomputes the date and its text and
+ *          empties the period table; everything else is served from what it
+ *          left.
+ *
+ *          bounds() is the arithmetic of utility::date_manager, on a date
+ *          passed in. Dates are written with std::to_chars into a buffer on
+ *          the stack instead of through a string stream.
+ ******************************************************************************/
+#include <calendar.h>
+#include <charconv>
+#include <stdexcept>
+
+namespace {
+        constexpr std::array<std::string_view, 12> month_names{
+                "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+        };
+
+        std::size_t slot(const utility::schedule& _schedule)
+        {
+                return static_cast<std::size_t>(_schedule.week) * 8 + _schedule.day;
+        }
+
+        char* write(char* _first, char* _last, const int& _value, const int& _width)
+        {
+                char digits[16]{};
+                char* end{std::to_chars(digits, digits + sizeof(digits), _value).ptr};
+                for (int pad = _width - static_cast<int>(end - digits); pad > 0 && _first < _last; --pad)
+                {
+                        *_first++ = '0';
+                }
+
+                return std::copy(digits, end, _first);
+        }
+
+        std::uint8_t number(std::string_view _text, const char* _error)
+        {
+                while (_text.empty() == false && (_text.front() == ' ' || _text.front() == '\t'))
+                {
+                        _text.remove_prefix(1);
+                }
+
+                int value{0};
+                if (std::from_chars(_text.data(), _text.data() + _text.size(), value).ec != std::errc{} ||
+                    value < 1 || value > 7)
+                {
+                        throw std::runtime_error(_error);
+                }
+
+                return static_cast<std::uint8_t>(value);
+        }
+}
+
+bool utility::schedule::is_set() const
+{
+        return this->week != 0;
+}
+
+utility::calendar::calendar() {}
+
+utility::calendar::calendar(const std::chrono::time_zone* _zone) : zone{_zone} {}
+
+utility::calendar::~calendar() {}
+
+utility::calendar& utility::calendar::instance()
+{
+        static calendar shared{};
+        return shared;
+}
+
+utility::schedule utility::calendar::parse(std::string_view _schedule)
+{
+        if (_schedule.empty() == true)
+        {
+                return schedule{};
+        }
+
+        const std::size_t comma{_schedule.find(',')};
+        if (comma == std::string_view::npos)
+        {
+                throw std::runtime_error("Invalid schedule: expected N,D");
+        }
+
+        schedule parsed{};
+        parsed.week = number(_schedule.substr(0, comma), "Invalid N (must be in [1,4])");
+        if (parsed.week > 4)
+        {
+                throw std::runtime_error("Invalid N (must be in [1,4])");
+        }
+        parsed.day = number(_schedule.substr(comma + 1), "Invalid D (must be in [1,7])");
+
+        return parsed;
+}
+
+utility::period_bounds utility::calendar::bounds(const utility::schedule& _schedule,
+                                                 const std::chrono::year_month_day& _today)
+{
+        if (_schedule.is_set() == false)
+        {
+                return period_bounds{};
+        }
+
+        const std::chrono::sys_days today{_today};
+        if (_schedule.week == 1)
+        {
+                const std::chrono::sys_days monday{today - (std::chrono::weekday{today} - std::chrono::Monday)};
+                return period_bounds{
+                        format(std::chrono::year_month_day{monday}),
+                        format(std::chrono::year_month_day{monday + std::chrono::days{_schedule.day - 1}})
+                };
+        }
+
+        const std::chrono::year_month_day first_of_month{_today.year(), _today.month(), std::chrono::day{1}};
+        const std::chrono::sys_days first{first_of_month};
+        const std::chrono::sys_days last{std::chrono::year_month_day_last{_today.year(),
+                                         std::chrono::month_day_last{_today.month()}}};
+        const std::chrono::sys_days first_monday{first + (std::chrono::Monday - std::chrono::weekday{first})};
+        std::chrono::sys_days end{first_monday + std::chrono::days{7 * (_schedule.week - 1) + _schedule.day - 1}};
+        if (end > last)
+        {
+                end = last;
+        }
+
+        return period_bounds{format(first_of_month), format(std::chrono::year_month_day{end})};
+}
+
+std::string utility::calendar::format(const std::chrono::year_month_day& _date)
+{
+        char buffer[32]{};
+        char* const last{buffer + sizeof(buffer)};
+        char* end{write(buffer, last, static_cast<int>(static_cast<unsigned>(_date.month())), 0)};
+        *end++ = '-';
+        end = write(end, last, static_cast<int>(static_cast<unsigned>(_date.day())), 0);
+        *end++ = '-';
+        end = write(end, last, static_cast<int>(_date.year()), 0);
+
+        return std::string{buffer, end};
+}
+
+std::chrono::year_month_day utility::calendar::today()
+{
+        std::lock_guard<std::mutex> lock{this->guard};
+        refresh();
+        return this->date;
+}
+
+std::string utility::calendar::current_date()
+{
+        std::lock_guard<std::mutex> lock{this->guard};
+        refresh();
+        return this->formatted;
+}
+
+utility::period_bounds utility::calendar::compute_period_bounds(const utility::schedule& _schedule)
+{
+        std::lock_guard<std::mutex> lock{this->guard};
+        refresh();
+        return lookup(_schedule);
+}
+
+std::vector<utility::period_bounds> utility::calendar::compute_period_bounds(
+                                                std::span<const utility::schedule> _schedules)
+{
+        std::vector<period_bounds> result{};
+        result.reserve(_schedules.size());
+        std::lock_guard<std::mutex> lock{this->guard};
+        refresh();
+        for (const schedule& client_schedule : _schedules)
+        {
+                result.push_back(lookup(client_schedule));
+        }
+
+        return result;
+}
+
+std::chrono::system_clock::time_point utility::calendar::now() const
+{
+        return std::chrono::system_clock::now();
+}
+
+void utility::calendar::refresh()
+{
+        const std::chrono::system_clock::time_point current{now()};
+        if (current >= this->midnight && current < this->rollover)
+        {
+                return;
+        }
+
+        if (this->zone == nullptr)
+        {
+                this->zone = std::chrono::current_zone();
+        }
+
+        const std::chrono::local_days local{std::chrono::floor<std::chrono::days>(this->zone->to_local(current))};
+        this->date = std::chrono::year_month_day{local};
+        this->midnight = this->zone->to_sys(local, std::chrono::choose::earliest);
+        this->rollover = this->zone->to_sys(local + std::chrono::days{1}, std::chrono::choose::earliest);
+
+        const unsigned month{static_cast<unsigned>(this->date.month())};
+        char buffer[32]{};
+        char* const last{buffer + sizeof(buffer)};
+        char* end{std::copy(month_names[month - 1].begin(), month_names[month - 1].end(), buffer)};
+        *end++ = '-';
+        end = write(end, last, static_cast<int>(static_cast<unsigned>(this->date.day())), 2);
+        *end++ = '-';
+        end = write(end, last, static_cast<int>(this->date.year()), 4);
+        this->formatted.assign(buffer, end);
+        this->periods.fill(std::nullopt);
+}
+
+const utility::period_bounds& utility::calendar::lookup(const utility::schedule& _schedule)
+{
+        std::optional<period_bounds>& period{this->periods[slot(_schedule)]};
+        if (period.has_value() == false)
+        {
+                period = bounds(_schedule, this->date);
+        }
+
+        return *period;
+}
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * @file    line_breaker.cpp
+ * @brief   Implementation of the width-aware line breaker.
+ *
+ * @details wrap() builds the memoization key, serves a known key from the
+ *          table and moves it to the front; anything else is computed and
+ *          inserted at the front, evicting from the back once the table holds
+ *          @ref capacity entries. The key joins its parts with a unit
+ *          separator, which does not occur in document text.
+ *
+ *          compute() walks the words with utility::word_slicer::next() and
+ *          keeps the advance of the line so far, so every word is measured
+ *          once. split() measures an over-long word one code point at a time
+ *          and cuts it where the next code point (and the hyphen) would no
+ *          longer fit; a piece always holds at least one code point, so a
+ *          width narrower than a single glyph still makes progress.
+ ******************************************************************************/
+#include <line_breaker.h>
+#include <word_slicer.h>
+
+namespace utf8 {
+        constexpr bool continuation(const char& _byte)
+        {
+                return (static_cast<unsigned char>(_byte) & 0xC0) == 0x80;
+        }
+}
+
+utility::line_breaker::~line_breaker() {}
+
+utility::line_breaker& utility::line_breaker::instance()
+{
+        static line_breaker shared{};
+        return shared;
+}
+
+std::vector<std::string> utility::line_breaker::wrap(const std::string& _text, const double& _width, const double& _size,
+                                                     interface::glyph_advances& _advances,
+                                                     const utility::hyphenation& _hyphenation)
+{
+        std::string key{_advances.font()};
+        key.append("\x1f").append(std::to_string(_size))
+           .append("\x1f").append(std::to_string(_width))
+           .append("\x1f").append(std::to_string(static_cast<int>(_hyphenation)))
+           .append("\x1f").append(_text);
+        {
+                std::lock_guard<std::mutex> lock{this->guard};
+                auto found{this->index.find(key)};
+                if (found != this->index.end())
+                {
+                        ++this->hits;
+                        this->recent.splice(this->recent.begin(), this->recent, found->second);
+                        return found->second->second;
+                }
+                ++this->misses;
+        }
+
+        std::vector<std::string> lines{compute(_text, _width, _size, _advances, _hyphenation)};
+        std::lock_guard<std::mutex> lock{this->guard};
+        if (this->capacity > 0 && this->index.contains(key) == false)
+        {
+                if (this->recent.size() >= this->capacity)
+                {
+                        this->index.erase(this->recent.back().first);
+                        this->recent.pop_back();
+                }
+
+                this->recent.emplace_front(std::move(key), lines);
+                this->index.emplace(this->recent.front().first, this->recent.begin());
+        }
+
+        return lines;
+}
+
+utility::break_statistics utility::line_breaker::statistics() const
+{
+        std::lock_guard<std::mutex> lock{this->guard};
+        return utility::break_statistics{this->hits, this->misses, this->recent.size()};
+}
+
+void utility::line_breaker::clear()
+{
+        std::lock_guard<std::mutex> lock{this->guard};
+        this->index.clear();
+        this->recent.clear();
+        this->hits = 0;
+        this->misses = 0;
+}
+
+std::vector<std::string> utility::line_breaker::compute(std::string_view _text, const double& _width, const double& _size,
+                                                        interface::glyph_advances& _advances,
+                                                        const utility::hyphenation& _hyphenation) const
+{
+        std::vector<std::string> lines{};
+        const double space{_advances.advance(" ", _size)};
+        std::string line{""};
+        double line_width{0.0};
+        std::string_view word{};
+        while (utility::word_slicer::next(_text, word) == true)
+        {
+                const double word_width{_advances.advance(word, _size)};
+                if (line.empty() == false && line_width + space + word_width <= _width)
+                {
+                        line.append(" ").append(word);
+                        line_width += space + word_width;
+                        continue;
+                }
+
+                if (line.empty() == false)
+                {
+                        lines.push_back(std::move(line));
+                }
+
+                line_width = word_width;
+                if (word_width > _width)
+                {
+                        split(word, lines, _width, _size, _advances, _hyphenation);
+                        line_width = _advances.advance(word, _size);
+                }
+                line = word;
+        }
+
+        if (line.empty() == false)
+        {
+                lines.push_back(std::move(line));
+        }
+
+        return lines;
+}
+
+void utility::line_breaker::split(std::string_view& _word, std::vector<std::string>& _lines, const double& _width,
+                                  const double& _size, interface::glyph_advances& _advances,
+                                  const utility::hyphenation& _hyphenation) const
+{
+        const double hyphen{(_hyphenation == utility::hyphenation::on) ? _advances.advance("-", _size) : 0.0};
+        while (_advances.advance(_word, _size) > _width)
+        {
+                std::string_view::size_type end{0};
+                double piece_width{0.0};
+                while (end < _word.size())
+                {
+                        std::string_view::size_type next{end + 1};
+                        while (next < _word.size() && utf8::continuation(_word[next]) == true)
+                        {
+                                ++next;
+                        }
+
+                        const double glyph{_advances.advance(_word.substr(end, next - end), _size)};
+                        if (end > 0 && piece_width + glyph + hyphen > _width)
+                        {
+                                break;
+                        }
+
+                        piece_width += glyph;
+                        end = next;
+                }
+
+                if (end == _word.size())
+                {
+                        break;
+                }
+
+                std::string piece{_word.substr(0, end)};
+                if (_hyphenation == utility::hyphenation::on)
+                {
+                        piece.append("-");
+                }
+                _lines.push_back(std::move(piece));
+                _word.remove_prefix(end);
+        }
+}
@@ -0,0 +1,302 @@
+/*******************************************************************************
+ * @file    metrics.cpp
+ * @brief   Implementation of the runtime metrics registry.
+ *
+ * @details Counters are single relaxed atomics. Histograms spread their
+ *          writes over `shard_count` shards chosen by a per-thread slot, so
+ *          concurrent recorders do not share cache lines in the common case;
+ *          summary() adds the shards together and walks the merged buckets to
+ *          find the percentiles.
+ *
+ *          Bucketing is log-linear: values below 16 get a bucket each, larger
+ *          values are split into eight buckets per power of two using the
+ *          three bits below the most significant bit. A percentile is reported
+ *          as the middle of its bucket, clamped to the recorded min and max.
+ *
+ *          The registry maps names to heap-allocated metrics behind a mutex
+ *          that is only taken by lookups, snapshots and reset().
+ ******************************************************************************/
+#include <metrics.h>
+#include <map>
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <syslog.h>
+
+
+namespace utility::metrics {
+namespace {
+        struct registry {
+                std::mutex guard{};
+                std::map<std::string, std::unique_ptr<counter>> counters{};
+                std::map<std::string, std::unique_ptr<histogram>> histograms{};
+        };
+
+        registry& instance()
+        {
+                static registry metrics{};
+                return metrics;
+        }
+
+        std::size_t shard_slot()
+        {
+                static std::atomic<std::size_t> next_slot{0};
+                thread_local const std::size_t slot{next_slot.fetch_add(1, std::memory_order_relaxed) % shard_count};
+                return slot;
+        }
+
+        std::uint64_t bucket_width(const std::size_t& _bucket)
+        {
+                std::uint64_t width{1};
+                if (_bucket >= 2 * sub_buckets)
+                {
+                        const std::size_t magnitude{(_bucket - 2 * sub_buckets) / sub_buckets + 4};
+                        width = std::uint64_t{1} << (magnitude - 3);
+                }
+
+                return width;
+        }
+
+        void escape(std::ostringstream& _out, const std::string& _text)
+        {
+                for (const char character : _text)
+                {
+                        if (character == '"' || character == '\\')
+                                _out << '\\';
+                        if (static_cast<unsigned char>(character) >= 0x20)
+                                _out << character;
+                }
+        }
+}
+}
+
+void utility::metrics::counter::add(const std::uint64_t& _amount)
+{
+        this->total.fetch_add(_amount, std::memory_order_relaxed);
+}
+
+std::uint64_t utility::metrics::counter::value() const
+{
+        return this->total.load(std::memory_order_relaxed);
+}
+
+void utility::metrics::counter::reset()
+{
+        this->total.store(0, std::memory_order_relaxed);
+}
+
+void utility::metrics::histogram::record(const std::uint64_t& _value)
+{
+        shard& current{this->shards[shard_slot()]};
+        current.buckets[bucket_of(_value)].fetch_add(1, std::memory_order_relaxed);
+        current.sum.fetch_add(_value, std::memory_order_relaxed);
+
+        std::uint64_t seen{this->smallest.load(std::memory_order_relaxed)};
+        while (_value < seen && this->smallest.compare_exchange_weak(seen, _value, std::memory_order_relaxed) == false) {}
+        seen = this->largest.load(std::memory_order_relaxed);
+        while (_value > seen && this->largest.compare_exchange_weak(seen, _value, std::memory_order_relaxed) == false) {}
+}
+
+utility::metrics::histogram_summary utility::metrics::histogram::summary() const
+{
+        std::array<std::uint64_t, bucket_count> merged{};
+        histogram_summary summary{};
+        for (const shard& current : this->shards)
+        {
+                for (std::size_t bucket{0}; bucket < bucket_count; ++bucket)
+                {
+                        const std::uint64_t hits{current.buckets[bucket].load(std::memory_order_relaxed)};
+                        merged[bucket] += hits;
+                        summary.count += hits;
+                }
+                summary.sum += current.sum.load(std::memory_order_relaxed);
+        }
+
+        if (summary.count > 0)
+        {
+                summary.min = this->smallest.load(std::memory_order_relaxed);
+                summary.max = this->largest.load(std::memory_order_relaxed);
+                const std::array<std::pair<std::uint64_t, std::uint64_t*>, 3> percentiles{{
+                        {50, &summary.p50}, {90, &summary.p90}, {99, &summary.p99}
+                }};
+                for (const auto& [percent, result] : percentiles)
+                {
+                        const std::uint64_t rank{(summary.count * percent + 99) / 100};
+                        std::uint64_t seen{0};
+                        std::size_t bucket{0};
+                        for (; bucket < bucket_count - 1; ++bucket)
+                        {
+                                seen += merged[bucket];
+                                if (seen >= rank)
+                                        break;
+                        }
+                        const std::uint64_t middle{lower_bound_of(bucket) + bucket_width(bucket) / 2};
+                        *result = std::clamp(middle, summary.min, summary.max);
+                }
+        }
+
+        return summary;
+}
+
+void utility::metrics::histogram::reset()
+{
+        for (shard& current : this->shards)
+        {
+                for (std::atomic<std::uint64_t>& bucket : current.buckets)
+                        bucket.store(0, std::memory_order_relaxed);
+                current.sum.store(0, std::memory_order_relaxed);
+        }
+        this->smallest.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+        this->largest.store(0, std::memory_order_relaxed);
+}
+
+std::size_t utility::metrics::histogram::bucket_of(const std::uint64_t& _value)
+{
+        std::size_t bucket{static_cast<std::size_t>(_value)};
+        if (_value >= 2 * sub_buckets)
+        {
+                const std::size_t magnitude{static_cast<std::size_t>(std::bit_width(_value)) - 1};
+                const std::size_t sub_bucket{static_cast<std::size_t>(_value >> (magnitude - 3)) & (sub_buckets - 1)};
+                bucket = 2 * sub_buckets + (magnitude - 4) * sub_buckets + sub_bucket;
+        }
+
+        return bucket;
+}
+
+std::uint64_t utility::metrics::histogram::lower_bound_of(const std::size_t& _bucket)
+{
+        std::uint64_t lower{static_cast<std::uint64_t>(_bucket)};
+        if (_bucket >= 2 * sub_buckets)
+        {
+                const std::size_t magnitude{(_bucket - 2 * sub_buckets) / sub_buckets + 4};
+                const std::uint64_t sub_bucket{(_bucket - 2 * sub_buckets) % sub_buckets};
+                lower = (sub_buckets + sub_bucket) << (magnitude - 3);
+        }
+
+        return lower;
+}
+
+utility::metrics::timer::timer(histogram& _target)
+        : target{_target}, start_ns{now_ns()}
+{
+}
+
+utility::metrics::timer::~timer()
+{
+        this->target.record(now_ns() - this->start_ns);
+}
+
+std::uint64_t utility::metrics::now_ns()
+{
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+utility::metrics::counter& utility::metrics::counter_named(const std::string& _name)
+{
+        registry& metrics{instance()};
+        std::lock_guard<std::mutex> guard(metrics.guard);
+        std::unique_ptr<counter>& found{metrics.counters[_name]};
+        if (found == nullptr)
+                found = std::make_unique<counter>();
+
+        return *found;
+}
+
+utility::metrics::histogram& utility::metrics::histogram_named(const std::string& _name)
+{
+        registry& metrics{instance()};
+        std::lock_guard<std::mutex> guard(metrics.guard);
+        std::unique_ptr<histogram>& found{metrics.histograms[_name]};
+        if (found == nullptr)
+                found = std::make_unique<histogram>();
+
+        return *found;
+}
+
+utility::metrics::snapshot utility::metrics::take()
+{
+        snapshot current{};
+        registry& metrics{instance()};
+        std::lock_guard<std::mutex> guard(metrics.guard);
+        for (const auto& [name, metric] : metrics.counters)
+        {
+                current.counters.emplace_back(name, metric->value());
+        }
+
+        for (const auto& [name, metric] : metrics.histograms)
+        {
+                histogram_summary summary{metric->summary()};
+                summary.name = name;
+                current.histograms.push_back(std::move(summary));
+        }
+
+        return current;
+}
+
+std::string utility::metrics::json(const snapshot& _snapshot)
+{
+        std::ostringstream out{};
+        out << "{\n\"counters\":{";
+        bool first{true};
+        for (const auto& [name, value] : _snapshot.counters)
+        {
+                out << (first ? "\n\"" : ",\n\"");
+                escape(out, name);
+                out << "\":" << value;
+                first = false;
+        }
+
+        out << "\n},\n\"histograms\":{";
+        first = true;
+        for (const histogram_summary& summary : _snapshot.histograms)
+        {
+                out << (first ? "\n\"" : ",\n\"");
+                escape(out, summary.name);
+                out << "\":{\"count\":" << summary.count << ",\"sum\":" << summary.sum
+                    << ",\"min\":" << summary.min << ",\"max\":" << summary.max
+                    << ",\"p50\":" << summary.p50 << ",\"p90\":" << summary.p90
+                    << ",\"p99\":" << summary.p99 << "}";
+                first = false;
+        }
+        out << "\n}\n}\n";
+
+        return out.str();
+}
+
+bool utility::metrics::write(const std::string& _path)
+{
+        bool success{false};
+        std::ofstream output{_path, std::ios::out | std::ios::trunc};
+        if (output.is_open() == false)
+        {
+                syslog(LOG_CRIT, "UTILITY: failed to open the metrics file - "
+                                 "filename %s, line number %d", __FILE__, __LINE__);
+        }
+        else
+        {
+                output << json(take());
+                success = output.good();
+        }
+
+        return success;
+}
+
+void utility::metrics::reset()
+{
+        registry& metrics{instance()};
+        std::lock_guard<std::mutex> guard(metrics.guard);
+        for (const auto& [name, metric] : metrics.counters)
+        {
+                metric->reset();
+        }
+
+        for (const auto& [name, metric] : metrics.histograms)
+        {
+                metric->reset();
+        }
+}
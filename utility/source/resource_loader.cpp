@@ -0,0 +1,208 @@
+/*******************************************************************************
+ * @file    resource_loader.cpp
+ * @brief   Implementation of the cached resource loader.
+ *
+ * @details read() opens the file, sizes a string from fstat and reads the
+ *          whole file into it with read(2); a short read (the file shrank
+ *          while it was read) keeps what was read. Handles share the string
+ *          through a std::shared_ptr<const std::string>, so the loader can
+ *          forget it while a caller still reads from it, and a file
+ *          rewritten or truncated in place never changes a handle's bytes.
+ *
+ *          With reload::on_change the loader owns a non-blocking inotify
+ *          descriptor. load() first drains it: every event names a file in
+ *          a watched directory, and the content of that file is dropped so
+ *          the lookup that follows reads the file again.
+ ******************************************************************************/
+#include <resource_loader.h>
+#include <array>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <syslog.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+
+namespace events {
+        constexpr std::uint32_t changes{IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MOVED_FROM};
+}
+
+bool utility::resource::is_valid() const
+{
+        return this->data != nullptr;
+}
+
+std::string_view utility::resource::view() const
+{
+        return (this->data == nullptr) ? std::string_view{} : std::string_view{*this->data};
+}
+
+
+utility::resource_loader::resource_loader(const utility::reload& _reload)
+{
+        if (_reload == utility::reload::on_change)
+        {
+                this->notify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                if (this->notify < 0)
+                {
+                        syslog(LOG_CRIT, "RESOURCE_LOADER: inotify is not available, resources will not reload - "
+                                         "filename %s, line number %d", __FILE__, __LINE__);
+                }
+        }
+}
+
+utility::resource_loader::~resource_loader()
+{
+        if (this->notify >= 0)
+        {
+                (void)::close(this->notify);
+        }
+}
+
+utility::resource_loader& utility::resource_loader::instance()
+{
+        static resource_loader shared{utility::reload::on_change};
+        return shared;
+}
+
+utility::resource utility::resource_loader::load(const std::string& _path)
+{
+        std::error_code error{};
+        const std::filesystem::path path{std::filesystem::absolute(_path, error).lexically_normal()};
+        std::lock_guard<std::mutex> lock{this->guard};
+        drain();
+        auto found{this->contents.find(path.string())};
+        if (found != this->contents.end())
+        {
+                ++this->hits;
+                return utility::resource{found->second};
+        }
+
+        std::shared_ptr<const std::string> data{read(path)};
+        if (data == nullptr)
+        {
+                return utility::resource{};
+        }
+
+        ++this->reads;
+        watch(path.parent_path());
+        this->contents.emplace(path.string(), data);
+
+        return utility::resource{data};
+}
+
+utility::resource_statistics utility::resource_loader::statistics() const
+{
+        std::lock_guard<std::mutex> lock{this->guard};
+        return utility::resource_statistics{this->reads, this->hits, this->reloads, this->contents.size()};
+}
+
+void utility::resource_loader::clear()
+{
+        std::lock_guard<std::mutex> lock{this->guard};
+        this->contents.clear();
+        this->reads = 0;
+        this->hits = 0;
+        this->reloads = 0;
+}
+
+std::shared_ptr<const std::string> utility::resource_loader::read(const std::filesystem::path& _path)
+{
+        const int descriptor{::open(_path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (descriptor < 0)
+        {
+                syslog(LOG_CRIT, "RESOURCE_LOADER: failed to open %s - "
+                                 "filename %s, line number %d", _path.c_str(), __FILE__, __LINE__);
+                return nullptr;
+        }
+
+        struct stat status{};
+        std::shared_ptr<std::string> data{nullptr};
+        if (::fstat(descriptor, &status) != 0 || S_ISREG(status.st_mode) == false)
+        {
+                syslog(LOG_CRIT, "RESOURCE_LOADER: %s is not a regular file - "
+                                 "filename %s, line number %d", _path.c_str(), __FILE__, __LINE__);
+        }
+        else
+        {
+                data = std::make_shared<std::string>(static_cast<std::size_t>(status.st_size), '\0');
+                std::size_t length{0};
+                while (data != nullptr && length < data->size())
+                {
+                        const ssize_t count{::read(descriptor, data->data() + length, data->size() - length)};
+                        if (count > 0)
+                        {
+                                length += static_cast<std::size_t>(count);
+                        }
+                        else if (count == 0)
+                        {
+                                data->resize(length);
+                        }
+                        else if (errno != EINTR)
+                        {
+                                syslog(LOG_CRIT, "RESOURCE_LOADER: failed to read %s - "
+                                                 "filename %s, line number %d", _path.c_str(), __FILE__, __LINE__);
+                                data = nullptr;
+                        }
+                }
+        }
+
+        (void)::close(descriptor);
+        return data;
+}
+
+void utility::resource_loader::watch(const std::filesystem::path& _directory)
+{
+        if (this->notify < 0)
+        {
+                return;
+        }
+
+        const int descriptor{::inotify_add_watch(this->notify, _directory.c_str(), events::changes)};
+        if (descriptor < 0)
+        {
+                syslog(LOG_CRIT, "RESOURCE_LOADER: failed to watch %s - "
+                                 "filename %s, line number %d", _directory.c_str(), __FILE__, __LINE__);
+                return;
+        }
+
+        this->directories[descriptor] = _directory;
+}
+
+void utility::resource_loader::drain()
+{
+        if (this->notify < 0)
+        {
+                return;
+        }
+
+        alignas(struct inotify_event) std::array<char, 4096> buffer{};
+        for (;;)
+        {
+                const ssize_t length{::read(this->notify, buffer.data(), buffer.size())};
+                if (length <= 0)
+                {
+                        if (length < 0 && errno == EINTR)
+                        {
+                                continue;
+                        }
+                        break;
+                }
+
+                for (ssize_t offset{0}; offset < length;)
+                {
+                        const struct inotify_event* event{reinterpret_cast<const struct inotify_event*>(buffer.data() + offset)};
+                        offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+                        auto directory{this->directories.find(event->wd)};
+                        if (directory == this->directories.end() || event->len == 0)
+                        {
+                                continue;
+                        }
+
+                        if (this->contents.erase((directory->second / event->name).string()) > 0)
+                        {
+                                ++this->reloads;
+                        }
+                }
+        }
+}
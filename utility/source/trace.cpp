@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * @file    trace.cpp
+ * @brief   Implementation of the scoped tracing spans and their export.
+ *
+ * @details Every thread that records owns one ring of `ring_capacity` events,
+ *          taken on its first span from a process-wide list. When the thread
+ *          exits, its ring goes back to the list with its events and the next
+ *          thread to trace takes it over, so the list only grows to the number
+ *          of threads tracing at the same time, not the number that ever did.
+ *          Each event carries the id of the thread that recorded it, so the
+ *          events of an exited thread are exported under their own id until
+ *          the thread reusing the ring overwrites them. The per-ring mutex is
+ *          only contended while an export or clear() walks the rings.
+ *
+ *          Timestamps are nanoseconds on the steady clock, measured from the
+ *          first use of the tracer. The export converts them to the
+ *          microseconds Chrome expects and orders events by start time.
+ ******************************************************************************/
+#include <trace.h>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <syslog.h>
+
+
+namespace utility::trace {
+namespace {
+        struct ring {
+                std::mutex guard{};
+                std::vector<event> slots{};
+                std::size_t next{0};
+                std::uint32_t thread{0};
+                bool in_use{false};
+        };
+
+        std::mutex registry_guard{};
+        std::vector<std::shared_ptr<ring>> registry{};
+        std::atomic<std::uint32_t> next_thread{1};
+
+        std::uint64_t now()
+        {
+                static const std::chrono::steady_clock::time_point origin{std::chrono::steady_clock::now()};
+                return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::steady_clock::now() - origin).count());
+        }
+
+        class owner {
+                public:
+                        owner()
+                        {
+                                const std::uint32_t thread{next_thread.fetch_add(1, std::memory_order_relaxed)};
+                                std::lock_guard<std::mutex> registry_lock(registry_guard);
+                                auto released{std::find_if(registry.begin(), registry.end(),
+                                                           [] (const std::shared_ptr<ring>& _ring) {
+                                                                   return _ring->in_use == false;
+                                                           })};
+                                if (released == registry.end())
+                                {
+                                        registry.push_back(std::make_shared<ring>());
+                                        registry.back()->slots.reserve(ring_capacity);
+                                        released = std::prev(registry.end());
+                                }
+
+                                this->current = *released;
+                                this->current->in_use = true;
+                                std::lock_guard<std::mutex> guard(this->current->guard);
+                                this->current->thread = thread;
+                        }
+
+                        owner(const owner&) = delete;
+                        owner(owner&&) = delete;
+                        owner& operator= (const owner&) = delete;
+                        owner& operator= (owner&&) = delete;
+
+                        ~owner()
+                        {
+                                std::lock_guard<std::mutex> registry_lock(registry_guard);
+                                this->current->in_use = false;
+                        }
+
+                        std::shared_ptr<ring> current{};
+        };
+
+        ring& local()
+        {
+                thread_local owner holder{};
+                return *holder.current;
+        }
+
+        void record(const event& _event)
+        {
+                ring& current{local()};
+                std::lock_guard<std::mutex> guard(current.guard);
+                event entry{_event};
+                entry.thread = current.thread;
+                if (current.slots.size() < ring_capacity)
+                {
+                        current.slots.push_back(entry);
+                }
+                else
+                {
+                        current.slots[current.next] = entry;
+                }
+                current.next = (current.next + 1) % ring_capacity;
+        }
+
+        void escape(std::ostringstream& _out, const char* _text)
+        {
+                for (const char* character{_text}; character != nullptr && *character != '\0'; ++character)
+                {
+                        switch (*character)
+                        {
+                                case '"': _out << "\\\""; break;
+                                case '\\': _out << "\\\\"; break;
+                                case '\n': _out << "\\n"; break;
+                                case '\t': _out << "\\t"; break;
+                                default:
+                                        if (static_cast<unsigned char>(*character) >= 0x20)
+                                                _out << *character;
+                                        break;
+                        }
+                }
+        }
+
+        void microseconds(std::ostringstream& _out, const std::uint64_t& _ns)
+        {
+                _out << _ns / 1000 << '.' << std::setw(3) << std::setfill('0') << _ns % 1000;
+        }
+}
+}
+
+utility::trace::span::span(const char* _category, const char* _name)
+        : category{_category}, name{_name}, start_ns{now()}
+{
+}
+
+utility::trace::span::~span()
+{
+        const std::uint64_t end_ns{now()};
+        record(event{
+                .name = this->name,
+                .category = this->category,
+                .start_ns = this->start_ns,
+                .duration_ns = end_ns - this->start_ns,
+        });
+}
+
+std::vector<utility::trace::event> utility::trace::events()
+{
+        std::vector<event> collected{};
+        std::lock_guard<std::mutex> registry_lock(registry_guard);
+        for (const std::shared_ptr<ring>& current : registry)
+        {
+                std::lock_guard<std::mutex> guard(current->guard);
+                collected.insert(collected.end(), current->slots.begin(), current->slots.end());
+        }
+
+        std::stable_sort(collected.begin(), collected.end(), [] (const event& _a, const event& _b) {
+                return _a.start_ns < _b.start_ns;
+        });
+
+        return collected;
+}
+
+std::string utility::trace::chrome_json()
+{
+        std::ostringstream out{};
+        out << "{\"traceEvents\":[";
+        bool first{true};
+        for (const event& current : events())
+        {
+                out << (first ? "\n" : ",\n") << "{\"name\":\"";
+                escape(out, current.name);
+                out << "\",\"cat\":\"";
+                escape(out, current.category);
+                out << "\",\"ph\":\"X\",\"ts\":";
+                microseconds(out, current.start_ns);
+                out << ",\"dur\":";
+                microseconds(out, current.duration_ns);
+                out << ",\"pid\":1,\"tid\":" << current.thread << "}";
+                first = false;
+        }
+        out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+        return out.str();
+}
+
+bool utility::trace::write_chrome_json(const std::string& _path)
+{
+        bool success{false};
+        std::ofstream output{_path, std::ios::out | std::ios::trunc};
+        if (output.is_open() == false)
+        {
+                syslog(LOG_CRIT, "UTILITY: failed to open the trace file - "
+                                 "filename %s, line number %d", __FILE__, __LINE__);
+        }
+        else
+        {
+                output << chrome_json();
+                success = output.good();
+        }
+
+        return success;
+}
+
+std::size_t utility::trace::rings()
+{
+        std::lock_guard<std::mutex> registry_lock(registry_guard);
+        return registry.size();
+}
+
+void utility::trace::clear()
+{
+        std::lock_guard<std::mutex> registry_lock(registry_guard);
+        for (const std::shared_ptr<ring>& current : registry)
+        {
+                std::lock_guard<std::mutex> guard(current->guard);
+                current->slots.clear();
+                current->next = 0;
+        }
+}
@@ -2,20 +2,20 @@
  * @file    word_slicer.cpp
  * @brief   Implementation of the word-by-word slicing utility.
  *
- * @details Contains the operational logic for validating data, iterating through
- *          whitespace-separated tokens, and populating the internal vector of
- *          words. A mutex guards updates to the sliced_data structure, ensuring
- *          consistent behavior when accessed from multiple threads.
+ * @details Contains the operational logic for iterating through
+ *          whitespace-separated tokens. Everything is built on next(), which
+ *          only moves two views over the caller's text:
  *
- *          Key behaviors:
- *            • slice(...) resets state and populates words up to a fixed limit.
- *            • data_ok(...) checks basic validity of the input.
- *            • safely_add(...) performs synchronized insertion into the buffer.
+ *            • next(...) skips the leading whitespace of the rest, cuts the
+ *              word in front of it and advances the rest past the word.
+ *            • slice(text, words) stops when the span is full.
+ *            • slice(text) copies up to a fixed limit of words into strings.
  *
  *          This component is intentionally lightweight and is commonly used to
  *          segment customer-facing text in the billing system.
  ******************************************************************************/
 #include <word_slicer.h>
+#include <algorithm>
 
 namespace limit {
         constexpr long unsigned int max{50};
@@ -25,37 +25,40 @@ utility::word_slicer::~word_slicer() {}
 
 std::vector<std::string> utility::word_slicer::slice(const std::string& _data)
 {
-        this->sliced_data.clear();
-        if (data_ok(_data) == true)
+        std::vector<std::string> sliced_data{};
+        std::string_view rest{_data};
+        std::string_view word{};
+        while (sliced_data.size() < limit::max && next(rest, word) == true)
         {
-                slice_data(_data);
+                sliced_data.emplace_back(word);
         }
 
-        return this->sliced_data;
+        return sliced_data;
 }
 
-bool utility::word_slicer::data_ok(const std::string& _data)
+std::size_t utility::word_slicer::slice(std::string_view _data, std::span<std::string_view> _words)
 {
-        return (!_data.empty());
-}
+        std::size_t count{0};
+        while (count < _words.size() && next(_data, _words[count]) == true)
+        {
+                ++count;
+        }
 
-bool utility::word_slicer::not_maxed()
-{
-        return (this->sliced_data.size() < limit::max);
+        return count;
 }
 
-void utility::word_slicer::slice_data(const std::string& _data)
+bool utility::word_slicer::next(std::string_view& _rest, std::string_view& _word)
 {
-        std::string word{""};
-        std::istringstream stream{_data};
-        while ((stream >> word) && not_maxed())
+        const std::string_view::size_type begin{_rest.find_first_not_of(utility::text::whitespace)};
+        if (begin == std::string_view::npos)
         {
-                safely_add(word);
+                _rest = {};
+                return false;
         }
-}
 
-void utility::word_slicer::safely_add(const std::string& _word)
-{
-        std::lock_guard<std::mutex> guard(this->data_mutex);
-        this->sliced_data.push_back(_word);
+        const std::string_view::size_type end{std::min(_rest.find_first_of(utility::text::whitespace, begin), _rest.size())};
+        _word = _rest.substr(begin, end - begin);
+        _rest.remove_prefix(end);
+
+        return true;
 }
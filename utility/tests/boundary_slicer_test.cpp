@@ -21,7 +21,8 @@
  *            4. Validation that the implemented logic produces expected output
  *               sequences (golden-value comparison).
  *
- *            5. Internal thread-safe operations through mutex-guarded updates.
+ *            5. Stateless slicing into std::string_view lines, lazily or into
+ *               a caller-provided span, with multi-byte characters kept whole.
  *
  *          These tests ensure slicing stability for UI formatting, receipts,
  *          PDF rendering, and any feature relying on deterministic text-boundary
@@ -31,6 +32,8 @@
 #include "CppUTestExt/MockSupport.h"
 
 
+#include <array>
+#include <string_view>
 #include <boundary_slicer.h>
 extern "C"
 {
@@ -76,6 +79,10 @@ static const std::string bad_description{"Beneath the sky so vast and blue, Wher
  * 3) When a word is sliced it should be resliced to be cut off at the
  *    previous white space. (Done)
  * 4) Ensure thread safety. (Done)
+ * 5) Yield the lines lazily as views into the input. (Done)
+ * 6) Fill a caller-provided span of views and count the lines. (Done)
+ * 7) A long word is not cut inside a UTF-8 character. (Done)
+ * 8) A long word is emitted after the line in front of it. (Done)
  ******************************************************************************/
 TEST_GROUP(boundary_slicer_test)
 {
@@ -142,3 +149,60 @@ TEST(boundary_slicer_test, check_the_boundary_for_400_plus_word_sizes)
                 STRCMP_EQUAL("ddddddddddddddddddddddddddddddddddddddd", str.c_str());
         }
 }
+
+TEST(boundary_slicer_test, yield_the_lines_lazily_as_views_into_the_input)
+{
+        std::string_view rest{long_description};
+        std::string_view line{};
+
+        int i{1};
+        while (slicer.next(rest, line) == true)
+        {
+                CHECK_EQUAL(std::string{expected[i]}, std::string{line});
+                CHECK(line.data() >= long_description.data());
+                CHECK(line.data() + line.size() <= long_description.data() + long_description.size());
+                ++i;
+        }
+        CHECK_EQUAL(14, i);
+        CHECK_EQUAL(true, rest.empty());
+}
+
+TEST(boundary_slicer_test, fill_a_caller_provided_span_and_count_the_lines)
+{
+        std::array<std::string_view, 16> lines{};
+        std::array<std::string_view, 2> few{};
+
+        CHECK_EQUAL(13, slicer.count(long_description));
+        CHECK_EQUAL(0, slicer.count(" \t\n"));
+        CHECK_EQUAL(13, slicer.slice(long_description, lines));
+        CHECK_EQUAL(std::string{expected[13]}, std::string{lines[12]});
+        CHECK_EQUAL(2, slicer.slice(long_description, few));
+        CHECK_EQUAL(std::string{expected[2]}, std::string{few[1]});
+}
+
+TEST(boundary_slicer_test, a_long_word_is_not_cut_inside_a_utf8_character)
+{
+        const utility::boundary_slicer narrow{4};
+        const std::string word{"ab" "\xE2\x80\x99" "cd"};
+        std::string_view rest{word};
+        std::string_view line{};
+
+        CHECK_EQUAL(true, narrow.next(rest, line));
+        CHECK_EQUAL(std::string{"ab"}, std::string{line});
+        CHECK_EQUAL(true, narrow.next(rest, line));
+        CHECK_EQUAL(std::string{"\xE2\x80\x99" "c"}, std::string{line});
+        CHECK_EQUAL(true, narrow.next(rest, line));
+        CHECK_EQUAL(std::string{"d"}, std::string{line});
+        CHECK_EQUAL(false, narrow.next(rest, line));
+}
+
+TEST(boundary_slicer_test, a_long_word_is_emitted_after_the_line_in_front_of_it)
+{
+        utility::boundary_slicer narrow{10};
+        std::vector<std::string> result{narrow.slice("order no ABCDEFGHIJKLMN end")};
+
+        CHECK_EQUAL(3, result.size());
+        CHECK_EQUAL(std::string{"order no"}, result[0]);
+        CHECK_EQUAL(std::string{"ABCDEFGHIJ"}, result[1]);
+        CHECK_EQUAL(std::string{"KLMN end"}, result[2]);
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ * @file    calendar_test.cpp
+ * @brief   Unit tests for the utility::calendar class.
+ *
+ * @details This test suite verifies the cached calendar behind the invoice
+ *          saves. The period computation is checked on fixed dates, and the
+ *          cached date through a calendar whose clock the test sets. The
+ *          tests ensure:
+ *
+ *            • "N,D" schedules parse into their week and day, an empty one
+ *              into an unset schedule, and malformed ones throw.
+ *
+ *            • Weekly and monthly bounds match the date_manager semantics,
+ *              including the clamp to the last day of the month.
+ *
+ *            • The current date keeps the "Mon-DD-YYYY" format, and the date
+ *              and bounds follow the clock across midnight, forwards and
+ *              backwards.
+ *
+ *            • A batch returns the bounds of every schedule in order, the
+ *              same as one call per schedule.
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <calendar.h>
+#include <date_manager.h>
+extern "C"
+{
+
+}
+
+
+namespace test {
+        class fixed_calendar : public utility::calendar {
+                public:
+                        fixed_calendar() : utility::calendar{std::chrono::locate_zone("UTC")} {}
+
+                        std::chrono::system_clock::time_point clock{};
+
+                protected:
+                        std::chrono::system_clock::time_point now() const override
+                        {
+                                return this->clock;
+                        }
+        };
+
+        std::chrono::system_clock::time_point at(const std::chrono::year_month_day& _date,
+                                                 const std::chrono::seconds& _time)
+        {
+                return std::chrono::sys_days{_date} + _time;
+        }
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Parse a schedule into its week and day. (Done)
+ * 2) Throw on a malformed schedule. (Done)
+ * 3) Compute the Monday-aligned week for N = 1. (Done)
+ * 4) Compute and clamp the month periods for N = 2-4. (Done)
+ * 5) Format the current date as Mon-DD-YYYY. (Done)
+ * 6) Follow the clock across midnight. (Done)
+ * 7) A batch returns the bounds of every schedule in order. (Done)
+ * 8) The date_manager answers through the shared calendar. (Done)
+ ******************************************************************************/
+TEST_GROUP(calendar_test)
+{
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(calendar_test, parse_a_schedule_into_its_week_and_day)
+{
+        const utility::schedule parsed{utility::calendar::parse("4,5")};
+        const utility::schedule empty{utility::calendar::parse("")};
+
+        CHECK_EQUAL(4, parsed.week);
+        CHECK_EQUAL(5, parsed.day);
+        CHECK_EQUAL(true, parsed.is_set());
+        CHECK_EQUAL(false, empty.is_set());
+        CHECK_EQUAL(true, utility::calendar::bounds(empty, std::chrono::year{2025}/6/14).period_start.empty());
+}
+
+TEST(calendar_test, throw_on_a_malformed_schedule)
+{
+        for (const std::string schedule : {"45", "0,1", "5,1", "1,0", "1,8", "x,1", "1,"})
+        {
+                CHECK_THROWS(std::runtime_error, (void)utility::calendar::parse(schedule));
+        }
+}
+
+TEST(calendar_test, compute_the_monday_aligned_week_for_n_1)
+{
+        const std::chrono::year_month_day saturday{std::chrono::year{2025}/6/14};
+
+        const utility::period_bounds first{utility::calendar::bounds({1, 1}, saturday)};
+        const utility::period_bounds last{utility::calendar::bounds({1, 7}, saturday)};
+
+        CHECK_EQUAL("6-9-2025", first.period_start);
+        CHECK_EQUAL("6-9-2025", first.period_end);
+        CHECK_EQUAL("6-9-2025", last.period_start);
+        CHECK_EQUAL("6-15-2025", last.period_end);
+}
+
+TEST(calendar_test, compute_and_clamp_the_month_periods_for_n_2_to_4)
+{
+        const std::chrono::year_month_day june{std::chrono::year{2025}/6/14};
+        const std::chrono::year_month_day february{std::chrono::year{2025}/2/10};
+
+        CHECK_EQUAL("6-1-2025", utility::calendar::bounds({2, 5}, june).period_start);
+        CHECK_EQUAL("6-13-2025", utility::calendar::bounds({2, 5}, june).period_end);
+        CHECK_EQUAL("6-29-2025", utility::calendar::bounds({4, 7}, june).period_end);
+        CHECK_EQUAL("2-1-2025", utility::calendar::bounds({4, 7}, february).period_start);
+        CHECK_EQUAL("2-28-2025", utility::calendar::bounds({4, 7}, february).period_end);
+}
+
+TEST(calendar_test, format_the_current_date_as_mon_dd_yyyy)
+{
+        test::fixed_calendar calendar{};
+        calendar.clock = test::at(std::chrono::year{2025}/6/5, std::chrono::hours{12});
+
+        CHECK_EQUAL("Jun-05-2025", calendar.current_date());
+        CHECK(std::chrono::year{2025}/6/5 == calendar.today());
+}
+
+TEST(calendar_test, follow_the_clock_across_midnight)
+{
+        test::fixed_calendar calendar{};
+        const utility::schedule schedule{4, 7};
+        calendar.clock = test::at(std::chrono::year{2025}/6/30, std::chrono::seconds{86399});
+
+        CHECK_EQUAL("Jun-30-2025", calendar.current_date());
+        CHECK_EQUAL("6-29-2025", calendar.compute_period_bounds(schedule).period_end);
+
+        calendar.clock += std::chrono::seconds{1};
+        CHECK_EQUAL("Jul-01-2025", calendar.current_date());
+        CHECK_EQUAL("7-1-2025", calendar.compute_period_bounds(schedule).period_start);
+        CHECK_EQUAL("7-31-2025", calendar.compute_period_bounds(schedule).period_end);
+
+        calendar.clock -= std::chrono::hours{1};
+        CHECK_EQUAL("Jun-30-2025", calendar.current_date());
+        CHECK_EQUAL("6-29-2025", calendar.compute_period_bounds(schedule).period_end);
+}
+
+TEST(calendar_test, a_batch_returns_the_bounds_of_every_schedule_in_order)
+{
+        test::fixed_calendar calendar{};
+        calendar.clock = test::at(std::chrono::year{2025}/6/14, std::chrono::hours{9});
+        std::vector<utility::schedule> schedules{utility::schedule{}};
+        for (std::uint8_t round = 0; round < 100; ++round)
+        {
+                for (std::uint8_t week = 1; week <= 4; ++week)
+                {
+                        for (std::uint8_t day = 1; day <= 7; ++day)
+                        {
+                                schedules.push_back(utility::schedule{week, day});
+                        }
+                }
+        }
+
+        const std::vector<utility::period_bounds> bounds{calendar.compute_period_bounds(schedules)};
+
+        CHECK_EQUAL(schedules.size(), bounds.size());
+        for (std::size_t index = 0; index < schedules.size(); ++index)
+        {
+                const utility::period_bounds expected{
+                        utility::calendar::bounds(schedules[index], std::chrono::year{2025}/6/14)};
+                CHECK_EQUAL(expected.period_start, bounds[index].period_start);
+                CHECK_EQUAL(expected.period_end, bounds[index].period_end);
+        }
+}
+
+TEST(calendar_test, the_date_manager_answers_through_the_shared_calendar)
+{
+        utility::date_manager date_manager{};
+
+        const utility::period_bounds bounds{date_manager.compute_period_bounds("2,3")};
+
+        CHECK_EQUAL(utility::calendar::instance().current_date(), date_manager.current_date());
+        CHECK_EQUAL(utility::calendar::instance().compute_period_bounds({2, 3}).period_end, bounds.period_end);
+        CHECK_THROWS(std::runtime_error, (void)date_manager.compute_period_bounds("9,9"));
+}
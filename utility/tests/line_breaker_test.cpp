@@ -0,0 +1,187 @@
+/*******************************************************************************
+ * @file    line_breaker_test.cpp
+ * @brief   Unit tests for the utility::line_breaker class.
+ *
+ * @details This test suite verifies width-aware line breaking against a fake
+ *          advance table in which 'W' is twice as wide as any other glyph.
+ *          The tests ensure:
+ *
+ *            • Lines are broken on measured widths, so wide glyphs wrap
+ *              earlier than a character count would.
+ *
+ *            • Over-long words are cut into pieces that fit, with or without
+ *              a hyphen, and never inside a UTF-8 sequence.
+ *
+ *            • A repeated wrap is served from the table without measuring,
+ *              while a different width, size or font is computed afresh.
+ *
+ *            • The least recently used entry is evicted at capacity.
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <string>
+#include <vector>
+#include <string_view>
+#include <line_breaker.h>
+extern "C"
+{
+
+}
+
+
+namespace {
+class fake_advances : public interface::glyph_advances {
+public:
+        explicit fake_advances(const std::string& _font) : name{_font} {}
+
+        double advance(std::string_view _text, const double& _size) override
+        {
+                ++this->calls;
+                double total{0.0};
+                for (const char& byte : _text)
+                {
+                        if ((static_cast<unsigned char>(byte) & 0xC0) != 0x80)
+                        {
+                                total += (byte == 'W') ? 2.0 : 1.0;
+                        }
+                }
+
+                return total * _size / 10.0;
+        }
+
+        std::string font() const override
+        {
+                return this->name;
+        }
+
+        std::string name{""};
+        int calls{0};
+};
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Break lines on measured widths. (Done)
+ * 2) Join the words of a line with one space. (Done)
+ * 3) Cut an over-long word into pieces that fit. (Done)
+ * 4) Hyphenate the pieces of an over-long word. (Done)
+ * 5) Do not cut inside a UTF-8 character. (Done)
+ * 6) Serve a repeated wrap from the table. (Done)
+ * 7) Compute a different width, size or font afresh. (Done)
+ * 8) Evict the least recently used entry at capacity. (Done)
+ ******************************************************************************/
+TEST_GROUP(line_breaker_test)
+{
+        utility::line_breaker breaker{};
+        fake_advances advances{"fake"};
+	void setup()
+	{
+	}
+
+	void teardown()
+	{
+	}
+};
+
+TEST(line_breaker_test, break_lines_on_measured_widths)
+{
+        const std::vector<std::string> narrow{breaker.wrap("aaaa bbbb cccc", 9.0, 10.0, advances)};
+        const std::vector<std::string> wide{breaker.wrap("aaWW bbbb cccc", 9.0, 10.0, advances)};
+        const std::vector<std::string> large{breaker.wrap("aaaa bbbb cccc", 9.0, 20.0, advances)};
+
+        CHECK_EQUAL(2, narrow.size());
+        CHECK_EQUAL(std::string{"aaaa bbbb"}, narrow[0]);
+        CHECK_EQUAL(std::string{"cccc"}, narrow[1]);
+        CHECK_EQUAL(2, wide.size());
+        CHECK_EQUAL(std::string{"aaWW"}, wide[0]);
+        CHECK_EQUAL(std::string{"bbbb cccc"}, wide[1]);
+        CHECK_EQUAL(3, large.size());
+}
+
+TEST(line_breaker_test, join_the_words_of_a_line_with_one_space)
+{
+        const std::vector<std::string> lines{breaker.wrap("  aa \t bb\n\ncc  ", 20.0, 10.0, advances)};
+
+        CHECK_EQUAL(1, lines.size());
+        CHECK_EQUAL(std::string{"aa bb cc"}, lines[0]);
+        CHECK_EQUAL(0, breaker.wrap(" \t ", 20.0, 10.0, advances).size());
+}
+
+TEST(line_breaker_test, cut_an_over_long_word_into_pieces_that_fit)
+{
+        const std::vector<std::string> lines{breaker.wrap("ab 0123456789AB cd", 4.0, 10.0, advances)};
+
+        CHECK_EQUAL(5, lines.size());
+        CHECK_EQUAL(std::string{"ab"}, lines[0]);
+        CHECK_EQUAL(std::string{"0123"}, lines[1]);
+        CHECK_EQUAL(std::string{"4567"}, lines[2]);
+        CHECK_EQUAL(std::string{"89AB"}, lines[3]);
+        CHECK_EQUAL(std::string{"cd"}, lines[4]);
+}
+
+TEST(line_breaker_test, hyphenate_the_pieces_of_an_over_long_word)
+{
+        const std::vector<std::string> lines{breaker.wrap("012345678 x", 4.0, 10.0, advances, utility::hyphenation::on)};
+
+        CHECK_EQUAL(4, lines.size());
+        CHECK_EQUAL(std::string{"012-"}, lines[0]);
+        CHECK_EQUAL(std::string{"345-"}, lines[1]);
+        CHECK_EQUAL(std::string{"678"}, lines[2]);
+        CHECK_EQUAL(std::string{"x"}, lines[3]);
+}
+
+TEST(line_breaker_test, do_not_cut_inside_a_utf8_character)
+{
+        const std::vector<std::string> lines{breaker.wrap("ab" "\xE2\x80\x99" "cd", 3.0, 10.0, advances)};
+
+        CHECK_EQUAL(2, lines.size());
+        CHECK_EQUAL(std::string{"ab" "\xE2\x80\x99"}, lines[0]);
+        CHECK_EQUAL(std::string{"cd"}, lines[1]);
+}
+
+TEST(line_breaker_test, serve_a_repeated_wrap_from_the_table)
+{
+        const std::vector<std::string> first{breaker.wrap("aaaa bbbb cccc", 9.0, 10.0, advances)};
+        const int calls{advances.calls};
+        const std::vector<std::string> second{breaker.wrap("aaaa bbbb cccc", 9.0, 10.0, advances)};
+        const utility::break_statistics statistics{breaker.statistics()};
+
+        CHECK_TRUE(first == second);
+        CHECK_EQUAL(calls, advances.calls);
+        CHECK_EQUAL(1, statistics.hits);
+        CHECK_EQUAL(1, statistics.misses);
+        CHECK_EQUAL(1, statistics.entries);
+}
+
+TEST(line_breaker_test, compute_a_different_width_size_or_font_afresh)
+{
+        fake_advances other{"other"};
+        (void)breaker.wrap("aaaa bbbb cccc", 9.0, 10.0, advances);
+        (void)breaker.wrap("aaaa bbbb cccc", 14.0, 10.0, advances);
+        (void)breaker.wrap("aaaa bbbb cccc", 9.0, 12.0, advances);
+        (void)breaker.wrap("aaaa bbbb cccc", 9.0, 10.0, other);
+        (void)breaker.wrap("aaaa bbbb cccc", 9.0, 10.0, advances, utility::hyphenation::on);
+
+        CHECK_EQUAL(0, breaker.statistics().hits);
+        CHECK_EQUAL(5, breaker.statistics().entries);
+        breaker.clear();
+        CHECK_EQUAL(0, breaker.statistics().entries);
+}
+
+TEST(line_breaker_test, evict_the_least_recently_used_entry_at_capacity)
+{
+        utility::line_breaker small{2};
+        (void)small.wrap("first", 9.0, 10.0, advances);
+        (void)small.wrap("second", 9.0, 10.0, advances);
+        (void)small.wrap("first", 9.0, 10.0, advances);
+        (void)small.wrap("third", 9.0, 10.0, advances);
+        const int calls{advances.calls};
+        (void)small.wrap("first", 9.0, 10.0, advances);
+
+        CHECK_EQUAL(calls, advances.calls);
+        CHECK_EQUAL(2, small.statistics().entries);
+        (void)small.wrap("second", 9.0, 10.0, advances);
+        CHECK_TRUE(calls < advances.calls);
+}
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * @file    metrics_test.cpp
+ * @brief   Unit tests for the utility::metrics registry.
+ *
+ * @details This test suite verifies the counters and histograms fed from the
+ *          storage, model, feature and GUI hot paths. The tests ensure:
+ *
+ *            • A name always resolves to the same metric.
+ *
+ *            • Counters add up across threads.
+ *
+ *            • Histogram buckets stay within the documented relative error
+ *              and the percentiles of a known distribution land in the right
+ *              bucket after the per-thread shards are merged.
+ *
+ *            • Snapshots serialise to JSON and reset() zeroes every metric.
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <metrics.h>
+#include <string>
+#include <thread>
+#include <vector>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Resolve a name to the same metric. (Done)
+ * 2) Add up a counter across threads. (Done)
+ * 3) Keep bucket lower bounds within one eighth of the value. (Done)
+ * 4) Merge the shards of a histogram recorded on several threads. (Done)
+ * 5) Serialise a snapshot and reset every metric. (Done)
+ ******************************************************************************/
+TEST_GROUP(metrics_test)
+{
+	void setup()
+	{
+		utility::metrics::reset();
+	}
+
+	void teardown()
+	{
+		utility::metrics::reset();
+	}
+};
+
+TEST(metrics_test, resolve_a_name_to_the_same_metric)
+{
+	CHECK_TRUE(&utility::metrics::counter_named("test.same") == &utility::metrics::counter_named("test.same"));
+	CHECK_TRUE(&utility::metrics::histogram_named("test.same") == &utility::metrics::histogram_named("test.same"));
+	CHECK_TRUE(&utility::metrics::counter_named("test.same") != &utility::metrics::counter_named("test.other"));
+}
+
+TEST(metrics_test, add_up_a_counter_across_threads)
+{
+	utility::metrics::counter& counter{utility::metrics::counter_named("test.counter")};
+	std::vector<std::thread> threads{};
+	for (int thread{0}; thread < 4; ++thread)
+	{
+		threads.emplace_back([&counter] {
+			for (int i{0}; i < 1000; ++i)
+				counter.add();
+		});
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+
+	CHECK_EQUAL(4000, counter.value());
+}
+
+TEST(metrics_test, keep_bucket_lower_bounds_within_one_eighth)
+{
+	for (std::uint64_t value{1}; value < (std::uint64_t{1} << 40); value = value * 3 + 1)
+	{
+		const std::uint64_t lower{utility::metrics::histogram::lower_bound_of(
+				utility::metrics::histogram::bucket_of(value))};
+		CHECK_TRUE(lower <= value);
+		CHECK_TRUE(value - lower <= value / 8);
+	}
+	CHECK_EQUAL(utility::metrics::bucket_count - 1,
+		    utility::metrics::histogram::bucket_of(std::numeric_limits<std::uint64_t>::max()));
+}
+
+TEST(metrics_test, merge_the_shards_of_a_histogram)
+{
+	utility::metrics::histogram& histogram{utility::metrics::histogram_named("test.histogram")};
+	std::vector<std::thread> threads{};
+	for (int thread{0}; thread < 4; ++thread)
+	{
+		threads.emplace_back([&histogram] {
+			for (std::uint64_t value{1}; value <= 1000; ++value)
+				histogram.record(value * 1000);
+		});
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+	utility::metrics::histogram_summary summary{histogram.summary()};
+
+	CHECK_EQUAL(4000, summary.count);
+	CHECK_EQUAL(4 * 500500000, summary.sum);
+	CHECK_EQUAL(1000, summary.min);
+	CHECK_EQUAL(1000000, summary.max);
+	CHECK_TRUE(summary.p50 >= 500000 * 7 / 8 && summary.p50 <= 500000 * 9 / 8);
+	CHECK_TRUE(summary.p90 >= 900000 * 7 / 8 && summary.p90 <= 900000 * 9 / 8);
+	CHECK_TRUE(summary.p99 >= 990000 * 7 / 8 && summary.p99 <= 1000000);
+}
+
+TEST(metrics_test, serialise_a_snapshot_and_reset)
+{
+	utility::metrics::counter_named("test.json").add(7);
+	utility::metrics::histogram_named("test.json_ns").record(42);
+	std::string json{utility::metrics::json(utility::metrics::take())};
+
+	CHECK_TRUE(json.find("\"test.json\":7") != std::string::npos);
+	CHECK_TRUE(json.find("\"test.json_ns\":{\"count\":1,\"sum\":42,\"min\":42,\"max\":42") != std::string::npos);
+
+	utility::metrics::reset();
+	CHECK_EQUAL(0, utility::metrics::counter_named("test.json").value());
+	CHECK_EQUAL(0, utility::metrics::histogram_named("test.json_ns").summary().count);
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * @file    resource_loader_test.cpp
+ * @brief   Unit tests for the utility::resource_loader class.
+ *
+ * @details This test suite verifies the cached asset loader used for the
+ *          email templates and the UI and CSS definitions. The tests ensure:
+ *
+ *            • A file is read once and every later load of it, by a relative
+ *              or an absolute path, is served from that content.
+ *
+ *            • Empty files load as empty resources, and files that cannot
+ *              be opened as invalid ones.
+ *
+ *            • With reload::on_change a replaced file is read again on the
+ *              next load, while a handle taken earlier keeps its content;
+ *              with reload::never the first content is kept.
+ *
+ *            • A file truncated and rewritten in place leaves the content of
+ *              a handle taken earlier as it was.
+ *
+ *            • The email templates read the same as through utility::file.
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <file.h>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <resource_loader.h>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Read a file once and serve it from the cache afterwards. (Done)
+ * 2) A relative and an absolute path are the same resource. (Done)
+ * 3) Load an empty file as an empty resource. (Done)
+ * 4) A missing file is an invalid resource and is not cached. (Done)
+ * 5) Read a replaced file again when reloading on change. (Done)
+ * 6) Keep the first content when never reloading. (Done)
+ * 7) Read the email templates as utility::file does. (Done)
+ * 8) Keep a handle's content when the file is rewritten in place. (Done)
+ ******************************************************************************/
+TEST_GROUP(resource_loader_test)
+{
+        const std::filesystem::path directory{std::filesystem::temp_directory_path() / "mint-bill-resource-loader-test"};
+	void setup()
+	{
+                std::filesystem::create_directories(directory);
+	}
+
+	void teardown()
+	{
+                std::filesystem::remove_all(directory);
+	}
+
+        void write(const std::filesystem::path& _path, const std::string& _content)
+        {
+                const std::filesystem::path staging{_path.string() + ".tmp"};
+                {
+                        std::ofstream file{staging, std::ios::binary | std::ios::trunc};
+                        file << _content;
+                }
+                std::filesystem::rename(staging, _path);
+        }
+};
+
+TEST(resource_loader_test, read_a_file_once_and_serve_it_from_the_cache_afterwards)
+{
+        utility::resource_loader loader{};
+        write(directory / "template.txt", "Hello, {{CLIENT_NAME}}");
+
+        const utility::resource first{loader.load((directory / "template.txt").string())};
+        const utility::resource second{loader.load((directory / "template.txt").string())};
+
+        CHECK_EQUAL(true, first.is_valid());
+        CHECK_EQUAL(std::string{"Hello, {{CLIENT_NAME}}"}, std::string{first.view()});
+        CHECK_EQUAL(first.view().data(), second.view().data());
+        CHECK_EQUAL(1, loader.statistics().reads);
+        CHECK_EQUAL(1, loader.statistics().hits);
+}
+
+TEST(resource_loader_test, a_relative_and_an_absolute_path_are_the_same_resource)
+{
+        utility::resource_loader loader{};
+
+        const utility::resource relative{loader.load("email.txt")};
+        const utility::resource absolute{loader.load(std::filesystem::absolute("email.txt").string())};
+
+        CHECK_EQUAL(relative.view().data(), absolute.view().data());
+        CHECK_EQUAL(1, loader.statistics().resources);
+}
+
+TEST(resource_loader_test, load_an_empty_file_as_an_empty_resource)
+{
+        utility::resource_loader loader{};
+        write(directory / "empty.txt", "");
+
+        const utility::resource empty{loader.load((directory / "empty.txt").string())};
+
+        CHECK_EQUAL(true, empty.is_valid());
+        CHECK_EQUAL(true, empty.view().empty());
+}
+
+TEST(resource_loader_test, a_missing_file_is_an_invalid_resource_and_is_not_cached)
+{
+        utility::resource_loader loader{};
+
+        const utility::resource missing{loader.load((directory / "missing.txt").string())};
+
+        CHECK_EQUAL(false, missing.is_valid());
+        CHECK_EQUAL(true, missing.view().empty());
+        CHECK_EQUAL(false, utility::resource{}.is_valid());
+        CHECK_EQUAL(0, loader.statistics().resources);
+}
+
+TEST(resource_loader_test, read_a_replaced_file_again_when_reloading_on_change)
+{
+        utility::resource_loader loader{utility::reload::on_change};
+        write(directory / "template.txt", "first");
+        const utility::resource before{loader.load((directory / "template.txt").string())};
+
+        write(directory / "template.txt", "second version");
+        const utility::resource after{loader.load((directory / "template.txt").string())};
+
+        CHECK_EQUAL(std::string{"first"}, std::string{before.view()});
+        CHECK_EQUAL(std::string{"second version"}, std::string{after.view()});
+        CHECK_EQUAL(2, loader.statistics().reads);
+        CHECK_EQUAL(1, loader.statistics().reloads);
+}
+
+TEST(resource_loader_test, keep_the_first_content_when_never_reloading)
+{
+        utility::resource_loader loader{utility::reload::never};
+        write(directory / "template.txt", "first");
+        const utility::resource before{loader.load((directory / "template.txt").string())};
+
+        write(directory / "template.txt", "second version");
+        const utility::resource after{loader.load((directory / "template.txt").string())};
+
+        CHECK_EQUAL(std::string{"first"}, std::string{after.view()});
+        CHECK_EQUAL(before.view().data(), after.view().data());
+}
+
+TEST(resource_loader_test, read_the_email_templates_as_utility_file_does)
+{
+        utility::resource_loader loader{};
+        utility::file text{"email.txt"};
+        utility::file html{"email.html"};
+
+        CHECK_EQUAL(text.read(), std::string{loader.load("email.txt").view()});
+        CHECK_EQUAL(html.read(), std::string{loader.load("email.html").view()});
+}
+
+TEST(resource_loader_test, keep_a_handles_content_when_the_file_is_rewritten_in_place)
+{
+        utility::resource_loader loader{utility::reload::on_change};
+        write(directory / "template.txt", "a template long enough to be cut short");
+        const utility::resource before{loader.load((directory / "template.txt").string())};
+
+        {
+                std::ofstream file{directory / "template.txt", std::ios::binary | std::ios::trunc};
+                file << "cut";
+        }
+        const utility::resource after{loader.load((directory / "template.txt").string())};
+
+        CHECK_EQUAL(std::string{"a template long enough to be cut short"}, std::string{before.view()});
+        CHECK_EQUAL(std::string{"cut"}, std::string{after.view()});
+}
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * @file    trace_test.cpp
+ * @brief   Unit tests for the utility::trace spans and their export.
+ *
+ * @details This test suite verifies the tracing facility used to find where
+ *          a slow run spends its time. The tests ensure:
+ *
+ *            • A span records one event with its name, category and a
+ *              duration covering the enclosing scope.
+ *
+ *            • Spans recorded on another thread carry a different thread id
+ *              and survive the thread's exit.
+ *
+ *            • A full ring keeps only the newest `ring_capacity` events.
+ *
+ *            • Threads started one after another reuse one ring instead of
+ *              each leaving a new one behind, and their events keep their
+ *              own thread ids.
+ *
+ *            • The Chrome export is a single traceEvents array of complete
+ *              ("X") events with escaped names.
+ ******************************************************************************/
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+
+
+#include <trace.h>
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+extern "C"
+{
+
+}
+
+
+/**********************************TEST LIST************************************
+ * 1) Record a span with its duration. (Done)
+ * 2) Keep the events of an exited thread under its own id. (Done)
+ * 3) Overwrite the oldest events of a full ring. (Done)
+ * 4) Export the events as Chrome trace-event JSON. (Done)
+ * 5) Reuse the ring of an exited thread. (Done)
+ ******************************************************************************/
+TEST_GROUP(trace_test)
+{
+	void setup()
+	{
+		utility::trace::clear();
+	}
+
+	void teardown()
+	{
+		utility::trace::clear();
+	}
+};
+
+TEST(trace_test, record_a_span_with_its_duration)
+{
+	{
+		utility::trace::span span{"test", "sleep"};
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+	std::vector<utility::trace::event> events{utility::trace::events()};
+
+	CHECK_EQUAL(1, events.size());
+	STRCMP_EQUAL("test", events[0].category);
+	STRCMP_EQUAL("sleep", events[0].name);
+	CHECK_TRUE(events[0].duration_ns >= 2000000);
+}
+
+TEST(trace_test, keep_the_events_of_an_exited_thread)
+{
+	{
+		utility::trace::span span{"test", "main"};
+	}
+	std::thread worker{[] {
+		utility::trace::span span{"test", "worker"};
+	}};
+	worker.join();
+	std::vector<utility::trace::event> events{utility::trace::events()};
+
+	CHECK_EQUAL(2, events.size());
+	CHECK_TRUE(events[0].thread != events[1].thread);
+}
+
+TEST(trace_test, overwrite_the_oldest_events_of_a_full_ring)
+{
+	{
+		utility::trace::span span{"test", "oldest"};
+	}
+	for (std::size_t i{0}; i < utility::trace::ring_capacity; ++i)
+	{
+		utility::trace::span span{"test", "newer"};
+	}
+	std::vector<utility::trace::event> events{utility::trace::events()};
+
+	CHECK_EQUAL(utility::trace::ring_capacity, events.size());
+	STRCMP_EQUAL("newer", events[0].name);
+}
+
+TEST(trace_test, export_chrome_trace_event_json)
+{
+	{
+		utility::trace::span span{"test", "say \"hi\""};
+	}
+	std::string json{utility::trace::chrome_json()};
+
+	CHECK_EQUAL(0, json.find("{\"traceEvents\":["));
+	CHECK_TRUE(json.find("\"name\":\"say \\\"hi\\\"\"") != std::string::npos);
+	CHECK_TRUE(json.find("\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+	CHECK_TRUE(json.find("\"pid\":1,\"tid\":") != std::string::npos);
+}
+
+TEST(trace_test, reuse_the_ring_of_an_exited_thread)
+{
+	{
+		utility::trace::span span{"test", "main"};
+	}
+	const std::size_t rings{utility::trace::rings()};
+	for (int i = 0; i < 64; ++i)
+	{
+		std::thread worker{[] {
+			utility::trace::span span{"test", "worker"};
+		}};
+		worker.join();
+	}
+	std::set<std::uint32_t> threads{};
+	for (const utility::trace::event& event : utility::trace::events())
+	{
+		threads.insert(event.thread);
+	}
+
+	CHECK_TRUE(utility::trace::rings() <= rings + 1);
+	CHECK_EQUAL(65, threads.size());
+}
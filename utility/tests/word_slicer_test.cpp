@@ -9,8 +9,9 @@
  *            • Correct parsing of arbitrary strings into discrete words, with
  *              whitespace handled strictly as a separator.
  *
- *            • Enforcement of the class’s internal safety guarantees, including
- *              thread-safe insertion of sliced words via mutex protection.
+ *            • Stateless slicing into std::string_view pieces, either lazily
+ *              through next() or into a caller-provided span, that point into
+ *              the input and can be run concurrently without a lock.
  *
  *            • Proper non-copyable and non-movable semantics, preventing unsafe
  *              transfer of internal state that could lead to race conditions.
@@ -30,6 +31,8 @@
 #include "CppUTestExt/MockSupport.h"
 
 
+#include <array>
+#include <string_view>
 #include <word_slicer.h>
 extern "C"
 {
@@ -83,6 +86,9 @@ std::vector<std::string> expected{"Forty","plus","years","in","our","two-story",
  * 3) Ensure object is none copyable. (Done)
  * 4) Ensure object is not moveable. (Done)
  * 5) It should handle a maximum string length of 50 words. (Done)
+ * 6) Yield the words lazily as views into the input. (Done)
+ * 7) Fill a caller-provided span of views up to its size. (Done)
+ * 8) Two cursors over the same text do not interfere. (Done)
  ******************************************************************************/
 TEST_GROUP(word_slicer_test)
 {
@@ -130,3 +136,49 @@ TEST(word_slicer_test, slice_to_much_data)
                 ++i;
         }
 }
+
+TEST(word_slicer_test, yield_the_words_lazily_as_views_into_the_input)
+{
+        const std::string text{"\t Forty  plus\nyears "};
+        std::string_view rest{text};
+        std::string_view word{};
+
+        CHECK_EQUAL(true, utility::word_slicer::next(rest, word));
+        CHECK_EQUAL(std::string_view{"Forty"}, word);
+        CHECK_EQUAL(text.data() + 2, word.data());
+        CHECK_EQUAL(true, utility::word_slicer::next(rest, word));
+        CHECK_EQUAL(std::string_view{"plus"}, word);
+        CHECK_EQUAL(true, utility::word_slicer::next(rest, word));
+        CHECK_EQUAL(std::string_view{"years"}, word);
+        CHECK_EQUAL(false, utility::word_slicer::next(rest, word));
+        CHECK_EQUAL(true, rest.empty());
+}
+
+TEST(word_slicer_test, fill_a_caller_provided_span_up_to_its_size)
+{
+        std::array<std::string_view, 8> words{};
+        std::array<std::string_view, 3> few{};
+
+        CHECK_EQUAL(0, utility::word_slicer::slice("   ", words));
+        CHECK_EQUAL(3, utility::word_slicer::slice(max_num_words, few));
+        CHECK_EQUAL(expected[2], std::string{few[2]});
+        CHECK_EQUAL(7, utility::word_slicer::slice("Forty plus years in our two-story house", words));
+        for (std::size_t i{0}; i < 7; ++i)
+        {
+                CHECK_EQUAL(expected[i], std::string{words[i]});
+        }
+}
+
+TEST(word_slicer_test, two_cursors_over_the_same_text_do_not_interfere)
+{
+        std::string_view first{max_num_words};
+        std::string_view second{max_num_words};
+        std::string_view word{};
+
+        CHECK_EQUAL(true, utility::word_slicer::next(first, word));
+        CHECK_EQUAL(true, utility::word_slicer::next(first, word));
+        CHECK_EQUAL(true, utility::word_slicer::next(second, word));
+        CHECK_EQUAL(expected[0], std::string{word});
+        CHECK_EQUAL(true, utility::word_slicer::next(first, word));
+        CHECK_EQUAL(expected[2], std::string{word});
+}